@@ -0,0 +1,251 @@
+/**
+ * @file joint_trajectory_block.h
+ * @brief A compact representation of a joint trajectory
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_COMMAND_LANGUAGE_JOINT_TRAJECTORY_BLOCK_H
+#define TESSERACT_COMMAND_LANGUAGE_JOINT_TRAJECTORY_BLOCK_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <string>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/poly/instruction_poly.h>
+#include <tesseract_command_language/poly/move_instruction_poly.h>
+#include <tesseract_command_language/constants.h>
+#include <tesseract_command_language/profile_dictionary.h>
+#include <tesseract_common/manipulator_info.h>
+
+namespace tesseract_planning
+{
+class CompositeInstruction;
+
+/**
+ * @brief A sequence of move instructions with state waypoints stored as a single instruction
+ * @details Planned and time parameterized programs can contain tens of thousands of move instructions, each with its
+ * own joint names, profiles and waypoint vectors. This instruction stores the state of each point as a column of a
+ * [dof x size] matrix and shares the joint names, manipulator info and profiles of every point, so the whole
+ * trajectory is a handful of allocations.
+ *
+ * The velocity, acceleration and effort are either provided for every point or for none of them, in which case the
+ * matrix is empty. The UUID, parent UUID and move type of each point are kept so converting to and from move
+ * instructions is lossless.
+ */
+class JointTrajectoryBlock
+{
+public:
+  JointTrajectoryBlock() = default;  // Required for boost serialization do not use
+
+  /**
+   * @brief Construct a block from joint positions
+   * @param joint_names The joint names shared by every point
+   * @param position The position of each point as a column of a [dof x size] matrix
+   * @param time The time from start of each point
+   * @param type The move type of every point
+   * @param profile The waypoint profile of every point
+   * @param manipulator_info The manipulator information of every point
+   */
+  JointTrajectoryBlock(std::vector<std::string> joint_names,
+                       Eigen::MatrixXd position,
+                       Eigen::VectorXd time,
+                       MoveInstructionType type = MoveInstructionType::FREESPACE,
+                       std::string profile = DEFAULT_PROFILE_KEY,
+                       tesseract_common::ManipulatorInfo manipulator_info = tesseract_common::ManipulatorInfo());
+
+  /**
+   * @brief Construct a block from move instructions
+   * @details Throws if the instructions are not all move instructions with state waypoints which share the same joint
+   * names, manipulator info, profiles and description, or if only some of them have velocity, acceleration or effort.
+   * @param instructions The move instructions to store
+   */
+  explicit JointTrajectoryBlock(const std::vector<InstructionPoly>& instructions);
+
+  const boost::uuids::uuid& getUUID() const;
+  void regenerateUUID();
+
+  const boost::uuids::uuid& getParentUUID() const;
+  void setParentUUID(const boost::uuids::uuid& uuid);
+
+  const std::string& getDescription() const;
+
+  void setDescription(const std::string& description);
+
+  void print(const std::string& prefix = "") const;  // NOLINT
+
+  /** @brief The number of points */
+  Eigen::Index size() const;
+
+  /** @brief The number of joints */
+  Eigen::Index dof() const;
+
+  /** @brief Check if the block has no points */
+  bool empty() const;
+
+  void setJointNames(std::vector<std::string> joint_names);
+  const std::vector<std::string>& getJointNames() const;
+
+  /** @brief The position of each point as a column of a [dof x size] matrix */
+  Eigen::MatrixXd& getPosition();
+  const Eigen::MatrixXd& getPosition() const;
+
+  /** @brief The velocity of each point as a column of a [dof x size] matrix, empty if not provided */
+  Eigen::MatrixXd& getVelocity();
+  const Eigen::MatrixXd& getVelocity() const;
+
+  /** @brief The acceleration of each point as a column of a [dof x size] matrix, empty if not provided */
+  Eigen::MatrixXd& getAcceleration();
+  const Eigen::MatrixXd& getAcceleration() const;
+
+  /** @brief The effort of each point as a column of a [dof x size] matrix, empty if not provided */
+  Eigen::MatrixXd& getEffort();
+  const Eigen::MatrixXd& getEffort() const;
+
+  /** @brief The time from start of each point */
+  Eigen::VectorXd& getTime();
+  const Eigen::VectorXd& getTime() const;
+
+  /**
+   * @brief Change the number of points
+   * @details Existing points are kept, new points are zero initialized, assigned new UUIDs and use the move type of
+   * the last point. The velocity, acceleration and effort are resized only if they are provided.
+   * @param size The new number of points
+   */
+  void resize(Eigen::Index size);
+
+  /** @brief Allocate zero velocity and acceleration for every point if they are not provided */
+  void initializeDynamics();
+
+  /** @brief The UUID of each point, used when converting the points to move instructions */
+  std::vector<boost::uuids::uuid>& getPointUUIDs();
+  const std::vector<boost::uuids::uuid>& getPointUUIDs() const;
+
+  /** @brief The parent UUID of each point, used when converting the points to move instructions */
+  std::vector<boost::uuids::uuid>& getPointParentUUIDs();
+  const std::vector<boost::uuids::uuid>& getPointParentUUIDs() const;
+
+  void setMoveType(MoveInstructionType move_type);
+  void setMoveType(Eigen::Index i, MoveInstructionType move_type);
+  MoveInstructionType getMoveType(Eigen::Index i) const;
+
+  void setManipulatorInfo(tesseract_common::ManipulatorInfo info);
+  const tesseract_common::ManipulatorInfo& getManipulatorInfo() const;
+
+  void setProfile(const std::string& profile);
+  const std::string& getProfile() const;
+
+  void setPathProfile(const std::string& profile);
+  const std::string& getPathProfile() const;
+
+  void setProfileOverrides(ProfileDictionary::ConstPtr profile_overrides);
+  ProfileDictionary::ConstPtr getProfileOverrides() const;
+
+  void setPathProfileOverrides(ProfileDictionary::ConstPtr profile_overrides);
+  ProfileDictionary::ConstPtr getPathProfileOverrides() const;
+
+  /** @brief The description of every point */
+  void setPointDescription(const std::string& description);
+  const std::string& getPointDescription() const;
+
+  /**
+   * @brief Get a point as a move instruction with a state waypoint
+   * @param i The index of the point
+   * @return The move instruction
+   */
+  MoveInstructionPoly getMoveInstruction(Eigen::Index i) const;
+
+  /**
+   * @brief Convert the block to a move instruction with a state waypoint for each point
+   * @return The move instructions
+   */
+  std::vector<InstructionPoly> toInstructions() const;
+
+  /**
+   * @brief Equal operator. Does not compare descriptions
+   * @param rhs JointTrajectoryBlock
+   * @return True if equal, otherwise false
+   */
+  bool operator==(const JointTrajectoryBlock& rhs) const;
+
+  /**
+   * @brief Not equal operator. Does not compare descriptions
+   * @param rhs JointTrajectoryBlock
+   * @return True if not equal, otherwise false
+   */
+  bool operator!=(const JointTrajectoryBlock& rhs) const;
+
+private:
+  /** @brief The instructions UUID */
+  boost::uuids::uuid uuid_{};
+  /** @brief The parent UUID if created from createChild */
+  boost::uuids::uuid parent_uuid_{};
+  /** @brief The description of the instruction */
+  std::string description_{ "Tesseract Joint Trajectory Block" };
+
+  /** @brief The joint names shared by every point */
+  std::vector<std::string> joint_names_;
+  /** @brief The position of each point as a column */
+  Eigen::MatrixXd position_;
+  /** @brief The velocity of each point as a column, empty if not provided */
+  Eigen::MatrixXd velocity_;
+  /** @brief The acceleration of each point as a column, empty if not provided */
+  Eigen::MatrixXd acceleration_;
+  /** @brief The effort of each point as a column, empty if not provided */
+  Eigen::MatrixXd effort_;
+  /** @brief The time from start of each point */
+  Eigen::VectorXd time_;
+
+  /** @brief The UUID of each point */
+  std::vector<boost::uuids::uuid> point_uuids_;
+  /** @brief The parent UUID of each point */
+  std::vector<boost::uuids::uuid> point_parent_uuids_;
+  /** @brief The move type of each point */
+  std::vector<MoveInstructionType> move_types_;
+
+  /** @brief The description of every point */
+  std::string point_description_{ "Tesseract Move Instruction" };
+  /** @brief The profile of every point */
+  std::string profile_{ DEFAULT_PROFILE_KEY };
+  /** @brief The path profile of every point */
+  std::string path_profile_;
+  /** @brief Dictionary of profiles that will override named profiles for a specific task*/
+  ProfileDictionary::ConstPtr profile_overrides_;
+  /** @brief Dictionary of path profiles that will override named profiles for a specific task*/
+  ProfileDictionary::ConstPtr path_profile_overrides_;
+  /** @brief Contains information about the manipulator associated with every point */
+  tesseract_common::ManipulatorInfo manipulator_info_;
+
+  friend class boost::serialization::access;
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version);  // NOLINT
+};
+
+/** @brief Filter for flattening which returns true for joint trajectory blocks */
+bool jointTrajectoryBlockFilter(const InstructionPoly& instruction, const CompositeInstruction& composite);
+
+/** @brief Filter for flattening which returns true for move instructions and joint trajectory blocks */
+bool moveOrJointTrajectoryBlockFilter(const InstructionPoly& instruction, const CompositeInstruction& composite);
+
+}  // namespace tesseract_planning
+
+TESSERACT_INSTRUCTION_EXPORT_KEY(tesseract_planning, JointTrajectoryBlock);
+
+#endif  // TESSERACT_COMMAND_LANGUAGE_JOINT_TRAJECTORY_BLOCK_H
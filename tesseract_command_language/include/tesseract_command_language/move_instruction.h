@@ -120,6 +120,13 @@ public:
   const boost::uuids::uuid& getUUID() const;
   void regenerateUUID();
 
+  /**
+   * @brief Set the UUID
+   * @details This should only be used when restoring an instruction, for example from a JointTrajectoryBlock
+   * @param uuid The UUID
+   */
+  void setUUID(const boost::uuids::uuid& uuid);
+
   const boost::uuids::uuid& getParentUUID() const;
   void setParentUUID(const boost::uuids::uuid& uuid);
 
@@ -186,6 +186,8 @@ struct InstructionPoly : InstructionPolyBase
 
   bool isMoveInstruction() const;
 
+  bool isJointTrajectoryBlock() const;
+
 private:
   friend class boost::serialization::access;
   friend struct tesseract_common::Serialization;
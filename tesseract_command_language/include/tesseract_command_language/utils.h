@@ -48,7 +48,8 @@ tesseract_common::JointTrajectory toJointTrajectory(const InstructionPoly& instr
 /**
  * @brief Convert composite instruction to a joint trajectory
  * @details This searches for both move and plan instruction to support converting both input and results to planning
- * requests. If it contains a Cartesian waypoint it is skipped.
+ * requests. If it contains a Cartesian waypoint it is skipped. Joint trajectory blocks are expanded to a joint state
+ * per point.
  * @param composite_instructions The composite instruction to convert
  * @return A joint trajectory
  */
@@ -162,6 +163,24 @@ bool clampToJointLimits(WaypointPoly& wp,
  */
 CompositeInstruction generateSkeletonSeed(const CompositeInstruction& composite_instructions);
 
+/**
+ * @brief Replace the move instructions of a program with joint trajectory blocks
+ * @details Each run of consecutive move instructions with state waypoints, which share the same joint names,
+ * description, profiles and manipulator info, is replaced by a single JointTrajectoryBlock. Other instructions and the
+ * structure of the composite instructions are left unchanged.
+ * @param composite_instructions The program to convert
+ * @return The program with joint trajectory blocks
+ */
+CompositeInstruction toJointTrajectoryBlocks(const CompositeInstruction& composite_instructions);
+
+/**
+ * @brief Replace the joint trajectory blocks of a program with move instructions
+ * @details This is the inverse of toJointTrajectoryBlocks
+ * @param composite_instructions The program to convert
+ * @return The program with move instructions
+ */
+CompositeInstruction fromJointTrajectoryBlocks(const CompositeInstruction& composite_instructions);
+
 /**
  * @brief Convert a CompositeInstruction to delimited formate file by extracting all MoveInstructions
  * @param composite_instructions The CompositeInstruction to extract data from
@@ -0,0 +1,417 @@
+/**
+ * @file joint_trajectory_block.cpp
+ * @brief A compact representation of a joint trajectory
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <iostream>
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+#include <boost/uuid/uuid_serialize.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_command_language/joint_trajectory_block.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_common/utils.h>
+
+namespace tesseract_planning
+{
+namespace
+{
+/** @brief Compare matrices which must have the same dimensions */
+bool isApprox(const Eigen::MatrixXd& lhs, const Eigen::MatrixXd& rhs)
+{
+  static auto max_diff = static_cast<double>(std::numeric_limits<float>::epsilon());
+
+  if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+    return false;
+
+  if (lhs.size() == 0)
+    return true;
+
+  return tesseract_common::almostEqualRelativeAndAbs(Eigen::Map<const Eigen::VectorXd>(lhs.data(), lhs.size()),
+                                                     Eigen::Map<const Eigen::VectorXd>(rhs.data(), rhs.size()),
+                                                     max_diff);
+}
+
+/** @brief Serialize the dimensions and data of a dynamically sized matrix */
+template <class Archive, typename Derived>
+void serializeMatrix(Archive& ar, const std::string& name, Eigen::PlainObjectBase<Derived>& m)
+{
+  Eigen::Index rows = m.rows();
+  Eigen::Index cols = m.cols();
+  ar& boost::serialization::make_nvp((name + "_rows").c_str(), rows);
+  ar& boost::serialization::make_nvp((name + "_cols").c_str(), cols);
+  if (Archive::is_loading::value)
+    m.resize(rows, cols);
+
+  ar& boost::serialization::make_nvp(name.c_str(),
+                                     boost::serialization::make_array(m.data(), static_cast<std::size_t>(m.size())));
+}
+
+/** @brief Get the data of a point which must be provided for every point or none of them */
+void assignOptionalColumn(Eigen::MatrixXd& m, Eigen::Index i, const Eigen::VectorXd& value, const std::string& name)
+{
+  if (i == 0 && value.size() != 0)
+    m.resize(value.size(), m.cols());
+
+  if (value.size() != m.rows())
+    throw std::runtime_error("JointTrajectoryBlock, the " + name +
+                             " must be provided for every point or none of them!");
+
+  if (value.size() != 0)
+    m.col(i) = value;
+}
+}  // namespace
+
+JointTrajectoryBlock::JointTrajectoryBlock(std::vector<std::string> joint_names,
+                                           Eigen::MatrixXd position,
+                                           Eigen::VectorXd time,
+                                           MoveInstructionType type,
+                                           std::string profile,
+                                           tesseract_common::ManipulatorInfo manipulator_info)
+  : uuid_(boost::uuids::random_generator()())
+  , joint_names_(std::move(joint_names))
+  , position_(std::move(position))
+  , time_(std::move(time))
+  , point_parent_uuids_(static_cast<std::size_t>(position_.cols()))
+  , move_types_(static_cast<std::size_t>(position_.cols()), type)
+  , profile_(std::move(profile))
+  , manipulator_info_(std::move(manipulator_info))
+{
+  if (position_.rows() != static_cast<Eigen::Index>(joint_names_.size()))
+    throw std::runtime_error("JointTrajectoryBlock, the number of position rows does not match the joint names!");
+
+  if (time_.size() != position_.cols())
+    throw std::runtime_error("JointTrajectoryBlock, the number of times does not match the number of points!");
+
+  boost::uuids::random_generator gen;
+  point_uuids_.reserve(point_parent_uuids_.size());
+  for (std::size_t i = 0; i < point_parent_uuids_.size(); ++i)
+    point_uuids_.push_back(gen());
+
+  if (type == MoveInstructionType::LINEAR || type == MoveInstructionType::CIRCULAR)
+    path_profile_ = profile_;
+}
+
+JointTrajectoryBlock::JointTrajectoryBlock(const std::vector<InstructionPoly>& instructions)
+  : uuid_(boost::uuids::random_generator()())
+{
+  if (instructions.empty())
+    throw std::runtime_error("JointTrajectoryBlock, no instructions were provided!");
+
+  const auto n = static_cast<Eigen::Index>(instructions.size());
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    const InstructionPoly& instruction = instructions[static_cast<std::size_t>(i)];
+    if (!instruction.isMoveInstruction())
+      throw std::runtime_error("JointTrajectoryBlock, only move instructions are supported!");
+
+    const auto& mi = instruction.as<MoveInstructionPoly>();
+    if (!mi.getWaypoint().isStateWaypoint())
+      throw std::runtime_error("JointTrajectoryBlock, only state waypoints are supported!");
+
+    const auto& swp = mi.getWaypoint().as<StateWaypointPoly>();
+    if (i == 0)
+    {
+      joint_names_ = swp.getNames();
+      point_description_ = mi.getDescription();
+      profile_ = mi.getProfile();
+      path_profile_ = mi.getPathProfile();
+      profile_overrides_ = mi.getProfileOverrides();
+      path_profile_overrides_ = mi.getPathProfileOverrides();
+      manipulator_info_ = mi.getManipulatorInfo();
+
+      position_.resize(swp.getPosition().size(), n);
+      velocity_.resize(0, n);
+      acceleration_.resize(0, n);
+      effort_.resize(0, n);
+      time_.resize(n);
+      point_uuids_.reserve(instructions.size());
+      point_parent_uuids_.reserve(instructions.size());
+      move_types_.reserve(instructions.size());
+    }
+    else if (swp.getNames() != joint_names_ || mi.getDescription() != point_description_ ||
+             mi.getProfile() != profile_ || mi.getPathProfile() != path_profile_ ||
+             mi.getProfileOverrides() != profile_overrides_ ||
+             mi.getPathProfileOverrides() != path_profile_overrides_ || mi.getManipulatorInfo() != manipulator_info_)
+    {
+      throw std::runtime_error("JointTrajectoryBlock, every move instruction must have the same joint names, "
+                               "description, profiles and manipulator info!");
+    }
+
+    if (swp.getPosition().size() != position_.rows())
+      throw std::runtime_error("JointTrajectoryBlock, every position must have the same size!");
+
+    position_.col(i) = swp.getPosition();
+    assignOptionalColumn(velocity_, i, swp.getVelocity(), "velocity");
+    assignOptionalColumn(acceleration_, i, swp.getAcceleration(), "acceleration");
+    assignOptionalColumn(effort_, i, swp.getEffort(), "effort");
+    time_(i) = swp.getTime();
+
+    point_uuids_.push_back(mi.getUUID());
+    point_parent_uuids_.push_back(mi.getParentUUID());
+    move_types_.push_back(mi.getMoveType());
+  }
+
+  // Matrices which were not provided are left empty rather than [0 x size]
+  if (velocity_.rows() == 0)
+    velocity_.resize(0, 0);
+
+  if (acceleration_.rows() == 0)
+    acceleration_.resize(0, 0);
+
+  if (effort_.rows() == 0)
+    effort_.resize(0, 0);
+}
+
+const boost::uuids::uuid& JointTrajectoryBlock::getUUID() const { return uuid_; }
+void JointTrajectoryBlock::regenerateUUID() { uuid_ = boost::uuids::random_generator()(); }
+
+const boost::uuids::uuid& JointTrajectoryBlock::getParentUUID() const { return parent_uuid_; }
+void JointTrajectoryBlock::setParentUUID(const boost::uuids::uuid& uuid) { parent_uuid_ = uuid; }
+
+const std::string& JointTrajectoryBlock::getDescription() const { return description_; }
+
+void JointTrajectoryBlock::setDescription(const std::string& description) { description_ = description; }
+
+void JointTrajectoryBlock::print(const std::string& prefix) const  // NOLINT
+{
+  std::cout << prefix + "Joint Trajectory Block, Points: " << size() << ", DOF: " << dof()
+            << ", Profile: " << profile_;
+  std::cout << ", Description: " << getDescription() << std::endl;
+}
+
+Eigen::Index JointTrajectoryBlock::size() const { return position_.cols(); }
+
+Eigen::Index JointTrajectoryBlock::dof() const { return position_.rows(); }
+
+bool JointTrajectoryBlock::empty() const { return (position_.cols() == 0); }
+
+void JointTrajectoryBlock::setJointNames(std::vector<std::string> joint_names) { joint_names_ = std::move(joint_names); }
+const std::vector<std::string>& JointTrajectoryBlock::getJointNames() const { return joint_names_; }
+
+Eigen::MatrixXd& JointTrajectoryBlock::getPosition() { return position_; }
+const Eigen::MatrixXd& JointTrajectoryBlock::getPosition() const { return position_; }
+
+Eigen::MatrixXd& JointTrajectoryBlock::getVelocity() { return velocity_; }
+const Eigen::MatrixXd& JointTrajectoryBlock::getVelocity() const { return velocity_; }
+
+Eigen::MatrixXd& JointTrajectoryBlock::getAcceleration() { return acceleration_; }
+const Eigen::MatrixXd& JointTrajectoryBlock::getAcceleration() const { return acceleration_; }
+
+Eigen::MatrixXd& JointTrajectoryBlock::getEffort() { return effort_; }
+const Eigen::MatrixXd& JointTrajectoryBlock::getEffort() const { return effort_; }
+
+Eigen::VectorXd& JointTrajectoryBlock::getTime() { return time_; }
+const Eigen::VectorXd& JointTrajectoryBlock::getTime() const { return time_; }
+
+void JointTrajectoryBlock::resize(Eigen::Index size)
+{
+  const Eigen::Index current_size = position_.cols();
+  const Eigen::Index rows = dof();
+  auto resizeMatrix = [current_size, size, rows](Eigen::MatrixXd& m) {
+    m.conservativeResize(rows, size);
+    if (size > current_size)
+      m.rightCols(size - current_size).setZero();
+  };
+
+  resizeMatrix(position_);
+  if (velocity_.size() != 0)
+    resizeMatrix(velocity_);
+
+  if (acceleration_.size() != 0)
+    resizeMatrix(acceleration_);
+
+  if (effort_.size() != 0)
+    resizeMatrix(effort_);
+
+  time_.conservativeResize(size);
+  if (size > current_size)
+    time_.tail(size - current_size).setZero();
+
+  const MoveInstructionType type = move_types_.empty() ? MoveInstructionType::FREESPACE : move_types_.back();
+  point_uuids_.resize(static_cast<std::size_t>(size));
+  point_parent_uuids_.resize(static_cast<std::size_t>(size));
+  move_types_.resize(static_cast<std::size_t>(size), type);
+
+  boost::uuids::random_generator gen;
+  for (auto i = static_cast<std::size_t>(current_size); i < point_uuids_.size(); ++i)
+    point_uuids_[i] = gen();
+}
+
+void JointTrajectoryBlock::initializeDynamics()
+{
+  if (velocity_.size() == 0)
+    velocity_ = Eigen::MatrixXd::Zero(dof(), size());
+
+  if (acceleration_.size() == 0)
+    acceleration_ = Eigen::MatrixXd::Zero(dof(), size());
+}
+
+std::vector<boost::uuids::uuid>& JointTrajectoryBlock::getPointUUIDs() { return point_uuids_; }
+const std::vector<boost::uuids::uuid>& JointTrajectoryBlock::getPointUUIDs() const { return point_uuids_; }
+
+std::vector<boost::uuids::uuid>& JointTrajectoryBlock::getPointParentUUIDs() { return point_parent_uuids_; }
+const std::vector<boost::uuids::uuid>& JointTrajectoryBlock::getPointParentUUIDs() const
+{
+  return point_parent_uuids_;
+}
+
+void JointTrajectoryBlock::setMoveType(MoveInstructionType move_type)
+{
+  std::fill(move_types_.begin(), move_types_.end(), move_type);
+}
+void JointTrajectoryBlock::setMoveType(Eigen::Index i, MoveInstructionType move_type)
+{
+  move_types_.at(static_cast<std::size_t>(i)) = move_type;
+}
+MoveInstructionType JointTrajectoryBlock::getMoveType(Eigen::Index i) const
+{
+  return move_types_.at(static_cast<std::size_t>(i));
+}
+
+void JointTrajectoryBlock::setManipulatorInfo(tesseract_common::ManipulatorInfo info)
+{
+  manipulator_info_ = std::move(info);
+}
+const tesseract_common::ManipulatorInfo& JointTrajectoryBlock::getManipulatorInfo() const { return manipulator_info_; }
+
+void JointTrajectoryBlock::setProfile(const std::string& profile)
+{
+  profile_ = (profile.empty()) ? DEFAULT_PROFILE_KEY : profile;
+}
+const std::string& JointTrajectoryBlock::getProfile() const { return profile_; }
+
+void JointTrajectoryBlock::setPathProfile(const std::string& profile) { path_profile_ = profile; }
+const std::string& JointTrajectoryBlock::getPathProfile() const { return path_profile_; }
+
+void JointTrajectoryBlock::setProfileOverrides(ProfileDictionary::ConstPtr profile_overrides)
+{
+  profile_overrides_ = std::move(profile_overrides);
+}
+ProfileDictionary::ConstPtr JointTrajectoryBlock::getProfileOverrides() const { return profile_overrides_; }
+
+void JointTrajectoryBlock::setPathProfileOverrides(ProfileDictionary::ConstPtr profile_overrides)
+{
+  path_profile_overrides_ = std::move(profile_overrides);
+}
+ProfileDictionary::ConstPtr JointTrajectoryBlock::getPathProfileOverrides() const { return path_profile_overrides_; }
+
+void JointTrajectoryBlock::setPointDescription(const std::string& description) { point_description_ = description; }
+const std::string& JointTrajectoryBlock::getPointDescription() const { return point_description_; }
+
+MoveInstructionPoly JointTrajectoryBlock::getMoveInstruction(Eigen::Index i) const
+{
+  StateWaypoint swp(joint_names_, position_.col(i));
+  if (velocity_.size() != 0)
+    swp.setVelocity(velocity_.col(i));
+
+  if (acceleration_.size() != 0)
+    swp.setAcceleration(acceleration_.col(i));
+
+  if (effort_.size() != 0)
+    swp.setEffort(effort_.col(i));
+
+  swp.setTime(time_(i));
+
+  const auto idx = static_cast<std::size_t>(i);
+  MoveInstruction mi(StateWaypointPoly(swp), move_types_[idx], profile_, path_profile_, manipulator_info_);
+  mi.setUUID(point_uuids_[idx]);
+  mi.setParentUUID(point_parent_uuids_[idx]);
+  mi.setDescription(point_description_);
+  mi.setProfileOverrides(profile_overrides_);
+  mi.setPathProfileOverrides(path_profile_overrides_);
+  return mi;
+}
+
+std::vector<InstructionPoly> JointTrajectoryBlock::toInstructions() const
+{
+  std::vector<InstructionPoly> instructions;
+  instructions.reserve(static_cast<std::size_t>(size()));
+  for (Eigen::Index i = 0; i < size(); ++i)
+    instructions.emplace_back(getMoveInstruction(i));
+
+  return instructions;
+}
+
+bool JointTrajectoryBlock::operator==(const JointTrajectoryBlock& rhs) const
+{
+  bool equal = true;
+  equal &= tesseract_common::isIdentical(joint_names_, rhs.joint_names_);
+  equal &= isApprox(position_, rhs.position_);
+  equal &= isApprox(velocity_, rhs.velocity_);
+  equal &= isApprox(acceleration_, rhs.acceleration_);
+  equal &= isApprox(effort_, rhs.effort_);
+  equal &= isApprox(time_, rhs.time_);
+  equal &= (move_types_ == rhs.move_types_);
+  equal &= (manipulator_info_ == rhs.manipulator_info_);
+  equal &= (profile_ == rhs.profile_);            // NO LINT
+  equal &= (path_profile_ == rhs.path_profile_);  // NO LINT
+  /** @todo Add profiles overrides when serialization is supported for profiles */
+  return equal;
+}
+
+bool JointTrajectoryBlock::operator!=(const JointTrajectoryBlock& rhs) const { return !operator==(rhs); }
+
+template <class Archive>
+void JointTrajectoryBlock::serialize(Archive& ar, const unsigned int /*version*/)
+{
+  ar& boost::serialization::make_nvp("uuid", uuid_);
+  ar& boost::serialization::make_nvp("parent_uuid", parent_uuid_);
+  ar& boost::serialization::make_nvp("description", description_);
+  ar& boost::serialization::make_nvp("joint_names", joint_names_);
+  serializeMatrix(ar, "position", position_);
+  serializeMatrix(ar, "velocity", velocity_);
+  serializeMatrix(ar, "acceleration", acceleration_);
+  serializeMatrix(ar, "effort", effort_);
+  serializeMatrix(ar, "time", time_);
+  ar& boost::serialization::make_nvp("point_uuids", point_uuids_);
+  ar& boost::serialization::make_nvp("point_parent_uuids", point_parent_uuids_);
+  ar& boost::serialization::make_nvp("move_types", move_types_);
+  ar& boost::serialization::make_nvp("point_description", point_description_);
+  ar& boost::serialization::make_nvp("profile", profile_);
+  ar& boost::serialization::make_nvp("path_profile", path_profile_);
+  ar& boost::serialization::make_nvp("manipulator_info", manipulator_info_);
+  /** @todo Add profiles overrides when serialization is supported for profiles */
+}
+
+bool jointTrajectoryBlockFilter(const InstructionPoly& instruction, const CompositeInstruction& /*composite*/)
+{
+  return instruction.isJointTrajectoryBlock();
+}
+
+bool moveOrJointTrajectoryBlockFilter(const InstructionPoly& instruction, const CompositeInstruction& /*composite*/)
+{
+  return instruction.isMoveInstruction() || instruction.isJointTrajectoryBlock();
+}
+
+}  // namespace tesseract_planning
+
+#include <tesseract_common/serialization.h>
+TESSERACT_SERIALIZE_ARCHIVES_INSTANTIATE(tesseract_planning::JointTrajectoryBlock)
+TESSERACT_INSTRUCTION_EXPORT_IMPLEMENT(tesseract_planning::JointTrajectoryBlock);
@@ -161,6 +161,7 @@ MoveInstruction::MoveInstruction(StateWaypointPoly waypoint,
 
 const boost::uuids::uuid& MoveInstruction::getUUID() const { return uuid_; }
 void MoveInstruction::regenerateUUID() { uuid_ = boost::uuids::random_generator()(); }
+void MoveInstruction::setUUID(const boost::uuids::uuid& uuid) { uuid_ = uuid; }
 
 const boost::uuids::uuid& MoveInstruction::getParentUUID() const { return parent_uuid_; }
 void MoveInstruction::setParentUUID(const boost::uuids::uuid& uuid) { parent_uuid_ = uuid; }
@@ -6,6 +6,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_command_language/poly/instruction_poly.h>
 #include <tesseract_command_language/poly/move_instruction_poly.h>
 #include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
 
 template <class Archive>
 void tesseract_planning::detail_instruction::InstructionInterface::serialize(Archive& ar,
@@ -51,6 +52,11 @@ bool tesseract_planning::InstructionPoly::isMoveInstruction() const
   return (isNull() ? false : (getInterface().getType() == std::type_index(typeid(MoveInstructionPoly))));
 }
 
+bool tesseract_planning::InstructionPoly::isJointTrajectoryBlock() const
+{
+  return (isNull() ? false : (getInterface().getType() == std::type_index(typeid(JointTrajectoryBlock))));
+}
+
 template <class Archive>
 void tesseract_planning::InstructionPoly::serialize(Archive& ar, const unsigned int /*version*/)  // NOLINT
 {
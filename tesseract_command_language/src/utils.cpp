@@ -30,6 +30,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/utils.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
 #include <tesseract_command_language/poly/cartesian_waypoint_poly.h>
 #include <tesseract_command_language/poly/joint_waypoint_poly.h>
 #include <tesseract_command_language/poly/state_waypoint_poly.h>
@@ -38,7 +39,7 @@ namespace tesseract_planning
 {
 static const tesseract_planning::locateFilterFn toJointTrajectoryInstructionFilter =
     [](const tesseract_planning::InstructionPoly& i, const tesseract_planning::CompositeInstruction& /*composite*/) {
-      return i.isMoveInstruction();
+      return i.isMoveInstruction() || i.isJointTrajectoryBlock();
     };
 
 tesseract_common::JointTrajectory toJointTrajectory(const InstructionPoly& instruction)
@@ -66,7 +67,36 @@ tesseract_common::JointTrajectory toJointTrajectory(const CompositeInstruction&
   double total_time = 0;
   for (auto& i : flattened_program)
   {
-    if (i.get().isMoveInstruction())
+    if (i.get().isJointTrajectoryBlock())
+    {
+      const auto& block = i.get().as<JointTrajectoryBlock>();
+      for (Eigen::Index p = 0; p < block.size(); ++p)
+      {
+        tesseract_common::JointState joint_state;
+        joint_state.joint_names = block.getJointNames();
+        joint_state.position = block.getPosition().col(p);
+        if (block.getVelocity().size() != 0)
+          joint_state.velocity = block.getVelocity().col(p);
+
+        if (block.getAcceleration().size() != 0)
+          joint_state.acceleration = block.getAcceleration().col(p);
+
+        if (block.getEffort().size() != 0)
+          joint_state.effort = block.getEffort().col(p);
+
+        // It is possible for sub composites to start back from zero, this accounts for it
+        current_time = block.getTime()(p);
+        if (current_time < last_time)
+          last_time = 0;
+
+        double dt = current_time - last_time;
+        total_time += dt;
+        joint_state.time = total_time;
+        last_time = current_time;
+        trajectory.push_back(joint_state);
+      }
+    }
+    else if (i.get().isMoveInstruction())
     {
       const auto& pi = i.get().as<MoveInstructionPoly>();
       if (pi.getWaypoint().isJointWaypoint())
@@ -382,6 +412,104 @@ bool toDelimitedFile(const CompositeInstruction& composite_instructions, const s
   return true;
 }
 
+/** @brief Check if a move instruction can be stored in the same joint trajectory block as another */
+bool isJointTrajectoryBlockCompatible(const MoveInstructionPoly& mi, const MoveInstructionPoly& front)
+{
+  if (!mi.getWaypoint().isStateWaypoint())
+    return false;
+
+  const auto& swp = mi.getWaypoint().as<StateWaypointPoly>();
+  const auto& front_swp = front.getWaypoint().as<StateWaypointPoly>();
+  return (swp.getNames() == front_swp.getNames() && swp.getPosition().size() == front_swp.getPosition().size() &&
+          swp.getVelocity().size() == front_swp.getVelocity().size() &&
+          swp.getAcceleration().size() == front_swp.getAcceleration().size() &&
+          swp.getEffort().size() == front_swp.getEffort().size() && mi.getDescription() == front.getDescription() &&
+          mi.getProfile() == front.getProfile() && mi.getPathProfile() == front.getPathProfile() &&
+          mi.getProfileOverrides() == front.getProfileOverrides() &&
+          mi.getPathProfileOverrides() == front.getPathProfileOverrides() &&
+          mi.getManipulatorInfo() == front.getManipulatorInfo());
+}
+
+void toJointTrajectoryBlocksHelper(CompositeInstruction& composite_instructions)
+{
+  std::vector<InstructionPoly> instructions;
+  instructions.reserve(composite_instructions.getInstructions().size());
+
+  std::vector<InstructionPoly> run;
+  auto flushRun = [&instructions, &run]() {
+    if (!run.empty())
+      instructions.emplace_back(JointTrajectoryBlock(run));
+
+    run.clear();
+  };
+
+  for (auto& i : composite_instructions.getInstructions())
+  {
+    if (i.isCompositeInstruction())
+    {
+      flushRun();
+      toJointTrajectoryBlocksHelper(i.as<CompositeInstruction>());
+      instructions.push_back(std::move(i));
+    }
+    else if (i.isMoveInstruction() && i.as<MoveInstructionPoly>().getWaypoint().isStateWaypoint())
+    {
+      if (!run.empty() &&
+          !isJointTrajectoryBlockCompatible(i.as<MoveInstructionPoly>(), run.front().as<MoveInstructionPoly>()))
+        flushRun();
+
+      run.push_back(std::move(i));
+    }
+    else
+    {
+      flushRun();
+      instructions.push_back(std::move(i));
+    }
+  }
+  flushRun();
+
+  composite_instructions.setInstructions(std::move(instructions));
+}
+
+void fromJointTrajectoryBlocksHelper(CompositeInstruction& composite_instructions)
+{
+  std::vector<InstructionPoly> instructions;
+  instructions.reserve(composite_instructions.getInstructions().size());
+  for (auto& i : composite_instructions.getInstructions())
+  {
+    if (i.isCompositeInstruction())
+    {
+      fromJointTrajectoryBlocksHelper(i.as<CompositeInstruction>());
+      instructions.push_back(std::move(i));
+    }
+    else if (i.isJointTrajectoryBlock())
+    {
+      const auto& block = i.as<JointTrajectoryBlock>();
+      for (Eigen::Index p = 0; p < block.size(); ++p)
+        instructions.emplace_back(block.getMoveInstruction(p));
+    }
+    else
+    {
+      instructions.push_back(std::move(i));
+    }
+  }
+
+  composite_instructions.setInstructions(std::move(instructions));
+}
+
+CompositeInstruction toJointTrajectoryBlocks(const CompositeInstruction& composite_instructions)
+{
+  CompositeInstruction program = composite_instructions;
+  toJointTrajectoryBlocksHelper(program);
+  return program;
+}
+
+CompositeInstruction fromJointTrajectoryBlocks(const CompositeInstruction& composite_instructions)
+{
+  CompositeInstruction program = composite_instructions;
+  fromJointTrajectoryBlocksHelper(program);
+  return program;
+}
+
 CompositeInstruction generateSkeletonSeed(const CompositeInstruction& composite_instructions)
 {
   CompositeInstruction seed = composite_instructions;
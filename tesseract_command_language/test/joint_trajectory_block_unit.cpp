@@ -0,0 +1,205 @@
+/**
+ * @file joint_trajectory_block_unit.cpp
+ * @brief Contains unit tests for JointTrajectoryBlock
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+#include <tesseract_common/serialization.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_command_language/timer_instruction.h>
+#include <tesseract_command_language/utils.h>
+
+using namespace tesseract_planning;
+
+static const std::vector<std::string> JOINT_NAMES = { "j1", "j2", "j3", "j4", "j5", "j6" };
+
+/** @brief Create move instructions with state waypoints which have velocity, acceleration and time */
+std::vector<InstructionPoly> createMoveInstructions(long size)
+{
+  std::vector<InstructionPoly> instructions;
+  for (long i = 0; i < size; ++i)
+  {
+    const auto value = static_cast<double>(i);
+    StateWaypoint swp(JOINT_NAMES,
+                      Eigen::VectorXd::Constant(6, value),
+                      Eigen::VectorXd::Constant(6, 2 * value),
+                      Eigen::VectorXd::Constant(6, 3 * value),
+                      value);
+    MoveInstruction mi(StateWaypointPoly(swp), MoveInstructionType::LINEAR, "profile", "path_profile");
+    mi.setParentUUID(mi.getUUID());
+    mi.regenerateUUID();
+    instructions.emplace_back(mi);
+  }
+  return instructions;
+}
+
+TEST(TesseractCommandLanguageJointTrajectoryBlockUnit, constructor)  // NOLINT
+{
+  Eigen::MatrixXd position = Eigen::MatrixXd::Random(6, 10);
+  Eigen::VectorXd time = Eigen::VectorXd::LinSpaced(10, 0, 1);
+  JointTrajectoryBlock block(JOINT_NAMES, position, time, MoveInstructionType::LINEAR, "profile");
+  EXPECT_EQ(block.size(), 10);
+  EXPECT_EQ(block.dof(), 6);
+  EXPECT_FALSE(block.empty());
+  EXPECT_FALSE(block.getUUID().is_nil());
+  EXPECT_TRUE(block.getParentUUID().is_nil());
+  EXPECT_EQ(block.getJointNames(), JOINT_NAMES);
+  EXPECT_TRUE(block.getPosition().isApprox(position));
+  EXPECT_TRUE(block.getTime().isApprox(time));
+  EXPECT_EQ(block.getVelocity().size(), 0);
+  EXPECT_EQ(block.getAcceleration().size(), 0);
+  EXPECT_EQ(block.getEffort().size(), 0);
+  EXPECT_EQ(block.getProfile(), "profile");
+  EXPECT_EQ(block.getPathProfile(), "profile");
+  EXPECT_EQ(block.getMoveType(0), MoveInstructionType::LINEAR);
+  EXPECT_EQ(block.getPointUUIDs().size(), 10);
+  EXPECT_FALSE(block.getPointUUIDs().front().is_nil());
+
+  block.initializeDynamics();
+  EXPECT_TRUE(block.getVelocity().isApprox(Eigen::MatrixXd::Zero(6, 10)));
+  EXPECT_TRUE(block.getAcceleration().isApprox(Eigen::MatrixXd::Zero(6, 10)));
+
+  block.resize(12);
+  EXPECT_EQ(block.size(), 12);
+  EXPECT_EQ(block.getVelocity().cols(), 12);
+  EXPECT_TRUE(block.getPosition().leftCols(10).isApprox(position));
+  EXPECT_TRUE(block.getPosition().rightCols(2).isZero());
+  EXPECT_EQ(block.getPointUUIDs().size(), 12);
+  EXPECT_FALSE(block.getPointUUIDs().back().is_nil());
+  EXPECT_EQ(block.getMoveType(11), MoveInstructionType::LINEAR);
+
+  EXPECT_ANY_THROW(JointTrajectoryBlock(JOINT_NAMES, Eigen::MatrixXd::Zero(5, 10), time));  // NOLINT
+  EXPECT_ANY_THROW(JointTrajectoryBlock(JOINT_NAMES, position, Eigen::VectorXd::Zero(5)));  // NOLINT
+}
+
+TEST(TesseractCommandLanguageJointTrajectoryBlockUnit, instructions)  // NOLINT
+{
+  std::vector<InstructionPoly> instructions = createMoveInstructions(20);
+  JointTrajectoryBlock block(instructions);
+  EXPECT_EQ(block.size(), 20);
+  EXPECT_EQ(block.dof(), 6);
+  EXPECT_EQ(block.getVelocity().cols(), 20);
+  EXPECT_EQ(block.getAcceleration().cols(), 20);
+  EXPECT_EQ(block.getEffort().size(), 0);
+  EXPECT_NEAR(block.getTime()(19), 19, 1e-8);
+
+  // Converting back is lossless
+  std::vector<InstructionPoly> converted = block.toInstructions();
+  ASSERT_EQ(converted.size(), instructions.size());
+  for (std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    const auto& mi = instructions[i].as<MoveInstructionPoly>();
+    const auto& cmi = converted[i].as<MoveInstructionPoly>();
+    EXPECT_EQ(instructions[i], converted[i]);
+    EXPECT_EQ(mi.getUUID(), cmi.getUUID());
+    EXPECT_EQ(mi.getParentUUID(), cmi.getParentUUID());
+    EXPECT_EQ(mi.getDescription(), cmi.getDescription());
+
+    const auto& swp = mi.getWaypoint().as<StateWaypointPoly>();
+    const auto& cswp = cmi.getWaypoint().as<StateWaypointPoly>();
+    EXPECT_TRUE(swp.getVelocity().isApprox(cswp.getVelocity()));
+    EXPECT_TRUE(swp.getAcceleration().isApprox(cswp.getAcceleration()));
+    EXPECT_EQ(cswp.getEffort().size(), 0);
+    EXPECT_NEAR(swp.getTime(), cswp.getTime(), 1e-8);
+  }
+
+  // Every point must share the same profile
+  instructions.back().as<MoveInstructionPoly>().setProfile("other_profile");
+  EXPECT_ANY_THROW(JointTrajectoryBlock{ instructions });  // NOLINT
+
+  // Every point must provide velocity or none of them
+  instructions = createMoveInstructions(3);
+  instructions.back().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>().setVelocity(Eigen::VectorXd());
+  EXPECT_ANY_THROW(JointTrajectoryBlock{ instructions });  // NOLINT
+
+  // Only state waypoints are supported
+  instructions = createMoveInstructions(3);
+  instructions.emplace_back(TimerInstruction(TimerInstructionType::DIGITAL_OUTPUT_LOW, 1, 1));
+  EXPECT_ANY_THROW(JointTrajectoryBlock{ instructions });  // NOLINT
+
+  EXPECT_ANY_THROW(JointTrajectoryBlock{ std::vector<InstructionPoly>() });  // NOLINT
+}
+
+TEST(TesseractCommandLanguageJointTrajectoryBlockUnit, program)  // NOLINT
+{
+  CompositeInstruction program;
+  CompositeInstruction segment;
+  for (auto& instruction : createMoveInstructions(5))
+    segment.push_back(instruction);
+  program.push_back(segment);
+
+  // The timer splits the second segment into two blocks
+  segment.clear();
+  for (auto& instruction : createMoveInstructions(5))
+    segment.push_back(instruction);
+  segment.push_back(TimerInstruction(TimerInstructionType::DIGITAL_OUTPUT_LOW, 1, 1));
+  for (auto& instruction : createMoveInstructions(3))
+    segment.push_back(instruction);
+  program.push_back(segment);
+
+  CompositeInstruction blocks = toJointTrajectoryBlocks(program);
+  ASSERT_EQ(blocks.size(), 2);
+  const auto& segment0 = blocks[0].as<CompositeInstruction>();
+  const auto& segment1 = blocks[1].as<CompositeInstruction>();
+  ASSERT_EQ(segment0.size(), 1);
+  ASSERT_EQ(segment1.size(), 3);
+  EXPECT_TRUE(segment0[0].isJointTrajectoryBlock());
+  EXPECT_EQ(segment0[0].as<JointTrajectoryBlock>().size(), 5);
+  EXPECT_TRUE(segment1[0].isJointTrajectoryBlock());
+  EXPECT_FALSE(segment1[1].isJointTrajectoryBlock());
+  EXPECT_TRUE(segment1[2].isJointTrajectoryBlock());
+  EXPECT_EQ(segment1[2].as<JointTrajectoryBlock>().size(), 3);
+  EXPECT_EQ(blocks.getMoveInstructionCount(), 0);
+
+  // The joint trajectory is the same for both representations
+  tesseract_common::JointTrajectory trajectory = toJointTrajectory(program);
+  tesseract_common::JointTrajectory blocks_trajectory = toJointTrajectory(blocks);
+  ASSERT_EQ(trajectory.size(), blocks_trajectory.size());
+  for (std::size_t i = 0; i < trajectory.size(); ++i)
+    EXPECT_EQ(trajectory[i], blocks_trajectory[i]);
+
+  // Converting back is lossless
+  CompositeInstruction moves = fromJointTrajectoryBlocks(blocks);
+  EXPECT_EQ(moves, program);
+  EXPECT_EQ(moves.getMoveInstructionCount(), program.getMoveInstructionCount());
+  EXPECT_EQ(moves.getLastMoveInstruction()->getUUID(), program.getLastMoveInstruction()->getUUID());
+}
+
+TEST(TesseractCommandLanguageJointTrajectoryBlockUnit, serialization)  // NOLINT
+{
+  InstructionPoly block{ JointTrajectoryBlock(createMoveInstructions(20)) };
+  std::string block_string = tesseract_common::Serialization::toArchiveStringXML<InstructionPoly>(block, "block");
+  EXPECT_FALSE(block_string.empty());
+  auto nblock = tesseract_common::Serialization::fromArchiveStringXML<InstructionPoly>(block_string);
+  EXPECT_TRUE(block == nblock);
+  EXPECT_EQ(block.as<JointTrajectoryBlock>().getPointUUIDs(), nblock.as<JointTrajectoryBlock>().getPointUUIDs());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
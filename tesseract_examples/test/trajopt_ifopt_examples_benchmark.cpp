@@ -0,0 +1,85 @@
+/**
+ * @file trajopt_ifopt_examples_benchmark.cpp
+ * @brief Benchmark the TrajOpt and TrajOpt IFOPT examples end to end
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <benchmark/benchmark.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_examples/basic_cartesian_example.h>
+#include <tesseract_examples/glass_upright_example.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_examples;
+using namespace tesseract_common;
+using namespace tesseract_environment;
+
+namespace
+{
+Environment::Ptr createEnvironment()
+{
+  auto locator = std::make_shared<TesseractSupportResourceLocator>();
+  tesseract_common::fs::path urdf_path =
+      locator->locateResource("package://tesseract_support/urdf/lbr_iiwa_14_r820.urdf")->getFilePath();
+  tesseract_common::fs::path srdf_path =
+      locator->locateResource("package://tesseract_support/urdf/lbr_iiwa_14_r820.srdf")->getFilePath();
+  auto env = std::make_shared<Environment>();
+  if (!env->init(urdf_path, srdf_path, locator))
+    return nullptr;
+
+  return env;
+}
+
+/**
+ * @brief Run an example, the argument selects TrajOpt (0) or TrajOpt IFOPT (1)
+ * @details Every run creates new planners, so QP solvers are never reused. The reuse is measured by the
+ * tesseract_motion_planners_trajopt_ifopt_qp_solver_pool_benchmark.
+ */
+template <typename ExampleType>
+void BM_EXAMPLE(benchmark::State& state)
+{
+  const bool ifopt = (state.range(0) != 0);
+  for (auto _ : state)
+  {
+    // The examples modify the environment so each iteration starts from a new one
+    state.PauseTiming();
+    Environment::Ptr env = createEnvironment();
+    if (env == nullptr)
+    {
+      state.SkipWithError("Failed to initialize the environment");
+      break;
+    }
+    ExampleType example(env, nullptr, ifopt, false);
+    state.ResumeTiming();
+
+    if (!example.run())
+    {
+      state.SkipWithError("The example failed");
+      break;
+    }
+  }
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_EXAMPLE, BasicCartesianExample)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_EXAMPLE, GlassUprightExample)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
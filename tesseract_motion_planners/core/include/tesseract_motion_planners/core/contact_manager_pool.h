@@ -0,0 +1,218 @@
+/**
+ * @file contact_manager_pool.h
+ * @brief A pool of contact managers providing each thread its own clone
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_CONTACT_MANAGER_POOL_H
+#define TESSERACT_MOTION_PLANNERS_CONTACT_MANAGER_POOL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_collision/core/discrete_contact_manager.h>
+#include <tesseract_collision/core/continuous_contact_manager.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief Provides each calling thread its own clone of a contact manager
+ * @details Contact managers are not thread safe, so anything performing collision checks from multiple threads needs
+ * a manager per thread. The clones are owned by the pool and each thread keeps a thread local list of the clones it
+ * was assigned, so after the first call on a thread, get() is a short linear search without locking or hashing. When
+ * a thread exits, its managers are returned to the pools still alive so short lived threads do not grow the pool.
+ *
+ * The template manager is only ever cloned, never used for collision checking, so it is safe to clone while other
+ * threads are checking. Use warm() to clone the managers up front, for example to the number of planner threads,
+ * so the first check on each thread does not pay for the clone.
+ */
+template <typename ManagerType>
+class ContactManagerPool
+{
+public:
+  using Ptr = std::shared_ptr<ContactManagerPool<ManagerType>>;
+  using ConstPtr = std::shared_ptr<const ContactManagerPool<ManagerType>>;
+  using UPtr = std::unique_ptr<ContactManagerPool<ManagerType>>;
+  using ConstUPtr = std::unique_ptr<const ContactManagerPool<ManagerType>>;
+
+  /**
+   * @brief Construct a pool
+   * @param manager The manager cloned for each thread, it should be fully configured
+   */
+  explicit ContactManagerPool(std::shared_ptr<ManagerType> manager)
+    : id_(nextId()), state_(std::make_shared<State>()), template_(std::move(manager))
+  {
+    if (template_ == nullptr)
+      throw std::runtime_error("ContactManagerPool, the provided contact manager is a nullptr!");
+  }
+
+  ~ContactManagerPool() = default;
+  ContactManagerPool(const ContactManagerPool&) = delete;
+  ContactManagerPool& operator=(const ContactManagerPool&) = delete;
+  ContactManagerPool(ContactManagerPool&&) = delete;
+  ContactManagerPool& operator=(ContactManagerPool&&) = delete;
+
+  /**
+   * @brief Get the contact manager assigned to the calling thread
+   * @details The returned manager must only be used by the calling thread and is valid until the thread exits or the
+   * pool is destroyed
+   * @return The calling thread's contact manager
+   */
+  ManagerType& get() const
+  {
+    std::vector<Entry>& entries = threadEntries().entries;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it)
+    {
+      if (it->id == id_)
+        return *it->manager;
+    }
+
+    return assign(entries);
+  }
+
+  /**
+   * @brief Clone managers up front so the first calls to get() on up to num_threads threads do not clone
+   * @param num_threads The number of threads expected to call get()
+   */
+  void warm(std::size_t num_threads) const
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    while (state_->managers.size() < num_threads)
+    {
+      state_->managers.push_back(template_->clone());
+      state_->spares.push_back(state_->managers.back().get());
+    }
+  }
+
+  /** @brief The number of managers cloned, including the ones not assigned to a thread */
+  std::size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->managers.size();
+  }
+
+  /** @brief The manager each thread's manager is cloned from, this must not be used for collision checking */
+  const ManagerType& getTemplate() const { return *template_; }
+
+private:
+  /**
+   * @brief The managers of a pool
+   * @details Shared with the threads exiting while the pool is destroyed, so they can still return their managers
+   */
+  struct State
+  {
+    /** @brief Guards the managers and spares, only used the first time a thread calls get() and when it exits */
+    std::mutex mutex;
+
+    /** @brief Every manager cloned by the pool */
+    std::vector<std::unique_ptr<ManagerType>> managers;
+
+    /** @brief Managers not assigned to a thread */
+    std::vector<ManagerType*> spares;
+  };
+
+  /** @brief A manager assigned to a thread */
+  struct Entry
+  {
+    std::size_t id;
+    std::weak_ptr<State> state;
+    ManagerType* manager;
+  };
+
+  /** @brief The entries of a thread, which returns the managers to the pools still alive when the thread exits */
+  struct ThreadEntries
+  {
+    std::vector<Entry> entries;
+
+    ThreadEntries() = default;
+    ~ThreadEntries()
+    {
+      for (const Entry& entry : entries)
+      {
+        if (std::shared_ptr<State> state = entry.state.lock())
+        {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          state->spares.push_back(entry.manager);
+        }
+      }
+    }
+    ThreadEntries(const ThreadEntries&) = delete;
+    ThreadEntries& operator=(const ThreadEntries&) = delete;
+    ThreadEntries(ThreadEntries&&) = delete;
+    ThreadEntries& operator=(ThreadEntries&&) = delete;
+  };
+
+  /** @brief Unique for every pool so a thread local entry is never matched to a different pool */
+  const std::size_t id_;
+
+  /** @brief The managers, the thread local entries only hold a weak pointer so they expire with the pool */
+  const std::shared_ptr<State> state_;
+
+  /** @brief The manager cloned for each thread */
+  std::shared_ptr<const ManagerType> template_;
+
+  ManagerType& assign(std::vector<Entry>& entries) const
+  {
+    ManagerType* manager{ nullptr };
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (state_->spares.empty())
+      {
+        state_->managers.push_back(template_->clone());
+        manager = state_->managers.back().get();
+      }
+      else
+      {
+        manager = state_->spares.back();
+        state_->spares.pop_back();
+      }
+    }
+
+    // Remove the entries of destroyed pools so long lived threads do not accumulate them
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](const Entry& e) { return e.state.expired(); }),
+                  entries.end());
+    entries.push_back(Entry{ id_, state_, manager });
+    return *manager;
+  }
+
+  static ThreadEntries& threadEntries()
+  {
+    static thread_local ThreadEntries entries;
+    return entries;
+  }
+
+  static std::size_t nextId()
+  {
+    static std::atomic<std::size_t> counter{ 0 };
+    return counter++;
+  }
+};
+
+using DiscreteContactManagerPool = ContactManagerPool<tesseract_collision::DiscreteContactManager>;
+using ContinuousContactManagerPool = ContactManagerPool<tesseract_collision::ContinuousContactManager>;
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_CONTACT_MANAGER_POOL_H
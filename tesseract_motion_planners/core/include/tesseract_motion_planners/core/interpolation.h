@@ -29,12 +29,15 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <memory>
+#include <thread>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/composite_instruction.h>
 #include <tesseract_kinematics/core/joint_group.h>
 #include <tesseract_kinematics/core/kinematic_group.h>
 #include <tesseract_motion_planners/core/types.h>
+#include <tesseract_motion_planners/core/planner_request_context.h>
 
 namespace tesseract_planning
 {
@@ -45,8 +48,18 @@ struct JointGroupInstructionInfo
                             const PlannerRequest& request,
                             const tesseract_common::ManipulatorInfo& manip_info);
 
+  /**
+   * @brief Construct the instruction information using the kinematics and TCP offset resolved by the context
+   * @param plan_instruction The instruction
+   * @param context The context of the planner request
+   * @param manip_info The manipulator information combined with the manipulator information of the instruction
+   */
+  JointGroupInstructionInfo(const MoveInstructionPoly& plan_instruction,
+                            const PlannerRequestContext& context,
+                            const tesseract_common::ManipulatorInfo& manip_info);
+
   const MoveInstructionPoly& instruction;
-  tesseract_kinematics::JointGroup::UPtr manip;
+  tesseract_kinematics::JointGroup::ConstPtr manip;
   std::string working_frame;
   Eigen::Isometry3d working_frame_transform{ Eigen::Isometry3d::Identity() };
   std::string tcp_frame;
@@ -90,8 +103,18 @@ struct KinematicGroupInstructionInfo
                                 const PlannerRequest& request,
                                 const tesseract_common::ManipulatorInfo& manip_info);
 
+  /**
+   * @brief Construct the instruction information using the kinematics and TCP offset resolved by the context
+   * @param plan_instruction The instruction
+   * @param context The context of the planner request
+   * @param manip_info The manipulator information combined with the manipulator information of the instruction
+   */
+  KinematicGroupInstructionInfo(const MoveInstructionPoly& plan_instruction,
+                                const PlannerRequestContext& context,
+                                const tesseract_common::ManipulatorInfo& manip_info);
+
   const MoveInstructionPoly& instruction;
-  tesseract_kinematics::KinematicGroup::UPtr manip;
+  tesseract_kinematics::KinematicGroup::ConstPtr manip;
   std::string working_frame;
   Eigen::Isometry3d working_frame_transform{ Eigen::Isometry3d::Identity() };
   std::string tcp_frame;
@@ -488,6 +511,35 @@ std::array<Eigen::VectorXd, 2> getClosestJointSolution(const KinematicGroupInstr
                                                        const KinematicGroupInstructionInfo& info2,
                                                        const Eigen::VectorXd& seed);
 
+/**
+ * @brief Find the closest joint solution for each of the provided cartesian poses
+ * @details Inverse kinematics of each pose is seeded with the solution of the previous pose, starting with the provided
+ * seed, and the solution within the limits closest to it is selected.
+ * @param info The instruction info providing the manipulator, working frame, tcp frame and tcp offset
+ * @param poses The poses of the tcp relative to the working frame
+ * @param seed The seed of the first pose
+ * @return The joint solutions, one per column. If inverse kinematics fails for a pose, only the solutions of the poses
+ * preceding it are returned.
+ */
+Eigen::MatrixXd getClosestJointSolutions(const KinematicGroupInstructionInfo& info,
+                                         const tesseract_common::VectorIsometry3d& poses,
+                                         const Eigen::VectorXd& seed);
+
+/**
+ * @brief Find the closest joint solutions of several segments of cartesian poses in parallel
+ * @details Each segment is solved independently as by getClosestJointSolutions, so the results do not depend on the
+ * number of threads. The calling thread is used as one of the threads.
+ * @param info The instruction info providing the manipulator, working frame, tcp frame and tcp offset
+ * @param segments The segments of poses of the tcp relative to the working frame
+ * @param seeds The seed of the first pose of each segment
+ * @param num_threads The maximum number of threads
+ * @return The joint solutions of each segment
+ */
+std::vector<Eigen::MatrixXd> getClosestJointSolutions(const KinematicGroupInstructionInfo& info,
+                                                      const std::vector<tesseract_common::VectorIsometry3d>& segments,
+                                                      const std::vector<Eigen::VectorXd>& seeds,
+                                                      std::size_t num_threads = std::thread::hardware_concurrency());
+
 }  // namespace tesseract_planning
 
 #endif  // TESSERACT_MOTION_PLANNERS_INTERPOLATION_H
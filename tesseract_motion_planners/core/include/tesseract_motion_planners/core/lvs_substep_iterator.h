@@ -0,0 +1,103 @@
+/**
+ * @file lvs_substep_iterator.h
+ * @brief Iterate over the states interpolated along a segment based on the longest valid segment length
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_LVS_SUBSTEP_ITERATOR_H
+#define TESSERACT_MOTION_PLANNERS_LVS_SUBSTEP_ITERATOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_planning
+{
+/**
+ * @brief Iterates over the states linearly interpolated between two joint positions
+ * @details The number of states is the same as the longest valid segment checks performed by contactCheckProgram,
+ * ceil(distance / longest_valid_segment_length) + 1, including the start and end positions. Each state is computed
+ * into an internal buffer on demand, so once the buffers have been sized for the number of joints, resetting the
+ * iterator for a new segment does not allocate.
+ *
+ * Example:
+ * @code
+ * LVSSubstepIterator substeps;
+ * substeps.reset(start, end, 0.05);
+ * do
+ * {
+ *   const Eigen::VectorXd& state = substeps.state();
+ * } while (substeps.next());
+ * @endcode
+ */
+class LVSSubstepIterator
+{
+public:
+  LVSSubstepIterator() = default;
+
+  /**
+   * @brief Reset the iterator to the first state of a new segment
+   * @param start The start joint position of the segment
+   * @param end The end joint position of the segment
+   * @param longest_valid_segment_length The maximum joint distance between states
+   */
+  void reset(const Eigen::Ref<const Eigen::VectorXd>& start,
+             const Eigen::Ref<const Eigen::VectorXd>& end,
+             double longest_valid_segment_length);
+
+  /**
+   * @brief Advance to the next state
+   * @return False if the current state is the end of the segment, otherwise true
+   */
+  bool next();
+
+  /** @brief The current state */
+  const Eigen::VectorXd& state() const;
+
+  /** @brief The index of the current state */
+  long index() const;
+
+  /** @brief The number of states including the start and end of the segment */
+  long size() const;
+
+  /** @brief The joint distance between the start and end of the segment */
+  double distance() const;
+
+  /**
+   * @brief Compute the state at the provided index without changing the current state
+   * @details This allocates and is intended for reporting, use state() when iterating
+   */
+  Eigen::VectorXd interpolate(long index) const;
+
+private:
+  Eigen::VectorXd start_;
+  Eigen::VectorXd end_;
+  Eigen::VectorXd delta_;
+  Eigen::VectorXd state_;
+  double distance_{ 0 };
+  long size_{ 0 };
+  long index_{ 0 };
+
+  /** @brief Compute the state at the provided index into the output */
+  void interpolate(long index, Eigen::VectorXd& state) const;
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_LVS_SUBSTEP_ITERATOR_H
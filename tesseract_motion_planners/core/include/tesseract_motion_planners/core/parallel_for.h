@@ -0,0 +1,60 @@
+/**
+ * @file parallel_for.h
+ * @brief Distribute the indices of a loop across multiple threads
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_PARALLEL_FOR_H
+#define TESSERACT_MOTION_PLANNERS_PARALLEL_FOR_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cstddef>
+#include <functional>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_planning
+{
+/**
+ * @brief The function called by parallelFor
+ * @details It is given the index to process and the index of the worker calling it, which is in [0, num_workers).
+ * Returning false stops the indices which have not been started yet.
+ */
+using ParallelForFunction = std::function<bool(std::size_t index, std::size_t worker)>;
+
+/**
+ * @brief Get the number of workers used by parallelFor
+ * @return num_threads limited to count, at least one
+ */
+std::size_t getParallelForWorkers(std::size_t count, std::size_t num_threads);
+
+/**
+ * @brief Call function for each index in [0, count)
+ * @details The indices are taken in order by getParallelForWorkers(count, num_threads) workers and the calling thread
+ * is one of them, so a single worker does not start any threads. Once the function returns false or throws, the
+ * remaining indices are not started. The first exception is rethrown after all of the threads have finished.
+ * @param count The number of indices
+ * @param num_threads The maximum number of threads, including the calling thread
+ * @param function The function called for each index
+ * @return True if the function returned true for every index, otherwise false
+ */
+bool parallelFor(std::size_t count, std::size_t num_threads, const ParallelForFunction& function);
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_PARALLEL_FOR_H
@@ -0,0 +1,103 @@
+/**
+ * @file planner_request_context.h
+ * @brief Resolves the kinematics and TCP offsets of a planner request once
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_PLANNER_REQUEST_CONTEXT_H
+#define TESSERACT_MOTION_PLANNERS_PLANNER_REQUEST_CONTEXT_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/manipulator_info.h>
+#include <tesseract_kinematics/core/joint_group.h>
+#include <tesseract_kinematics/core/kinematic_group.h>
+#include <tesseract_motion_planners/core/types.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief The kinematics and TCP offsets of the manipulators of a planner request
+ * @details Getting a kinematic group from the environment creates a new group and finding the TCP offset searches the
+ * environment, which is expensive compared to interpolating a single instruction. The context resolves each
+ * manipulator and manipulator information on first use and returns the same result for the rest of the request, so a
+ * program with thousands of instructions only resolves them once.
+ *
+ * The returned groups are shared, so they must only be used through their const interface. The context is thread safe
+ * and references the request, so it must not outlive it.
+ */
+class PlannerRequestContext
+{
+public:
+  using Ptr = std::shared_ptr<PlannerRequestContext>;
+  using ConstPtr = std::shared_ptr<const PlannerRequestContext>;
+  using UPtr = std::unique_ptr<PlannerRequestContext>;
+  using ConstUPtr = std::unique_ptr<const PlannerRequestContext>;
+
+  explicit PlannerRequestContext(const PlannerRequest& request);
+  ~PlannerRequestContext() = default;
+  PlannerRequestContext(const PlannerRequestContext&) = delete;
+  PlannerRequestContext& operator=(const PlannerRequestContext&) = delete;
+  PlannerRequestContext(PlannerRequestContext&&) = delete;
+  PlannerRequestContext& operator=(PlannerRequestContext&&) = delete;
+
+  /** @brief The planner request */
+  const PlannerRequest& getRequest() const;
+
+  /**
+   * @brief Get the joint group of a manipulator
+   * @param manipulator The name of the manipulator
+   * @return The joint group
+   */
+  tesseract_kinematics::JointGroup::ConstPtr getJointGroup(const std::string& manipulator) const;
+
+  /**
+   * @brief Get the kinematic group of a manipulator
+   * @param manipulator The name of the manipulator
+   * @param ik_solver The name of the IK solver, if empty the default IK solver is used
+   * @return The kinematic group
+   */
+  tesseract_kinematics::KinematicGroup::ConstPtr getKinematicGroup(const std::string& manipulator,
+                                                                   const std::string& ik_solver = "") const;
+
+  /**
+   * @brief Get the TCP offset of the manipulator information
+   * @param manip_info The manipulator information
+   * @return The TCP offset
+   */
+  Eigen::Isometry3d getTCPOffset(const tesseract_common::ManipulatorInfo& manip_info) const;
+
+private:
+  const PlannerRequest& request_;
+
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::string, tesseract_kinematics::JointGroup::ConstPtr> joint_groups_;
+  mutable std::unordered_map<std::string, tesseract_kinematics::KinematicGroup::ConstPtr> kinematic_groups_;
+  mutable std::unordered_map<std::string, Eigen::Isometry3d> tcp_offsets_;
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_PLANNER_REQUEST_CONTEXT_H
@@ -114,6 +114,8 @@ struct PlannerResponse
   /** @brief Planner specific data. Planners in Tesseract_planning use this to store the planner problem that was solved
    */
   std::shared_ptr<void> data;
+  /** @brief Planner specific statistics, for example the solve time or the number of iterations, keyed by name */
+  std::unordered_map<std::string, double> statistics;
 
   /** @brief This return true if successful */
   explicit operator bool() const noexcept { return successful; }
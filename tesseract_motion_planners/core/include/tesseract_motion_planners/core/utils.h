@@ -115,6 +115,46 @@ bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& con
                          const CompositeInstruction& program,
                          const tesseract_collision::CollisionCheckConfig& config);
 
+/**
+ * @brief Should perform a continuous collision check over the trajectory using multiple threads.
+ * @details The trajectory steps are distributed across the threads, each using its own clone of the contact manager
+ * and state solver. If the contact test type is FIRST, all threads stop once a collision is found so contacts may be
+ * reported for more than one step.
+ * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
+ * @param manager A continuous contact manager which is cloned for each thread
+ * @param state_solver The environment state solver which is cloned for each thread
+ * @param program The program to check for contacts
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param num_threads The number of threads to use, including the calling thread
+ * @return True if collision was found, otherwise false.
+ */
+bool contactCheckProgramParallel(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                                 const tesseract_collision::ContinuousContactManager& manager,
+                                 const tesseract_scene_graph::StateSolver& state_solver,
+                                 const CompositeInstruction& program,
+                                 const tesseract_collision::CollisionCheckConfig& config,
+                                 std::size_t num_threads);
+
+/**
+ * @brief Should perform a discrete collision check over the trajectory using multiple threads.
+ * @details The trajectory steps are distributed across the threads, each using its own clone of the contact manager
+ * and state solver. If the contact test type is FIRST, all threads stop once a collision is found so contacts may be
+ * reported for more than one step.
+ * @param contacts A vector of vector of ContactMap where each index corresponds to a timestep
+ * @param manager A discrete contact manager which is cloned for each thread
+ * @param state_solver The environment state solver which is cloned for each thread
+ * @param program The program to check for contacts
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param num_threads The number of threads to use, including the calling thread
+ * @return True if collision was found, otherwise false.
+ */
+bool contactCheckProgramParallel(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                                 const tesseract_collision::DiscreteContactManager& manager,
+                                 const tesseract_scene_graph::StateSolver& state_solver,
+                                 const CompositeInstruction& program,
+                                 const tesseract_collision::CollisionCheckConfig& config,
+                                 std::size_t num_threads);
+
 }  // namespace tesseract_planning
 
 #endif  // TESSERACT_PLANNING_UTILS_H
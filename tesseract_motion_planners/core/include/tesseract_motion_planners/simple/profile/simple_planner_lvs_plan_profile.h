@@ -57,11 +57,13 @@ public:
                               int min_steps = 1,
                               int max_steps = std::numeric_limits<int>::max());
 
+  using SimplePlannerPlanProfile::generate;
+
   std::vector<MoveInstructionPoly> generate(const MoveInstructionPoly& prev_instruction,
                                             const MoveInstructionPoly& prev_seed,
                                             const MoveInstructionPoly& base_instruction,
                                             const InstructionPoly& next_instruction,
-                                            const PlannerRequest& request,
+                                            const PlannerRequestContext& context,
                                             const tesseract_common::ManipulatorInfo& global_manip_info) const override;
 
   /** @brief The maximum joint distance, the norm of changes to all joint positions between successive steps. */
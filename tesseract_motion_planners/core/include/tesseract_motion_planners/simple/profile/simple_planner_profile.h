@@ -34,6 +34,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/poly/move_instruction_poly.h>
 #include <tesseract_motion_planners/core/types.h>
+#include <tesseract_motion_planners/core/planner_request_context.h>
 
 namespace tesseract_planning
 {
@@ -61,7 +62,7 @@ public:
    * @param prev_seed The previous seed
    * @param base_instruction The base/current instruction to generate the seed for
    * @param next_instruction The next instruction. This will be a null instruction for the final instruction
-   * @param request The planning request
+   * @param context The context of the planning request, shared by every instruction of the request
    * @param global_manip_info The global manipulator information
    * @return A vector of move instrucitons
    */
@@ -70,8 +71,24 @@ public:
            const MoveInstructionPoly& prev_seed,
            const MoveInstructionPoly& base_instruction,
            const InstructionPoly& next_instruction,
-           const PlannerRequest& request,
+           const PlannerRequestContext& context,
            const tesseract_common::ManipulatorInfo& global_manip_info) const = 0;
+
+  /**
+   * @brief Generate a seed for the provided base_instruction using a context for this instruction only
+   * @details Prefer the overload taking a context when generating seeds for multiple instructions of a request
+   * @param request The planning request
+   */
+  std::vector<MoveInstructionPoly> generate(const MoveInstructionPoly& prev_instruction,
+                                            const MoveInstructionPoly& prev_seed,
+                                            const MoveInstructionPoly& base_instruction,
+                                            const InstructionPoly& next_instruction,
+                                            const PlannerRequest& request,
+                                            const tesseract_common::ManipulatorInfo& global_manip_info) const
+  {
+    PlannerRequestContext context(request);
+    return generate(prev_instruction, prev_seed, base_instruction, next_instruction, context, global_manip_info);
+  }
 };
 
 class SimplePlannerCompositeProfile
@@ -71,7 +71,7 @@ protected:
   CompositeInstruction processCompositeInstruction(const CompositeInstruction& instructions,
                                                    MoveInstructionPoly& prev_instruction,
                                                    MoveInstructionPoly& prev_seed,
-                                                   const PlannerRequest& request) const;
+                                                   const PlannerRequestContext& context) const;
 };
 
 }  // namespace tesseract_planning
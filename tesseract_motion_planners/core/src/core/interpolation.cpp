@@ -25,14 +25,87 @@
  */
 
 #include <tesseract_motion_planners/core/interpolation.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
 #include <tesseract_command_language/utils.h>
 #include <tesseract_kinematics/core/utils.h>
 
 namespace tesseract_planning
 {
+namespace
+{
+/**
+ * @brief Store the IK solutions, each followed by its redundant solutions, as the columns of a matrix
+ * @details Storing the candidates contiguously allows the distance to a reference to be computed for all of them in a
+ * single vectorized expression.
+ * @param solutions The IK solutions
+ * @param limits The joint limits
+ * @param redundancy_indices The indices of the redundancy capable joints
+ * @param filter_limits Exclude the IK solutions which do not satisfy the limits before expanding them
+ * @return The candidate solutions, one per column
+ */
+Eigen::MatrixXd getCandidateSolutions(const tesseract_kinematics::IKSolutions& solutions,
+                                      const Eigen::MatrixX2d& limits,
+                                      const std::vector<Eigen::Index>& redundancy_indices,
+                                      bool filter_limits)
+{
+  tesseract_kinematics::IKSolutions candidates;
+  candidates.reserve(solutions.size());
+  for (const auto& sol : solutions)
+  {
+    if (filter_limits && !tesseract_common::satisfiesPositionLimits<double>(sol, limits))
+      continue;
+
+    candidates.push_back(sol);
+    auto redundant_solutions = tesseract_kinematics::getRedundantSolutions<double>(sol, limits, redundancy_indices);
+    candidates.insert(candidates.end(), redundant_solutions.begin(), redundant_solutions.end());
+  }
+
+  Eigen::MatrixXd matrix(limits.rows(), static_cast<Eigen::Index>(candidates.size()));
+  for (std::size_t i = 0; i < candidates.size(); ++i)
+    matrix.col(static_cast<Eigen::Index>(i)) = candidates[i];
+
+  return matrix;
+}
+
+/**
+ * @brief Find the candidate closest to the reference
+ * @details Ties are resolved in favor of the first candidate
+ * @param candidates The candidate solutions, one per column
+ * @param reference The reference joint state
+ * @param limits If not null, only candidates which satisfy the limits are considered
+ * @return The column of the closest candidate, -1 if there is none
+ */
+Eigen::Index findClosestSolution(const Eigen::MatrixXd& candidates,
+                                 const Eigen::Ref<const Eigen::VectorXd>& reference,
+                                 const Eigen::MatrixX2d* limits)
+{
+  if (candidates.cols() == 0)
+    return -1;
+
+  const Eigen::RowVectorXd dist = (candidates.colwise() - reference).colwise().norm();
+  Eigen::Index index{ -1 };
+  for (Eigen::Index i = 0; i < candidates.cols(); ++i)
+  {
+    if (limits != nullptr && !tesseract_common::satisfiesPositionLimits<double>(candidates.col(i), *limits))
+      continue;
+
+    if (index < 0 || dist(i) < dist(index))
+      index = i;
+  }
+  return index;
+}
+}  // namespace
+
 JointGroupInstructionInfo::JointGroupInstructionInfo(const MoveInstructionPoly& plan_instruction,
                                                      const PlannerRequest& request,
                                                      const tesseract_common::ManipulatorInfo& manip_info)
+  : JointGroupInstructionInfo(plan_instruction, PlannerRequestContext(request), manip_info)
+{
+}
+
+JointGroupInstructionInfo::JointGroupInstructionInfo(const MoveInstructionPoly& plan_instruction,
+                                                     const PlannerRequestContext& context,
+                                                     const tesseract_common::ManipulatorInfo& manip_info)
   : instruction(plan_instruction)
 {
   assert(!(manip_info.empty() && plan_instruction.getManipulatorInfo().empty()));
@@ -49,13 +122,13 @@ JointGroupInstructionInfo::JointGroupInstructionInfo(const MoveInstructionPoly&
     throw std::runtime_error("InstructionInfo, working frame is empty!");
 
   // Get Previous Instruction Kinematics
-  manip = request.env->getJointGroup(mi.manipulator);
+  manip = context.getJointGroup(mi.manipulator);
 
   // Get Previous Instruction TCP and Working Frame
   working_frame = mi.working_frame;
-  working_frame_transform = request.env_state.link_transforms.at(working_frame);
+  working_frame_transform = context.getRequest().env_state.link_transforms.at(working_frame);
   tcp_frame = mi.tcp_frame;
-  tcp_offset = request.env->findTCPOffset(mi);
+  tcp_offset = context.getTCPOffset(mi);
 
   // Get Previous Instruction Waypoint Info
   if (plan_instruction.getWaypoint().isStateWaypoint() || plan_instruction.getWaypoint().isJointWaypoint())
@@ -95,6 +168,13 @@ const Eigen::VectorXd& JointGroupInstructionInfo::extractJointPosition() const
 KinematicGroupInstructionInfo::KinematicGroupInstructionInfo(const MoveInstructionPoly& plan_instruction,
                                                              const PlannerRequest& request,
                                                              const tesseract_common::ManipulatorInfo& manip_info)
+  : KinematicGroupInstructionInfo(plan_instruction, PlannerRequestContext(request), manip_info)
+{
+}
+
+KinematicGroupInstructionInfo::KinematicGroupInstructionInfo(const MoveInstructionPoly& plan_instruction,
+                                                             const PlannerRequestContext& context,
+                                                             const tesseract_common::ManipulatorInfo& manip_info)
   : instruction(plan_instruction)
 {
   assert(!(manip_info.empty() && plan_instruction.getManipulatorInfo().empty()));
@@ -111,13 +191,13 @@ KinematicGroupInstructionInfo::KinematicGroupInstructionInfo(const MoveInstructi
     throw std::runtime_error("InstructionInfo, working frame is empty!");
 
   // Get Previous Instruction Kinematics
-  manip = request.env->getKinematicGroup(mi.manipulator);
+  manip = context.getKinematicGroup(mi.manipulator);
 
   // Get Previous Instruction TCP and Working Frame
   working_frame = mi.working_frame;
-  working_frame_transform = request.env_state.link_transforms.at(working_frame);
+  working_frame_transform = context.getRequest().env_state.link_transforms.at(working_frame);
   tcp_frame = mi.tcp_frame;
-  tcp_offset = request.env->findTCPOffset(mi);
+  tcp_offset = context.getTCPOffset(mi);
 
   // Get Previous Instruction Waypoint Info
   if (plan_instruction.getWaypoint().isStateWaypoint() || plan_instruction.getWaypoint().isJointWaypoint())
@@ -1101,8 +1181,8 @@ std::vector<MoveInstructionPoly> getInterpolatedInstructions(const tesseract_com
 
 Eigen::VectorXd getClosestJointSolution(const KinematicGroupInstructionInfo& info, const Eigen::VectorXd& seed)
 {
-  auto limits = info.manip->getLimits();
-  auto redundancy_indices = info.manip->getRedundancyCapableJointIndices();
+  const tesseract_common::KinematicLimits limits = info.manip->getLimits();
+  const std::vector<Eigen::Index> redundancy_indices = info.manip->getRedundancyCapableJointIndices();
 
   if (!info.has_cartesian_waypoint)
     throw std::runtime_error("Instruction waypoint type is not a CartesianWaypoint, unable to extract cartesian pose!");
@@ -1110,56 +1190,29 @@ Eigen::VectorXd getClosestJointSolution(const KinematicGroupInstructionInfo& inf
   Eigen::Isometry3d cwp =
       info.instruction.getWaypoint().as<CartesianWaypointPoly>().getTransform() * info.tcp_offset.inverse();
 
-  Eigen::VectorXd jp_final;
-  tesseract_kinematics::IKSolutions jp;
   tesseract_kinematics::KinGroupIKInput ik_input(cwp, info.working_frame, info.tcp_frame);
   tesseract_kinematics::IKSolutions solutions = info.manip->calcInvKin({ ik_input }, seed);
-  for (const auto& sol : solutions)
-  {
-    jp.push_back(sol);
-    auto redundant_solutions =
-        tesseract_kinematics::getRedundantSolutions<double>(sol, limits.joint_limits, redundancy_indices);
-    jp.insert(jp.end(), redundant_solutions.begin(), redundant_solutions.end());
-  }
 
-  if (!jp.empty())
-  {
-    // Find closest solution to the start state
-    double dist = std::numeric_limits<double>::max();
-    for (const auto& solution : jp)
-    {
-      if (tesseract_common::satisfiesPositionLimits<double>(solution, limits.joint_limits))
-      {
-        if (jp_final.rows() == 0)
-        {
-          jp_final = solution;
-          dist = (solution - seed).norm();
-          continue;
-        }
-
-        /// @todo: May be nice to add contact checking to find best solution, but may not be necessary because this is
-        /// used to generate the seed
-        double d = (solution - seed).norm();
-        if (d < dist)
-        {
-          jp_final = solution;
-          dist = d;
-        }
-      }
-    }
-  }
-  return jp_final;
+  /// @todo: May be nice to add contact checking to find best solution, but may not be necessary because this is
+  /// used to generate the seed
+  const Eigen::MatrixXd candidates =
+      getCandidateSolutions(solutions, limits.joint_limits, redundancy_indices, false);
+  const Eigen::Index index = findClosestSolution(candidates, seed, &limits.joint_limits);
+  if (index < 0)
+    return {};
+
+  return candidates.col(index);
 }
 
 std::array<Eigen::VectorXd, 2> getClosestJointSolution(const KinematicGroupInstructionInfo& info1,
                                                        const KinematicGroupInstructionInfo& info2,
                                                        const Eigen::VectorXd& seed)
 {
-  auto manip1_limits = info1.manip->getLimits();
-  auto manip1_redundancy_indices = info1.manip->getRedundancyCapableJointIndices();
+  const tesseract_common::KinematicLimits manip1_limits = info1.manip->getLimits();
+  const std::vector<Eigen::Index> manip1_redundancy_indices = info1.manip->getRedundancyCapableJointIndices();
 
-  auto manip2_limits = info2.manip->getLimits();
-  auto manip2_redundancy_indices = info2.manip->getRedundancyCapableJointIndices();
+  const tesseract_common::KinematicLimits manip2_limits = info2.manip->getLimits();
+  const std::vector<Eigen::Index> manip2_redundancy_indices = info2.manip->getRedundancyCapableJointIndices();
 
   if (!info1.has_cartesian_waypoint || !info2.has_cartesian_waypoint)
     throw std::runtime_error("Instruction waypoint type is not a CartesianWaypoint, unable to extract cartesian pose!");
@@ -1171,107 +1224,91 @@ std::array<Eigen::VectorXd, 2> getClosestJointSolution(const KinematicGroupInstr
 
   std::array<Eigen::VectorXd, 2> results;
 
-  // Calculate IK for start and end
-  Eigen::VectorXd j1_final;
-  tesseract_kinematics::IKSolutions j1;
+  // Calculate IK for start and end, only solutions within the limits are expanded into redundant solutions
   tesseract_kinematics::KinGroupIKInput ik_input1(cwp1, info1.working_frame, info1.tcp_frame);
   tesseract_kinematics::IKSolutions j1_solutions = info1.manip->calcInvKin({ ik_input1 }, seed);
-  j1_solutions.erase(std::remove_if(j1_solutions.begin(),
-                                    j1_solutions.end(),
-                                    [&manip1_limits](const Eigen::VectorXd& solution) {
-                                      return !tesseract_common::satisfiesPositionLimits<double>(
-                                          solution, manip1_limits.joint_limits);
-                                    }),
-                     j1_solutions.end());
-
-  // Get redundant solutions
-  for (const auto& sol : j1_solutions)
-  {
-    j1.push_back(sol);
-    auto redundant_solutions =
-        tesseract_kinematics::getRedundantSolutions<double>(sol, manip1_limits.joint_limits, manip1_redundancy_indices);
-    j1.insert(j1.end(), redundant_solutions.begin(), redundant_solutions.end());
-  }
+  const Eigen::MatrixXd j1 =
+      getCandidateSolutions(j1_solutions, manip1_limits.joint_limits, manip1_redundancy_indices, true);
 
-  Eigen::VectorXd j2_final;
-  tesseract_kinematics::IKSolutions j2;
   tesseract_kinematics::KinGroupIKInput ik_input2(cwp2, info2.working_frame, info2.tcp_frame);
   tesseract_kinematics::IKSolutions j2_solutions = info2.manip->calcInvKin({ ik_input2 }, seed);
-  j2_solutions.erase(std::remove_if(j2_solutions.begin(),
-                                    j2_solutions.end(),
-                                    [&manip2_limits](const Eigen::VectorXd& solution) {
-                                      // NOLINTNEXTLINE(clang-analyzer-core.uninitialized.UndefReturn)
-                                      return !tesseract_common::satisfiesPositionLimits<double>(
-                                          solution, manip2_limits.joint_limits);
-                                    }),
-                     j2_solutions.end());
-
-  // Get redundant solutions
-  for (const auto& sol : j2_solutions)
-  {
-    j2.push_back(sol);
-    auto redundant_solutions =
-        tesseract_kinematics::getRedundantSolutions<double>(sol, manip2_limits.joint_limits, manip2_redundancy_indices);
-    j2.insert(j2.end(), redundant_solutions.begin(), redundant_solutions.end());
-  }
+  const Eigen::MatrixXd j2 =
+      getCandidateSolutions(j2_solutions, manip2_limits.joint_limits, manip2_redundancy_indices, true);
 
-  if (!j1.empty() && !j2.empty())
+  if (j1.cols() > 0 && j2.cols() > 0)
   {
     // Find closest solution to the end state
+    /// @todo: May be nice to add contact checking to find best solution, but may not be necessary because this is
+    /// used to generate the seed.
     double dist = std::numeric_limits<double>::max();
-    j1_final = j1[0];
-    j2_final = j2[0];
-    for (const auto& j1_solution : j1)
+    Eigen::Index j1_index{ 0 };
+    Eigen::Index j2_index{ 0 };
+    for (Eigen::Index i = 0; i < j1.cols(); ++i)
     {
-      for (const auto& j2_solution : j2)
-      {
-        /// @todo: May be nice to add contact checking to find best solution, but may not be necessary because this is
-        /// used to generate the seed.
-        double d = (j2_solution - j1_solution).norm();
-        if (d < dist)
-        {
-          j1_final = j1_solution;
-          j2_final = j2_solution;
-          dist = d;
-        }
-      }
-    }
-    results[0] = j1_final;
-    results[1] = j2_final;
-  }
-  else if (!j1.empty())
-  {
-    double dist = std::numeric_limits<double>::max();
-    j1_final = j1[0];
-    for (const auto& j1_solution : j1)
-    {
-      double d = (seed - j1_solution).norm();
+      Eigen::Index index{ 0 };
+      const double d = (j2.colwise() - j1.col(i)).colwise().norm().minCoeff(&index);
       if (d < dist)
       {
-        j1_final = j1_solution;
+        j1_index = i;
+        j2_index = index;
         dist = d;
       }
     }
-
-    results[0] = j1_final;
+    results[0] = j1.col(j1_index);
+    results[1] = j2.col(j2_index);
   }
-  else if (!j2.empty())
+  else if (j1.cols() > 0)
   {
-    double dist = std::numeric_limits<double>::max();
-    j2_final = j2[0];
-    for (const auto& j2_solution : j2)
-    {
-      double d = (seed - j2_solution).norm();
-      if (d < dist)
-      {
-        j2_final = j2_solution;
-        dist = d;
-      }
-    }
+    results[0] = j1.col(findClosestSolution(j1, seed, nullptr));
+  }
+
+  // Without a solution for the start state both results are left empty, even if the end state has solutions
+
+  return results;
+}
 
-    results[1] = j1_final;
+Eigen::MatrixXd getClosestJointSolutions(const KinematicGroupInstructionInfo& info,
+                                         const tesseract_common::VectorIsometry3d& poses,
+                                         const Eigen::VectorXd& seed)
+{
+  const tesseract_common::KinematicLimits limits = info.manip->getLimits();
+  const std::vector<Eigen::Index> redundancy_indices = info.manip->getRedundancyCapableJointIndices();
+  const Eigen::Isometry3d tcp_offset_inv = info.tcp_offset.inverse();
+
+  Eigen::MatrixXd states(seed.size(), static_cast<Eigen::Index>(poses.size()));
+  Eigen::VectorXd prev_state = seed;
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    tesseract_kinematics::KinGroupIKInput ik_input(poses[i] * tcp_offset_inv, info.working_frame, info.tcp_frame);
+    tesseract_kinematics::IKSolutions solutions = info.manip->calcInvKin({ ik_input }, prev_state);
+
+    const Eigen::MatrixXd candidates =
+        getCandidateSolutions(solutions, limits.joint_limits, redundancy_indices, false);
+    const Eigen::Index index = findClosestSolution(candidates, prev_state, &limits.joint_limits);
+    if (index < 0)
+      return states.leftCols(static_cast<Eigen::Index>(i));
+
+    states.col(static_cast<Eigen::Index>(i)) = candidates.col(index);
+    prev_state = candidates.col(index);
   }
 
+  return states;
+}
+
+std::vector<Eigen::MatrixXd> getClosestJointSolutions(const KinematicGroupInstructionInfo& info,
+                                                      const std::vector<tesseract_common::VectorIsometry3d>& segments,
+                                                      const std::vector<Eigen::VectorXd>& seeds,
+                                                      std::size_t num_threads)
+{
+  if (segments.size() != seeds.size())
+    throw std::runtime_error("getClosestJointSolutions, the number of segments and seeds must be equal!");
+
+  std::vector<Eigen::MatrixXd> results(segments.size());
+  parallelFor(segments.size(), num_threads, [&](std::size_t i, std::size_t /*worker*/) {
+    results[i] = getClosestJointSolutions(info, segments[i], seeds[i]);
+    return true;
+  });
+
   return results;
 }
 
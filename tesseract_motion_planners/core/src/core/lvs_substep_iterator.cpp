@@ -0,0 +1,85 @@
+/**
+ * @file lvs_substep_iterator.cpp
+ * @brief Iterate over the states interpolated along a segment based on the longest valid segment length
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/core/lvs_substep_iterator.h>
+
+namespace tesseract_planning
+{
+void LVSSubstepIterator::reset(const Eigen::Ref<const Eigen::VectorXd>& start,
+                               const Eigen::Ref<const Eigen::VectorXd>& end,
+                               double longest_valid_segment_length)
+{
+  assert(start.size() == end.size());
+  assert(longest_valid_segment_length > 0);
+
+  // Assignment only reallocates if the number of joints changed
+  start_ = start;
+  end_ = end;
+  delta_ = end - start;
+  distance_ = delta_.norm();
+  size_ = std::max(static_cast<long>(std::ceil(distance_ / longest_valid_segment_length)) + 1, 2L);
+  index_ = 0;
+  state_ = start_;
+}
+
+bool LVSSubstepIterator::next()
+{
+  if (index_ >= size_ - 1)
+    return false;
+
+  interpolate(++index_, state_);
+  return true;
+}
+
+const Eigen::VectorXd& LVSSubstepIterator::state() const { return state_; }
+
+long LVSSubstepIterator::index() const { return index_; }
+
+long LVSSubstepIterator::size() const { return size_; }
+
+double LVSSubstepIterator::distance() const { return distance_; }
+
+Eigen::VectorXd LVSSubstepIterator::interpolate(long index) const
+{
+  Eigen::VectorXd state(start_.size());
+  interpolate(index, state);
+  return state;
+}
+
+void LVSSubstepIterator::interpolate(long index, Eigen::VectorXd& state) const
+{
+  assert(index >= 0 && index < size_);
+
+  // The end is assigned directly so it matches exactly, like Eigen's LinSpaced
+  if (index == size_ - 1)
+    state = end_;
+  else
+    state.noalias() = start_ + (static_cast<double>(index) / static_cast<double>(size_ - 1)) * delta_;
+}
+
+}  // namespace tesseract_planning
@@ -0,0 +1,89 @@
+/**
+ * @file parallel_for.cpp
+ * @brief Distribute the indices of a loop across multiple threads
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/core/parallel_for.h>
+
+namespace tesseract_planning
+{
+std::size_t getParallelForWorkers(std::size_t count, std::size_t num_threads)
+{
+  return std::max<std::size_t>(std::min(num_threads, count), 1);
+}
+
+bool parallelFor(std::size_t count, std::size_t num_threads, const ParallelForFunction& function)
+{
+  const std::size_t num_workers = getParallelForWorkers(count, num_threads);
+
+  std::atomic<std::size_t> next_index{ 0 };
+  std::atomic<bool> successful{ true };
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+
+  auto worker = [&](std::size_t worker_index) {
+    try
+    {
+      while (successful)
+      {
+        const std::size_t i = next_index++;
+        if (i >= count)
+          break;
+
+        if (!function(i, worker_index))
+          successful = false;
+      }
+    }
+    catch (...)
+    {
+      successful = false;
+      std::scoped_lock lock(exception_mutex);
+      if (!exception)
+        exception = std::current_exception();
+    }
+  };
+
+  // The calling thread is the first worker
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  for (std::size_t i = 1; i < num_workers; ++i)
+    threads.emplace_back(worker, i);
+
+  worker(0);
+
+  for (auto& thread : threads)
+    thread.join();
+
+  if (exception)
+    std::rethrow_exception(exception);
+
+  return successful;
+}
+
+}  // namespace tesseract_planning
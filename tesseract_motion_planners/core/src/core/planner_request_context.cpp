@@ -0,0 +1,88 @@
+/**
+ * @file planner_request_context.cpp
+ * @brief Resolves the kinematics and TCP offsets of a planner request once
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_motion_planners/core/planner_request_context.h>
+
+namespace tesseract_planning
+{
+PlannerRequestContext::PlannerRequestContext(const PlannerRequest& request) : request_(request) {}
+
+const PlannerRequest& PlannerRequestContext::getRequest() const { return request_; }
+
+tesseract_kinematics::JointGroup::ConstPtr PlannerRequestContext::getJointGroup(const std::string& manipulator) const
+{
+  std::scoped_lock lock(mutex_);
+  auto it = joint_groups_.find(manipulator);
+  if (it != joint_groups_.end())
+    return it->second;
+
+  tesseract_kinematics::JointGroup::ConstPtr manip = request_.env->getJointGroup(manipulator);
+  joint_groups_[manipulator] = manip;
+  return manip;
+}
+
+tesseract_kinematics::KinematicGroup::ConstPtr
+PlannerRequestContext::getKinematicGroup(const std::string& manipulator, const std::string& ik_solver) const
+{
+  // The names can not contain a null character so they are joined with it
+  std::string key = manipulator;
+  key.push_back('\0');
+  key.append(ik_solver);
+
+  std::scoped_lock lock(mutex_);
+  auto it = kinematic_groups_.find(key);
+  if (it != kinematic_groups_.end())
+    return it->second;
+
+  tesseract_kinematics::KinematicGroup::ConstPtr manip = (ik_solver.empty()) ?
+                                                             request_.env->getKinematicGroup(manipulator) :
+                                                             request_.env->getKinematicGroup(manipulator, ik_solver);
+  kinematic_groups_[key] = manip;
+  return manip;
+}
+
+Eigen::Isometry3d PlannerRequestContext::getTCPOffset(const tesseract_common::ManipulatorInfo& manip_info) const
+{
+  // An offset provided as a transform does not require a lookup
+  if (manip_info.tcp_offset.index() != 0)
+    return request_.env->findTCPOffset(manip_info);
+
+  std::string key = manip_info.manipulator;
+  for (const std::string* name : { &manip_info.manipulator_ik_solver,
+                                   &manip_info.working_frame,
+                                   &manip_info.tcp_frame,
+                                   &std::get<0>(manip_info.tcp_offset) })
+  {
+    key.push_back('\0');
+    key.append(*name);
+  }
+
+  std::scoped_lock lock(mutex_);
+  auto it = tcp_offsets_.find(key);
+  if (it != tcp_offsets_.end())
+    return it->second;
+
+  const Eigen::Isometry3d tcp_offset = request_.env->findTCPOffset(manip_info);
+  tcp_offsets_[key] = tcp_offset;
+  return tcp_offset;
+}
+
+}  // namespace tesseract_planning
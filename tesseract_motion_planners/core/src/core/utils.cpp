@@ -26,6 +26,7 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <Eigen/Geometry>
+#include <atomic>
 #include <memory>
 #include <typeindex>
 #include <console_bridge/console.h>
@@ -38,8 +39,11 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_command_language/poly/state_waypoint_poly.h>
 #include <tesseract_command_language/poly/joint_waypoint_poly.h>
 #include <tesseract_command_language/poly/cartesian_waypoint_poly.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
 #include <tesseract_command_language/utils.h>
 #include <tesseract_motion_planners/core/utils.h>
+#include <tesseract_motion_planners/core/lvs_substep_iterator.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
 
 namespace tesseract_planning
 {
@@ -247,151 +251,130 @@ bool formatProgram(CompositeInstruction& composite_instructions, const tesseract
   return format_required;
 }
 
-bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
-                         tesseract_collision::ContinuousContactManager& manager,
-                         const tesseract_scene_graph::StateSolver& state_solver,
-                         const CompositeInstruction& program,
-                         const tesseract_collision::CollisionCheckConfig& config)
+namespace
 {
-  if (config.type != tesseract_collision::CollisionEvaluatorType::CONTINUOUS &&
-      config.type != tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
-    throw std::runtime_error("contactCheckProgram was given an CollisionEvaluatorType that is inconsistent with the "
-                             "ContactManager type (Continuous)");
-  manager.applyContactManagerConfig(config.contact_manager_config);
+/** @brief Check if the contact check should stop early */
+inline bool isCancelled(const std::atomic<bool>* cancel) { return (cancel != nullptr) && cancel->load(); }
 
-  // Flatten results
-  std::vector<std::reference_wrapper<const InstructionPoly>> mi = program.flatten(moveFilter);
-
-  bool found = false;
-
-  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+/**
+ * @brief The joint states of a program which may contain move instructions and joint trajectory blocks
+ * @details Each point of a joint trajectory block is a state, so the steps of the trajectory do not depend on how it
+ * is stored. The states reference the program which must outlive this object.
+ */
+class ProgramStates
+{
+public:
+  explicit ProgramStates(const CompositeInstruction& program)
   {
-    assert(config.longest_valid_segment_length > 0);
-
-    contacts.resize(mi.size() - 1);
-    for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
+    for (const auto& instruction : program.flatten(moveOrJointTrajectoryBlockFilter))
     {
-      tesseract_collision::ContactResultMap& segment_results = contacts[static_cast<size_t>(iStep)];
-      segment_results.clear();
-
-      const auto& swp0 = mi.at(iStep).get().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>();
-      const auto& swp1 = mi.at(iStep + 1).get().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>();
-
-      // TODO: Should check joint names and make sure they are in the same order
-      double dist = (swp1.getPosition() - swp0.getPosition()).norm();
-      if (dist > config.longest_valid_segment_length)
+      if (instruction.get().isJointTrajectoryBlock())
       {
-        auto cnt = static_cast<long>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
-        tesseract_common::TrajArray subtraj(cnt, swp0.getPosition().size());
-        for (long iVar = 0; iVar < swp0.getPosition().size(); ++iVar)
-          subtraj.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, swp0.getPosition()(iVar), swp1.getPosition()(iVar));
-
-        for (int iSubStep = 0; iSubStep < subtraj.rows() - 1; ++iSubStep)
-        {
-          tesseract_scene_graph::SceneState state0 = state_solver.getState(swp0.getNames(), subtraj.row(iSubStep));
-          tesseract_scene_graph::SceneState state1 = state_solver.getState(swp0.getNames(), subtraj.row(iSubStep + 1));
-          tesseract_collision::ContactResultMap sub_segment_results = tesseract_environment::checkTrajectorySegment(
-              manager, state0.link_transforms, state1.link_transforms, config.contact_request);
-          if (!sub_segment_results.empty())
-          {
-            found = true;
-            tesseract_environment::processInterpolatedSubSegmentCollisionResults(segment_results,
-                                                                                 sub_segment_results,
-                                                                                 iSubStep,
-                                                                                 static_cast<int>(subtraj.rows() - 1),
-                                                                                 manager.getActiveCollisionObjects(),
-                                                                                 false);
-
-            if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-            {
-              std::stringstream ss;
-              ss << "Continuous collision detected at step: " << iStep << " of " << (mi.size() - 1)
-                 << " substep: " << iSubStep << std::endl;
-
-              ss << "     Names:";
-              for (const auto& name : swp0.getNames())
-                ss << " " << name;
-
-              ss << std::endl
-                 << "    State0: " << subtraj.row(iSubStep) << std::endl
-                 << "    State1: " << subtraj.row(iSubStep + 1) << std::endl;
-
-              CONSOLE_BRIDGE_logError(ss.str().c_str());
-            }
-          }
-
-          if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-            break;
-        }
-
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
+        const auto& block = instruction.get().as<JointTrajectoryBlock>();
+        for (Eigen::Index i = 0; i < block.size(); ++i)
+          states_.push_back({ &block.getJointNames(), block.getPosition().col(i).data(), block.dof() });
       }
       else
       {
-        tesseract_collision::ContactResultMap& segment_results = contacts[static_cast<size_t>(iStep)];
-        segment_results.clear();
-
-        const auto& swp0 = mi.at(iStep).get().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>();
-        const auto& swp1 = mi.at(iStep + 1).get().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>();
-        tesseract_scene_graph::SceneState state0 = state_solver.getState(swp0.getNames(), swp0.getPosition());
-        tesseract_scene_graph::SceneState state1 = state_solver.getState(swp1.getNames(), swp1.getPosition());
-        segment_results = tesseract_environment::checkTrajectorySegment(
-            manager, state0.link_transforms, state1.link_transforms, config);
-        if (!segment_results.empty())
-        {
-          found = true;
-          if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-          {
-            std::stringstream ss;
-            ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
-
-            ss << "     Names:";
-            for (const auto& name : swp0.getNames())
-              ss << " " << name;
-
-            ss << std::endl
-               << "    State0: " << swp0.getPosition() << std::endl
-               << "    State1: " << swp1.getPosition() << std::endl;
-
-            CONSOLE_BRIDGE_logError(ss.str().c_str());
-          }
-        }
-
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
+        const auto& wp = instruction.get().as<MoveInstructionPoly>().getWaypoint();
+        const Eigen::VectorXd& position = getJointPosition(wp);
+        states_.push_back({ &tesseract_planning::getJointNames(wp), position.data(), position.size() });
       }
     }
   }
-  else
+
+  std::size_t size() const { return states_.size(); }
+
+  const std::vector<std::string>& getJointNames(std::size_t i) const { return *states_.at(i).joint_names; }
+
+  Eigen::Map<const Eigen::VectorXd> getPosition(std::size_t i) const
+  {
+    const State& state = states_.at(i);
+    return { state.position, state.dof };
+  }
+
+private:
+  struct State
+  {
+    const std::vector<std::string>* joint_names;
+    const double* position;
+    Eigen::Index dof;
+  };
+
+  std::vector<State> states_;
+};
+
+/**
+ * @brief Perform a continuous collision check of a single step of the trajectory
+ * @param segment_results The contact results for the step
+ * @param manager A continuous contact manager
+ * @param state_solver The environment state solver
+ * @param states The joint states of the program
+ * @param iStep The step of the trajectory to check which is the segment from states[iStep] to states[iStep + 1]
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param substeps The iterator used to interpolate the LVS substeps, reused between steps to avoid allocations
+ * @param cancel Optional flag which stops checking the remaining substeps when set
+ * @return True if collision was found, otherwise false.
+ */
+bool contactCheckStep(tesseract_collision::ContactResultMap& segment_results,
+                      tesseract_collision::ContinuousContactManager& manager,
+                      const tesseract_scene_graph::StateSolver& state_solver,
+                      const ProgramStates& states,
+                      std::size_t iStep,
+                      const tesseract_collision::CollisionCheckConfig& config,
+                      LVSSubstepIterator& substeps,
+                      const std::atomic<bool>* cancel)
+{
+  segment_results.clear();
+
+  bool found = false;
+  const std::vector<std::string>& jn = states.getJointNames(iStep);
+  const Eigen::Map<const Eigen::VectorXd> p0 = states.getPosition(iStep);
+  const Eigen::Map<const Eigen::VectorXd> p1 = states.getPosition(iStep + 1);
+
+  // TODO: Should check joint names and make sure they are in the same order
+  double dist = -1;
+  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+  {
+    substeps.reset(p0, p1, config.longest_valid_segment_length);
+    dist = substeps.distance();
+  }
+
+  if (dist > config.longest_valid_segment_length)
   {
-    contacts.resize(mi.size() - 1);
-    for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
+    const auto num_substeps = static_cast<int>(substeps.size() - 1);
+
+    // The end state of each substep is the start state of the next so each state is only computed once
+    tesseract_scene_graph::SceneState state0 = state_solver.getState(jn, substeps.state());
+    tesseract_scene_graph::SceneState state1;
+    for (int iSubStep = 0; substeps.next(); ++iSubStep)
     {
-      tesseract_collision::ContactResultMap& segment_results = contacts[static_cast<size_t>(iStep)];
-      segment_results.clear();
-
-      const auto& swp0 = mi.at(iStep).get().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>();
-      const auto& swp1 = mi.at(iStep + 1).get().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>();
-      tesseract_scene_graph::SceneState state0 = state_solver.getState(swp0.getNames(), swp0.getPosition());
-      tesseract_scene_graph::SceneState state1 = state_solver.getState(swp1.getNames(), swp1.getPosition());
-      segment_results = tesseract_environment::checkTrajectorySegment(
-          manager, state0.link_transforms, state1.link_transforms, config);
-      if (!segment_results.empty())
+      state1 = state_solver.getState(jn, substeps.state());
+      tesseract_collision::ContactResultMap sub_segment_results = tesseract_environment::checkTrajectorySegment(
+          manager, state0.link_transforms, state1.link_transforms, config.contact_request);
+      if (!sub_segment_results.empty())
       {
         found = true;
+        tesseract_environment::processInterpolatedSubSegmentCollisionResults(segment_results,
+                                                                             sub_segment_results,
+                                                                             iSubStep,
+                                                                             num_substeps,
+                                                                             manager.getActiveCollisionObjects(),
+                                                                             false);
+
         if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
         {
           std::stringstream ss;
-          ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
+          ss << "Continuous collision detected at step: " << iStep << " of " << (states.size() - 1)
+             << " substep: " << iSubStep << std::endl;
 
           ss << "     Names:";
-          for (const auto& name : swp0.getNames())
+          for (const auto& name : jn)
             ss << " " << name;
 
           ss << std::endl
-             << "    State0: " << swp0.getPosition() << std::endl
-             << "    State1: " << swp1.getPosition() << std::endl;
+             << "    State0: " << substeps.interpolate(iSubStep).transpose() << std::endl
+             << "    State1: " << substeps.state().transpose() << std::endl;
 
           CONSOLE_BRIDGE_logError(ss.str().c_str());
         }
@@ -399,156 +382,110 @@ bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& con
 
       if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
         break;
-    }
-  }
-  return found;
-}
 
-bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
-                         tesseract_collision::DiscreteContactManager& manager,
-                         const tesseract_scene_graph::StateSolver& state_solver,
-                         const CompositeInstruction& program,
-                         const tesseract_collision::CollisionCheckConfig& config)
-{
-  if (config.type != tesseract_collision::CollisionEvaluatorType::DISCRETE &&
-      config.type != tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
-    throw std::runtime_error("contactCheckProgram was given an CollisionEvaluatorType that is inconsistent with the "
-                             "ContactManager type (Discrete)");
-
-  manager.applyContactManagerConfig(config.contact_manager_config);
-  bool found = false;
-
-  // Flatten results
-  std::vector<std::reference_wrapper<const InstructionPoly>> mi = program.flatten(moveFilter);
+      if (isCancelled(cancel))
+        break;
 
-  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
+      std::swap(state0, state1);
+    }
+  }
+  else
   {
-    assert(config.longest_valid_segment_length > 0);
-
-    contacts.resize(mi.size());
-    for (std::size_t iStep = 0; iStep < mi.size(); ++iStep)
+    tesseract_scene_graph::SceneState state0 = state_solver.getState(jn, p0);
+    tesseract_scene_graph::SceneState state1 = state_solver.getState(states.getJointNames(iStep + 1), p1);
+    segment_results = tesseract_environment::checkTrajectorySegment(
+        manager, state0.link_transforms, state1.link_transforms, config);
+    if (!segment_results.empty())
     {
-      tesseract_collision::ContactResultMap& segment_results = contacts[static_cast<size_t>(iStep)];
-      segment_results.clear();
-
-      const auto& wp0 = mi.at(iStep).get().as<MoveInstructionPoly>().getWaypoint();
-      const std::vector<std::string>& jn = getJointNames(wp0);
-      const Eigen::VectorXd& p0 = getJointPosition(wp0);
-      const Eigen::VectorXd* p1{ nullptr };
-
-      double dist = -1;
-      if (iStep < mi.size() - 1)
-      {
-        const auto& wp1 = mi.at(iStep + 1).get().as<MoveInstructionPoly>().getWaypoint();
-        p1 = &(getJointPosition(wp1));
-        dist = (*p1 - p0).norm();
-      }
-
-      if (dist > 0 && dist > config.longest_valid_segment_length)
+      found = true;
+      if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
       {
-        auto cnt = static_cast<int>(std::ceil(dist / config.longest_valid_segment_length)) + 1;
-        tesseract_common::TrajArray subtraj(cnt, p0.size());
-        for (long iVar = 0; iVar < p0.size(); ++iVar)
-          subtraj.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, p0(iVar), (*p1)(iVar));
+        std::stringstream ss;
+        ss << "Discrete collision detected at step: " << iStep << " of " << (states.size() - 1) << std::endl;
 
-        for (int iSubStep = 0; iSubStep < subtraj.rows() - 1; ++iSubStep)
-        {
-          tesseract_scene_graph::SceneState state = state_solver.getState(jn, subtraj.row(iSubStep));
-          tesseract_collision::ContactResultMap sub_segment_results =
-              tesseract_environment::checkTrajectoryState(manager, state.link_transforms, config);
-          if (!sub_segment_results.empty())
-          {
-            found = true;
-            tesseract_environment::processInterpolatedSubSegmentCollisionResults(segment_results,
-                                                                                 sub_segment_results,
-                                                                                 iSubStep,
-                                                                                 static_cast<int>(subtraj.rows() - 1),
-                                                                                 manager.getActiveCollisionObjects(),
-                                                                                 true);
-
-            if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-            {
-              std::stringstream ss;
-              ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1)
-                 << " substate: " << iSubStep << std::endl;
-
-              ss << "     Names:";
-              for (const auto& name : jn)
-                ss << " " << name;
-
-              ss << std::endl << "    State: " << subtraj.row(iSubStep) << std::endl;
-
-              CONSOLE_BRIDGE_logError(ss.str().c_str());
-            }
-          }
-
-          if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-            break;
-        }
+        ss << "     Names:";
+        for (const auto& name : jn)
+          ss << " " << name;
 
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
-      }
-      else
-      {
-        tesseract_scene_graph::SceneState state = state_solver.getState(jn, p0);
-        tesseract_collision::ContactResultMap sub_segment_results =
-            tesseract_environment::checkTrajectoryState(manager, state.link_transforms, config.contact_request);
-        if (!sub_segment_results.empty())
-        {
-          found = true;
-          tesseract_environment::processInterpolatedSubSegmentCollisionResults(
-              segment_results, sub_segment_results, 0, 0, manager.getActiveCollisionObjects(), true);
-          if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
-          {
-            std::stringstream ss;
-            ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
-
-            ss << "     Names:";
-            for (const auto& name : jn)
-              ss << " " << name;
-
-            ss << std::endl << "    State: " << p0 << std::endl;
-
-            CONSOLE_BRIDGE_logError(ss.str().c_str());
-          }
-        }
+        ss << std::endl
+           << "    State0: " << p0 << std::endl
+           << "    State1: " << p1 << std::endl;
 
-        if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
-          break;
+        CONSOLE_BRIDGE_logError(ss.str().c_str());
       }
     }
   }
-  else
+
+  return found;
+}
+
+/**
+ * @brief Perform a discrete collision check of a single step of the trajectory
+ * @param segment_results The contact results for the step
+ * @param manager A discrete contact manager
+ * @param state_solver The environment state solver
+ * @param states The joint states of the program
+ * @param iStep The step of the trajectory to check which is the state states[iStep] and, if LVS, the states
+ * interpolated to states[iStep + 1]
+ * @param config CollisionCheckConfig used to specify collision check settings
+ * @param substeps The iterator used to interpolate the LVS substeps, reused between steps to avoid allocations
+ * @param cancel Optional flag which stops checking the remaining substeps when set
+ * @return True if collision was found, otherwise false.
+ */
+bool contactCheckStep(tesseract_collision::ContactResultMap& segment_results,
+                      tesseract_collision::DiscreteContactManager& manager,
+                      const tesseract_scene_graph::StateSolver& state_solver,
+                      const ProgramStates& states,
+                      std::size_t iStep,
+                      const tesseract_collision::CollisionCheckConfig& config,
+                      LVSSubstepIterator& substeps,
+                      const std::atomic<bool>* cancel)
+{
+  segment_results.clear();
+
+  bool found = false;
+  const std::vector<std::string>& jn = states.getJointNames(iStep);
+  const Eigen::Map<const Eigen::VectorXd> p0 = states.getPosition(iStep);
+
+  double dist = -1;
+  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE && iStep < states.size() - 1)
   {
-    contacts.resize(mi.size());
-    for (std::size_t iStep = 0; iStep < mi.size() - 1; ++iStep)
-    {
-      tesseract_collision::ContactResultMap& segment_results = contacts[static_cast<size_t>(iStep)];
-      segment_results.clear();
+    substeps.reset(p0, states.getPosition(iStep + 1), config.longest_valid_segment_length);
+    dist = substeps.distance();
+  }
 
-      const auto& wp0 = mi.at(iStep).get().as<MoveInstructionPoly>().getWaypoint();
-      const std::vector<std::string>& jn = getJointNames(wp0);
-      const Eigen::VectorXd& p0 = getJointPosition(wp0);
+  if (dist > 0 && dist > config.longest_valid_segment_length)
+  {
+    const auto num_substeps = static_cast<int>(substeps.size() - 1);
 
-      tesseract_scene_graph::SceneState state = state_solver.getState(jn, p0);
+    // The end state is not checked since it is the first state of the next step
+    int iSubStep = 0;
+    do
+    {
+      tesseract_scene_graph::SceneState state = state_solver.getState(jn, substeps.state());
       tesseract_collision::ContactResultMap sub_segment_results =
-          tesseract_environment::checkTrajectoryState(manager, state.link_transforms, config.contact_request);
+          tesseract_environment::checkTrajectoryState(manager, state.link_transforms, config);
       if (!sub_segment_results.empty())
       {
         found = true;
-        tesseract_environment::processInterpolatedSubSegmentCollisionResults(
-            segment_results, sub_segment_results, 0, 0, manager.getActiveCollisionObjects(), true);
+        tesseract_environment::processInterpolatedSubSegmentCollisionResults(segment_results,
+                                                                             sub_segment_results,
+                                                                             iSubStep,
+                                                                             num_substeps,
+                                                                             manager.getActiveCollisionObjects(),
+                                                                             true);
+
         if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
         {
           std::stringstream ss;
-          ss << "Discrete collision detected at step: " << iStep << " of " << (mi.size() - 1) << std::endl;
+          ss << "Discrete collision detected at step: " << iStep << " of " << (states.size() - 1)
+             << " substate: " << iSubStep << std::endl;
 
           ss << "     Names:";
           for (const auto& name : jn)
             ss << " " << name;
 
-          ss << std::endl << "    State0: " << p0 << std::endl;
+          ss << std::endl << "    State: " << substeps.state().transpose() << std::endl;
 
           CONSOLE_BRIDGE_logError(ss.str().c_str());
         }
@@ -556,9 +493,209 @@ bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& con
 
       if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
         break;
+
+      if (isCancelled(cancel))
+        break;
+
+      ++iSubStep;
+    } while (iSubStep < num_substeps && substeps.next());
+  }
+  else
+  {
+    tesseract_scene_graph::SceneState state = state_solver.getState(jn, p0);
+    tesseract_collision::ContactResultMap sub_segment_results =
+        tesseract_environment::checkTrajectoryState(manager, state.link_transforms, config.contact_request);
+    if (!sub_segment_results.empty())
+    {
+      found = true;
+      tesseract_environment::processInterpolatedSubSegmentCollisionResults(
+          segment_results, sub_segment_results, 0, 0, manager.getActiveCollisionObjects(), true);
+      if (console_bridge::getLogLevel() > console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_INFO)
+      {
+        std::stringstream ss;
+        ss << "Discrete collision detected at step: " << iStep << " of " << (states.size() - 1) << std::endl;
+
+        ss << "     Names:";
+        for (const auto& name : jn)
+          ss << " " << name;
+
+        ss << std::endl << "    State: " << p0 << std::endl;
+
+        CONSOLE_BRIDGE_logError(ss.str().c_str());
+      }
     }
   }
+
   return found;
 }
 
+/**
+ * @brief Check the steps of the trajectory in order on the calling thread
+ * @return True if collision was found, otherwise false.
+ */
+template <typename ContactManagerType>
+bool contactCheckSteps(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                       ContactManagerType& manager,
+                       const tesseract_scene_graph::StateSolver& state_solver,
+                       const ProgramStates& states,
+                       std::size_t num_steps,
+                       const tesseract_collision::CollisionCheckConfig& config)
+{
+  bool found = false;
+  LVSSubstepIterator substeps;
+  for (std::size_t iStep = 0; iStep < num_steps; ++iStep)
+  {
+    if (contactCheckStep(contacts[iStep], manager, state_solver, states, iStep, config, substeps, nullptr))
+      found = true;
+
+    if (found && (config.contact_request.type == tesseract_collision::ContactTestType::FIRST))
+      break;
+  }
+  return found;
+}
+
+/**
+ * @brief Check the steps of the trajectory distributed across multiple threads
+ * @details Each thread takes the next unchecked step and uses its own clone of the contact manager and state solver.
+ * If the contact test type is FIRST, a shared flag stops all threads once a collision is found.
+ * @return True if collision was found, otherwise false.
+ */
+template <typename ContactManagerType>
+bool contactCheckStepsParallel(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                               const ContactManagerType& manager,
+                               const tesseract_scene_graph::StateSolver& state_solver,
+                               const ProgramStates& states,
+                               std::size_t num_steps,
+                               const tesseract_collision::CollisionCheckConfig& config,
+                               std::size_t num_threads)
+{
+  num_threads = getParallelForWorkers(num_steps, num_threads);
+
+  std::vector<typename ContactManagerType::UPtr> managers;
+  std::vector<tesseract_scene_graph::StateSolver::UPtr> state_solvers;
+  std::vector<LVSSubstepIterator> substeps(num_threads);
+  managers.reserve(num_threads);
+  state_solvers.reserve(num_threads);
+  for (std::size_t i = 0; i < num_threads; ++i)
+  {
+    managers.push_back(manager.clone());
+    managers.back()->applyContactManagerConfig(config.contact_manager_config);
+    state_solvers.push_back(state_solver.clone());
+  }
+
+  // Stops the substeps of the steps in progress once a collision is found and only the first one is requested
+  std::atomic<bool> cancel{ false };
+  std::atomic<bool> found{ false };
+  parallelFor(num_steps, num_threads, [&](std::size_t iStep, std::size_t worker) {
+    const tesseract_scene_graph::StateSolver& worker_state_solver = *state_solvers[worker];
+    if (!contactCheckStep(
+            contacts[iStep], *managers[worker], worker_state_solver, states, iStep, config, substeps[worker], &cancel))
+      return true;
+
+    found = true;
+    if (config.contact_request.type == tesseract_collision::ContactTestType::FIRST)
+      cancel = true;
+
+    return !cancel;
+  });
+
+  return found;
+}
+
+/** @brief Get the number of steps checked and the number of contact results for a continuous collision check */
+std::pair<std::size_t, std::size_t> getContinuousSteps(const ProgramStates& states,
+                                                       const tesseract_collision::CollisionCheckConfig& config)
+{
+  if (config.type != tesseract_collision::CollisionEvaluatorType::CONTINUOUS &&
+      config.type != tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+    throw std::runtime_error("contactCheckProgram was given an CollisionEvaluatorType that is inconsistent with the "
+                             "ContactManager type (Continuous)");
+
+  assert(config.type != tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS ||
+         config.longest_valid_segment_length > 0);
+
+  return { states.size() - 1, states.size() - 1 };
+}
+
+/** @brief Get the number of steps checked and the number of contact results for a discrete collision check */
+std::pair<std::size_t, std::size_t> getDiscreteSteps(const ProgramStates& states,
+                                                     const tesseract_collision::CollisionCheckConfig& config)
+{
+  if (config.type != tesseract_collision::CollisionEvaluatorType::DISCRETE &&
+      config.type != tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
+    throw std::runtime_error("contactCheckProgram was given an CollisionEvaluatorType that is inconsistent with the "
+                             "ContactManager type (Discrete)");
+
+  if (config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
+  {
+    assert(config.longest_valid_segment_length > 0);
+    return { states.size(), states.size() };
+  }
+
+  return { states.size() - 1, states.size() };
+}
+}  // namespace
+
+bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                         tesseract_collision::ContinuousContactManager& manager,
+                         const tesseract_scene_graph::StateSolver& state_solver,
+                         const CompositeInstruction& program,
+                         const tesseract_collision::CollisionCheckConfig& config)
+{
+  // Flatten results
+  const ProgramStates states(program);
+  auto [num_steps, num_results] = getContinuousSteps(states, config);
+
+  manager.applyContactManagerConfig(config.contact_manager_config);
+  contacts.resize(num_results);
+  return contactCheckSteps(contacts, manager, state_solver, states, num_steps, config);
+}
+
+bool contactCheckProgram(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                         tesseract_collision::DiscreteContactManager& manager,
+                         const tesseract_scene_graph::StateSolver& state_solver,
+                         const CompositeInstruction& program,
+                         const tesseract_collision::CollisionCheckConfig& config)
+{
+  // Flatten results
+  const ProgramStates states(program);
+  auto [num_steps, num_results] = getDiscreteSteps(states, config);
+
+  manager.applyContactManagerConfig(config.contact_manager_config);
+  contacts.resize(num_results);
+  return contactCheckSteps(contacts, manager, state_solver, states, num_steps, config);
+}
+
+bool contactCheckProgramParallel(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                                 const tesseract_collision::ContinuousContactManager& manager,
+                                 const tesseract_scene_graph::StateSolver& state_solver,
+                                 const CompositeInstruction& program,
+                                 const tesseract_collision::CollisionCheckConfig& config,
+                                 std::size_t num_threads)
+{
+  // Flatten results
+  const ProgramStates states(program);
+  auto [num_steps, num_results] = getContinuousSteps(states, config);
+
+  contacts.clear();
+  contacts.resize(num_results);
+  return contactCheckStepsParallel(contacts, manager, state_solver, states, num_steps, config, num_threads);
+}
+
+bool contactCheckProgramParallel(std::vector<tesseract_collision::ContactResultMap>& contacts,
+                                 const tesseract_collision::DiscreteContactManager& manager,
+                                 const tesseract_scene_graph::StateSolver& state_solver,
+                                 const CompositeInstruction& program,
+                                 const tesseract_collision::CollisionCheckConfig& config,
+                                 std::size_t num_threads)
+{
+  // Flatten results
+  const ProgramStates states(program);
+  auto [num_steps, num_results] = getDiscreteSteps(states, config);
+
+  contacts.clear();
+  contacts.resize(num_results);
+  return contactCheckStepsParallel(contacts, manager, state_solver, states, num_steps, config, num_threads);
+}
+
 }  // namespace tesseract_planning
@@ -48,11 +48,11 @@ SimplePlannerLVSPlanProfile::generate(const MoveInstructionPoly& prev_instructio
                                       const MoveInstructionPoly& /*prev_seed*/,
                                       const MoveInstructionPoly& base_instruction,
                                       const InstructionPoly& /*next_instruction*/,
-                                      const PlannerRequest& request,
+                                      const PlannerRequestContext& context,
                                       const tesseract_common::ManipulatorInfo& global_manip_info) const
 {
-  KinematicGroupInstructionInfo info1(prev_instruction, request, global_manip_info);
-  KinematicGroupInstructionInfo info2(base_instruction, request, global_manip_info);
+  KinematicGroupInstructionInfo info1(prev_instruction, context, global_manip_info);
+  KinematicGroupInstructionInfo info2(base_instruction, context, global_manip_info);
 
   if (!info1.has_cartesian_waypoint && !info2.has_cartesian_waypoint)
     return interpolateJointJointWaypoint(info1,
@@ -88,7 +88,7 @@ SimplePlannerLVSPlanProfile::generate(const MoveInstructionPoly& prev_instructio
                                      rotation_longest_valid_segment_length,
                                      min_steps,
                                      max_steps,
-                                     request.env_state);
+                                     context.getRequest().env_state);
 }
 
 }  // namespace tesseract_planning
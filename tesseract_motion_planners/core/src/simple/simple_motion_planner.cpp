@@ -71,8 +71,11 @@ PlannerResponse SimpleMotionPlanner::solve(const PlannerRequest& request) const
   const std::string manipulator = request.instructions.getManipulatorInfo().manipulator;
   const std::string manipulator_ik_solver = request.instructions.getManipulatorInfo().manipulator_ik_solver;
 
+  // The kinematics and TCP offsets are resolved once and shared by every instruction of the request
+  PlannerRequestContext context(request);
+
   // Initialize
-  tesseract_kinematics::JointGroup::UPtr manip = request.env->getJointGroup(manipulator);
+  tesseract_kinematics::JointGroup::ConstPtr manip = context.getJointGroup(manipulator);
 
   // Create seed
   CompositeInstruction seed;
@@ -86,7 +89,7 @@ PlannerResponse SimpleMotionPlanner::solve(const PlannerRequest& request) const
     MoveInstructionPoly start_instruction_copy = null_instruction;
     MoveInstructionPoly start_instruction_seed_copy = null_instruction;
     seed =
-        processCompositeInstruction(request.instructions, start_instruction_copy, start_instruction_seed_copy, request);
+        processCompositeInstruction(request.instructions, start_instruction_copy, start_instruction_seed_copy, context);
   }
   catch (std::exception& e)
   {
@@ -131,8 +134,9 @@ PlannerResponse SimpleMotionPlanner::solve(const PlannerRequest& request) const
 CompositeInstruction SimpleMotionPlanner::processCompositeInstruction(const CompositeInstruction& instructions,
                                                                       MoveInstructionPoly& prev_instruction,
                                                                       MoveInstructionPoly& prev_seed,
-                                                                      const PlannerRequest& request) const
+                                                                      const PlannerRequestContext& context) const
 {
+  const PlannerRequest& request = context.getRequest();
   CompositeInstruction seed(instructions);
   seed.clear();
 
@@ -143,7 +147,7 @@ CompositeInstruction SimpleMotionPlanner::processCompositeInstruction(const Comp
     if (instruction.isCompositeInstruction())
     {
       seed.push_back(
-          processCompositeInstruction(instruction.as<CompositeInstruction>(), prev_instruction, prev_seed, request));
+          processCompositeInstruction(instruction.as<CompositeInstruction>(), prev_instruction, prev_seed, context));
     }
     else if (instruction.isMoveInstruction())
     {
@@ -152,7 +156,7 @@ CompositeInstruction SimpleMotionPlanner::processCompositeInstruction(const Comp
       {
         const std::string manipulator = request.instructions.getManipulatorInfo().manipulator;
         const std::string manipulator_ik_solver = request.instructions.getManipulatorInfo().manipulator_ik_solver;
-        tesseract_kinematics::JointGroup::UPtr manip = request.env->getJointGroup(manipulator);
+        tesseract_kinematics::JointGroup::ConstPtr manip = context.getJointGroup(manipulator);
 
         prev_instruction = base_instruction;
         auto& start_waypoint = prev_instruction.getWaypoint();
@@ -212,7 +216,7 @@ CompositeInstruction SimpleMotionPlanner::processCompositeInstruction(const Comp
                                  prev_seed,
                                  base_instruction,
                                  next_instruction,
-                                 request,
+                                 context,
                                  request.instructions.getManipulatorInfo());
 
       // The data for the last instruction should be unchanged with exception to seed or tolerance joint state
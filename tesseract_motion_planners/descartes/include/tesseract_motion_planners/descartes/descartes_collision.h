@@ -34,6 +34,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <tesseract_collision/core/types.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
+
 namespace tesseract_planning
 {
 class DescartesCollision
@@ -59,7 +61,7 @@ public:
   virtual ~DescartesCollision() = default;
 
   /**
-   * @brief Copy constructor that clones the object
+   * @brief Copy constructor that shares the contact manager pool, each thread checks with its own contact manager
    * @param collision_interface Object to copy/clone
    */
   DescartesCollision(const DescartesCollision& collision_interface);
@@ -82,7 +84,7 @@ public:
   double distance(const Eigen::Ref<const Eigen::VectorXd>& pos);
 
   /**
-   * @brief This should clone the object and make new instance of objects that are not safe to share across threads
+   * @brief Clone the object, the clone shares the contact manager pool so it is safe to use from any thread
    * @return Descartes collision interface
    */
   DescartesCollision::Ptr clone() const;
@@ -96,9 +98,9 @@ private:
    */
   bool isContactAllowed(const std::string& a, const std::string& b) const;
 
-  tesseract_kinematics::JointGroup::ConstPtr manip_;                 /**< @brief The tesseract state solver */
-  std::vector<std::string> active_link_names_;                       /**< @brief A vector of active link names */
-  tesseract_collision::DiscreteContactManager::Ptr contact_manager_; /**< @brief The discrete contact manager */
+  tesseract_kinematics::JointGroup::ConstPtr manip_; /**< @brief The tesseract state solver */
+  std::vector<std::string> active_link_names_;       /**< @brief A vector of active link names */
+  DiscreteContactManagerPool::Ptr contact_managers_; /**< @brief The discrete contact manager for each thread */
   tesseract_collision::CollisionCheckConfig collision_check_config_;
   bool debug_; /**< @brief Enable debug information to be printed to the terminal */
 };
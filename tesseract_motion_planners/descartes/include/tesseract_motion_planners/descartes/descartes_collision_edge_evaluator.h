@@ -37,70 +37,119 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <tesseract_collision/core/types.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
+
 namespace tesseract_planning
 {
 template <typename FloatType>
 class DescartesCollisionEdgeEvaluator : public descartes_light::EdgeEvaluator<FloatType>
 {
 public:
+  /**
+   * @brief Constructor
+   * @param num_threads The number of threads expected to evaluate edges, used to clone contact managers up front
+   */
   DescartesCollisionEdgeEvaluator(const tesseract_environment::Environment& collision_env,
                                   tesseract_kinematics::JointGroup::ConstPtr manip,
                                   tesseract_collision::CollisionCheckConfig config,
                                   bool allow_collision = false,
-                                  bool debug = false);
+                                  bool debug = false,
+                                  std::size_t num_threads = 1);
 
+  /**
+   * @brief Check the edge for collision
+   * @details The scratch data and contact manager of the calling thread are reused, and only the transforms of the
+   * active links are updated.
+   * @return True and zero if not in collision. If in collision and collisions are allowed it returns true and a cost
+   * increasing with the penetration, otherwise false.
+   */
   std::pair<bool, FloatType> evaluate(const descartes_light::State<FloatType>& start,
                                       const descartes_light::State<FloatType>& end) const override;
 
 protected:
+  /**
+   * @brief The data a thread reuses for every edge it evaluates
+   * @details The ContactManagerPool only requires clone(), so the scratch data is pooled together with the contact
+   * manager and found by the same thread local lookup. Only the contact manager of the configured evaluator type is
+   * set, the other is nullptr.
+   */
+  struct Workspace
+  {
+    using UPtr = std::unique_ptr<Workspace>;
+
+    Workspace(std::shared_ptr<tesseract_collision::DiscreteContactManager> discrete_contact_manager,
+              std::shared_ptr<tesseract_collision::ContinuousContactManager> continuous_contact_manager);
+
+    /** @brief Clone the contact manager and allocate new scratch data */
+    UPtr clone() const;
+
+    std::shared_ptr<tesseract_collision::DiscreteContactManager> discrete_contact_manager;
+    std::shared_ptr<tesseract_collision::ContinuousContactManager> continuous_contact_manager;
+
+    /** @brief The joint values of the start and end of the edge */
+    Eigen::VectorXd start_values;
+    Eigen::VectorXd end_values;
+
+    /** @brief The joint values of the current interpolated state */
+    Eigen::VectorXd state_values;
+
+    /** @brief The link transforms at the start of the current sub-segment */
+    tesseract_common::TransformMap start_transforms;
+
+    /** @brief The link transforms at the end of the current sub-segment */
+    tesseract_common::TransformMap end_transforms;
+
+    tesseract_collision::ContactResultMap contact_map;
+  };
+
   /** @brief The tesseract state solver */
   tesseract_kinematics::JointGroup::ConstPtr manip_;
   /** @brief A vector of active link names */
   std::vector<std::string> active_link_names_;
-  /** @brief The discrete contact manager */
-  tesseract_collision::DiscreteContactManager::Ptr discrete_contact_manager_;
-  /** @brief The discrete contact manager */
-  tesseract_collision::ContinuousContactManager::Ptr continuous_contact_manager_;
+  /** @brief The workspace for each thread */
+  std::unique_ptr<ContactManagerPool<Workspace>> workspaces_;
   /** @brief The minimum allowed collision distance */
   tesseract_collision::CollisionCheckConfig collision_check_config_;
+  /** @brief The contact request, only the first contact is requested unless collisions are allowed */
+  tesseract_collision::ContactRequest contact_request_;
   /** @brief If true and no valid edges are found it will return the one with the lowest cost */
   bool allow_collision_;
   /** @brief Enable debug information to be printed to the terminal */
   bool debug_;
 
-  // The member variables below are to cache the contact manager based on thread ID. Currently descartes is multi
-  // threaded but the methods used to implement collision checking are not thread safe. To prevent
-  // reconstructing the collision environment for every check this will cache a contact manager
-  // based on its thread ID.
-
-  /** @brief Contact manager caching mutex */
-  mutable std::mutex mutex_;
-
-  /** @brief The continuous contact manager cache */
-  mutable std::map<unsigned long int, tesseract_collision::ContinuousContactManager::Ptr> continuous_contact_managers_;
-
-  /** @brief The discrete contact manager cache */
-  mutable std::map<unsigned long int, tesseract_collision::DiscreteContactManager::Ptr> discrete_contact_managers_;
+  /**
+   * @brief Get the number of sub-segments the edge is checked in
+   * @param workspace The calling thread's workspace holding the start and end joint values
+   * @return The number of sub-segments, at least one
+   */
+  long getSegmentCount(const Workspace& workspace) const;
 
   /**
-   * @brief Perform a continuous collision check between two states
-   * @param segment Trajectory containing two states
-   * @param results Store results from collision check.
+   * @brief Perform a continuous collision check between the start and end joint values of the workspace
+   * @details The link transforms at the end of a sub-segment are reused as the start of the next one, and unless
+   * collisions are allowed the check stops at the first sub-segment in contact.
+   * @param workspace The calling thread's workspace
+   * @param min_distance The minimum contact distance found, unchanged if not in contact
    * @return True if in collision otherwise false
    */
-  bool continuousCollisionCheck(std::vector<tesseract_collision::ContactResultMap>& results,
-                                const tesseract_common::TrajArray& segment,
-                                bool find_best) const;
+  bool continuousCollisionCheck(Workspace& workspace, double& min_distance) const;
 
   /**
-   * @brief Perform a continuous discrete check between two states
-   * @param segment Trajectory containing two states
-   * @param results Store results from collision check.
+   * @brief Perform a discrete collision check of the states between the start and end joint values of the workspace
+   * @details Unless collisions are allowed the check stops at the first state in contact.
+   * @param workspace The calling thread's workspace
+   * @param min_distance The minimum contact distance found, unchanged if not in contact
    * @return True if in collision otherwise false
    */
-  bool discreteCollisionCheck(std::vector<tesseract_collision::ContactResultMap>& results,
-                              const tesseract_common::TrajArray& segment,
-                              bool find_best) const;
+  bool discreteCollisionCheck(Workspace& workspace, double& min_distance) const;
+
+  /**
+   * @brief Check the contact map of the workspace
+   * @param workspace The calling thread's workspace
+   * @param min_distance Updated with the minimum contact distance in the contact map
+   * @return True if the contact map is not empty
+   */
+  bool processContacts(const Workspace& workspace, double& min_distance) const;
 };
 
 using DescartesCollisionEdgeEvaluatorF = DescartesCollisionEdgeEvaluator<float>;
@@ -0,0 +1,156 @@
+/**
+ * @file descartes_ik_cache.h
+ * @brief A cache of inverse kinematics solutions shared by the Descartes samplers
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_DESCARTES_IK_CACHE_H
+#define TESSERACT_MOTION_PLANNERS_DESCARTES_IK_CACHE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_kinematics/core/types.h>
+#include <tesseract_kinematics/core/kinematic_group.h>
+#include <tesseract_environment/environment.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A thread safe cache of inverse kinematics solutions keyed on the exact target pose
+ * @details Raster programs frequently sample the same pose more than once, for example where two segments share an
+ * endpoint or when a program is planned again. Only identical poses hit the cache so the samples are unchanged. The
+ * cache is split into shards, each guarded by its own mutex, so concurrent samplers rarely contend.
+ *
+ * The solutions also depend on the kinematic group, so every pose is stored with a context created by createContext.
+ * Problems using a different inverse kinematics solver, environment revision or position of the joints which carry the
+ * group do not share solutions. The context does not identify the environment itself, so a cache must not be shared
+ * between unrelated environments.
+ */
+class DescartesIKCache
+{
+public:
+  using Ptr = std::shared_ptr<DescartesIKCache>;
+  using ConstPtr = std::shared_ptr<const DescartesIKCache>;
+  using UPtr = std::unique_ptr<DescartesIKCache>;
+  using ConstUPtr = std::unique_ptr<const DescartesIKCache>;
+
+  /**
+   * @brief Constructor
+   * @param max_entries The maximum number of poses stored, a shard is cleared once it holds its share of the maximum
+   */
+  explicit DescartesIKCache(std::size_t max_entries = 100000);
+
+  /**
+   * @brief Find the solutions of a pose
+   * @param context The context of the kinematic group created by createContext
+   * @param working_frame The working frame of the pose
+   * @param tip_link The tip link of the pose
+   * @param pose The target pose of the tip link relative to the working frame
+   * @param solutions The solutions if found
+   * @return True if the pose was found, otherwise false
+   */
+  bool lookup(const std::string& context,
+              const std::string& working_frame,
+              const std::string& tip_link,
+              const Eigen::Isometry3d& pose,
+              tesseract_kinematics::IKSolutions& solutions) const;
+
+  /**
+   * @brief Store the solutions of a pose
+   * @param context The context of the kinematic group created by createContext
+   * @param working_frame The working frame of the pose
+   * @param tip_link The tip link of the pose
+   * @param pose The target pose of the tip link relative to the working frame
+   * @param solutions The solutions, which may be empty
+   */
+  void insert(const std::string& context,
+              const std::string& working_frame,
+              const std::string& tip_link,
+              const Eigen::Isometry3d& pose,
+              const tesseract_kinematics::IKSolutions& solutions);
+
+  /**
+   * @brief Create the context of the solutions of a kinematic group
+   * @details It contains the name of the group, the inverse kinematics solver, the environment revision and the
+   * current position of the active joints which are not part of the group.
+   * @param env The environment the kinematic group was created from
+   * @param manip The kinematic group
+   * @param ik_solver The name of the inverse kinematics solver of the group, empty for the default solver
+   * @return The context
+   */
+  static std::string createContext(const tesseract_environment::Environment& env,
+                                   const tesseract_kinematics::KinematicGroup& manip,
+                                   const std::string& ik_solver);
+
+  /** @brief Remove all solutions and reset the statistics */
+  void clear();
+
+  /** @brief The number of stored poses */
+  std::size_t size() const;
+
+  /** @brief The number of lookups */
+  std::size_t getLookupCount() const;
+
+  /** @brief The number of lookups which found the pose */
+  std::size_t getHitCount() const;
+
+protected:
+  static constexpr std::size_t NUM_SHARDS{ 16 };
+
+  struct Key
+  {
+    std::string frames;
+    std::array<double, 12> pose{};
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex mutex;
+    std::unordered_map<Key, tesseract_kinematics::IKSolutions, KeyHash> entries;
+  };
+
+  std::size_t max_entries_per_shard_;
+  std::array<Shard, NUM_SHARDS> shards_;
+  mutable std::atomic<std::size_t> lookup_count_{ 0 };
+  mutable std::atomic<std::size_t> hit_count_{ 0 };
+
+  static Key createKey(const std::string& context,
+                       const std::string& working_frame,
+                       const std::string& tip_link,
+                       const Eigen::Isometry3d& pose);
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_DESCARTES_IK_CACHE_H
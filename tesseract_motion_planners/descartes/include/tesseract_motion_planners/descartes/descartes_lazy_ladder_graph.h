@@ -0,0 +1,129 @@
+/**
+ * @file descartes_lazy_ladder_graph.h
+ * @brief A ladder graph which defers expensive edge evaluations until they are on a candidate path
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_DESCARTES_LAZY_LADDER_GRAPH_H
+#define TESSERACT_MOTION_PLANNERS_DESCARTES_LAZY_LADDER_GRAPH_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <memory>
+#include <vector>
+#include <Eigen/Core>
+#include <descartes_light/core/edge_evaluator.h>
+#include <descartes_light/core/solver.h>
+#include <descartes_light/core/state_evaluator.h>
+#include <descartes_light/core/waypoint_sampler.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+namespace tesseract_planning
+{
+/**
+ * @brief A ladder graph which defers expensive edge evaluations until the edges are on the cheapest path
+ * @details Every edge is first evaluated with the cheap edge evaluators only. The cheapest path is then searched and
+ * only its edges are evaluated with the lazy edge evaluators, for example collision checking. Invalid edges are
+ * removed, the cost of valid edges is increased by the lazy cost and the graph is searched again, starting at the
+ * first rung affected, until every edge of the cheapest path has been evaluated. Since the lazy costs are expected to
+ * be non-negative the result is the same path the graph would find if every edge was evaluated up front, while only
+ * evaluating a small fraction of the edges.
+ *
+ * The cost of a path is the sum of the sample and state evaluator costs of its vertices and the costs of its edges.
+ */
+template <typename FloatType>
+class DescartesLazyLadderGraph
+{
+public:
+  using Ptr = std::shared_ptr<DescartesLazyLadderGraph<FloatType>>;
+  using ConstPtr = std::shared_ptr<const DescartesLazyLadderGraph<FloatType>>;
+  using UPtr = std::unique_ptr<DescartesLazyLadderGraph<FloatType>>;
+  using ConstUPtr = std::unique_ptr<const DescartesLazyLadderGraph<FloatType>>;
+
+  /** @param num_threads The number of threads used to build the graph, including the calling thread */
+  explicit DescartesLazyLadderGraph(int num_threads = 1);
+
+  /**
+   * @brief Evaluate the states and the cheap cost of every edge
+   * @param samples The samples of each waypoint
+   * @param edge_evaluators The evaluators of the edges between consecutive waypoints, applied to every edge
+   * @param lazy_edge_evaluators The evaluators of the edges between consecutive waypoints, only applied to the edges
+   * of candidate paths. An evaluator may be null if the edges have no lazy evaluation.
+   * @param state_evaluators The evaluators of the states of each waypoint, invalid states are removed
+   */
+  void build(std::vector<std::vector<descartes_light::StateSample<FloatType>>> samples,
+             const std::vector<typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr>& edge_evaluators,
+             const std::vector<typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr>& lazy_edge_evaluators,
+             const std::vector<typename descartes_light::StateEvaluator<FloatType>::ConstPtr>& state_evaluators);
+
+  /**
+   * @brief Search the cheapest path whose edges are valid for both the cheap and the lazy edge evaluators
+   * @return The states of the path, empty if there is no valid path
+   */
+  descartes_light::SearchResult<FloatType> search();
+
+  /** @brief The number of searches performed by the last call to search() */
+  std::size_t getSearchCount() const;
+
+  /** @brief The number of edges evaluated by the lazy edge evaluators */
+  std::size_t getLazyEvaluationCount() const;
+
+protected:
+  using CostMatrix = Eigen::Matrix<FloatType, Eigen::Dynamic, Eigen::Dynamic>;
+  using CostVector = Eigen::Matrix<FloatType, Eigen::Dynamic, 1>;
+
+  struct Rung
+  {
+    /** @brief The valid samples, their cost includes the state evaluator cost */
+    std::vector<descartes_light::StateSample<FloatType>> samples;
+
+    /** @brief The cost of the cheapest path from the first rung to each sample */
+    CostVector path_cost;
+
+    /** @brief The sample of the previous rung on the cheapest path to each sample */
+    std::vector<Eigen::Index> predecessors;
+  };
+
+  struct Edges
+  {
+    /** @brief The cost of the edge from each sample of a rung (row) to each sample of the next rung (column) */
+    CostMatrix cost;
+
+    /** @brief Indicate if the lazy edge evaluator has been applied to an edge */
+    Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> evaluated;
+
+    /** @brief The lazy edge evaluator, may be null */
+    typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr lazy_evaluator;
+  };
+
+  std::size_t num_threads_;
+  std::vector<Rung> rungs_;
+  std::vector<Edges> edges_;
+  std::size_t search_count_{ 0 };
+  std::size_t lazy_evaluation_count_{ 0 };
+
+  /** @brief Update the cheapest paths of every rung starting at the provided rung */
+  void searchFrom(std::size_t rung);
+};
+
+using DescartesLazyLadderGraphF = DescartesLazyLadderGraph<float>;
+using DescartesLazyLadderGraphD = DescartesLazyLadderGraph<double>;
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_DESCARTES_LAZY_LADDER_GRAPH_H
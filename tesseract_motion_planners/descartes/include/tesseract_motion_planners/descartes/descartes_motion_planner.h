@@ -9,6 +9,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/core/planner.h>
+#include <tesseract_motion_planners/descartes/descartes_ik_cache.h>
 #include <tesseract_motion_planners/descartes/descartes_problem.h>
 #include <tesseract_motion_planners/descartes/profile/descartes_profile.h>
 
@@ -26,6 +27,16 @@ public:
   DescartesMotionPlanner(DescartesMotionPlanner&&) noexcept = delete;
   DescartesMotionPlanner& operator=(DescartesMotionPlanner&&) noexcept = delete;
 
+  /**
+   * @brief Solve the request
+   * @details The waypoints are sampled up front in parallel using the number of threads of the problem. The response
+   * statistics contain the time in seconds to sample the waypoints (sample_time), to build the edges of the graph
+   * (build_time) and to search the graph (search_time), along with the total number of samples (num_samples). If an IK
+   * cache is set they also contain its hit rate (ik_cache_hit_rate).
+   *
+   * If the problem has lazy edge evaluators the graph is searched using a DescartesLazyLadderGraph, and the statistics
+   * also contain the number of searches (num_searches) and of lazily evaluated edges (num_lazy_edge_evaluations).
+   */
   PlannerResponse solve(const PlannerRequest& request) const override;
 
   bool terminate() override;
@@ -35,6 +46,18 @@ public:
   MotionPlanner::Ptr clone() const override;
 
   virtual std::shared_ptr<DescartesProblem<FloatType>> createProblem(const PlannerRequest& request) const;
+
+  /**
+   * @brief Set the cache of inverse kinematics solutions used by the samplers of the problems
+   * @details The cache may be shared by multiple planners using the same environment kinematics, for example the
+   * raster segments of a program.
+   * @param cache The IK cache, nullptr to always solve IK
+   */
+  void setIKCache(DescartesIKCache::Ptr cache);
+  DescartesIKCache::Ptr getIKCache() const;
+
+protected:
+  DescartesIKCache::Ptr ik_cache_;
 };
 
 using DescartesMotionPlannerD = DescartesMotionPlanner<double>;
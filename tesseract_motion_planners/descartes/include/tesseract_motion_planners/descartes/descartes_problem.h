@@ -36,6 +36,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/descartes/descartes_ik_cache.h>
 
 namespace tesseract_planning
 {
@@ -57,6 +58,16 @@ struct DescartesProblem
   std::vector<typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr> edge_evaluators{};
   std::vector<typename descartes_light::WaypointSampler<FloatType>::ConstPtr> samplers{};
   std::vector<typename descartes_light::StateEvaluator<FloatType>::ConstPtr> state_evaluators{};
+
+  // The edge evaluators only applied to the edges of candidate paths, may be empty or contain null evaluators
+  std::vector<typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr> lazy_edge_evaluators{};
+
+  // The cache of IK solutions used by the samplers, may be null
+  DescartesIKCache::Ptr ik_cache;
+
+  // The context of the kinematic group used to store its solutions in the cache
+  std::string ik_cache_context;
+
   int num_threads = static_cast<int>(std::thread::hardware_concurrency());
 };
 using DescartesProblemF = DescartesProblem<float>;
@@ -29,12 +29,14 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <descartes_light/core/waypoint_sampler.h>
 #include <Eigen/Dense>
+#include <memory_resource>
 #include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_kinematics/core/kinematic_group.h>
 #include <tesseract_motion_planners/descartes/descartes_utils.h>
 #include <tesseract_motion_planners/descartes/descartes_collision.h>
+#include <tesseract_motion_planners/descartes/descartes_ik_cache.h>
 #include <tesseract_motion_planners/descartes/types.h>
 
 namespace tesseract_planning
@@ -52,6 +54,9 @@ public:
    * @param robot_tcp The robot tcp to be used.
    * @param allow_collision If true and no valid solution was found it will return the best of the worst
    * @param is_valid This is a user defined function to filter out solution
+   * @param use_redundant_joint_solutions Add the redundant solutions of each sample
+   * @param ik_cache The cache of inverse kinematics solutions, if null inverse kinematics is always solved
+   * @param ik_cache_context The context of manip created by DescartesIKCache::createContext
    */
   DescartesRobotSampler(std::string target_working_frame,
                         const Eigen::Isometry3d& target_pose,
@@ -62,10 +67,34 @@ public:
                         const Eigen::Isometry3d& tcp_offset,
                         bool allow_collision,
                         DescartesVertexEvaluator::Ptr is_valid,
-                        bool use_redundant_joint_solutions);
+                        bool use_redundant_joint_solutions,
+                        DescartesIKCache::Ptr ik_cache = nullptr,
+                        std::string ik_cache_context = "");
 
   std::vector<descartes_light::StateSample<FloatType>> sample() const override;
 
+  /**
+   * @brief Generate the target poses of the waypoint using the target pose sampler
+   * @details The samples are generated by calling samplePose for each pose followed by finalizeSamples, which allows
+   * the poses of every waypoint to be sampled in parallel.
+   * @return The target poses
+   */
+  tesseract_common::VectorIsometry3d getTargetPoses() const;
+
+  /**
+   * @brief Append the valid joint states of a target pose to the samples, this is safe to call concurrently
+   * @param pose The target pose generated by getTargetPoses
+   * @param samples The samples to append to, where the cost of a sample is its distance to collision if collisions
+   * are allowed
+   */
+  void samplePose(const Eigen::Isometry3d& pose, std::vector<descartes_light::StateSample<FloatType>>& samples) const;
+
+  /**
+   * @brief Convert the distances of the samples into costs and add the redundant solutions
+   * @param samples The samples of all target poses in the order of getTargetPoses
+   */
+  void finalizeSamples(std::vector<descartes_light::StateSample<FloatType>>& samples) const;
+
 private:
   /** @brief The target pose working frame */
   std::string target_working_frame_;
@@ -102,6 +131,19 @@ private:
 
   /** @brief Should redundant solutions be used */
   bool use_redundant_joint_solutions_{ false };
+
+  /** @brief The cache of inverse kinematics solutions */
+  DescartesIKCache::Ptr ik_cache_;
+
+  /** @brief The context of the kinematic group used to store solutions in the cache */
+  std::string ik_cache_context_;
+
+  /** @brief The pool the sample states are allocated from, which lives as long as any of its states */
+  std::shared_ptr<std::pmr::synchronized_pool_resource> state_pool_;
+
+  /** @brief Allocate a sample state from the pool */
+  std::shared_ptr<descartes_light::State<FloatType>>
+  allocateState(const Eigen::Ref<const Eigen::Matrix<FloatType, Eigen::Dynamic, 1>>& values) const;
 };
 
 using DescartesRobotSamplerF = DescartesRobotSampler<float>;
@@ -28,53 +28,82 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
-#include <thread>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/descartes/descartes_collision_edge_evaluator.h>
-#include <tesseract_environment/utils.h>
 
 namespace tesseract_planning
 {
+template <typename FloatType>
+DescartesCollisionEdgeEvaluator<FloatType>::Workspace::Workspace(
+    std::shared_ptr<tesseract_collision::DiscreteContactManager> discrete_contact_manager,
+    std::shared_ptr<tesseract_collision::ContinuousContactManager> continuous_contact_manager)
+  : discrete_contact_manager(std::move(discrete_contact_manager))
+  , continuous_contact_manager(std::move(continuous_contact_manager))
+{
+}
+
+template <typename FloatType>
+typename DescartesCollisionEdgeEvaluator<FloatType>::Workspace::UPtr
+DescartesCollisionEdgeEvaluator<FloatType>::Workspace::clone() const
+{
+  if (continuous_contact_manager != nullptr)
+    return std::make_unique<Workspace>(nullptr, continuous_contact_manager->clone());
+
+  return std::make_unique<Workspace>(discrete_contact_manager->clone(), nullptr);
+}
+
 template <typename FloatType>
 DescartesCollisionEdgeEvaluator<FloatType>::DescartesCollisionEdgeEvaluator(
     const tesseract_environment::Environment& collision_env,
     tesseract_kinematics::JointGroup::ConstPtr manip,
     tesseract_collision::CollisionCheckConfig config,
     bool allow_collision,
-    bool debug)
+    bool debug,
+    std::size_t num_threads)
   : manip_(std::move(manip))
   , active_link_names_(manip_->getActiveLinkNames())
-  , discrete_contact_manager_(collision_env.getDiscreteContactManager())
-  , continuous_contact_manager_(collision_env.getContinuousContactManager())
   , collision_check_config_(std::move(config))
+  , contact_request_(collision_check_config_.contact_request)
   , allow_collision_(allow_collision)
   , debug_(debug)
 {
-  if (discrete_contact_manager_ != nullptr)
-  {
-    discrete_contact_manager_->setActiveCollisionObjects(active_link_names_);
-    discrete_contact_manager_->applyContactManagerConfig(config.contact_manager_config);
-  }
-  else if (collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::DISCRETE ||
-           collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
-  {
-    throw std::runtime_error("Evaluator type is DISCRETE or LVS_DISCRETE, but discrete contact manager is not "
-                             "available");
-  }
+  // When collisions are not allowed the first contact invalidates the edge, otherwise the closest contacts are needed
+  contact_request_.type =
+      (allow_collision_) ? tesseract_collision::ContactTestType::CLOSEST : tesseract_collision::ContactTestType::FIRST;
 
-  if (continuous_contact_manager_ != nullptr)
+  // Only the contact manager for the configured evaluator type is used, so only it is cloned for each thread
+  std::shared_ptr<Workspace> workspace;
+  if (collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::CONTINUOUS ||
+      collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
   {
-    continuous_contact_manager_->setActiveCollisionObjects(active_link_names_);
-    continuous_contact_manager_->applyContactManagerConfig(config.contact_manager_config);
+    tesseract_collision::ContinuousContactManager::Ptr manager = collision_env.getContinuousContactManager();
+    if (manager == nullptr)
+      throw std::runtime_error("Evaluator type is CONTINUOUS or LVS_CONTINUOUS, but continuous contact manager is not "
+                               "available");
+
+    manager->setActiveCollisionObjects(active_link_names_);
+    manager->applyContactManagerConfig(collision_check_config_.contact_manager_config);
+    workspace = std::make_shared<Workspace>(nullptr, std::move(manager));
   }
-  else if (collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::CONTINUOUS ||
-           collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+  else
   {
-    throw std::runtime_error("Evaluator type is CONTINUOUS or LVS_CONTINUOUS, but continuous contact manager is not "
-                             "available");
+    tesseract_collision::DiscreteContactManager::Ptr manager = collision_env.getDiscreteContactManager();
+    if (manager == nullptr)
+      throw std::runtime_error("Evaluator type is DISCRETE or LVS_DISCRETE, but discrete contact manager is not "
+                               "available");
+
+    manager->setActiveCollisionObjects(active_link_names_);
+    manager->applyContactManagerConfig(collision_check_config_.contact_manager_config);
+    workspace = std::make_shared<Workspace>(std::move(manager), nullptr);
   }
+
+  workspaces_ = std::make_unique<ContactManagerPool<Workspace>>(std::move(workspace));
+  workspaces_->warm(num_threads);
 }
 
 template <typename FloatType>
@@ -83,27 +112,18 @@ DescartesCollisionEdgeEvaluator<FloatType>::evaluate(const descartes_light::Stat
                                                      const descartes_light::State<FloatType>& end) const
 {
   assert(start.values.rows() == end.values.rows());
+  Workspace& workspace = workspaces_->get();
 
-  // Happens in two phases:
-  // 1. Compute the transform of all objects
-  tesseract_common::TrajArray segment(2, start.values.rows());
-  for (Eigen::Index i = 0; i < start.values.rows(); ++i)
-  {
-    segment(0, i) = start[i];
-    segment(1, i) = end[i];
-  }
+  // The buffers keep their size between edges, so these assignments do not allocate
+  workspace.start_values = start.values.template cast<double>();
+  workspace.end_values = end.values.template cast<double>();
 
-  std::vector<tesseract_collision::ContactResultMap> contact_results;
+  double min_distance = std::numeric_limits<double>::max();
   bool in_contact{ true };
-  if (collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::CONTINUOUS ||
-      collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
-  {
-    in_contact = continuousCollisionCheck(contact_results, segment, allow_collision_);
-  }
+  if (workspace.continuous_contact_manager != nullptr)
+    in_contact = continuousCollisionCheck(workspace, min_distance);
   else
-  {
-    in_contact = discreteCollisionCheck(contact_results, segment, allow_collision_);
-  }
+    in_contact = discreteCollisionCheck(workspace, min_distance);
 
   if (!in_contact)
     return std::make_pair(true, 0);
@@ -112,67 +132,122 @@ DescartesCollisionEdgeEvaluator<FloatType>::evaluate(const descartes_light::Stat
   auto collision_safety_margin_ =
       static_cast<FloatType>(collision_check_config_.contact_manager_config.margin_data.getMaxCollisionMargin());
 
-  if (in_contact && allow_collision_)
-    return std::make_pair(true, collision_safety_margin_ - contact_results.begin()->begin()->second[0].distance);
+  if (allow_collision_)
+    return std::make_pair(true, collision_safety_margin_ - static_cast<FloatType>(min_distance));
 
   return std::make_pair(false, 0);
 }
 
 template <typename FloatType>
-bool DescartesCollisionEdgeEvaluator<FloatType>::continuousCollisionCheck(
-    std::vector<tesseract_collision::ContactResultMap>& results,
-    const tesseract_common::TrajArray& segment,
-    bool find_best) const
+long DescartesCollisionEdgeEvaluator<FloatType>::getSegmentCount(const Workspace& workspace) const
 {
-  // It was time using chronos time elapsed and it was faster to cache the contact manager
-  unsigned long int hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
-  tesseract_collision::ContinuousContactManager::Ptr cm;
-  mutex_.lock();
-  auto it = continuous_contact_managers_.find(hash);
-  if (it == continuous_contact_managers_.end())
-  {
-    cm = continuous_contact_manager_->clone();
-    continuous_contact_managers_[hash] = cm;
-  }
-  else
+  if (collision_check_config_.type != tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE &&
+      collision_check_config_.type != tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+    return 1;
+
+  const double dist = (workspace.end_values - workspace.start_values).norm();
+  return std::max(static_cast<long>(std::ceil(dist / collision_check_config_.longest_valid_segment_length)), 1L);
+}
+
+template <typename FloatType>
+bool DescartesCollisionEdgeEvaluator<FloatType>::continuousCollisionCheck(Workspace& workspace,
+                                                                          double& min_distance) const
+{
+  tesseract_collision::ContinuousContactManager& cm = *workspace.continuous_contact_manager;
+  const long n_steps = getSegmentCount(workspace);
+
+  bool in_contact{ false };
+  workspace.start_transforms = manip_->calcFwdKin(workspace.start_values);
+  for (long i = 1; i <= n_steps; ++i)
   {
-    cm = it->second;
+    // The last sub-segment ends exactly at the end state
+    if (i < n_steps)
+    {
+      const double t = static_cast<double>(i) / static_cast<double>(n_steps);
+      workspace.state_values = workspace.start_values + t * (workspace.end_values - workspace.start_values);
+      workspace.end_transforms = manip_->calcFwdKin(workspace.state_values);
+    }
+    else
+    {
+      workspace.end_transforms = manip_->calcFwdKin(workspace.end_values);
+    }
+
+    for (const auto& link_name : active_link_names_)
+    {
+      cm.setCollisionObjectsTransform(
+          link_name, workspace.start_transforms[link_name], workspace.end_transforms[link_name]);
+    }
+
+    workspace.contact_map.clear();
+    cm.contactTest(workspace.contact_map, contact_request_);
+    if (processContacts(workspace, min_distance))
+    {
+      in_contact = true;
+      if (!allow_collision_)
+        break;
+    }
+
+    std::swap(workspace.start_transforms, workspace.end_transforms);
   }
-  mutex_.unlock();
-  tesseract_collision::CollisionCheckConfig config = collision_check_config_;
-  config.contact_request.type =
-      (find_best) ? tesseract_collision::ContactTestType::CLOSEST : tesseract_collision::ContactTestType::FIRST;
 
-  return tesseract_environment::checkTrajectory(results, *cm, *manip_, segment, config);
+  return in_contact;
 }
 
 template <typename FloatType>
-bool DescartesCollisionEdgeEvaluator<FloatType>::discreteCollisionCheck(
-    std::vector<tesseract_collision::ContactResultMap>& results,
-    const tesseract_common::TrajArray& segment,
-    bool find_best) const
+bool DescartesCollisionEdgeEvaluator<FloatType>::discreteCollisionCheck(Workspace& workspace,
+                                                                        double& min_distance) const
 {
-  // It was time using chronos time elapsed and it was faster to cache the contact manager
-  unsigned long int hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
-  tesseract_collision::DiscreteContactManager::Ptr cm;
-  mutex_.lock();
-  auto it = discrete_contact_managers_.find(hash);
-  if (it == discrete_contact_managers_.end())
+  tesseract_collision::DiscreteContactManager& cm = *workspace.discrete_contact_manager;
+  const long n_steps = getSegmentCount(workspace);
+
+  bool in_contact{ false };
+  for (long i = 0; i <= n_steps; ++i)
   {
-    cm = discrete_contact_manager_->clone();
-    discrete_contact_managers_[hash] = cm;
+    if (i == 0)
+    {
+      workspace.start_transforms = manip_->calcFwdKin(workspace.start_values);
+    }
+    else if (i == n_steps)
+    {
+      workspace.start_transforms = manip_->calcFwdKin(workspace.end_values);
+    }
+    else
+    {
+      const double t = static_cast<double>(i) / static_cast<double>(n_steps);
+      workspace.state_values = workspace.start_values + t * (workspace.end_values - workspace.start_values);
+      workspace.start_transforms = manip_->calcFwdKin(workspace.state_values);
+    }
+
+    for (const auto& link_name : active_link_names_)
+      cm.setCollisionObjectsTransform(link_name, workspace.start_transforms[link_name]);
+
+    workspace.contact_map.clear();
+    cm.contactTest(workspace.contact_map, contact_request_);
+    if (processContacts(workspace, min_distance))
+    {
+      in_contact = true;
+      if (!allow_collision_)
+        break;
+    }
   }
-  else
+
+  return in_contact;
+}
+
+template <typename FloatType>
+bool DescartesCollisionEdgeEvaluator<FloatType>::processContacts(const Workspace& workspace,
+                                                                 double& min_distance) const
+{
+  if (workspace.contact_map.empty())
+    return false;
+
+  for (const auto& pair : workspace.contact_map)
   {
-    cm = it->second;
+    for (const auto& result : pair.second)
+      min_distance = std::min(min_distance, result.distance);
   }
-  mutex_.unlock();
-
-  tesseract_collision::CollisionCheckConfig config = collision_check_config_;
-  config.contact_request.type =
-      (find_best) ? tesseract_collision::ContactTestType::CLOSEST : tesseract_collision::ContactTestType::FIRST;
 
-  return tesseract_environment::checkTrajectory(results, *cm, *manip_, segment, config);
+  return true;
 }
 
 }  // namespace tesseract_planning
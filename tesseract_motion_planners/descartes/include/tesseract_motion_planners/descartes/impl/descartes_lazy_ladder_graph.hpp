@@ -0,0 +1,223 @@
+/**
+ * @file descartes_lazy_ladder_graph.hpp
+ * @brief A ladder graph which defers expensive edge evaluations until they are on a candidate path
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_DESCARTES_IMPL_DESCARTES_LAZY_LADDER_GRAPH_HPP
+#define TESSERACT_MOTION_PLANNERS_DESCARTES_IMPL_DESCARTES_LAZY_LADDER_GRAPH_HPP
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/descartes/descartes_lazy_ladder_graph.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
+
+namespace tesseract_planning
+{
+template <typename FloatType>
+DescartesLazyLadderGraph<FloatType>::DescartesLazyLadderGraph(int num_threads)
+  : num_threads_(static_cast<std::size_t>(std::max(num_threads, 1)))
+{
+}
+
+template <typename FloatType>
+void DescartesLazyLadderGraph<FloatType>::build(
+    std::vector<std::vector<descartes_light::StateSample<FloatType>>> samples,
+    const std::vector<typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr>& edge_evaluators,
+    const std::vector<typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr>& lazy_edge_evaluators,
+    const std::vector<typename descartes_light::StateEvaluator<FloatType>::ConstPtr>& state_evaluators)
+{
+  if (samples.empty())
+    throw std::runtime_error("DescartesLazyLadderGraph, there are no samples");
+
+  if (edge_evaluators.size() != samples.size() - 1 || lazy_edge_evaluators.size() != edge_evaluators.size())
+    throw std::runtime_error("DescartesLazyLadderGraph, there must be one edge evaluator per pair of waypoints");
+
+  if (state_evaluators.size() != samples.size())
+    throw std::runtime_error("DescartesLazyLadderGraph, there must be one state evaluator per waypoint");
+
+  rungs_.clear();
+  rungs_.resize(samples.size());
+  edges_.clear();
+  edges_.resize(edge_evaluators.size());
+  search_count_ = 0;
+  lazy_evaluation_count_ = 0;
+
+  parallelFor(samples.size(), num_threads_, [&](std::size_t r, std::size_t /*worker*/) {
+    Rung& rung = rungs_[r];
+    rung.samples.reserve(samples[r].size());
+    for (auto& sample : samples[r])
+    {
+      const std::pair<bool, FloatType> result = state_evaluators[r]->evaluate(*sample.state);
+      if (!result.first)
+        continue;
+
+      sample.cost += result.second;
+      rung.samples.push_back(std::move(sample));
+    }
+    rung.path_cost.resize(static_cast<Eigen::Index>(rung.samples.size()));
+    rung.predecessors.resize(rung.samples.size(), -1);
+    return true;
+  });
+
+  // The edges of each pair of rungs are a separate task
+  parallelFor(edges_.size(), num_threads_, [&](std::size_t r, std::size_t /*worker*/) {
+    const std::vector<descartes_light::StateSample<FloatType>>& from = rungs_[r].samples;
+    const std::vector<descartes_light::StateSample<FloatType>>& to = rungs_[r + 1].samples;
+    Edges& edges = edges_[r];
+    edges.cost.resize(static_cast<Eigen::Index>(from.size()), static_cast<Eigen::Index>(to.size()));
+    edges.evaluated.setConstant(edges.cost.rows(), edges.cost.cols(), false);
+    edges.lazy_evaluator = lazy_edge_evaluators[r];
+    for (std::size_t j = 0; j < to.size(); ++j)
+    {
+      for (std::size_t i = 0; i < from.size(); ++i)
+      {
+        const std::pair<bool, FloatType> result = edge_evaluators[r]->evaluate(*from[i].state, *to[j].state);
+        edges.cost(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j)) =
+            (result.first) ? result.second : std::numeric_limits<FloatType>::infinity();
+      }
+    }
+    return true;
+  });
+}
+
+template <typename FloatType>
+descartes_light::SearchResult<FloatType> DescartesLazyLadderGraph<FloatType>::search()
+{
+  descartes_light::SearchResult<FloatType> result;
+  if (rungs_.empty())
+    return result;
+
+  struct PathEdge
+  {
+    std::size_t rung;
+    Eigen::Index from;
+    Eigen::Index to;
+  };
+
+  search_count_ = 0;
+  std::vector<Eigen::Index> path(rungs_.size());
+  std::vector<PathEdge> unevaluated;
+  std::size_t first_rung{ 0 };
+  while (true)
+  {
+    searchFrom(first_rung);
+    ++search_count_;
+
+    const Rung& last_rung = rungs_.back();
+    if (last_rung.samples.empty())
+      return result;
+
+    Eigen::Index index{ 0 };
+    const FloatType cost = last_rung.path_cost.minCoeff(&index);
+    if (cost == std::numeric_limits<FloatType>::infinity())
+      return result;
+
+    path.back() = index;
+    for (std::size_t r = rungs_.size() - 1; r > 0; --r)
+      path[r - 1] = rungs_[r].predecessors[static_cast<std::size_t>(path[r])];
+
+    unevaluated.clear();
+    for (std::size_t r = 0; r < edges_.size(); ++r)
+    {
+      if (edges_[r].lazy_evaluator != nullptr && !edges_[r].evaluated(path[r], path[r + 1]))
+        unevaluated.push_back(PathEdge{ r, path[r], path[r + 1] });
+    }
+
+    if (unevaluated.empty())
+    {
+      result.cost = cost;
+      result.trajectory.reserve(rungs_.size());
+      for (std::size_t r = 0; r < rungs_.size(); ++r)
+        result.trajectory.push_back(rungs_[r].samples[static_cast<std::size_t>(path[r])].state);
+
+      return result;
+    }
+
+    // A path has at most one edge per rung, which is too little work to start threads for on every search
+    for (const PathEdge& edge : unevaluated)
+    {
+      const std::pair<bool, FloatType> lazy_result = edges_[edge.rung].lazy_evaluator->evaluate(
+          *rungs_[edge.rung].samples[static_cast<std::size_t>(edge.from)].state,
+          *rungs_[edge.rung + 1].samples[static_cast<std::size_t>(edge.to)].state);
+
+      Edges& edges = edges_[edge.rung];
+      edges.evaluated(edge.from, edge.to) = true;
+      if (lazy_result.first)
+        edges.cost(edge.from, edge.to) += lazy_result.second;
+      else
+        edges.cost(edge.from, edge.to) = std::numeric_limits<FloatType>::infinity();
+    }
+    lazy_evaluation_count_ += unevaluated.size();
+
+    // Only the paths through the rungs following the first changed edge need to be updated
+    first_rung = unevaluated.front().rung + 1;
+  }
+}
+
+template <typename FloatType>
+std::size_t DescartesLazyLadderGraph<FloatType>::getSearchCount() const
+{
+  return search_count_;
+}
+
+template <typename FloatType>
+std::size_t DescartesLazyLadderGraph<FloatType>::getLazyEvaluationCount() const
+{
+  return lazy_evaluation_count_;
+}
+
+template <typename FloatType>
+void DescartesLazyLadderGraph<FloatType>::searchFrom(std::size_t rung)
+{
+  if (rung == 0)
+  {
+    Rung& first = rungs_.front();
+    for (std::size_t i = 0; i < first.samples.size(); ++i)
+      first.path_cost(static_cast<Eigen::Index>(i)) = first.samples[i].cost;
+
+    rung = 1;
+  }
+
+  for (std::size_t r = rung; r < rungs_.size(); ++r)
+  {
+    const CostVector& previous_cost = rungs_[r - 1].path_cost;
+    const CostMatrix& edge_cost = edges_[r - 1].cost;
+    Rung& current = rungs_[r];
+    for (std::size_t j = 0; j < current.samples.size(); ++j)
+    {
+      const auto col = static_cast<Eigen::Index>(j);
+      Eigen::Index predecessor{ -1 };
+      FloatType cost = std::numeric_limits<FloatType>::infinity();
+      if (previous_cost.size() > 0)
+        cost = (previous_cost + edge_cost.col(col)).minCoeff(&predecessor) + current.samples[j].cost;
+
+      current.path_cost(col) = cost;
+      current.predecessors[j] = predecessor;
+    }
+  }
+}
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_DESCARTES_IMPL_DESCARTES_LAZY_LADDER_GRAPH_HPP
@@ -30,9 +30,13 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <descartes_light/solvers/ladder_graph/ladder_graph_solver.h>
 #include <descartes_light/samplers/fixed_joint_waypoint_sampler.h>
+#include <algorithm>
+#include <iterator>
 #include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_common/timer.h>
+
 #include <tesseract_collision/core/discrete_contact_manager.h>
 #include <tesseract_collision/core/continuous_contact_manager.h>
 
@@ -40,9 +44,12 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_environment/utils.h>
 
 #include <tesseract_motion_planners/descartes/descartes_motion_planner.h>
+#include <tesseract_motion_planners/descartes/descartes_lazy_ladder_graph.h>
+#include <tesseract_motion_planners/descartes/descartes_robot_sampler.h>
 #include <tesseract_motion_planners/descartes/profile/descartes_default_plan_profile.h>
 #include <tesseract_motion_planners/core/utils.h>
 #include <tesseract_motion_planners/core/interpolation.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
 #include <tesseract_motion_planners/planner_utils.h>
 
 #include <tesseract_command_language/utils.h>
@@ -54,6 +61,96 @@ constexpr auto ERROR_FAILED_TO_FIND_VALID_SOLUTION{ "Failed to find valid soluti
 
 namespace tesseract_planning
 {
+namespace detail
+{
+/** @brief A waypoint sampler which returns the samples computed beforehand */
+template <typename FloatType>
+class DescartesPrecomputedSampler : public descartes_light::WaypointSampler<FloatType>
+{
+public:
+  explicit DescartesPrecomputedSampler(std::vector<descartes_light::StateSample<FloatType>> samples)
+    : samples_(std::move(samples))
+  {
+  }
+
+  std::vector<descartes_light::StateSample<FloatType>> sample() const override { return samples_; }
+
+private:
+  std::vector<descartes_light::StateSample<FloatType>> samples_;
+};
+
+/**
+ * @brief Sample all waypoints distributed across multiple threads
+ * @details Each pose of a DescartesRobotSampler is a separate task so waypoints with many poses are split between
+ * threads, other samplers are a single task. The samples of a waypoint are combined in the order of its poses before
+ * being finalized, so the result is the same as sampling the waypoints one at a time.
+ * @param samplers The samplers of the waypoints
+ * @param num_threads The number of threads, including the calling thread
+ * @return The samples of each waypoint
+ */
+template <typename FloatType>
+std::vector<std::vector<descartes_light::StateSample<FloatType>>>
+sampleWaypoints(const std::vector<typename descartes_light::WaypointSampler<FloatType>::ConstPtr>& samplers,
+                std::size_t num_threads)
+{
+  struct Task
+  {
+    std::size_t waypoint;
+    std::size_t pose;
+  };
+
+  std::vector<const DescartesRobotSampler<FloatType>*> robot_samplers(samplers.size(), nullptr);
+  std::vector<tesseract_common::VectorIsometry3d> poses(samplers.size());
+  std::vector<std::size_t> task_offsets(samplers.size() + 1, 0);
+  std::vector<Task> tasks;
+  for (std::size_t i = 0; i < samplers.size(); ++i)
+  {
+    task_offsets[i] = tasks.size();
+    robot_samplers[i] = dynamic_cast<const DescartesRobotSampler<FloatType>*>(samplers[i].get());
+    if (robot_samplers[i] != nullptr)
+    {
+      poses[i] = robot_samplers[i]->getTargetPoses();
+      for (std::size_t j = 0; j < poses[i].size(); ++j)
+        tasks.push_back(Task{ i, j });
+    }
+    else
+    {
+      tasks.push_back(Task{ i, 0 });
+    }
+  }
+  task_offsets.back() = tasks.size();
+
+  std::vector<std::vector<descartes_light::StateSample<FloatType>>> task_samples(tasks.size());
+  parallelFor(tasks.size(), num_threads, [&](std::size_t i, std::size_t /*worker*/) {
+    const Task& task = tasks[i];
+    const DescartesRobotSampler<FloatType>* robot_sampler = robot_samplers[task.waypoint];
+    if (robot_sampler != nullptr)
+      robot_sampler->samplePose(poses[task.waypoint][task.pose], task_samples[i]);
+    else
+      task_samples[i] = samplers[task.waypoint]->sample();
+
+    return true;
+  });
+
+  std::vector<std::vector<descartes_light::StateSample<FloatType>>> samples(samplers.size());
+  for (std::size_t i = 0; i < samplers.size(); ++i)
+  {
+    std::size_t num_samples{ 0 };
+    for (std::size_t j = task_offsets[i]; j < task_offsets[i + 1]; ++j)
+      num_samples += task_samples[j].size();
+
+    samples[i].reserve(num_samples);
+    for (std::size_t j = task_offsets[i]; j < task_offsets[i + 1]; ++j)
+      std::move(task_samples[j].begin(), task_samples[j].end(), std::back_inserter(samples[i]));
+
+    if (robot_samplers[i] != nullptr)
+      robot_samplers[i]->finalizeSamples(samples[i]);
+  }
+
+  return samples;
+}
+}  // namespace detail
+
 template <typename FloatType>
 DescartesMotionPlanner<FloatType>::DescartesMotionPlanner(std::string name) : MotionPlanner(std::move(name))  // NOLINT
 {
@@ -88,9 +185,63 @@ PlannerResponse DescartesMotionPlanner<FloatType>::solve(const PlannerRequest& r
   descartes_light::SearchResult<FloatType> descartes_result;
   try
   {
-    descartes_light::LadderGraphSolver<FloatType> solver(problem->num_threads);
-    solver.build(problem->samplers, problem->edge_evaluators, problem->state_evaluators);
-    descartes_result = solver.search();
+    tesseract_common::Timer timer;
+    timer.start();
+
+    // Sample up front so the poses of a waypoint are distributed across threads
+    auto samples = detail::sampleWaypoints<FloatType>(problem->samplers,
+                                                      static_cast<std::size_t>(std::max(problem->num_threads, 1)));
+
+    std::size_t num_samples{ 0 };
+    for (const auto& waypoint_samples : samples)
+      num_samples += waypoint_samples.size();
+
+    const double sample_time = timer.elapsedSeconds();
+    response.statistics["sample_time"] = sample_time;
+    response.statistics["num_samples"] = static_cast<double>(num_samples);
+    if (problem->ik_cache != nullptr && problem->ik_cache->getLookupCount() > 0)
+    {
+      response.statistics["ik_cache_hit_rate"] = static_cast<double>(problem->ik_cache->getHitCount()) /
+                                                 static_cast<double>(problem->ik_cache->getLookupCount());
+    }
+
+    const bool lazy = std::any_of(problem->lazy_edge_evaluators.begin(),
+                                  problem->lazy_edge_evaluators.end(),
+                                  [](const auto& evaluator) { return evaluator != nullptr; });
+    if (lazy)
+    {
+      auto lazy_edge_evaluators = problem->lazy_edge_evaluators;
+      lazy_edge_evaluators.resize(problem->edge_evaluators.size());
+
+      DescartesLazyLadderGraph<FloatType> graph(problem->num_threads);
+      graph.build(std::move(samples), problem->edge_evaluators, lazy_edge_evaluators, problem->state_evaluators);
+      const double build_time = timer.elapsedSeconds() - sample_time;
+      response.statistics["build_time"] = build_time;
+
+      descartes_result = graph.search();
+      response.statistics["search_time"] = timer.elapsedSeconds() - sample_time - build_time;
+      response.statistics["num_searches"] = static_cast<double>(graph.getSearchCount());
+      response.statistics["num_lazy_edge_evaluations"] = static_cast<double>(graph.getLazyEvaluationCount());
+    }
+    else
+    {
+      std::vector<typename descartes_light::WaypointSampler<FloatType>::ConstPtr> samplers;
+      samplers.reserve(samples.size());
+      for (auto& waypoint_samples : samples)
+      {
+        samplers.push_back(
+            std::make_shared<detail::DescartesPrecomputedSampler<FloatType>>(std::move(waypoint_samples)));
+      }
+
+      descartes_light::LadderGraphSolver<FloatType> solver(problem->num_threads);
+      solver.build(samplers, problem->edge_evaluators, problem->state_evaluators);
+      const double build_time = timer.elapsedSeconds() - sample_time;
+      response.statistics["build_time"] = build_time;
+
+      descartes_result = solver.search();
+      response.statistics["search_time"] = timer.elapsedSeconds() - sample_time - build_time;
+    }
+
     if (descartes_result.trajectory.empty())
     {
       CONSOLE_BRIDGE_logError("Search for graph completion failed");
@@ -213,7 +364,21 @@ void DescartesMotionPlanner<FloatType>::clear()
 template <typename FloatType>
 MotionPlanner::Ptr DescartesMotionPlanner<FloatType>::clone() const
 {
-  return std::make_shared<DescartesMotionPlanner<FloatType>>(name_);
+  auto planner = std::make_shared<DescartesMotionPlanner<FloatType>>(name_);
+  planner->setIKCache(ik_cache_);
+  return planner;
+}
+
+template <typename FloatType>
+void DescartesMotionPlanner<FloatType>::setIKCache(DescartesIKCache::Ptr cache)
+{
+  ik_cache_ = std::move(cache);
+}
+
+template <typename FloatType>
+DescartesIKCache::Ptr DescartesMotionPlanner<FloatType>::getIKCache() const
+{
+  return ik_cache_;
 }
 
 template <typename FloatType>
@@ -226,6 +391,7 @@ DescartesMotionPlanner<FloatType>::createProblem(const PlannerRequest& request)
   prob->edge_evaluators.clear();
   prob->samplers.clear();
   prob->state_evaluators.clear();
+  prob->lazy_edge_evaluators.clear();
 
   // Assume all the plan instructions have the same manipulator as the composite
   assert(!request.instructions.getManipulatorInfo().empty());
@@ -255,6 +421,10 @@ DescartesMotionPlanner<FloatType>::createProblem(const PlannerRequest& request)
 
   prob->env_state = request.env_state;
   prob->env = request.env;
+  prob->ik_cache = ik_cache_;
+  if (ik_cache_ != nullptr)
+    prob->ik_cache_context =
+        DescartesIKCache::createContext(*request.env, *prob->manip, composite_mi.manipulator_ik_solver);
 
   std::vector<std::string> joint_names = prob->manip->getJointNames();
 
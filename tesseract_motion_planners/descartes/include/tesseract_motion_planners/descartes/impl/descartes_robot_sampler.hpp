@@ -30,6 +30,7 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
 #include <Eigen/Geometry>
+#include <memory_resource>
 #include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
@@ -38,6 +39,43 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+namespace detail
+{
+/** @brief An allocator which keeps its memory resource alive as long as any of its allocations */
+template <typename T>
+struct SharedResourceAllocator
+{
+  using value_type = T;
+
+  explicit SharedResourceAllocator(std::shared_ptr<std::pmr::memory_resource> resource) : resource(std::move(resource))
+  {
+  }
+
+  template <typename U>
+  SharedResourceAllocator(const SharedResourceAllocator<U>& other) : resource(other.resource)  // NOLINT
+  {
+  }
+
+  T* allocate(std::size_t n) { return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T))); }
+
+  void deallocate(T* ptr, std::size_t n) { resource->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+  std::shared_ptr<std::pmr::memory_resource> resource;
+};
+
+template <typename T, typename U>
+bool operator==(const SharedResourceAllocator<T>& lhs, const SharedResourceAllocator<U>& rhs)
+{
+  return lhs.resource == rhs.resource;
+}
+
+template <typename T, typename U>
+bool operator!=(const SharedResourceAllocator<T>& lhs, const SharedResourceAllocator<U>& rhs)
+{
+  return lhs.resource != rhs.resource;
+}
+}  // namespace detail
+
 template <typename FloatType>
 DescartesRobotSampler<FloatType>::DescartesRobotSampler(std::string target_working_frame,
                                                         const Eigen::Isometry3d& target_pose,
@@ -48,7 +86,9 @@ DescartesRobotSampler<FloatType>::DescartesRobotSampler(std::string target_worki
                                                         const Eigen::Isometry3d& tcp_offset,
                                                         bool allow_collision,
                                                         DescartesVertexEvaluator::Ptr is_valid,
-                                                        bool use_redundant_joint_solutions)
+                                                        bool use_redundant_joint_solutions,
+                                                        DescartesIKCache::Ptr ik_cache,
+                                                        std::string ik_cache_context)
   : target_working_frame_(std::move(target_working_frame))
   , target_pose_(target_pose)
   , target_pose_sampler_(std::move(target_pose_sampler))
@@ -61,6 +101,9 @@ DescartesRobotSampler<FloatType>::DescartesRobotSampler(std::string target_worki
   , ik_seed_(Eigen::VectorXd::Zero(dof_))
   , is_valid_(std::move(is_valid))
   , use_redundant_joint_solutions_(use_redundant_joint_solutions)
+  , ik_cache_(std::move(ik_cache))
+  , ik_cache_context_(std::move(ik_cache_context))
+  , state_pool_(std::make_shared<std::pmr::synchronized_pool_resource>())
 {
   if (!allow_collision_ && !collision_)
     throw std::runtime_error("Collision checker must not be a nullptr if collisions are not allowed during planning");
@@ -68,50 +111,71 @@ DescartesRobotSampler<FloatType>::DescartesRobotSampler(std::string target_worki
 
 template <typename FloatType>
 std::vector<descartes_light::StateSample<FloatType>> DescartesRobotSampler<FloatType>::sample() const
+{
+  std::vector<descartes_light::StateSample<FloatType>> samples;
+  for (const auto& pose : getTargetPoses())
+    samplePose(pose, samples);
+
+  finalizeSamples(samples);
+  return samples;
+}
+
+template <typename FloatType>
+tesseract_common::VectorIsometry3d DescartesRobotSampler<FloatType>::getTargetPoses() const
 {
   // Generate all possible Cartesian poses
-  tesseract_common::VectorIsometry3d target_poses = target_pose_sampler_(target_pose_);
+  return target_pose_sampler_(target_pose_);
+}
 
-  // Generate the IK solutions for those poses
-  std::vector<descartes_light::StateSample<FloatType>> samples;
-  for (const auto& pose : target_poses)
-  {
-    // Get the transformation to the kinematic tip link
-    Eigen::Isometry3d target_pose = pose * tcp_offset_.inverse();
+template <typename FloatType>
+void DescartesRobotSampler<FloatType>::samplePose(const Eigen::Isometry3d& pose,
+                                                  std::vector<descartes_light::StateSample<FloatType>>& samples) const
+{
+  // Get the transformation to the kinematic tip link
+  Eigen::Isometry3d target_pose = pose * tcp_offset_.inverse();
 
-    // Solve IK (TODO Should tcp_offset be stored in KinGroupIKInput?)
+  // Solve IK (TODO Should tcp_offset be stored in KinGroupIKInput?)
+  tesseract_kinematics::IKSolutions ik_solutions;
+  if (ik_cache_ == nullptr ||
+      !ik_cache_->lookup(ik_cache_context_, target_working_frame_, tcp_frame_, target_pose, ik_solutions))
+  {
     tesseract_kinematics::KinGroupIKInput ik_input(target_pose, target_working_frame_, tcp_frame_);
-    tesseract_kinematics::IKSolutions ik_solutions = manip_->calcInvKin({ ik_input }, ik_seed_);
+    ik_solutions = manip_->calcInvKin({ ik_input }, ik_seed_);
 
-    if (ik_solutions.empty())
+    if (ik_cache_ != nullptr)
+      ik_cache_->insert(ik_cache_context_, target_working_frame_, tcp_frame_, target_pose, ik_solutions);
+  }
+
+  // Check each individual joint solution
+  for (const auto& sol : ik_solutions)
+  {
+    if ((is_valid_ != nullptr) && !(*is_valid_)(sol))
       continue;
 
-    // Check each individual joint solution
-    for (const auto& sol : ik_solutions)
+    if (allow_collision_ && collision_ == nullptr)
     {
-      if ((is_valid_ != nullptr) && !(*is_valid_)(sol))
-        continue;
-
-      auto state = std::make_shared<descartes_light::State<FloatType>>(sol.cast<FloatType>());
-      if (allow_collision_ && collision_ == nullptr)
-      {
-        samples.push_back(descartes_light::StateSample<FloatType>{ state, static_cast<FloatType>(0.0) });
-      }
-      else if (!allow_collision_)
-      {
-        if (collision_->validate(sol))
-          samples.push_back(descartes_light::StateSample<FloatType>{ state, 0.0 });
-      }
-      else
-      {
-        const FloatType cost = static_cast<FloatType>(collision_->distance(sol));
-        samples.push_back(descartes_light::StateSample<FloatType>{ state, cost });
-      }
+      samples.push_back(
+          descartes_light::StateSample<FloatType>{ allocateState(sol.cast<FloatType>()), static_cast<FloatType>(0.0) });
+    }
+    else if (!allow_collision_)
+    {
+      if (collision_->validate(sol))
+        samples.push_back(descartes_light::StateSample<FloatType>{ allocateState(sol.cast<FloatType>()), 0.0 });
+    }
+    else
+    {
+      const FloatType cost = static_cast<FloatType>(collision_->distance(sol));
+      samples.push_back(descartes_light::StateSample<FloatType>{ allocateState(sol.cast<FloatType>()), cost });
     }
   }
+}
 
+template <typename FloatType>
+void DescartesRobotSampler<FloatType>::finalizeSamples(
+    std::vector<descartes_light::StateSample<FloatType>>& samples) const
+{
   if (samples.empty())
-    return samples;
+    return;
 
   if (allow_collision_)
   {
@@ -137,32 +201,31 @@ std::vector<descartes_light::StateSample<FloatType>> DescartesRobotSampler<Float
     }
   }
 
-  // Generate the redundant solutions
+  // Append the redundant solutions after the nominal samples with the same cost as their nominal sample
   if (use_redundant_joint_solutions_)
   {
     const Eigen::MatrixX2d& limits = manip_->getLimits().joint_limits;
     std::vector<Eigen::Index> redundancy_capable_joints = manip_->getRedundancyCapableJointIndices();
-    std::vector<descartes_light::StateSample<FloatType>> redundant_samples;
-    for (const descartes_light::StateSample<FloatType>& sample : samples)
+    const std::size_t num_nominal_samples = samples.size();
+    for (std::size_t i = 0; i < num_nominal_samples; ++i)
     {
-      const auto redundant_solutions =
-          tesseract_kinematics::getRedundantSolutions<FloatType>(*(sample.state), limits, redundancy_capable_joints);
-
-      // Add the redundant samples with the same cost as the nominal sample
-      std::transform(redundant_solutions.begin(),
-                     redundant_solutions.end(),
-                     std::back_inserter(redundant_samples),
-                     [&sample](const auto& sol) {
-                       auto state = std::make_shared<descartes_light::State<FloatType>>(sol.template cast<FloatType>());
-                       return descartes_light::StateSample<FloatType>{ state, sample.cost };
-                     });
-    }
+      const FloatType cost = samples[i].cost;
+      const auto redundant_solutions = tesseract_kinematics::getRedundantSolutions<FloatType>(
+          samples[i].state->values, limits, redundancy_capable_joints);
 
-    // Combine the nominal samples with the redundant samples
-    samples.insert(samples.end(), redundant_samples.begin(), redundant_samples.end());
+      for (const auto& sol : redundant_solutions)
+        samples.push_back(descartes_light::StateSample<FloatType>{ allocateState(sol), cost });
+    }
   }
+}
 
-  return samples;
+template <typename FloatType>
+std::shared_ptr<descartes_light::State<FloatType>> DescartesRobotSampler<FloatType>::allocateState(
+    const Eigen::Ref<const Eigen::Matrix<FloatType, Eigen::Dynamic, 1>>& values) const
+{
+  // The state and its reference count share a single allocation from the pool
+  return std::allocate_shared<descartes_light::State<FloatType>>(
+      detail::SharedResourceAllocator<descartes_light::State<FloatType>>(state_pool_), values);
 }
 
 }  // namespace tesseract_planning
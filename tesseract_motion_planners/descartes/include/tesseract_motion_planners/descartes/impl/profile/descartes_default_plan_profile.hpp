@@ -92,6 +92,7 @@ DescartesDefaultPlanProfile<FloatType>::DescartesDefaultPlanProfile(const tinyxm
                                                                                                         "yMargin");
     const tinyxml2::XMLElement* long_valid_seg_len_element = edge_collisions_element->FirstChildElement("LongestValidSe"
                                                                                                         "gmentLength");
+    const tinyxml2::XMLElement* lazy_element = edge_collisions_element->FirstChildElement("Lazy");
 
     if (enabled_element != nullptr)
     {
@@ -100,6 +101,13 @@ DescartesDefaultPlanProfile<FloatType>::DescartesDefaultPlanProfile(const tinyxm
         throw std::runtime_error("DescartesPlanProfile: EdgeCollisions: Error parsing Enabled string");
     }
 
+    if (lazy_element != nullptr)
+    {
+      status = lazy_element->QueryBoolText(&lazy_edge_collision);
+      if (status != tinyxml2::XML_NO_ATTRIBUTE && status != tinyxml2::XML_SUCCESS)
+        throw std::runtime_error("DescartesPlanProfile: EdgeCollisions: Error parsing Lazy string");
+    }
+
     if (coll_safety_margin_element != nullptr)
     {
       std::string coll_safety_margin_string;
@@ -210,7 +218,9 @@ void DescartesDefaultPlanProfile<FloatType>::apply(DescartesProblem<FloatType>&
                                                                  tcp_offset,
                                                                  allow_collision,
                                                                  ve,
-                                                                 use_redundant_joint_solutions);
+                                                                 use_redundant_joint_solutions,
+                                                                 prob.ik_cache,
+                                                                 prob.ik_cache_context);
   }
   else
   {
@@ -223,44 +233,32 @@ void DescartesDefaultPlanProfile<FloatType>::apply(DescartesProblem<FloatType>&
                                                                  tcp_offset,
                                                                  allow_collision,
                                                                  vertex_evaluator(prob),
-                                                                 use_redundant_joint_solutions);
+                                                                 use_redundant_joint_solutions,
+                                                                 prob.ik_cache,
+                                                                 prob.ik_cache_context);
   }
   prob.samplers.push_back(std::move(sampler));
 
   if (index != 0)
   {
     // Add edge Evaluator
-    if (edge_evaluator == nullptr)
+    typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr collision_evaluator;
+    if (enable_edge_collision)
     {
-      if (enable_edge_collision)
-      {
-        auto compound_evaluator = std::make_shared<descartes_light::CompoundEdgeEvaluator<FloatType>>();
-        compound_evaluator->evaluators.push_back(
-            std::make_shared<descartes_light::EuclideanDistanceEdgeEvaluator<FloatType>>());
-        compound_evaluator->evaluators.push_back(std::make_shared<DescartesCollisionEdgeEvaluator<FloatType>>(
-            *prob.env, prob.manip, edge_collision_check_config, allow_collision, debug));
-        prob.edge_evaluators.push_back(compound_evaluator);
-      }
-      else
-      {
-        prob.edge_evaluators.push_back(std::make_shared<descartes_light::EuclideanDistanceEdgeEvaluator<FloatType>>());
-      }
+      collision_evaluator =
+          std::make_shared<DescartesCollisionEdgeEvaluator<FloatType>>(*prob.env,
+                                                                       prob.manip,
+                                                                       edge_collision_check_config,
+                                                                       allow_collision,
+                                                                       debug,
+                                                                       static_cast<std::size_t>(num_threads));
     }
+
+    if (edge_evaluator == nullptr)
+      addEdgeEvaluator(
+          prob, std::make_shared<descartes_light::EuclideanDistanceEdgeEvaluator<FloatType>>(), collision_evaluator);
     else
-    {
-      if (enable_edge_collision)
-      {
-        auto compound_evaluator = std::make_shared<descartes_light::CompoundEdgeEvaluator<FloatType>>();
-        compound_evaluator->evaluators.push_back(edge_evaluator(prob));
-        compound_evaluator->evaluators.push_back(std::make_shared<DescartesCollisionEdgeEvaluator<FloatType>>(
-            *prob.env, prob.manip, edge_collision_check_config, allow_collision, debug));
-        prob.edge_evaluators.push_back(compound_evaluator);
-      }
-      else
-      {
-        prob.edge_evaluators.push_back(edge_evaluator(prob));
-      }
-    }
+      addEdgeEvaluator(prob, edge_evaluator(prob), collision_evaluator);
   }
 
   // Add state evaluator
@@ -290,23 +288,23 @@ void DescartesDefaultPlanProfile<FloatType>::apply(DescartesProblem<FloatType>&
     // Add edge Evaluator
     if (edge_evaluator == nullptr)
     {
+      typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr collision_evaluator;
       if (enable_edge_collision)
       {
-        auto compound_evaluator = std::make_shared<descartes_light::CompoundEdgeEvaluator<FloatType>>();
-        compound_evaluator->evaluators.push_back(
-            std::make_shared<descartes_light::EuclideanDistanceEdgeEvaluator<FloatType>>());
-        compound_evaluator->evaluators.push_back(std::make_shared<DescartesCollisionEdgeEvaluator<FloatType>>(
-            *prob.env, prob.manip, edge_collision_check_config, allow_collision, debug));
-        prob.edge_evaluators.push_back(compound_evaluator);
-      }
-      else
-      {
-        prob.edge_evaluators.push_back(std::make_shared<descartes_light::EuclideanDistanceEdgeEvaluator<FloatType>>());
+        collision_evaluator =
+            std::make_shared<DescartesCollisionEdgeEvaluator<FloatType>>(*prob.env,
+                                                                         prob.manip,
+                                                                         edge_collision_check_config,
+                                                                         allow_collision,
+                                                                         debug,
+                                                                         static_cast<std::size_t>(num_threads));
       }
+      addEdgeEvaluator(
+          prob, std::make_shared<descartes_light::EuclideanDistanceEdgeEvaluator<FloatType>>(), collision_evaluator);
     }
     else
     {
-      prob.edge_evaluators.push_back(edge_evaluator(prob));
+      addEdgeEvaluator(prob, edge_evaluator(prob), nullptr);
     }
   }
 
@@ -318,6 +316,35 @@ void DescartesDefaultPlanProfile<FloatType>::apply(DescartesProblem<FloatType>&
   prob.num_threads = num_threads;
 }
 
+template <typename FloatType>
+void DescartesDefaultPlanProfile<FloatType>::addEdgeEvaluator(
+    DescartesProblem<FloatType>& prob,
+    typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr edge_evaluator,
+    typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr collision_evaluator) const
+{
+  // Keep the lazy edge evaluators aligned with the edge evaluators
+  prob.lazy_edge_evaluators.resize(prob.edge_evaluators.size());
+
+  if (collision_evaluator == nullptr)
+  {
+    prob.edge_evaluators.push_back(std::move(edge_evaluator));
+    prob.lazy_edge_evaluators.push_back(nullptr);
+  }
+  else if (lazy_edge_collision)
+  {
+    prob.edge_evaluators.push_back(std::move(edge_evaluator));
+    prob.lazy_edge_evaluators.push_back(std::move(collision_evaluator));
+  }
+  else
+  {
+    auto compound_evaluator = std::make_shared<descartes_light::CompoundEdgeEvaluator<FloatType>>();
+    compound_evaluator->evaluators.push_back(std::move(edge_evaluator));
+    compound_evaluator->evaluators.push_back(std::move(collision_evaluator));
+    prob.edge_evaluators.push_back(compound_evaluator);
+    prob.lazy_edge_evaluators.push_back(nullptr);
+  }
+}
+
 template <typename FloatType>
 tinyxml2::XMLElement* DescartesDefaultPlanProfile<FloatType>::toXML(tinyxml2::XMLDocument& doc) const
 {
@@ -342,6 +369,10 @@ tinyxml2::XMLElement* DescartesDefaultPlanProfile<FloatType>::toXML(tinyxml2::XM
   edge_collisions_enabled->SetText(enable_edge_collision);
   edge_collisions->InsertEndChild(edge_collisions_enabled);
 
+  tinyxml2::XMLElement* edge_collisions_lazy = doc.NewElement("Lazy");
+  edge_collisions_lazy->SetText(lazy_edge_collision);
+  edge_collisions->InsertEndChild(edge_collisions_lazy);
+
   /** @todo Update XML */
   //  tinyxml2::XMLElement* edge_collisions_safety_margin = doc.NewElement("CollisionSafetyMargin");
   //  edge_collisions_safety_margin->SetText(edge_collision_saftey_margin);
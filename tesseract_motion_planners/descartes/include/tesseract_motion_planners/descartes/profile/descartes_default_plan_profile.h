@@ -78,6 +78,14 @@ public:
   bool enable_edge_collision{ false };
   tesseract_collision::CollisionCheckConfig edge_collision_check_config{ 0 };
 
+  /**
+   * @brief Flag to only check the edges of candidate paths for collision
+   * @details The graph is built and searched using the other edge costs, then the edges of the cheapest path are
+   * checked for collision and the graph is searched again until every edge of the path has been checked. This finds
+   * the same path while checking a small fraction of the edges.
+   */
+  bool lazy_edge_collision{ false };
+
   /**
    * @brief Flag for generating redundant solutions as additional vertices for the planning graph search
    */
@@ -102,6 +110,17 @@ public:
              int index) const override;
 
   tinyxml2::XMLElement* toXML(tinyxml2::XMLDocument& doc) const override;
+
+protected:
+  /**
+   * @brief Add the edge evaluator of the edges leading to the waypoint being applied
+   * @param prob The problem
+   * @param edge_evaluator The evaluator of the edge cost
+   * @param collision_evaluator The evaluator of the edge collisions, may be null
+   */
+  void addEdgeEvaluator(DescartesProblem<FloatType>& prob,
+                        typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr edge_evaluator,
+                        typename descartes_light::EdgeEvaluator<FloatType>::ConstPtr collision_evaluator) const;
 };
 
 using DescartesDefaultPlanProfileF = DescartesDefaultPlanProfile<float>;
@@ -34,22 +34,22 @@ DescartesCollision::DescartesCollision(const tesseract_environment::Environment&
                                        bool debug)
   : manip_(std::move(manip))
   , active_link_names_(manip_->getActiveLinkNames())
-  , contact_manager_(collision_env.getDiscreteContactManager())
   , collision_check_config_(std::move(collision_check_config))
   , debug_(debug)
 {
-  contact_manager_->setActiveCollisionObjects(active_link_names_);
-  contact_manager_->applyContactManagerConfig(collision_check_config_.contact_manager_config);
+  tesseract_collision::DiscreteContactManager::Ptr contact_manager = collision_env.getDiscreteContactManager();
+  contact_manager->setActiveCollisionObjects(active_link_names_);
+  contact_manager->applyContactManagerConfig(collision_check_config_.contact_manager_config);
+  contact_managers_ = std::make_shared<DiscreteContactManagerPool>(std::move(contact_manager));
 }
 
 DescartesCollision::DescartesCollision(const DescartesCollision& collision_interface)
   : manip_(collision_interface.manip_)
   , active_link_names_(collision_interface.active_link_names_)
-  , contact_manager_(collision_interface.contact_manager_->clone())
+  , contact_managers_(collision_interface.contact_managers_)
   , collision_check_config_(collision_interface.collision_check_config_)
   , debug_(collision_interface.debug_)
 {
-  contact_manager_->applyContactManagerConfig(collision_check_config_.contact_manager_config);
 }
 
 bool DescartesCollision::validate(const Eigen::Ref<const Eigen::VectorXd>& pos)
@@ -61,7 +61,7 @@ bool DescartesCollision::validate(const Eigen::Ref<const Eigen::VectorXd>& pos)
   tesseract_collision::CollisionCheckConfig config(collision_check_config_);
   config.contact_request.type = tesseract_collision::ContactTestType::FIRST;
   tesseract_collision::ContactResultMap results =
-      tesseract_environment::checkTrajectoryState(*contact_manager_, state, config);
+      tesseract_environment::checkTrajectoryState(contact_managers_->get(), state, config);
   return results.empty();
 }
 
@@ -73,11 +73,12 @@ double DescartesCollision::distance(const Eigen::Ref<const Eigen::VectorXd>& pos
 
   tesseract_collision::CollisionCheckConfig config(collision_check_config_);
   config.contact_request.type = tesseract_collision::ContactTestType::CLOSEST;
+  tesseract_collision::DiscreteContactManager& contact_manager = contact_managers_->get();
   tesseract_collision::ContactResultMap results =
-      tesseract_environment::checkTrajectoryState(*contact_manager_, state, config);
+      tesseract_environment::checkTrajectoryState(contact_manager, state, config);
 
   if (results.empty())
-    return contact_manager_->getCollisionMarginData().getMaxCollisionMargin();
+    return contact_manager.getCollisionMarginData().getMaxCollisionMargin();
 
   return results.begin()->second.front().distance;
 }
@@ -0,0 +1,162 @@
+/**
+ * @file descartes_ik_cache.cpp
+ * @brief A cache of inverse kinematics solutions shared by the Descartes samplers
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <functional>
+#include <sstream>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/descartes/descartes_ik_cache.h>
+
+namespace tesseract_planning
+{
+bool DescartesIKCache::Key::operator==(const Key& other) const
+{
+  return (frames == other.frames && pose == other.pose);
+}
+
+std::size_t DescartesIKCache::KeyHash::operator()(const Key& key) const
+{
+  std::size_t seed = std::hash<std::string>()(key.frames);
+  for (double value : key.pose)
+    seed ^= std::hash<double>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+  return seed;
+}
+
+DescartesIKCache::DescartesIKCache(std::size_t max_entries)
+  : max_entries_per_shard_(std::max<std::size_t>(max_entries / NUM_SHARDS, 1))
+{
+}
+
+std::string DescartesIKCache::createContext(const tesseract_environment::Environment& env,
+                                           const tesseract_kinematics::KinematicGroup& manip,
+                                           const std::string& ik_solver)
+{
+  // The joints of the group are solved for, the other active joints can move the group relative to the working frame
+  const std::vector<std::string> group_joints = manip.getJointNames();
+  std::vector<std::string> other_joints;
+  for (const auto& joint : env.getActiveJointNames())
+  {
+    if (std::find(group_joints.begin(), group_joints.end(), joint) == group_joints.end())
+      other_joints.push_back(joint);
+  }
+
+  // The positions are written as hexadecimal floats so they are exact
+  std::ostringstream context;
+  context << manip.getName() << '\0' << ik_solver << '\0' << env.getRevision() << std::hexfloat;
+  if (!other_joints.empty())
+  {
+    const Eigen::VectorXd positions = env.getCurrentJointValues(other_joints);
+    for (Eigen::Index i = 0; i < positions.size(); ++i)
+      context << '\0' << positions(i);
+  }
+
+  return context.str();
+}
+
+DescartesIKCache::Key DescartesIKCache::createKey(const std::string& context,
+                                                  const std::string& working_frame,
+                                                  const std::string& tip_link,
+                                                  const Eigen::Isometry3d& pose)
+{
+  // The names can not contain a null character so they are joined with it
+  Key key;
+  key.frames.reserve(context.size() + working_frame.size() + tip_link.size() + 2);
+  key.frames.append(context).push_back('\0');
+  key.frames.append(working_frame).push_back('\0');
+  key.frames.append(tip_link);
+  Eigen::Map<Eigen::Matrix<double, 3, 4>>(key.pose.data()) = pose.matrix().topRows<3>();
+
+  // Negative zero compares equal to zero so it must also hash equal
+  for (double& value : key.pose)
+    value += 0.0;
+
+  return key;
+}
+
+bool DescartesIKCache::lookup(const std::string& context,
+                              const std::string& working_frame,
+                              const std::string& tip_link,
+                              const Eigen::Isometry3d& pose,
+                              tesseract_kinematics::IKSolutions& solutions) const
+{
+  const Key key = createKey(context, working_frame, tip_link, pose);
+  const std::size_t hash = KeyHash()(key);
+  const Shard& shard = shards_[hash % NUM_SHARDS];
+  ++lookup_count_;
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end())
+    return false;
+
+  ++hit_count_;
+  solutions = it->second;
+  return true;
+}
+
+void DescartesIKCache::insert(const std::string& context,
+                              const std::string& working_frame,
+                              const std::string& tip_link,
+                              const Eigen::Isometry3d& pose,
+                              const tesseract_kinematics::IKSolutions& solutions)
+{
+  Key key = createKey(context, working_frame, tip_link, pose);
+  const std::size_t hash = KeyHash()(key);
+  Shard& shard = shards_[hash % NUM_SHARDS];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.entries.size() >= max_entries_per_shard_)
+    shard.entries.clear();
+
+  shard.entries[std::move(key)] = solutions;
+}
+
+void DescartesIKCache::clear()
+{
+  for (Shard& shard : shards_)
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.clear();
+  }
+  lookup_count_ = 0;
+  hit_count_ = 0;
+}
+
+std::size_t DescartesIKCache::size() const
+{
+  std::size_t size{ 0 };
+  for (const Shard& shard : shards_)
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    size += shard.entries.size();
+  }
+  return size;
+}
+
+std::size_t DescartesIKCache::getLookupCount() const { return lookup_count_; }
+
+std::size_t DescartesIKCache::getHitCount() const { return hit_count_; }
+
+}  // namespace tesseract_planning
@@ -0,0 +1,30 @@
+/**
+ * @file descartes_lazy_ladder_graph.cpp
+ * @brief A ladder graph which defers expensive edge evaluations until they are on a candidate path
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_motion_planners/descartes/impl/descartes_lazy_ladder_graph.hpp>
+
+namespace tesseract_planning
+{
+// Explicit template instantiation
+template class DescartesLazyLadderGraph<float>;
+template class DescartesLazyLadderGraph<double>;
+
+}  // namespace tesseract_planning
@@ -29,26 +29,37 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <ompl/base/MotionValidator.h>
+#include <ompl/base/StateSpace.h>
 #include <ompl/base/StateValidityChecker.h>
-#include <mutex>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/ompl/utils.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
 #include <tesseract_environment/environment.h>
 #include <tesseract_kinematics/core/forward_kinematics.h>
 
 namespace tesseract_planning
 {
-/** @brief Continuous collision check between two states */
+/**
+ * @brief Continuous collision check between two states
+ * @details The motion is split into sub-segments of the longest valid segment length. The link transforms at the end
+ * of a sub-segment are reused as the start of the next one, so each sub-state is interpolated and solved once, and the
+ * check stops at the first invalid sub-segment.
+ */
 class ContinuousMotionValidator : public ompl::base::MotionValidator
 {
 public:
+  /**
+   * @brief Constructor
+   * @param num_threads The number of threads expected to check motions, used to clone contact managers up front
+   */
   ContinuousMotionValidator(const ompl::base::SpaceInformationPtr& space_info,
                             ompl::base::StateValidityCheckerPtr state_validator,
                             const tesseract_environment::Environment& env,
                             tesseract_kinematics::JointGroup::ConstPtr manip,
                             const tesseract_collision::CollisionCheckConfig& collision_check_config,
-                            OMPLStateExtractor extractor);
+                            OMPLStateExtractor extractor,
+                            std::size_t num_threads = 1);
 
   bool checkMotion(const ompl::base::State* s1, const ompl::base::State* s2) const override;
 
@@ -58,12 +69,47 @@ public:
 
 private:
   /**
-   * @brief Perform a continuous collision check between two ompl states
-   * @param s1 First OMPL State
-   * @param s2 Second OMPL State
+   * @brief The data a thread reuses for every motion it checks
+   * @details The ContactManagerPool only requires clone(), so the scratch data is pooled together with the contact
+   * manager and found by the same thread local lookup. The space information owns this validator, so the state is
+   * allocated from the state space to avoid a reference cycle.
+   */
+  struct Workspace
+  {
+    using UPtr = std::unique_ptr<Workspace>;
+
+    Workspace(ompl::base::StateSpacePtr state_space,
+              std::shared_ptr<tesseract_collision::ContinuousContactManager> contact_manager);
+    ~Workspace();
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+    Workspace(Workspace&&) = delete;
+    Workspace& operator=(Workspace&&) = delete;
+
+    /** @brief Clone the contact manager and allocate new scratch data */
+    UPtr clone() const;
+
+    ompl::base::StateSpacePtr state_space;
+    std::shared_ptr<tesseract_collision::ContinuousContactManager> contact_manager;
+
+    /** @brief The interpolated end state of the current sub-segment */
+    ompl::base::State* end_state{ nullptr };
+
+    /** @brief The link transforms at the start of the current sub-segment */
+    tesseract_common::TransformMap start_transforms;
+
+    /** @brief The link transforms at the end of the current sub-segment */
+    tesseract_common::TransformMap end_transforms;
+
+    tesseract_collision::ContactResultMap contact_map;
+  };
+
+  /**
+   * @brief Perform a continuous collision check between the start and end transforms of the workspace
+   * @param workspace The calling thread's workspace
    * @return True if not in collision, otherwise false.
    */
-  bool continuousCollisionCheck(const ompl::base::State* s1, const ompl::base::State* s2) const;
+  bool continuousCollisionCheck(Workspace& workspace) const;
 
   /**
    * @brief The state validator without collision checking
@@ -75,25 +121,18 @@ private:
   /** @brief The Tesseract Forward Kinematics */
   tesseract_kinematics::JointGroup::ConstPtr manip_;
 
-  /** @brief The continuous contact manager used for creating cached continuous contact managers. */
-  tesseract_collision::ContinuousContactManager::Ptr continuous_contact_manager_;
-
   /** @brief A list of active links */
   std::vector<std::string> links_;
 
   /** @brief This will extract an Eigen::VectorXd from the OMPL State */
   OMPLStateExtractor extractor_;
 
-  // The items below are to cache the contact manager based on thread ID. Currently ompl is multi
-  // threaded but the methods used to implement collision checking are not thread safe. To prevent
-  // reconstructing the collision environment for every check this will cache a contact manager
-  // based on its thread ID.
-
-  /** @brief Contact manager caching mutex */
-  mutable std::mutex mutex_;
-
-  /** @brief The continuous contact manager cache */
-  mutable std::map<unsigned long int, tesseract_collision::ContinuousContactManager::Ptr> continuous_contact_managers_;
+  /**
+   * @brief The workspace for each thread
+   * @details OMPL is multi threaded but contact managers are not thread safe, so to prevent reconstructing the
+   * collision environment for every check each thread is assigned its own contact manager and scratch data.
+   */
+  std::unique_ptr<ContactManagerPool<Workspace>> workspaces_;
 };
 }  // namespace tesseract_planning
 
@@ -28,6 +28,7 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
 #include <functional>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
@@ -85,12 +86,36 @@ public:
 
   MotionPlanner::Ptr clone() const override;
 
+  /**
+   * @brief Set the number of threads used to solve the sub-problems concurrently
+   * @details Each sub-problem between consecutive waypoints is independent once its start and goal states are set.
+   * The results are merged in order and all remaining sub-problems are cancelled as soon as one fails or throws. An
+   * exception is rethrown by solve regardless of the number of threads. If one, the default, the sub-problems are
+   * solved sequentially. The MotionPlannerTask of the task composer sets it with its num_threads config entry.
+   * @param num_threads The number of threads, including the calling thread
+   */
+  void setNumThreads(std::size_t num_threads);
+
+  /** @brief Get the number of threads used to solve the sub-problems concurrently */
+  std::size_t getNumThreads() const;
+
   virtual std::vector<OMPLProblemConfig> createProblems(const PlannerRequest& request) const;
 
 protected:
   /** @brief OMPL Parallel planner */
   std::shared_ptr<ompl::tools::ParallelPlan> parallel_plan_;
 
+  /** @brief The number of threads used to solve the sub-problems */
+  std::size_t num_threads_{ 1 };
+
+  /**
+   * @brief Solve a single sub-problem and post process its solution
+   * @param p The sub-problem to solve
+   * @param cancel Planning is stopped when set, used to cancel the remaining sub-problems when one fails
+   * @return True if an exact solution was found, otherwise false
+   */
+  static bool solveProblem(OMPLProblem& p, const std::atomic<bool>& cancel);
+
   OMPLProblemConfig createSubProblem(const PlannerRequest& request,
                                      const tesseract_common::ManipulatorInfo& composite_mi,
                                      const tesseract_kinematics::JointGroup::ConstPtr& manip,
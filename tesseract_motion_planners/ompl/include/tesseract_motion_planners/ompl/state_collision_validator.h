@@ -29,10 +29,10 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <ompl/base/StateValidityChecker.h>
-#include <mutex>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/ompl/utils.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
 #include <tesseract_environment/environment.h>
 #include <tesseract_kinematics/core/forward_kinematics.h>
 
@@ -42,11 +42,16 @@ namespace tesseract_planning
 class StateCollisionValidator : public ompl::base::StateValidityChecker
 {
 public:
+  /**
+   * @brief Constructor
+   * @param num_threads The number of threads expected to check states, used to clone contact managers up front
+   */
   StateCollisionValidator(const ompl::base::SpaceInformationPtr& space_info,
                           const tesseract_environment::Environment& env,
                           tesseract_kinematics::JointGroup::ConstPtr manip,
                           const tesseract_collision::CollisionCheckConfig& collision_check_config,
-                          OMPLStateExtractor extractor);
+                          OMPLStateExtractor extractor,
+                          std::size_t num_threads = 1);
 
   bool isValid(const ompl::base::State* state) const override;
 
@@ -54,25 +59,18 @@ private:
   /** @brief The Tesseract Joint Group */
   tesseract_kinematics::JointGroup::ConstPtr manip_;
 
-  /** @brief The continuous contact manager used for creating cached continuous contact managers. */
-  tesseract_collision::DiscreteContactManager::Ptr contact_manager_;
-
   /** @brief A list of active links */
   std::vector<std::string> links_;
 
   /** @brief This will extract an Eigen::VectorXd from the OMPL State */
   OMPLStateExtractor extractor_;
 
-  // The items below are to cache the contact manager based on thread ID. Currently ompl is multi
-  // threaded but the methods used to implement collision checking are not thread safe. To prevent
-  // reconstructing the collision environment for every check this will cache a contact manager
-  // based on its thread ID.
-
-  /** @brief Contact manager caching mutex */
-  mutable std::mutex mutex_;
-
-  /** @brief The continuous contact manager cache */
-  mutable std::map<unsigned long int, tesseract_collision::DiscreteContactManager::Ptr> contact_managers_;
+  /**
+   * @brief The discrete contact manager for each thread
+   * @details OMPL is multi threaded but contact managers are not thread safe, so to prevent reconstructing the
+   * collision environment for every check each thread is assigned its own contact manager.
+   */
+  DiscreteContactManagerPool::UPtr contact_managers_;
 };
 
 }  // namespace tesseract_planning
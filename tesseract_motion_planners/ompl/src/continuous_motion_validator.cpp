@@ -26,30 +26,48 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <ompl/base/SpaceInformation.h>
-#include <thread>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/ompl/continuous_motion_validator.h>
 
 namespace tesseract_planning
 {
+ContinuousMotionValidator::Workspace::Workspace(
+    ompl::base::StateSpacePtr state_space,
+    std::shared_ptr<tesseract_collision::ContinuousContactManager> contact_manager)
+  : state_space(std::move(state_space)), contact_manager(std::move(contact_manager))
+{
+  end_state = this->state_space->allocState();
+}
+
+ContinuousMotionValidator::Workspace::~Workspace() { state_space->freeState(end_state); }
+
+ContinuousMotionValidator::Workspace::UPtr ContinuousMotionValidator::Workspace::clone() const
+{
+  return std::make_unique<Workspace>(state_space, contact_manager->clone());
+}
+
 ContinuousMotionValidator::ContinuousMotionValidator(
     const ompl::base::SpaceInformationPtr& space_info,
     ompl::base::StateValidityCheckerPtr state_validator,
     const tesseract_environment::Environment& env,
     tesseract_kinematics::JointGroup::ConstPtr manip,
     const tesseract_collision::CollisionCheckConfig& collision_check_config,
-    OMPLStateExtractor extractor)
+    OMPLStateExtractor extractor,
+    std::size_t num_threads)
   : MotionValidator(space_info)
   , state_validator_(std::move(state_validator))
   , manip_(std::move(manip))
-  , continuous_contact_manager_(env.getContinuousContactManager())
   , extractor_(std::move(extractor))
 {
   links_ = manip_->getActiveLinkNames();
 
-  continuous_contact_manager_->setActiveCollisionObjects(links_);
-  continuous_contact_manager_->applyContactManagerConfig(collision_check_config.contact_manager_config);
+  tesseract_collision::ContinuousContactManager::Ptr continuous_contact_manager = env.getContinuousContactManager();
+  continuous_contact_manager->setActiveCollisionObjects(links_);
+  continuous_contact_manager->applyContactManagerConfig(collision_check_config.contact_manager_config);
+  workspaces_ = std::make_unique<ContactManagerPool<Workspace>>(
+      std::make_shared<Workspace>(space_info->getStateSpace(), std::move(continuous_contact_manager)));
+  workspaces_->warm(num_threads);
 }
 
 bool ContinuousMotionValidator::checkMotion(const ompl::base::State* s1, const ompl::base::State* s2) const
@@ -63,89 +81,55 @@ bool ContinuousMotionValidator::checkMotion(const ompl::base::State* s1,
                                             std::pair<ompl::base::State*, double>& lastValid) const
 {
   const ompl::base::StateSpace& state_space = *si_->getStateSpace();
+  Workspace& workspace = workspaces_->get();
 
-  unsigned n_steps = state_space.validSegmentCount(s1, s2);
-  bool is_valid = true;
-
-  ompl::base::State* start_interp = si_->allocState();
-  if (n_steps > 1)
+  const unsigned n_steps = state_space.validSegmentCount(s1, s2);
+  workspace.start_transforms = manip_->calcFwdKin(extractor_(s1));
+  for (unsigned i = 1; i <= n_steps; ++i)
   {
-    ompl::base::State* end_interp = si_->allocState();
-
-    for (unsigned i = 1; i < n_steps; ++i)
+    // The last sub-segment ends exactly at s2
+    const ompl::base::State* end_state = s2;
+    if (i < n_steps)
     {
-      state_space.interpolate(s1, s2, (i - 1) / static_cast<double>(n_steps), start_interp);
-      state_space.interpolate(s1, s2, (i) / static_cast<double>(n_steps), end_interp);
-      if (state_validator_ && !state_validator_->isValid(end_interp))
-      {
-        lastValid.second = static_cast<double>(i - 1) / static_cast<double>(n_steps);
-        if (lastValid.first != nullptr)
-          state_space.interpolate(s1, s2, lastValid.second, lastValid.first);
-
-        is_valid = false;
-      }
-      else if (!continuousCollisionCheck(start_interp, end_interp))
-      {
-        lastValid.second = (i - 1) / static_cast<double>(n_steps);
-        if (lastValid.first != nullptr)
-          state_space.interpolate(s1, s2, lastValid.second, lastValid.first);
-
-        is_valid = false;
-      }
+      state_space.interpolate(s1, s2, static_cast<double>(i) / static_cast<double>(n_steps), workspace.end_state);
+      end_state = workspace.end_state;
     }
 
-    si_->freeState(end_interp);
-  }
+    bool is_valid = (state_validator_ == nullptr || state_validator_->isValid(end_state));
+    if (is_valid)
+    {
+      workspace.end_transforms = manip_->calcFwdKin(extractor_(end_state));
+      is_valid = continuousCollisionCheck(workspace);
+    }
 
-  if (is_valid)
-  {
-    state_space.interpolate(s1, s2, (n_steps - 1) / static_cast<double>(n_steps), start_interp);
-    if ((state_validator_ != nullptr && !state_validator_->isValid(s2)) || !continuousCollisionCheck(start_interp, s2))
+    if (!is_valid)
     {
-      lastValid.second = static_cast<double>(n_steps - 1) / static_cast<double>(n_steps);
+      lastValid.second = static_cast<double>(i - 1) / static_cast<double>(n_steps);
       if (lastValid.first != nullptr)
         state_space.interpolate(s1, s2, lastValid.second, lastValid.first);
 
-      is_valid = false;
+      return false;
     }
-  }
 
-  si_->freeState(start_interp);
+    std::swap(workspace.start_transforms, workspace.end_transforms);
+  }
 
-  return is_valid;
+  return true;
 }
 
-bool ContinuousMotionValidator::continuousCollisionCheck(const ompl::base::State* s1, const ompl::base::State* s2) const
+bool ContinuousMotionValidator::continuousCollisionCheck(Workspace& workspace) const
 {
-  // It was time using chronos time elapsed and it was faster to cache the contact manager
-  unsigned long int hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
-  tesseract_collision::ContinuousContactManager::Ptr cm;
-  mutex_.lock();
-  auto it = continuous_contact_managers_.find(hash);
-  if (it == continuous_contact_managers_.end())
-  {
-    cm = continuous_contact_manager_->clone();
-    continuous_contact_managers_[hash] = cm;
-  }
-  else
+  tesseract_collision::ContinuousContactManager& cm = *workspace.contact_manager;
+  for (const auto& link_name : links_)
   {
-    cm = it->second;
+    cm.setCollisionObjectsTransform(
+        link_name, workspace.start_transforms[link_name], workspace.end_transforms[link_name]);
   }
-  mutex_.unlock();
-
-  Eigen::Map<Eigen::VectorXd> start_joints = extractor_(s1);
-  Eigen::Map<Eigen::VectorXd> finish_joints = extractor_(s2);
-
-  tesseract_common::TransformMap state0 = manip_->calcFwdKin(start_joints);
-  tesseract_common::TransformMap state1 = manip_->calcFwdKin(finish_joints);
-
-  for (const auto& link_name : links_)
-    cm->setCollisionObjectsTransform(link_name, state0[link_name], state1[link_name]);
 
-  tesseract_collision::ContactResultMap contact_map;
-  cm->contactTest(contact_map, tesseract_collision::ContactTestType::FIRST);
+  workspace.contact_map.clear();
+  cm.contactTest(workspace.contact_map, tesseract_collision::ContactTestType::FIRST);
 
-  return contact_map.empty();
+  return workspace.contact_map.empty();
 }
 
 }  // namespace tesseract_planning
@@ -29,7 +29,9 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
 #include <ompl/base/goals/GoalState.h>
 #include <ompl/base/goals/GoalStates.h>
+#include <ompl/base/PlannerTerminationCondition.h>
 #include <ompl/tools/multiplan/ParallelPlan.h>
+#include <atomic>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_environment/utils.h>
@@ -42,6 +44,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_motion_planners/ompl/profile/ompl_default_plan_profile.h>
 #include <tesseract_motion_planners/ompl/weighted_real_vector_state_sampler.h>
 #include <tesseract_motion_planners/core/utils.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
 
 #include <tesseract_command_language/utils.h>
 
@@ -91,12 +94,110 @@ bool checkGoalState(const ompl::base::ProblemDefinitionPtr& prob_def,
 /** @brief Construct a basic planner */
 OMPLMotionPlanner::OMPLMotionPlanner(std::string name) : MotionPlanner(std::move(name)) {}
 
+void OMPLMotionPlanner::setNumThreads(std::size_t num_threads) { num_threads_ = std::max<std::size_t>(num_threads, 1); }
+
+std::size_t OMPLMotionPlanner::getNumThreads() const { return num_threads_; }
+
 bool OMPLMotionPlanner::terminate()
 {
   CONSOLE_BRIDGE_logWarn("Termination of ongoing optimization is not implemented yet");
   return false;
 }
 
+bool OMPLMotionPlanner::solveProblem(OMPLProblem& p, const std::atomic<bool>& cancel)
+{
+  auto parallel_plan = std::make_shared<ompl::tools::ParallelPlan>(p.simple_setup->getProblemDefinition());
+
+  for (const auto& planner : p.planners)
+    parallel_plan->addPlanner(planner->create(p.simple_setup->getSpaceInformation()));
+
+  // Stop planning if the time runs out or another sub-problem failed
+  auto getTerminationCondition = [&cancel](double planning_time) {
+    return ompl::base::plannerOrTerminationCondition(
+        ompl::base::timedPlannerTerminationCondition(planning_time),
+        ompl::base::PlannerTerminationCondition([&cancel]() { return cancel.load(); }));
+  };
+
+  ompl::base::PlannerStatus status;
+  if (!p.optimize)
+  {
+    // Solve problem. Results are stored in the response
+    // Disabling hybridization because there is a bug which will return a trajectory that starts at the end state
+    // and finishes at the end state.
+    status = parallel_plan->solve(
+        getTerminationCondition(p.planning_time), 1, static_cast<unsigned>(p.max_solutions), false);
+  }
+  else
+  {
+    ompl::time::point end = ompl::time::now() + ompl::time::seconds(p.planning_time);
+    const ompl::base::ProblemDefinitionPtr& pdef = p.simple_setup->getProblemDefinition();
+    while (ompl::time::now() < end && !cancel)
+    {
+      // Solve problem. Results are stored in the response
+      // Disabling hybridization because there is a bug which will return a trajectory that starts at the end state
+      // and finishes at the end state.
+      ompl::base::PlannerStatus localResult =
+          parallel_plan->solve(getTerminationCondition(std::max(ompl::time::seconds(end - ompl::time::now()), 0.0)),
+                               1,
+                               static_cast<unsigned>(p.max_solutions),
+                               false);
+      if (localResult)
+      {
+        if (status != ompl::base::PlannerStatus::EXACT_SOLUTION)
+          status = localResult;
+
+        if (!pdef->hasOptimizationObjective())
+        {
+          CONSOLE_BRIDGE_logDebug("Terminating early since there is no optimization objective specified");
+          break;
+        }
+
+        ompl::base::Cost obj_cost = pdef->getSolutionPath()->cost(pdef->getOptimizationObjective());
+        CONSOLE_BRIDGE_logDebug("Motion Objective Cost: %f", obj_cost.value());
+
+        if (pdef->getOptimizationObjective()->isSatisfied(obj_cost))
+        {
+          CONSOLE_BRIDGE_logDebug("Terminating early since solution path satisfies the optimization objective");
+          break;
+        }
+
+        if (pdef->getSolutionCount() >= static_cast<std::size_t>(p.max_solutions))
+        {
+          CONSOLE_BRIDGE_logDebug("Terminating early since %u solutions were generated", p.max_solutions);
+          break;
+        }
+      }
+    }
+  }
+
+  if (status != ompl::base::PlannerStatus::EXACT_SOLUTION)
+    return false;
+
+  if (p.simplify)
+  {
+    p.simple_setup->simplifySolution();
+  }
+  else
+  {
+    // Interpolate the path if it shouldn't be simplified and there are currently fewer states than requested
+    auto num_output_states = static_cast<unsigned>(p.n_output_states);
+    if (p.simple_setup->getSolutionPath().getStateCount() < num_output_states)
+    {
+      p.simple_setup->getSolutionPath().interpolate(num_output_states);
+    }
+    else
+    {
+      // Now try to simplify the trajectory to get it under the requested number of output states
+      // The interpolate function only executes if the current number of states is less than the requested
+      p.simple_setup->simplifySolution();
+      if (p.simple_setup->getSolutionPath().getStateCount() < num_output_states)
+        p.simple_setup->getSolutionPath().interpolate(num_output_states);
+    }
+  }
+
+  return true;
+}
+
 PlannerResponse OMPLMotionPlanner::solve(const PlannerRequest& request) const
 {
   PlannerResponse response;
@@ -132,94 +233,31 @@ PlannerResponse OMPLMotionPlanner::solve(const PlannerRequest& request) const
   if (request.verbose)
     console_bridge::setLogLevel(console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_DEBUG);
 
-  /// @todo: Need to expand this to support multiple motion plans leveraging taskflow
-  for (auto& pc : problems)
-  {
-    auto& p = pc.problem;
-    auto parallel_plan = std::make_shared<ompl::tools::ParallelPlan>(p->simple_setup->getProblemDefinition());
-
-    for (const auto& planner : p->planners)
-      parallel_plan->addPlanner(planner->create(p->simple_setup->getSpaceInformation()));
-
-    ompl::base::PlannerStatus status;
-    if (!p->optimize)
+  // Solve the sub-problems, each is independent once its start and goal states are set.
+  // They are taken in order by the threads and all are cancelled as soon as one fails.
+  std::atomic<bool> cancel{ false };
+  auto solve = [&problems, &cancel](std::size_t idx, std::size_t /*worker*/) {
+    try
     {
-      // Solve problem. Results are stored in the response
-      // Disabling hybridization because there is a bug which will return a trajectory that starts at the end state
-      // and finishes at the end state.
-      status = parallel_plan->solve(p->planning_time, 1, static_cast<unsigned>(p->max_solutions), false);
+      if (solveProblem(*problems[idx].problem, cancel))
+        return true;
     }
-    else
+    catch (...)
     {
-      ompl::time::point end = ompl::time::now() + ompl::time::seconds(p->planning_time);
-      const ompl::base::ProblemDefinitionPtr& pdef = p->simple_setup->getProblemDefinition();
-      while (ompl::time::now() < end)
-      {
-        // Solve problem. Results are stored in the response
-        // Disabling hybridization because there is a bug which will return a trajectory that starts at the end state
-        // and finishes at the end state.
-        ompl::base::PlannerStatus localResult =
-            parallel_plan->solve(std::max(ompl::time::seconds(end - ompl::time::now()), 0.0),
-                                 1,
-                                 static_cast<unsigned>(p->max_solutions),
-                                 false);
-        if (localResult)
-        {
-          if (status != ompl::base::PlannerStatus::EXACT_SOLUTION)
-            status = localResult;
-
-          if (!pdef->hasOptimizationObjective())
-          {
-            CONSOLE_BRIDGE_logDebug("Terminating early since there is no optimization objective specified");
-            break;
-          }
-
-          ompl::base::Cost obj_cost = pdef->getSolutionPath()->cost(pdef->getOptimizationObjective());
-          CONSOLE_BRIDGE_logDebug("Motion Objective Cost: %f", obj_cost.value());
-
-          if (pdef->getOptimizationObjective()->isSatisfied(obj_cost))
-          {
-            CONSOLE_BRIDGE_logDebug("Terminating early since solution path satisfies the optimization objective");
-            break;
-          }
-
-          if (pdef->getSolutionCount() >= static_cast<std::size_t>(p->max_solutions))
-          {
-            CONSOLE_BRIDGE_logDebug("Terminating early since %u solutions were generated", p->max_solutions);
-            break;
-          }
-        }
-      }
+      // The exception is rethrown once every thread has stopped, the same as when solving sequentially
+      cancel = true;
+      throw;
     }
 
-    if (status != ompl::base::PlannerStatus::EXACT_SOLUTION)
-    {
-      response.successful = false;
-      response.message = ERROR_FAILED_TO_FIND_VALID_SOLUTION;
-      return response;
-    }
+    cancel = true;
+    return false;
+  };
 
-    if (p->simplify)
-    {
-      p->simple_setup->simplifySolution();
-    }
-    else
-    {
-      // Interpolate the path if it shouldn't be simplified and there are currently fewer states than requested
-      auto num_output_states = static_cast<unsigned>(p->n_output_states);
-      if (p->simple_setup->getSolutionPath().getStateCount() < num_output_states)
-      {
-        p->simple_setup->getSolutionPath().interpolate(num_output_states);
-      }
-      else
-      {
-        // Now try to simplify the trajectory to get it under the requested number of output states
-        // The interpolate function only executes if the current number of states is less than the requested
-        p->simple_setup->simplifySolution();
-        if (p->simple_setup->getSolutionPath().getStateCount() < num_output_states)
-          p->simple_setup->getSolutionPath().interpolate(num_output_states);
-      }
-    }
+  if (!parallelFor(problems.size(), num_threads_, solve))
+  {
+    response.successful = false;
+    response.message = ERROR_FAILED_TO_FIND_VALID_SOLUTION;
+    return response;
   }
 
   // Flatten the results to make them easier to process
@@ -306,7 +344,12 @@ PlannerResponse OMPLMotionPlanner::solve(const PlannerRequest& request) const
 
 void OMPLMotionPlanner::clear() { parallel_plan_ = nullptr; }
 
-MotionPlanner::Ptr OMPLMotionPlanner::clone() const { return std::make_shared<OMPLMotionPlanner>(name_); }
+MotionPlanner::Ptr OMPLMotionPlanner::clone() const
+{
+  auto planner = std::make_shared<OMPLMotionPlanner>(name_);
+  planner->setNumThreads(num_threads_);
+  return planner;
+}
 
 OMPLProblemConfig OMPLMotionPlanner::createSubProblem(const PlannerRequest& request,
                                                       const tesseract_common::ManipulatorInfo& composite_mi,
@@ -706,8 +706,13 @@ ompl::base::StateValidityCheckerPtr OMPLDefaultPlanProfile::processStateValidato
   if (collision_check_config.type == tesseract_collision::CollisionEvaluatorType::DISCRETE ||
       collision_check_config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
   {
-    auto svc = std::make_shared<StateCollisionValidator>(
-        prob.simple_setup->getSpaceInformation(), *prob.env, prob.manip, collision_check_config, prob.extractor);
+    // Each planner solving the problem in parallel checks states on its own thread
+    auto svc = std::make_shared<StateCollisionValidator>(prob.simple_setup->getSpaceInformation(),
+                                                         *prob.env,
+                                                         prob.manip,
+                                                         collision_check_config,
+                                                         prob.extractor,
+                                                         prob.planners.size());
     csvc->addStateValidator(svc);
   }
   prob.simple_setup->setStateValidityChecker(csvc);
@@ -737,7 +742,8 @@ void OMPLDefaultPlanProfile::processMotionValidator(
                                                          *prob.env,
                                                          prob.manip,
                                                          collision_check_config,
-                                                         prob.extractor);
+                                                         prob.extractor,
+                                                         prob.planners.size());
       }
       else
       {
@@ -26,7 +26,6 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <ompl/base/SpaceInformation.h>
-#include <thread>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/ompl/utils.h>
@@ -39,44 +38,31 @@ StateCollisionValidator::StateCollisionValidator(
     const tesseract_environment::Environment& env,
     tesseract_kinematics::JointGroup::ConstPtr manip,
     const tesseract_collision::CollisionCheckConfig& collision_check_config,
-    OMPLStateExtractor extractor)
-  : StateValidityChecker(space_info)
-  , manip_(std::move(manip))
-  , contact_manager_(env.getDiscreteContactManager())
-  , extractor_(std::move(extractor))
+    OMPLStateExtractor extractor,
+    std::size_t num_threads)
+  : StateValidityChecker(space_info), manip_(std::move(manip)), extractor_(std::move(extractor))
 {
   links_ = manip_->getActiveLinkNames();
 
-  contact_manager_->setActiveCollisionObjects(links_);
-  contact_manager_->applyContactManagerConfig(collision_check_config.contact_manager_config);
+  tesseract_collision::DiscreteContactManager::Ptr contact_manager = env.getDiscreteContactManager();
+  contact_manager->setActiveCollisionObjects(links_);
+  contact_manager->applyContactManagerConfig(collision_check_config.contact_manager_config);
+  contact_managers_ = std::make_unique<DiscreteContactManagerPool>(std::move(contact_manager));
+  contact_managers_->warm(num_threads);
 }
 
 bool StateCollisionValidator::isValid(const ompl::base::State* state) const
 {
-  // It was time using chronos time elapsed and it was faster to cache the contact manager
-  unsigned long int hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
-  tesseract_collision::DiscreteContactManager::Ptr cm;
-  mutex_.lock();
-  auto it = contact_managers_.find(hash);
-  if (it == contact_managers_.end())
-  {
-    cm = contact_manager_->clone();
-    contact_managers_[hash] = cm;
-  }
-  else
-  {
-    cm = it->second;
-  }
-  mutex_.unlock();
+  tesseract_collision::DiscreteContactManager& cm = contact_managers_->get();
 
   Eigen::Map<Eigen::VectorXd> finish_joints = extractor_(state);
   tesseract_common::TransformMap state1 = manip_->calcFwdKin(finish_joints);
 
   for (const auto& link_name : links_)
-    cm->setCollisionObjectsTransform(link_name, state1[link_name]);
+    cm.setCollisionObjectsTransform(link_name, state1[link_name]);
 
   tesseract_collision::ContactResultMap contact_map;
-  cm->contactTest(contact_map, tesseract_collision::ContactTestType::FIRST);
+  cm.contactTest(contact_map, tesseract_collision::ContactTestType::FIRST);
 
   return contact_map.empty();
 }
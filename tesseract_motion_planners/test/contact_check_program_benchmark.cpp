@@ -0,0 +1,198 @@
+/**
+ * @file contact_check_program_benchmark.cpp
+ * @brief Benchmark the longest valid segment substep generation used when contact checking a program
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <cstdlib>
+#include <new>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/core/lvs_substep_iterator.h>
+#include <tesseract_motion_planners/core/utils.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+/** @brief The number of heap allocations performed */
+static std::atomic<std::size_t> allocation_count{ 0 };
+
+#if defined(__GLIBC__)
+// Count every heap allocation, including Eigen's which do not go through operator new
+extern "C" void* __libc_malloc(std::size_t size);  // NOLINT
+extern "C" void* malloc(std::size_t size)          // NOLINT
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+#else
+void* operator new(std::size_t size)
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size))  // NOLINT
+    return ptr;
+
+  throw std::bad_alloc();
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }               // NOLINT
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }  // NOLINT
+#endif
+
+/** @brief The number of segments checked in each iteration */
+static const long NUM_SEGMENTS = 1000;
+
+/** @brief The longest valid segment length, each segment is split into ten substeps */
+static const double LONGEST_VALID_SEGMENT_LENGTH = 0.01;
+
+struct BenchmarkData
+{
+  tesseract_environment::Environment::Ptr env;
+  tesseract_scene_graph::StateSolver::UPtr state_solver;
+  std::vector<std::string> joint_names;
+  tesseract_common::TrajArray trajectory;
+};
+
+BenchmarkData& getBenchmarkData()
+{
+  static BenchmarkData benchmark_data = []() {
+    BenchmarkData data;
+    auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+    data.env = std::make_shared<tesseract_environment::Environment>();
+    tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+    tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+    data.env->init(urdf_path, srdf_path, locator);
+    data.state_solver = data.env->getStateSolver();
+    data.joint_names = data.env->getJointGroup("manipulator")->getJointNames();
+
+    // Each segment moves the first joint so its length is ten times the longest valid segment length
+    data.trajectory = tesseract_common::TrajArray::Zero(NUM_SEGMENTS + 1, static_cast<long>(data.joint_names.size()));
+    for (long i = 0; i <= NUM_SEGMENTS; ++i)
+      data.trajectory(i, 0) = -1.0 + (static_cast<double>(i % 2) * 10.0 * LONGEST_VALID_SEGMENT_LENGTH);
+
+    return data;
+  }();
+  return benchmark_data;
+}
+
+/** @brief Report the allocations per segment */
+void setAllocationCounter(benchmark::State& state, std::size_t allocations)
+{
+  state.counters["allocations_per_segment"] = benchmark::Counter(
+      static_cast<double>(allocations) / static_cast<double>(state.iterations() * NUM_SEGMENTS));
+}
+
+/** @brief Generate the substeps of each segment the way contactCheckProgram did prior to LVSSubstepIterator */
+static void BM_LVS_SUBSTEPS_TRAJARRAY(benchmark::State& state)
+{
+  BenchmarkData& data = getBenchmarkData();
+  const std::size_t start_count = allocation_count.load();
+  for (auto _ : state)
+  {
+    for (long iStep = 0; iStep < NUM_SEGMENTS; ++iStep)
+    {
+      Eigen::VectorXd p0 = data.trajectory.row(iStep);
+      Eigen::VectorXd p1 = data.trajectory.row(iStep + 1);
+      double dist = (p1 - p0).norm();
+      auto cnt = static_cast<long>(std::ceil(dist / LONGEST_VALID_SEGMENT_LENGTH)) + 1;
+      tesseract_common::TrajArray subtraj(cnt, p0.size());
+      for (long iVar = 0; iVar < p0.size(); ++iVar)
+        subtraj.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, p0(iVar), p1(iVar));
+
+      for (int iSubStep = 0; iSubStep < subtraj.rows() - 1; ++iSubStep)
+      {
+        tesseract_scene_graph::SceneState state0 = data.state_solver->getState(data.joint_names, subtraj.row(iSubStep));
+        tesseract_scene_graph::SceneState state1 =
+            data.state_solver->getState(data.joint_names, subtraj.row(iSubStep + 1));
+        benchmark::DoNotOptimize(state0);
+        benchmark::DoNotOptimize(state1);
+      }
+    }
+  }
+  setAllocationCounter(state, allocation_count.load() - start_count);
+}
+
+/** @brief Generate the substeps of each segment using LVSSubstepIterator, reusing the end state of each substep */
+static void BM_LVS_SUBSTEPS_ITERATOR(benchmark::State& state)
+{
+  BenchmarkData& data = getBenchmarkData();
+  LVSSubstepIterator substeps;
+  const std::size_t start_count = allocation_count.load();
+  for (auto _ : state)
+  {
+    for (long iStep = 0; iStep < NUM_SEGMENTS; ++iStep)
+    {
+      substeps.reset(data.trajectory.row(iStep).transpose(),
+                     data.trajectory.row(iStep + 1).transpose(),
+                     LONGEST_VALID_SEGMENT_LENGTH);
+
+      tesseract_scene_graph::SceneState state0 = data.state_solver->getState(data.joint_names, substeps.state());
+      tesseract_scene_graph::SceneState state1;
+      while (substeps.next())
+      {
+        state1 = data.state_solver->getState(data.joint_names, substeps.state());
+        benchmark::DoNotOptimize(state0);
+        benchmark::DoNotOptimize(state1);
+        std::swap(state0, state1);
+      }
+    }
+  }
+  setAllocationCounter(state, allocation_count.load() - start_count);
+}
+
+/** @brief Discrete LVS contact check of a program with the same segments */
+static void BM_CONTACT_CHECK_PROGRAM_LVS_DISCRETE(benchmark::State& state)
+{
+  BenchmarkData& data = getBenchmarkData();
+
+  CompositeInstruction program;
+  for (long i = 0; i <= NUM_SEGMENTS; ++i)
+  {
+    StateWaypointPoly wp{ StateWaypoint(data.joint_names, data.trajectory.row(i).transpose()) };
+    program.appendMoveInstruction(MoveInstruction(wp, MoveInstructionType::FREESPACE));
+  }
+
+  tesseract_collision::CollisionCheckConfig config;
+  config.type = tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE;
+  config.longest_valid_segment_length = LONGEST_VALID_SEGMENT_LENGTH;
+
+  tesseract_collision::DiscreteContactManager::Ptr manager = data.env->getDiscreteContactManager();
+  manager->setActiveCollisionObjects(data.env->getJointGroup("manipulator")->getActiveLinkNames());
+
+  std::vector<tesseract_collision::ContactResultMap> contacts;
+  const std::size_t start_count = allocation_count.load();
+  for (auto _ : state)
+  {
+    bool found = contactCheckProgram(contacts, *manager, *data.state_solver, program, config);
+    benchmark::DoNotOptimize(found);
+  }
+  setAllocationCounter(state, allocation_count.load() - start_count);
+}
+
+BENCHMARK(BM_LVS_SUBSTEPS_TRAJARRAY)->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK(BM_LVS_SUBSTEPS_ITERATOR)->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK(BM_CONTACT_CHECK_PROGRAM_LVS_DISCRETE)->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,224 @@
+/**
+ * @file descartes_collision_edge_evaluator_benchmark.cpp
+ * @brief Benchmark the collision edge evaluator used by the Descartes ladder graph
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <random>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_environment/commands.h>
+#include <tesseract_environment/utils.h>
+#include <tesseract_geometry/impl/sphere.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
+#include <tesseract_motion_planners/descartes/descartes_collision_edge_evaluator.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+/** @brief The number of random edges cycled through */
+static const std::size_t NUM_EDGES = 1000;
+
+/** @brief The maximum joint distance between the start and end of an edge, similar to neighboring rungs */
+static const double MAX_EDGE_LENGTH = 0.3;
+
+/**
+ * @brief The collision edge evaluator prior to reusing its scratch data
+ * @details Every edge allocates a trajectory, computes the transforms of every link of every state through the
+ * generic trajectory checker and collects the contact results of every state.
+ */
+class LegacyCollisionEdgeEvaluator : public descartes_light::EdgeEvaluator<double>
+{
+public:
+  LegacyCollisionEdgeEvaluator(const tesseract_environment::Environment& collision_env,
+                               tesseract_kinematics::JointGroup::ConstPtr manip,
+                               tesseract_collision::CollisionCheckConfig config,
+                               bool allow_collision,
+                               bool /*debug*/,
+                               std::size_t num_threads)
+    : manip_(std::move(manip)), collision_check_config_(std::move(config)), allow_collision_(allow_collision)
+  {
+    std::vector<std::string> active_link_names = manip_->getActiveLinkNames();
+    if (collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::CONTINUOUS ||
+        collision_check_config_.type == tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS)
+    {
+      tesseract_collision::ContinuousContactManager::Ptr manager = collision_env.getContinuousContactManager();
+      manager->setActiveCollisionObjects(active_link_names);
+      manager->applyContactManagerConfig(collision_check_config_.contact_manager_config);
+      continuous_contact_managers_ = std::make_unique<ContinuousContactManagerPool>(std::move(manager));
+      continuous_contact_managers_->warm(num_threads);
+    }
+    else
+    {
+      tesseract_collision::DiscreteContactManager::Ptr manager = collision_env.getDiscreteContactManager();
+      manager->setActiveCollisionObjects(active_link_names);
+      manager->applyContactManagerConfig(collision_check_config_.contact_manager_config);
+      discrete_contact_managers_ = std::make_unique<DiscreteContactManagerPool>(std::move(manager));
+      discrete_contact_managers_->warm(num_threads);
+    }
+  }
+
+  std::pair<bool, double> evaluate(const descartes_light::State<double>& start,
+                                   const descartes_light::State<double>& end) const override
+  {
+    tesseract_common::TrajArray segment(2, start.values.rows());
+    for (Eigen::Index i = 0; i < start.values.rows(); ++i)
+    {
+      segment(0, i) = start[i];
+      segment(1, i) = end[i];
+    }
+
+    tesseract_collision::CollisionCheckConfig config = collision_check_config_;
+    config.contact_request.type = (allow_collision_) ? tesseract_collision::ContactTestType::CLOSEST :
+                                                       tesseract_collision::ContactTestType::FIRST;
+
+    std::vector<tesseract_collision::ContactResultMap> contact_results;
+    bool in_contact{ true };
+    if (continuous_contact_managers_ != nullptr)
+      in_contact = tesseract_environment::checkTrajectory(
+          contact_results, continuous_contact_managers_->get(), *manip_, segment, config);
+    else
+      in_contact = tesseract_environment::checkTrajectory(
+          contact_results, discrete_contact_managers_->get(), *manip_, segment, config);
+
+    if (!in_contact)
+      return std::make_pair(true, 0);
+
+    auto margin = collision_check_config_.contact_manager_config.margin_data.getMaxCollisionMargin();
+    if (allow_collision_)
+      return std::make_pair(true, margin - contact_results.begin()->begin()->second[0].distance);
+
+    return std::make_pair(false, 0);
+  }
+
+private:
+  tesseract_kinematics::JointGroup::ConstPtr manip_;
+  DiscreteContactManagerPool::UPtr discrete_contact_managers_;
+  ContinuousContactManagerPool::UPtr continuous_contact_managers_;
+  tesseract_collision::CollisionCheckConfig collision_check_config_;
+  bool allow_collision_;
+};
+
+/** @brief The lbr iiwa with a sphere in its workspace so part of the edges are in collision */
+static tesseract_environment::Environment::Ptr createEnvironment()
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+  env->init(urdf_path, srdf_path, locator);
+
+  tesseract_scene_graph::Link link_sphere("sphere_attached");
+  auto visual = std::make_shared<tesseract_scene_graph::Visual>();
+  visual->origin = Eigen::Isometry3d::Identity();
+  visual->origin.translation() = Eigen::Vector3d(0.5, 0, 0.55);
+  visual->geometry = std::make_shared<tesseract_geometry::Sphere>(0.15);
+  link_sphere.visual.push_back(visual);
+
+  auto collision = std::make_shared<tesseract_scene_graph::Collision>();
+  collision->origin = visual->origin;
+  collision->geometry = visual->geometry;
+  link_sphere.collision.push_back(collision);
+
+  tesseract_scene_graph::Joint joint_sphere("joint_sphere_attached");
+  joint_sphere.parent_link_name = "base_link";
+  joint_sphere.child_link_name = link_sphere.getName();
+  joint_sphere.type = tesseract_scene_graph::JointType::FIXED;
+  env->applyCommand(std::make_shared<tesseract_environment::AddLinkCommand>(link_sphere, joint_sphere));
+
+  return env;
+}
+
+/**
+ * @brief Evaluate random edges
+ * @details The first argument is the collision evaluator type and the second is one if collisions are allowed.
+ */
+template <typename EvaluatorType>
+static void BM_DESCARTES_COLLISION_EDGE_EVALUATOR(benchmark::State& state)
+{
+  tesseract_environment::Environment::Ptr env = createEnvironment();
+  tesseract_kinematics::JointGroup::ConstPtr manip = env->getJointGroup("manipulator");
+
+  tesseract_collision::CollisionCheckConfig config;
+  config.type = static_cast<tesseract_collision::CollisionEvaluatorType>(state.range(0));
+  config.longest_valid_segment_length = 0.05;
+  const bool allow_collision = (state.range(1) != 0);
+
+  EvaluatorType evaluator(*env, manip, config, allow_collision, false, 1);
+
+  // Random edges within the joint limits
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> distribution(0, 1);
+  const Eigen::MatrixX2d limits = manip->getLimits().joint_limits;
+  std::vector<descartes_light::State<double>> start_states;
+  std::vector<descartes_light::State<double>> end_states;
+  std::size_t num_in_collision{ 0 };
+  for (std::size_t i = 0; i < NUM_EDGES; ++i)
+  {
+    Eigen::VectorXd start(limits.rows());
+    Eigen::VectorXd delta(limits.rows());
+    for (Eigen::Index j = 0; j < limits.rows(); ++j)
+    {
+      start(j) = limits(j, 0) + distribution(generator) * (limits(j, 1) - limits(j, 0));
+      delta(j) = distribution(generator) - 0.5;
+    }
+
+    Eigen::VectorXd end = start + delta.normalized() * MAX_EDGE_LENGTH * distribution(generator);
+    end = end.cwiseMax(limits.col(0)).cwiseMin(limits.col(1));
+    start_states.emplace_back(start);
+    end_states.emplace_back(end);
+    // In collision edges are invalid, or have a positive cost if collisions are allowed
+    const std::pair<bool, double> result = evaluator.evaluate(start_states.back(), end_states.back());
+    if (!result.first || result.second > 0)
+      ++num_in_collision;
+  }
+
+  std::size_t index{ 0 };
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(evaluator.evaluate(start_states[index], end_states[index]));
+    index = (index + 1) % NUM_EDGES;
+  }
+
+  state.counters["evaluations_per_second"] = benchmark::Counter(1, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["edges_in_collision"] = static_cast<double>(num_in_collision) / static_cast<double>(NUM_EDGES);
+}
+
+/** @brief The evaluator types and whether collisions are allowed */
+static void EvaluatorArguments(benchmark::internal::Benchmark* b)
+{
+  b->ArgNames({ "type", "allow_collision" });
+  for (auto type : { tesseract_collision::CollisionEvaluatorType::DISCRETE,
+                     tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE,
+                     tesseract_collision::CollisionEvaluatorType::CONTINUOUS,
+                     tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS })
+  {
+    b->Args({ static_cast<long>(type), 0 });
+    b->Args({ static_cast<long>(type), 1 });
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_DESCARTES_COLLISION_EDGE_EVALUATOR, LegacyCollisionEdgeEvaluator)->Apply(EvaluatorArguments);
+BENCHMARK_TEMPLATE(BM_DESCARTES_COLLISION_EDGE_EVALUATOR, DescartesCollisionEdgeEvaluatorD)->Apply(EvaluatorArguments);
+
+BENCHMARK_MAIN();
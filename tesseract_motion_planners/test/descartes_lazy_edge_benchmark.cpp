@@ -0,0 +1,177 @@
+/**
+ * @file descartes_lazy_edge_benchmark.cpp
+ * @brief Benchmark eager and lazy edge collision evaluation for the Descartes ladder graph
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_command_language/cartesian_waypoint.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_motion_planners/descartes/descartes_motion_planner.h>
+#include <tesseract_motion_planners/descartes/descartes_utils.h>
+#include <tesseract_motion_planners/descartes/profile/descartes_default_plan_profile.h>
+#include <tesseract_motion_planners/interface_utils.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+static const std::string DESCARTES_DEFAULT_NAMESPACE = "DescartesMotionPlannerTask";
+
+/** @brief Load the puzzle piece tool path, this matches the poses used by the puzzle piece example */
+static tesseract_common::VectorIsometry3d makePuzzleToolPoses(const tesseract_common::ResourceLocator& locator)
+{
+  tesseract_common::VectorIsometry3d path;
+  auto resource = locator.locateResource("package://tesseract_support/urdf/puzzle_bent.csv");
+  std::ifstream indata(resource->getFilePath());
+
+  std::string line;
+  int lnum = 0;
+  while (std::getline(indata, line))
+  {
+    ++lnum;
+    if (lnum < 3)
+      continue;
+
+    std::stringstream line_stream(line);
+    std::string cell;
+    Eigen::Matrix<double, 6, 1> xyzijk;
+    int i = -2;
+    while (std::getline(line_stream, cell, ','))
+    {
+      ++i;
+      if (i == -1)
+        continue;
+
+      xyzijk(i) = std::stod(cell);
+    }
+
+    // The part was exported in mm
+    Eigen::Vector3d pos = xyzijk.head<3>() / 1000.0;
+    Eigen::Vector3d norm = xyzijk.tail<3>().normalized();
+
+    Eigen::Vector3d temp_x = (-1 * pos).normalized();
+    Eigen::Vector3d y_axis = (norm.cross(temp_x)).normalized();
+    Eigen::Vector3d x_axis = (y_axis.cross(norm)).normalized();
+    Eigen::Isometry3d pose;
+    pose.matrix().col(0).head<3>() = x_axis;
+    pose.matrix().col(1).head<3>() = y_axis;
+    pose.matrix().col(2).head<3>() = norm;
+    pose.matrix().col(3).head<3>() = pos;
+    pose.matrix().row(3) = Eigen::Vector4d(0, 0, 0, 1);
+
+    path.push_back(pose);
+  }
+
+  return path;
+}
+
+/** @brief The puzzle piece environment and interpolated program shared by the benchmarks */
+struct PuzzlePieceFixture
+{
+  PuzzlePieceFixture()
+  {
+    auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+    env = std::make_shared<tesseract_environment::Environment>();
+    tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/puzzle_piece_workcell.urdf");
+    tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/puzzle_piece_workcell.srdf");
+    env->init(urdf_path, srdf_path, locator);
+
+    std::vector<std::string> joint_names{ "joint_a1", "joint_a2", "joint_a3", "joint_a4",
+                                          "joint_a5", "joint_a6", "joint_a7" };
+    Eigen::VectorXd joint_pos(7);
+    joint_pos << -0.785398, 0.4, 0.0, -1.9, 0.0, 1.0, 0.0;
+    env->setState(joint_names, joint_pos);
+
+    tesseract_common::ManipulatorInfo mi;
+    mi.manipulator = "manipulator";
+    mi.working_frame = "part";
+    mi.tcp_frame = "grinder_frame";
+
+    CompositeInstruction program("DEFAULT", CompositeInstructionOrder::ORDERED, mi);
+    for (const auto& tool_pose : makePuzzleToolPoses(*locator))
+    {
+      CartesianWaypointPoly wp{ CartesianWaypoint(tool_pose) };
+      program.appendMoveInstruction(MoveInstruction(wp, MoveInstructionType::LINEAR, "TEST_PROFILE"));
+    }
+
+    request.instructions = generateInterpolatedProgram(program, env->getState(), env, 3.14, 1.0, 3.14, 1);
+    request.env = env;
+    request.env_state = env->getState();
+  }
+
+  tesseract_environment::Environment::Ptr env;
+  PlannerRequest request;
+};
+
+/**
+ * @brief Solve the puzzle piece path with edge collision checking enabled
+ * @details The first argument selects lazy (1) or eager (0) edge collision evaluation and the second is the number of
+ * threads. The planner statistics are reported as counters so the build and search phases can be compared.
+ */
+static void BM_DESCARTES_PUZZLE_PIECE_EDGE_COLLISION(benchmark::State& state)
+{
+  PuzzlePieceFixture fixture;
+
+  auto plan_profile = std::make_shared<DescartesDefaultPlanProfileD>();
+  plan_profile->target_pose_sampler = [](const Eigen::Isometry3d& tool_pose) {
+    return sampleToolAxis(tool_pose, 10 * M_PI / 180.0, Eigen::Vector3d(0, 0, 1));
+  };
+  plan_profile->enable_edge_collision = true;
+  plan_profile->lazy_edge_collision = (state.range(0) != 0);
+  plan_profile->num_threads = static_cast<int>(state.range(1));
+
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<DescartesPlanProfile<double>>(DESCARTES_DEFAULT_NAMESPACE, "TEST_PROFILE", plan_profile);
+  fixture.request.profiles = profiles;
+
+  DescartesMotionPlannerD planner(DESCARTES_DEFAULT_NAMESPACE);
+  std::unordered_map<std::string, double> totals;
+  for (auto _ : state)
+  {
+    PlannerResponse response = planner.solve(fixture.request);
+    if (!response)
+      state.SkipWithError(response.message.c_str());
+
+    for (const auto& statistic : response.statistics)
+      totals[statistic.first] += statistic.second;
+  }
+
+  for (const auto& total : totals)
+    state.counters[total.first] = benchmark::Counter(total.second, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_DESCARTES_PUZZLE_PIECE_EDGE_COLLISION)
+    ->ArgNames({ "lazy", "threads" })
+    ->Args({ 0, 1 })
+    ->Args({ 1, 1 })
+    ->Args({ 0, 4 })
+    ->Args({ 1, 4 })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
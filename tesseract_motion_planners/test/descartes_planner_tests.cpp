@@ -35,6 +35,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_common/types.h>
 
 #include <tesseract_environment/environment.h>
+#include <tesseract_environment/commands.h>
+#include <tesseract_geometry/impl/sphere.h>
 
 #include <tesseract_command_language/joint_waypoint.h>
 #include <tesseract_command_language/cartesian_waypoint.h>
@@ -42,6 +44,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_command_language/utils.h>
 
 #include <tesseract_motion_planners/descartes/descartes_motion_planner.h>
+#include <tesseract_motion_planners/descartes/descartes_collision_edge_evaluator.h>
 #include <tesseract_motion_planners/descartes/descartes_utils.h>
 #include <tesseract_motion_planners/descartes/profile/descartes_default_plan_profile.h>
 #include <tesseract_motion_planners/core/types.h>
@@ -400,6 +403,297 @@ TEST_F(TesseractPlanningDescartesUnit, DescartesPlannerCollisionEdgeEvaluator)
   }
 }
 
+TEST_F(TesseractPlanningDescartesUnit, DescartesPlannerLazyCollisionEdgeEvaluator)  // NOLINT
+{
+  auto cur_state = env_->getState();
+
+  // Specify a start waypoint
+  CartesianWaypointPoly wp1{ CartesianWaypoint(Eigen::Isometry3d::Identity() * Eigen::Translation3d(0.8, -.10, 0.8) *
+                                               Eigen::Quaterniond(0, 0, -1.0, 0)) };
+
+  // Specify a end waypoint
+  CartesianWaypointPoly wp2{ CartesianWaypoint(Eigen::Isometry3d::Identity() * Eigen::Translation3d(0.8, .10, 0.8) *
+                                               Eigen::Quaterniond(0, 0, -1.0, 0)) };
+
+  // Define Start Instruction
+  MoveInstruction start_instruction(wp1, MoveInstructionType::LINEAR, "TEST_PROFILE", manip);
+
+  // Define Plan Instructions
+  MoveInstruction plan_f1(wp2, MoveInstructionType::LINEAR, "TEST_PROFILE", manip);
+
+  // Create a program
+  CompositeInstruction program;
+  program.setManipulatorInfo(manip);
+  program.appendMoveInstruction(start_instruction);
+  program.appendMoveInstruction(plan_f1);
+
+  // Create a seed
+  CompositeInstruction interpolated_program = generateInterpolatedProgram(program, cur_state, env_, 3.14, 1.0, 3.14, 5);
+
+  // Create Profiles
+  auto plan_profile = std::make_shared<DescartesDefaultPlanProfileD>();
+  plan_profile->target_pose_sampler = [](const Eigen::Isometry3d& tool_pose) {
+    return tesseract_planning::sampleToolAxis(tool_pose, 60 * M_PI * 180.0, Eigen::Vector3d(0, 0, 1));
+  };
+  plan_profile->enable_edge_collision = true;
+  plan_profile->lazy_edge_collision = true;
+  plan_profile->num_threads = 4;
+
+  // Profile Dictionary
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<DescartesPlanProfile<double>>(DESCARTES_DEFAULT_NAMESPACE, "TEST_PROFILE", plan_profile);
+
+  // Create Planning Request
+  PlannerRequest request;
+  request.instructions = interpolated_program;
+  request.env = env_;
+  request.env_state = cur_state;
+  request.profiles = profiles;
+
+  // The collision evaluators are lazy, so the edge evaluators only compute the distance
+  DescartesMotionPlannerD descartes_planner(DESCARTES_DEFAULT_NAMESPACE);
+  auto problem = descartes_planner.createProblem(request);
+  ASSERT_EQ(problem->edge_evaluators.size(), problem->samplers.size() - 1);
+  ASSERT_EQ(problem->lazy_edge_evaluators.size(), problem->edge_evaluators.size());
+  for (const auto& evaluator : problem->lazy_edge_evaluators)
+    EXPECT_TRUE(evaluator != nullptr);
+
+  PlannerResponse lazy_response = descartes_planner.solve(request);
+  EXPECT_TRUE(lazy_response.successful);
+  EXPECT_GE(lazy_response.statistics.at("num_searches"), 1);
+  EXPECT_GE(lazy_response.statistics.at("num_lazy_edge_evaluations"),
+            static_cast<double>(problem->edge_evaluators.size()));
+
+  auto expect_same_results = [](const PlannerResponse& lazy_response, const PlannerResponse& eager_response) {
+    auto lazy_results = lazy_response.results.flatten(&moveFilter);
+    auto eager_results = eager_response.results.flatten(&moveFilter);
+    ASSERT_EQ(lazy_results.size(), eager_results.size());
+    for (std::size_t i = 0; i < lazy_results.size(); ++i)
+    {
+      const auto& lazy_mi = lazy_results[i].get().as<MoveInstructionPoly>();
+      const auto& eager_mi = eager_results[i].get().as<MoveInstructionPoly>();
+      EXPECT_TRUE(getJointPosition(lazy_mi.getWaypoint()).isApprox(getJointPosition(eager_mi.getWaypoint()), 1e-5));
+    }
+  };
+
+  // The same path is found when every edge is checked for collision up front
+  plan_profile->lazy_edge_collision = false;
+  PlannerResponse eager_response = descartes_planner.solve(request);
+  EXPECT_TRUE(eager_response.successful);
+  EXPECT_EQ(eager_response.statistics.count("num_searches"), 0);
+  expect_same_results(lazy_response, eager_response);
+
+  // When collisions are allowed the lazy evaluators add a cost to the edges instead of removing them
+  plan_profile->allow_collision = true;
+  plan_profile->lazy_edge_collision = true;
+  PlannerResponse lazy_allow_response = descartes_planner.solve(request);
+  EXPECT_TRUE(lazy_allow_response.successful);
+  EXPECT_GE(lazy_allow_response.statistics.at("num_searches"), 1);
+
+  plan_profile->lazy_edge_collision = false;
+  PlannerResponse eager_allow_response = descartes_planner.solve(request);
+  EXPECT_TRUE(eager_allow_response.successful);
+  expect_same_results(lazy_allow_response, eager_allow_response);
+}
+
+/**
+ * @brief Add a sphere 0.3m in front of tool0 and a static sphere of the same radius
+ * @details The static sphere is centered where the tool sphere is with joint_1 rotated 0.05 radians past zero, so
+ * rotating joint_1 from -0.2 to zero moves the tool sphere into it and the penetration is deepest at the end.
+ * @return The distance between the spheres with all joints at zero
+ */
+static double addPenetratingSpheres(Environment& env, double radius)
+{
+  auto collision = std::make_shared<Collision>();
+  collision->origin = Eigen::Isometry3d::Identity();
+  collision->geometry = std::make_shared<tesseract_geometry::Sphere>(radius);
+
+  Link tool_sphere("tool_sphere");
+  tool_sphere.collision.push_back(collision);
+  Joint tool_joint("tool_sphere_joint");
+  tool_joint.parent_link_name = "tool0";
+  tool_joint.child_link_name = tool_sphere.getName();
+  tool_joint.type = JointType::FIXED;
+  tool_joint.parent_to_joint_origin_transform.translation() = Eigen::Vector3d(0, 0, 0.3);
+  EXPECT_TRUE(env.applyCommand(std::make_shared<AddLinkCommand>(tool_sphere, tool_joint)));
+
+  JointGroup::ConstPtr joint_group = env.getJointGroup("manipulator");
+  const Eigen::Vector3d end_center = joint_group->calcFwdKin(Eigen::VectorXd::Zero(6)).at("tool_sphere").translation();
+  const Eigen::Vector3d obstacle_center = Eigen::AngleAxisd(0.05, Eigen::Vector3d::UnitZ()) * end_center;
+
+  Link obstacle("obstacle_sphere");
+  obstacle.collision.push_back(collision);
+  Joint obstacle_joint("obstacle_sphere_joint");
+  obstacle_joint.parent_link_name = "base_link";
+  obstacle_joint.child_link_name = obstacle.getName();
+  obstacle_joint.type = JointType::FIXED;
+  obstacle_joint.parent_to_joint_origin_transform.translation() = obstacle_center;
+  EXPECT_TRUE(env.applyCommand(std::make_shared<AddLinkCommand>(obstacle, obstacle_joint)));
+
+  return (end_center - obstacle_center).norm() - 2 * radius;
+}
+
+TEST_F(TesseractPlanningDescartesUnit, DescartesCollisionEdgeEvaluatorAllowCollisionCost)  // NOLINT
+{
+  const double margin = 0.05;
+  const double end_distance = addPenetratingSpheres(*env_, 0.05);
+  ASSERT_LT(end_distance, 0);
+
+  JointGroup::ConstPtr joint_group = env_->getJointGroup(manip.manipulator);
+  Eigen::VectorXd start_values = Eigen::VectorXd::Zero(6);
+  start_values(0) = -0.2;
+  const State<double> start(start_values);
+  const State<double> end(Eigen::VectorXd::Zero(6));
+
+  // The cost uses the deepest penetration over the whole edge, not the first contact found
+  for (auto type : { CollisionEvaluatorType::DISCRETE,
+                     CollisionEvaluatorType::LVS_DISCRETE,
+                     CollisionEvaluatorType::CONTINUOUS,
+                     CollisionEvaluatorType::LVS_CONTINUOUS })
+  {
+    CollisionCheckConfig config;
+    config.type = type;
+    config.longest_valid_segment_length = 0.01;
+    config.contact_manager_config = ContactManagerConfig(margin);
+
+    DescartesCollisionEdgeEvaluatorD evaluator(*env_, joint_group, config, true, false, 1);
+    std::pair<bool, double> result = evaluator.evaluate(start, end);
+    EXPECT_TRUE(result.first);
+    EXPECT_NEAR(result.second, margin - end_distance, 1e-4);
+
+    // Collisions are not allowed, the edge is invalid
+    DescartesCollisionEdgeEvaluatorD invalid_evaluator(*env_, joint_group, config, false, false, 1);
+    EXPECT_FALSE(invalid_evaluator.evaluate(start, end).first);
+
+    // An edge which stays clear of the static sphere has no cost
+    std::pair<bool, double> clear_result = evaluator.evaluate(start, start);
+    EXPECT_TRUE(clear_result.first);
+    EXPECT_DOUBLE_EQ(clear_result.second, 0);
+  }
+}
+
+TEST_F(TesseractPlanningDescartesUnit, DescartesPlannerIKCache)  // NOLINT
+{
+  auto cur_state = env_->getState();
+
+  // Specify a start waypoint
+  CartesianWaypointPoly wp1{ CartesianWaypoint(Eigen::Isometry3d::Identity() * Eigen::Translation3d(0.8, -.20, 0.8) *
+                                               Eigen::Quaterniond(0, 0, -1.0, 0)) };
+
+  // Specify a end waypoint
+  CartesianWaypointPoly wp2{ CartesianWaypoint(Eigen::Isometry3d::Identity() * Eigen::Translation3d(0.8, .20, 0.8) *
+                                               Eigen::Quaterniond(0, 0, -1.0, 0)) };
+
+  // Define Start Instruction
+  MoveInstruction start_instruction(wp1, MoveInstructionType::LINEAR, "TEST_PROFILE", manip);
+
+  // Define Plan Instructions
+  MoveInstruction plan_f1(wp2, MoveInstructionType::LINEAR, "TEST_PROFILE", manip);
+
+  // Create a program
+  CompositeInstruction program;
+  program.setManipulatorInfo(manip);
+  program.appendMoveInstruction(start_instruction);
+  program.appendMoveInstruction(plan_f1);
+
+  // Create a seed
+  CompositeInstruction interpolated_program =
+      generateInterpolatedProgram(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+
+  // Create Profiles
+  auto plan_profile = std::make_shared<DescartesDefaultPlanProfileD>();
+  plan_profile->target_pose_sampler = [](const Eigen::Isometry3d& tool_pose) {
+    return tesseract_planning::sampleToolAxis(tool_pose, M_PI_4, Eigen::Vector3d(0, 0, 1));
+  };
+
+  // Profile Dictionary
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<DescartesPlanProfile<double>>(DESCARTES_DEFAULT_NAMESPACE, "TEST_PROFILE", plan_profile);
+
+  // Create Planning Request
+  PlannerRequest request;
+  request.instructions = interpolated_program;
+  request.env = env_;
+  request.env_state = cur_state;
+  request.profiles = profiles;
+
+  // Solve without a cache on a single thread
+  DescartesMotionPlannerD single_descartes_planner(DESCARTES_DEFAULT_NAMESPACE);
+  plan_profile->num_threads = 1;
+  PlannerResponse single_planner_response = single_descartes_planner.solve(request);
+  EXPECT_TRUE(single_planner_response.successful);
+  EXPECT_EQ(single_planner_response.statistics.count("sample_time"), 1);
+  EXPECT_EQ(single_planner_response.statistics.count("build_time"), 1);
+  EXPECT_EQ(single_planner_response.statistics.count("search_time"), 1);
+  EXPECT_GT(single_planner_response.statistics.at("num_samples"), 0);
+  EXPECT_EQ(single_planner_response.statistics.count("ik_cache_hit_rate"), 0);
+
+  // Solve with a cache on multiple threads, the second solve finds every pose in the cache
+  DescartesMotionPlannerD descartes_planner(DESCARTES_DEFAULT_NAMESPACE);
+  auto ik_cache = std::make_shared<DescartesIKCache>();
+  descartes_planner.setIKCache(ik_cache);
+  EXPECT_EQ(descartes_planner.getIKCache(), ik_cache);
+  EXPECT_EQ(std::dynamic_pointer_cast<DescartesMotionPlannerD>(descartes_planner.clone())->getIKCache(), ik_cache);
+  plan_profile->num_threads = 4;
+
+  PlannerResponse first_planner_response = descartes_planner.solve(request);
+  EXPECT_TRUE(first_planner_response.successful);
+  EXPECT_GT(ik_cache->size(), 0);
+  const std::size_t num_poses = ik_cache->getLookupCount();
+
+  PlannerResponse planner_response = descartes_planner.solve(request);
+  EXPECT_TRUE(planner_response.successful);
+  EXPECT_EQ(ik_cache->getLookupCount(), 2 * num_poses);
+  EXPECT_GE(ik_cache->getHitCount(), num_poses);
+  EXPECT_GE(planner_response.statistics.at("ik_cache_hit_rate"), 0.5);
+  EXPECT_EQ(planner_response.statistics.at("num_samples"), single_planner_response.statistics.at("num_samples"));
+
+  auto official_results = single_planner_response.results.flatten(&moveFilter);
+  auto results = planner_response.results.flatten(&moveFilter);
+  ASSERT_EQ(official_results.size(), results.size());
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const auto& mv_official = official_results[i].get().as<MoveInstructionPoly>();
+    const auto& mv = results[i].get().as<MoveInstructionPoly>();
+    EXPECT_TRUE(getJointPosition(mv_official.getWaypoint()).isApprox(getJointPosition(mv.getWaypoint()), 1e-5));
+  }
+}
+
+TEST_F(TesseractPlanningDescartesUnit, DescartesIKCacheContext)  // NOLINT
+{
+  KinematicGroup::ConstPtr opw_manip = env_->getKinematicGroup("manipulator", "OPWInvKin");
+  KinematicGroup::ConstPtr kdl_manip = env_->getKinematicGroup("manipulator", "KDLInvKinChainLMA");
+  const std::string opw_context = DescartesIKCache::createContext(*env_, *opw_manip, "OPWInvKin");
+  const std::string kdl_context = DescartesIKCache::createContext(*env_, *kdl_manip, "KDLInvKinChainLMA");
+  EXPECT_EQ(opw_context, DescartesIKCache::createContext(*env_, *opw_manip, "OPWInvKin"));
+  EXPECT_NE(opw_context, kdl_context);
+
+  // The joints of the group do not change the context
+  Eigen::VectorXd joint_values = Eigen::VectorXd::Constant(6, 0.1);
+  env_->setState(opw_manip->getJointNames(), joint_values);
+  EXPECT_EQ(opw_context, DescartesIKCache::createContext(*env_, *opw_manip, "OPWInvKin"));
+
+  // The solutions of one solver are not found with another
+  const Eigen::Isometry3d pose = Eigen::Isometry3d::Identity() * Eigen::Translation3d(0.8, 0, 0.8);
+  tesseract_kinematics::IKSolutions solutions{ joint_values };
+  DescartesIKCache ik_cache;
+  ik_cache.insert(opw_context, "base_link", "tool0", pose, solutions);
+
+  tesseract_kinematics::IKSolutions found;
+  EXPECT_FALSE(ik_cache.lookup(kdl_context, "base_link", "tool0", pose, found));
+  EXPECT_FALSE(ik_cache.lookup(opw_context, "base_link", "tool0", pose * Eigen::Translation3d(0, 0, 1e-9), found));
+  ASSERT_TRUE(ik_cache.lookup(opw_context, "base_link", "tool0", pose, found));
+  ASSERT_EQ(found.size(), 1);
+  EXPECT_TRUE(found[0].isApprox(joint_values));
+
+  // A new revision of the environment changes the context
+  EXPECT_TRUE(env_->applyCommand(std::make_shared<ChangeJointPositionLimitsCommand>("joint_1", -1.0, 1.0)));
+  opw_manip = env_->getKinematicGroup("manipulator", "OPWInvKin");
+  const std::string new_context = DescartesIKCache::createContext(*env_, *opw_manip, "OPWInvKin");
+  EXPECT_NE(opw_context, new_context);
+  EXPECT_FALSE(ik_cache.lookup(new_context, "base_link", "tool0", pose, found));
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
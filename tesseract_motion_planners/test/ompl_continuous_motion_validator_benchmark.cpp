@@ -0,0 +1,376 @@
+/**
+ * @file ompl_continuous_motion_validator_benchmark.cpp
+ * @brief Benchmark the continuous motion validator checking random motions and planning with RRTConnect
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_environment/commands.h>
+#include <tesseract_geometry/impl/sphere.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
+#include <tesseract_motion_planners/interface_utils.h>
+#include <tesseract_motion_planners/ompl/continuous_motion_validator.h>
+#include <tesseract_motion_planners/ompl/ompl_motion_planner.h>
+#include <tesseract_motion_planners/ompl/ompl_planner_configurator.h>
+#include <tesseract_motion_planners/ompl/profile/ompl_default_plan_profile.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+static const std::string OMPL_DEFAULT_NAMESPACE = "OMPLMotionPlannerTask";
+
+/** @brief The maximum number of threads, similar to the number of planners used by a ParallelPlan */
+static const int MAX_THREADS = 8;
+
+/** @brief The number of random motions each thread cycles through */
+static const std::size_t NUM_MOTIONS = 1000;
+
+/**
+ * @brief The continuous motion validator prior to reusing its scratch data
+ * @details Every motion allocates two states, interpolates and solves the forward kinematics of each sub-state
+ * twice and checks every sub-segment even after one is invalid.
+ */
+class LegacyContinuousMotionValidator : public ompl::base::MotionValidator
+{
+public:
+  LegacyContinuousMotionValidator(const ompl::base::SpaceInformationPtr& space_info,
+                                  const tesseract_environment::Environment& env,
+                                  tesseract_kinematics::JointGroup::ConstPtr manip,
+                                  const tesseract_collision::CollisionCheckConfig& collision_check_config,
+                                  OMPLStateExtractor extractor,
+                                  std::size_t num_threads)
+    : MotionValidator(space_info), manip_(std::move(manip)), extractor_(std::move(extractor))
+  {
+    links_ = manip_->getActiveLinkNames();
+    tesseract_collision::ContinuousContactManager::Ptr manager = env.getContinuousContactManager();
+    manager->setActiveCollisionObjects(links_);
+    manager->applyContactManagerConfig(collision_check_config.contact_manager_config);
+    contact_managers_ = std::make_unique<ContinuousContactManagerPool>(std::move(manager));
+    contact_managers_->warm(num_threads);
+  }
+
+  bool checkMotion(const ompl::base::State* s1, const ompl::base::State* s2) const override
+  {
+    std::pair<ompl::base::State*, double> dummy = { nullptr, 0.0 };
+    return checkMotion(s1, s2, dummy);
+  }
+
+  bool checkMotion(const ompl::base::State* s1,
+                   const ompl::base::State* s2,
+                   std::pair<ompl::base::State*, double>& lastValid) const override
+  {
+    const ompl::base::StateSpace& state_space = *si_->getStateSpace();
+    unsigned n_steps = state_space.validSegmentCount(s1, s2);
+    bool is_valid = true;
+
+    ompl::base::State* start_interp = si_->allocState();
+    ompl::base::State* end_interp = si_->allocState();
+    for (unsigned i = 1; i <= n_steps; ++i)
+    {
+      state_space.interpolate(s1, s2, (i - 1) / static_cast<double>(n_steps), start_interp);
+      state_space.interpolate(s1, s2, i / static_cast<double>(n_steps), end_interp);
+      if (!continuousCollisionCheck(start_interp, end_interp))
+      {
+        lastValid.second = (i - 1) / static_cast<double>(n_steps);
+        if (lastValid.first != nullptr)
+          state_space.interpolate(s1, s2, lastValid.second, lastValid.first);
+
+        is_valid = false;
+      }
+    }
+    si_->freeState(end_interp);
+    si_->freeState(start_interp);
+
+    return is_valid;
+  }
+
+private:
+  tesseract_kinematics::JointGroup::ConstPtr manip_;
+  std::vector<std::string> links_;
+  OMPLStateExtractor extractor_;
+  ContinuousContactManagerPool::UPtr contact_managers_;
+
+  bool continuousCollisionCheck(const ompl::base::State* s1, const ompl::base::State* s2) const
+  {
+    tesseract_collision::ContinuousContactManager& cm = contact_managers_->get();
+    tesseract_common::TransformMap state0 = manip_->calcFwdKin(extractor_(s1));
+    tesseract_common::TransformMap state1 = manip_->calcFwdKin(extractor_(s2));
+    for (const auto& link_name : links_)
+      cm.setCollisionObjectsTransform(link_name, state0[link_name], state1[link_name]);
+
+    tesseract_collision::ContactResultMap contact_map;
+    cm.contactTest(contact_map, tesseract_collision::ContactTestType::FIRST);
+    return contact_map.empty();
+  }
+};
+
+/** @brief Counts the motions checked by a validator */
+class CountingMotionValidator : public ompl::base::MotionValidator
+{
+public:
+  CountingMotionValidator(const ompl::base::SpaceInformationPtr& space_info,
+                          ompl::base::MotionValidatorPtr validator,
+                          std::atomic<std::size_t>& count)
+    : MotionValidator(space_info), validator_(std::move(validator)), count_(count)
+  {
+  }
+
+  bool checkMotion(const ompl::base::State* s1, const ompl::base::State* s2) const override
+  {
+    ++count_;
+    return validator_->checkMotion(s1, s2);
+  }
+
+  bool checkMotion(const ompl::base::State* s1,
+                   const ompl::base::State* s2,
+                   std::pair<ompl::base::State*, double>& lastValid) const override
+  {
+    ++count_;
+    return validator_->checkMotion(s1, s2, lastValid);
+  }
+
+private:
+  ompl::base::MotionValidatorPtr validator_;
+  std::atomic<std::size_t>& count_;
+};
+
+/** @brief The lbr iiwa with the sphere of the freespace_ompl_example */
+tesseract_environment::Environment::Ptr createEnvironment()
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+  env->init(urdf_path, srdf_path, locator);
+
+  tesseract_scene_graph::Link link_sphere("sphere_attached");
+  auto visual = std::make_shared<tesseract_scene_graph::Visual>();
+  visual->origin = Eigen::Isometry3d::Identity();
+  visual->origin.translation() = Eigen::Vector3d(0.5, 0, 0.55);
+  visual->geometry = std::make_shared<tesseract_geometry::Sphere>(0.15);
+  link_sphere.visual.push_back(visual);
+
+  auto collision = std::make_shared<tesseract_scene_graph::Collision>();
+  collision->origin = visual->origin;
+  collision->geometry = visual->geometry;
+  link_sphere.collision.push_back(collision);
+
+  tesseract_scene_graph::Joint joint_sphere("joint_sphere_attached");
+  joint_sphere.parent_link_name = "base_link";
+  joint_sphere.child_link_name = link_sphere.getName();
+  joint_sphere.type = tesseract_scene_graph::JointType::FIXED;
+  env->applyCommand(std::make_shared<tesseract_environment::AddLinkCommand>(link_sphere, joint_sphere));
+
+  return env;
+}
+
+tesseract_collision::CollisionCheckConfig createCollisionCheckConfig()
+{
+  tesseract_collision::CollisionCheckConfig config;
+  config.type = tesseract_collision::CollisionEvaluatorType::CONTINUOUS;
+  config.longest_valid_segment_length = 0.1;
+  return config;
+}
+
+template <typename ValidatorType>
+ompl::base::MotionValidatorPtr createValidator(const ompl::base::SpaceInformationPtr& space_info,
+                                               const tesseract_environment::Environment& env,
+                                               const tesseract_kinematics::JointGroup::ConstPtr& manip,
+                                               const OMPLStateExtractor& extractor,
+                                               std::size_t num_threads);
+
+template <>
+ompl::base::MotionValidatorPtr createValidator<LegacyContinuousMotionValidator>(
+    const ompl::base::SpaceInformationPtr& space_info,
+    const tesseract_environment::Environment& env,
+    const tesseract_kinematics::JointGroup::ConstPtr& manip,
+    const OMPLStateExtractor& extractor,
+    std::size_t num_threads)
+{
+  return std::make_shared<LegacyContinuousMotionValidator>(
+      space_info, env, manip, createCollisionCheckConfig(), extractor, num_threads);
+}
+
+template <>
+ompl::base::MotionValidatorPtr createValidator<ContinuousMotionValidator>(
+    const ompl::base::SpaceInformationPtr& space_info,
+    const tesseract_environment::Environment& env,
+    const tesseract_kinematics::JointGroup::ConstPtr& manip,
+    const OMPLStateExtractor& extractor,
+    std::size_t num_threads)
+{
+  return std::make_shared<ContinuousMotionValidator>(
+      space_info, nullptr, env, manip, createCollisionCheckConfig(), extractor, num_threads);
+}
+
+struct ValidatorData
+{
+  tesseract_environment::Environment::Ptr env;
+  ompl::base::SpaceInformationPtr space_info;
+  ompl::base::MotionValidatorPtr validator;
+  std::vector<ompl::base::State*> start_states;
+  std::vector<ompl::base::State*> end_states;
+};
+
+template <typename ValidatorType>
+ValidatorData& getValidatorData()
+{
+  static ValidatorData validator_data = []() {
+    ValidatorData data;
+    data.env = createEnvironment();
+    auto manip = data.env->getJointGroup("manipulator");
+
+    const auto dof = static_cast<unsigned>(manip->numJoints());
+    const Eigen::MatrixX2d limits = manip->getLimits().joint_limits;
+    auto state_space = std::make_shared<ompl::base::RealVectorStateSpace>(dof);
+    ompl::base::RealVectorBounds bounds(dof);
+    for (unsigned i = 0; i < dof; ++i)
+    {
+      bounds.setLow(i, limits(i, 0));
+      bounds.setHigh(i, limits(i, 1));
+    }
+    state_space->setBounds(bounds);
+    state_space->setLongestValidSegmentFraction(0.1 / state_space->getMaximumExtent());
+    data.space_info = std::make_shared<ompl::base::SpaceInformation>(state_space);
+
+    OMPLStateExtractor extractor = [dof](const ompl::base::State* state) -> Eigen::Map<Eigen::VectorXd> {
+      return RealVectorStateSpaceExtractor(state, dof);
+    };
+    data.validator = createValidator<ValidatorType>(
+        data.space_info, *data.env, manip, extractor, static_cast<std::size_t>(MAX_THREADS));
+
+    // Short motions similar to the range of the planners, so both valid and invalid motions are checked
+    ompl::base::StateSamplerPtr sampler = data.space_info->allocStateSampler();
+    data.start_states.resize(NUM_MOTIONS);
+    data.end_states.resize(NUM_MOTIONS);
+    data.space_info->allocStates(data.start_states);
+    data.space_info->allocStates(data.end_states);
+    for (std::size_t i = 0; i < NUM_MOTIONS; ++i)
+    {
+      sampler->sampleUniform(data.start_states[i]);
+      sampler->sampleUniformNear(data.end_states[i], data.start_states[i], 1.0);
+    }
+    return data;
+  }();
+  return validator_data;
+}
+
+/** @brief Check random motions with a validator shared by all threads, like the planners of a ParallelPlan */
+template <typename ValidatorType>
+static void BM_CONTINUOUS_MOTION_VALIDATOR_CHECK_MOTION(benchmark::State& state)
+{
+  ValidatorData& data = getValidatorData<ValidatorType>();
+  std::pair<ompl::base::State*, double> last_valid{ nullptr, 0.0 };
+  auto idx = static_cast<std::size_t>(state.thread_index());
+  for (auto _ : state)
+  {
+    const std::size_t i = idx++ % NUM_MOTIONS;
+    bool valid = data.validator->checkMotion(data.start_states[i], data.end_states[i], last_valid);
+    benchmark::DoNotOptimize(valid);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+/** @brief Plan the freespace_ompl_example with RRTConnect, the argument is the number of parallel planners */
+template <typename ValidatorType>
+static void BM_OMPL_RRT_CONNECT_FREESPACE(benchmark::State& state)
+{
+  auto env = createEnvironment();
+  tesseract_common::ManipulatorInfo manip_info("manipulator", "base_link", "tool0");
+  auto manip = env->getJointGroup(manip_info.manipulator);
+  const std::vector<std::string> joint_names = manip->getJointNames();
+
+  Eigen::VectorXd joint_start_pos(7);
+  joint_start_pos << -0.4, 0.2762, 0.0, -1.3348, 0.0, 1.4959, 0.0;
+  Eigen::VectorXd joint_end_pos(7);
+  joint_end_pos << 0.4, 0.2762, 0.0, -1.3348, 0.0, 1.4959, 0.0;
+  env->setState(joint_names, joint_start_pos);
+
+  CompositeInstruction program("FREESPACE", CompositeInstructionOrder::ORDERED, manip_info);
+  StateWaypointPoly wp0{ StateWaypoint(joint_names, joint_start_pos) };
+  StateWaypointPoly wp1{ StateWaypoint(joint_names, joint_end_pos) };
+  program.appendMoveInstruction(MoveInstruction(wp0, MoveInstructionType::FREESPACE, "FREESPACE"));
+  program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE, "FREESPACE"));
+
+  std::atomic<std::size_t> motion_checks{ 0 };
+  const auto num_planners = static_cast<std::size_t>(state.range(0));
+  auto plan_profile = std::make_shared<OMPLDefaultPlanProfile>();
+  plan_profile->collision_check_config = createCollisionCheckConfig();
+  plan_profile->planning_time = 10;
+  plan_profile->planners.assign(num_planners, std::make_shared<RRTConnectConfigurator>());
+  plan_profile->mv_allocator = [&motion_checks, &env, num_planners](const ompl::base::SpaceInformationPtr& si,
+                                                                    const OMPLProblem& prob) {
+    auto validator = createValidator<ValidatorType>(si, *env, prob.manip, prob.extractor, num_planners);
+    return std::make_shared<CountingMotionValidator>(si, validator, motion_checks);
+  };
+
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<OMPLPlanProfile>(OMPL_DEFAULT_NAMESPACE, "FREESPACE", plan_profile);
+
+  PlannerRequest request;
+  request.instructions = generateInterpolatedProgram(program, env->getState(), env, 3.14, 1.0, 3.14, 10);
+  request.env = env;
+  request.env_state = env->getState();
+  request.profiles = profiles;
+
+  OMPLMotionPlanner planner(OMPL_DEFAULT_NAMESPACE);
+  for (auto _ : state)
+  {
+    PlannerResponse response = planner.solve(request);
+    if (!response)
+    {
+      state.SkipWithError(response.message.c_str());
+      break;
+    }
+  }
+
+  state.counters["motion_checks_per_second"] =
+      benchmark::Counter(static_cast<double>(motion_checks), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(BM_CONTINUOUS_MOTION_VALIDATOR_CHECK_MOTION, LegacyContinuousMotionValidator)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_CONTINUOUS_MOTION_VALIDATOR_CHECK_MOTION, ContinuousMotionValidator)
+    ->ThreadRange(1, MAX_THREADS)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_OMPL_RRT_CONNECT_FREESPACE, LegacyContinuousMotionValidator)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_OMPL_RRT_CONNECT_FREESPACE, ContinuousMotionValidator)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
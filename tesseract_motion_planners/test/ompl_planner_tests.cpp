@@ -41,6 +41,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <ompl/geometric/planners/prm/SPARS.h>
 
 #include <ompl/util/RandomNumbers.h>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
 
 #include <functional>
 #include <cmath>
@@ -52,6 +54,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_environment/environment.h>
 #include <tesseract_environment/utils.h>
 #include <tesseract_motion_planners/ompl/ompl_motion_planner.h>
+#include <tesseract_motion_planners/ompl/continuous_motion_validator.h>
 #include <tesseract_motion_planners/ompl/ompl_planner_configurator.h>
 #include <tesseract_motion_planners/ompl/profile/ompl_default_plan_profile.h>
 
@@ -558,6 +561,199 @@ TYPED_TEST(OMPLTestFixture, OMPLFreespaceCartesianStartPlannerUnit)  // NOLINT
 //  kin->getJointNames());
 //}
 
+TEST(OMPLMultiThreadedPlannerUnit, OMPLFreespaceMultiThreadedPlannerUnit)  // NOLINT
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  Environment::Ptr env = std::make_shared<Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+  EXPECT_TRUE(env->init(urdf_path, srdf_path, locator));
+  addBox(*env);
+
+  tesseract_common::ManipulatorInfo manip;
+  manip.manipulator = "manipulator";
+  manip.working_frame = "base_link";
+  manip.tcp_frame = "tool0";
+
+  auto joint_group = env->getJointGroup(manip.manipulator);
+  auto cur_state = env->getState();
+
+  JointWaypointPoly wp1{ JointWaypoint(
+      joint_group->getJointNames(),
+      Eigen::Map<const Eigen::VectorXd>(start_state.data(), static_cast<long>(start_state.size()))) };
+  JointWaypointPoly wp2{ JointWaypoint(
+      joint_group->getJointNames(),
+      Eigen::Map<const Eigen::VectorXd>(end_state.data(), static_cast<long>(end_state.size()))) };
+
+  // Four independent sub-problems going back and forth around the box
+  std::vector<boost::uuids::uuid> plan_uuids;
+  auto create_program = [&manip, &wp1, &plan_uuids](const std::vector<JointWaypointPoly>& waypoints) {
+    CompositeInstruction program;
+    program.setManipulatorInfo(manip);
+    program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+    plan_uuids.clear();
+    for (const auto& wp : waypoints)
+    {
+      MoveInstruction plan(wp, MoveInstructionType::FREESPACE, "TEST_PROFILE");
+      plan_uuids.push_back(plan.getUUID());
+      program.appendMoveInstruction(plan);
+    }
+    return program;
+  };
+  CompositeInstruction program = create_program({ wp2, wp1, wp2, wp1 });
+
+  auto plan_profile = std::make_shared<OMPLDefaultPlanProfile>();
+  plan_profile->collision_check_config.longest_valid_segment_length = 0.1;
+  plan_profile->collision_check_config.type = tesseract_collision::CollisionEvaluatorType::CONTINUOUS;
+  plan_profile->planning_time = 10;
+  plan_profile->optimize = false;
+  plan_profile->max_solutions = 2;
+  plan_profile->simplify = false;
+  plan_profile->planners = { std::make_shared<RRTConnectConfigurator>() };
+
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<OMPLPlanProfile>(OMPL_DEFAULT_NAMESPACE, "TEST_PROFILE", plan_profile);
+
+  PlannerRequest request;
+  request.instructions = generateInterpolatedProgram(program, cur_state, env, 3.14, 1.0, 3.14, 10);
+  request.env = env;
+  request.env_state = cur_state;
+  request.profiles = profiles;
+
+  OMPLMotionPlanner ompl_planner(OMPL_DEFAULT_NAMESPACE);
+  EXPECT_EQ(ompl_planner.getNumThreads(), 1);
+  ompl_planner.setNumThreads(4);
+  EXPECT_EQ(ompl_planner.getNumThreads(), 4);
+  EXPECT_EQ(std::dynamic_pointer_cast<OMPLMotionPlanner>(ompl_planner.clone())->getNumThreads(), 4);
+
+  // The results are merged in program order
+  PlannerResponse planner_response = ompl_planner.solve(request);
+  ASSERT_TRUE(planner_response.successful) << planner_response.message;
+  EXPECT_EQ(planner_response.results.getMoveInstructionCount(), 41);
+  std::size_t found{ 0 };
+  for (const auto& i : planner_response.results)
+  {
+    const auto& mi = i.as<MoveInstructionPoly>();
+    for (std::size_t j = 0; j < plan_uuids.size(); ++j)
+    {
+      if (mi.getUUID() != plan_uuids[j])
+        continue;
+
+      EXPECT_EQ(j, found++);
+      const JointWaypointPoly& wp = (j % 2 == 0) ? wp2 : wp1;
+      EXPECT_TRUE(wp.getPosition().isApprox(getJointPosition(mi.getWaypoint()), 1e-5));
+    }
+  }
+  EXPECT_EQ(found, plan_uuids.size());
+
+  // A waypoint in collision fails the whole request
+  std::vector<double> collision_state = { 0, 0.7, 0.0, 0, 0.0, 0, 0.0 };
+  JointWaypointPoly collision_wp{ JointWaypoint(
+      joint_group->getJointNames(),
+      Eigen::Map<const Eigen::VectorXd>(collision_state.data(), static_cast<long>(collision_state.size()))) };
+  program = create_program({ wp2, collision_wp, wp2, wp1 });
+  request.instructions = generateInterpolatedProgram(program, cur_state, env, 3.14, 1.0, 3.14, 10);
+  request.data = nullptr;
+  planner_response = ompl_planner.solve(request);
+  EXPECT_FALSE(planner_response.successful);
+}
+
+/** @brief Accepts every state and counts the states checked */
+class CountingStateValidityChecker : public ompl::base::StateValidityChecker
+{
+public:
+  using ompl::base::StateValidityChecker::StateValidityChecker;
+
+  bool isValid(const ompl::base::State* /*state*/) const override
+  {
+    ++count;
+    return true;
+  }
+
+  mutable std::size_t count{ 0 };
+};
+
+TEST(OMPLContinuousMotionValidatorUnit, CheckMotionUnit)  // NOLINT
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  Environment::Ptr env = std::make_shared<Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+  EXPECT_TRUE(env->init(urdf_path, srdf_path, locator));
+  addBox(*env);
+
+  auto manip = env->getJointGroup("manipulator");
+  const auto dof = static_cast<unsigned>(manip->numJoints());
+  const Eigen::MatrixX2d limits = manip->getLimits().joint_limits;
+  auto state_space = std::make_shared<ompl::base::RealVectorStateSpace>(dof);
+  ompl::base::RealVectorBounds bounds(dof);
+  for (unsigned i = 0; i < dof; ++i)
+  {
+    bounds.setLow(i, limits(i, 0));
+    bounds.setHigh(i, limits(i, 1));
+  }
+  state_space->setBounds(bounds);
+  state_space->setLongestValidSegmentFraction(0.05 / state_space->getMaximumExtent());
+
+  OMPLStateExtractor extractor = [dof](const ompl::base::State* state) -> Eigen::Map<Eigen::VectorXd> {
+    return RealVectorStateSpaceExtractor(state, dof);
+  };
+
+  tesseract_collision::CollisionCheckConfig config;
+  config.type = tesseract_collision::CollisionEvaluatorType::CONTINUOUS;
+  config.longest_valid_segment_length = 0.05;
+
+  auto space_info = std::make_shared<ompl::base::SpaceInformation>(state_space);
+  auto checker = std::make_shared<CountingStateValidityChecker>(space_info);
+  auto validator = std::make_shared<ContinuousMotionValidator>(space_info, checker, *env, manip, config, extractor);
+  space_info->setStateValidityChecker(checker);
+  space_info->setMotionValidator(validator);
+  space_info->setup();
+
+  // The motion between the states of the planner tests passes through the box
+  ompl::base::State* s1 = space_info->allocState();
+  ompl::base::State* s2 = space_info->allocState();
+  extractor(s1) = Eigen::Map<const Eigen::VectorXd>(start_state.data(), static_cast<long>(start_state.size()));
+  extractor(s2) = Eigen::Map<const Eigen::VectorXd>(end_state.data(), static_cast<long>(end_state.size()));
+
+  const unsigned n_steps = state_space->validSegmentCount(s1, s2);
+  ASSERT_GT(n_steps, 2);
+  std::vector<ompl::base::State*> states(n_steps + 1);
+  space_info->allocStates(states);
+  for (unsigned i = 0; i <= n_steps; ++i)
+    state_space->interpolate(s1, s2, static_cast<double>(i) / static_cast<double>(n_steps), states[i]);
+
+  // Find the first sub-segment in collision by checking each of them on its own
+  unsigned first_invalid = n_steps;
+  for (unsigned i = 0; i < n_steps && first_invalid == n_steps; ++i)
+  {
+    if (!validator->checkMotion(states[i], states[i + 1]))
+      first_invalid = i;
+  }
+  ASSERT_LT(first_invalid, n_steps - 1);
+
+  // The check stops at the first sub-segment in collision and the last valid state is its start
+  checker->count = 0;
+  ompl::base::State* last_valid_state = space_info->allocState();
+  std::pair<ompl::base::State*, double> last_valid{ last_valid_state, 0.0 };
+  EXPECT_FALSE(validator->checkMotion(s1, s2, last_valid));
+  EXPECT_EQ(checker->count, first_invalid + 1);
+  EXPECT_NEAR(last_valid.second, static_cast<double>(first_invalid) / static_cast<double>(n_steps), 1e-12);
+  EXPECT_LT(space_info->distance(last_valid_state, states[first_invalid]), 1e-9);
+
+  space_info->freeState(last_valid_state);
+  space_info->freeStates(states);
+  space_info->freeState(s2);
+  space_info->freeState(s1);
+
+  // The validator and its contact managers do not keep the space information alive
+  std::weak_ptr<ompl::base::SpaceInformation> weak_space_info = space_info;
+  validator.reset();
+  checker.reset();
+  space_info.reset();
+  EXPECT_TRUE(weak_space_info.expired());
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,150 @@
+/**
+ * @file ompl_state_validator_benchmark.cpp
+ * @brief Benchmark the throughput of the OMPL state collision validator as the number of threads increases
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <map>
+#include <mutex>
+#include <thread>
+#include <ompl/base/SpaceInformation.h>
+#include <ompl/base/spaces/RealVectorStateSpace.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
+#include <tesseract_motion_planners/ompl/state_collision_validator.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+/** @brief The maximum number of threads, similar to the number of planners used by a ParallelPlan */
+static const int MAX_THREADS = 16;
+
+/** @brief The number of random states each thread cycles through */
+static const std::size_t NUM_STATES = 1000;
+
+struct BenchmarkData
+{
+  tesseract_environment::Environment::Ptr env;
+  tesseract_kinematics::JointGroup::ConstPtr manip;
+  ompl::base::SpaceInformationPtr space_info;
+  std::shared_ptr<StateCollisionValidator> validator;
+};
+
+BenchmarkData& getBenchmarkData()
+{
+  static BenchmarkData benchmark_data = []() {
+    BenchmarkData data;
+    auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+    data.env = std::make_shared<tesseract_environment::Environment>();
+    tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+    tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+    data.env->init(urdf_path, srdf_path, locator);
+    data.manip = data.env->getJointGroup("manipulator");
+
+    const auto dof = static_cast<unsigned>(data.manip->numJoints());
+    const Eigen::MatrixX2d limits = data.manip->getLimits().joint_limits;
+    auto state_space = std::make_shared<ompl::base::RealVectorStateSpace>(dof);
+    ompl::base::RealVectorBounds bounds(dof);
+    for (unsigned i = 0; i < dof; ++i)
+    {
+      bounds.setLow(i, limits(i, 0));
+      bounds.setHigh(i, limits(i, 1));
+    }
+    state_space->setBounds(bounds);
+    data.space_info = std::make_shared<ompl::base::SpaceInformation>(state_space);
+
+    OMPLStateExtractor extractor = [dof](const ompl::base::State* state) -> Eigen::Map<Eigen::VectorXd> {
+      return RealVectorStateSpaceExtractor(state, dof);
+    };
+
+    tesseract_collision::CollisionCheckConfig config;
+    config.type = tesseract_collision::CollisionEvaluatorType::DISCRETE;
+    data.validator = std::make_shared<StateCollisionValidator>(
+        data.space_info, *data.env, data.manip, config, extractor, static_cast<std::size_t>(MAX_THREADS));
+    return data;
+  }();
+  return benchmark_data;
+}
+
+/** @brief Look up a thread's contact manager the way the validators did prior to ContactManagerPool */
+static void BM_CONTACT_MANAGER_LOOKUP_MUTEX_MAP(benchmark::State& state)
+{
+  static std::mutex mutex;
+  static std::map<unsigned long int, tesseract_collision::DiscreteContactManager::Ptr> contact_managers;
+  BenchmarkData& data = getBenchmarkData();
+  for (auto _ : state)
+  {
+    unsigned long int hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    tesseract_collision::DiscreteContactManager::Ptr cm;
+    mutex.lock();
+    auto it = contact_managers.find(hash);
+    if (it == contact_managers.end())
+    {
+      cm = data.env->getDiscreteContactManager();
+      contact_managers[hash] = cm;
+    }
+    else
+    {
+      cm = it->second;
+    }
+    mutex.unlock();
+    benchmark::DoNotOptimize(cm);
+  }
+}
+
+/** @brief Look up a thread's contact manager using ContactManagerPool */
+static void BM_CONTACT_MANAGER_LOOKUP_POOL(benchmark::State& state)
+{
+  static DiscreteContactManagerPool pool(getBenchmarkData().env->getDiscreteContactManager());
+  for (auto _ : state)
+  {
+    tesseract_collision::DiscreteContactManager& cm = pool.get();
+    benchmark::DoNotOptimize(&cm);
+  }
+}
+
+/** @brief Check random states with a validator shared by all threads, like the planners of a ParallelPlan */
+static void BM_STATE_COLLISION_VALIDATOR_IS_VALID(benchmark::State& state)
+{
+  BenchmarkData& data = getBenchmarkData();
+  ompl::base::StateSamplerPtr sampler = data.space_info->allocStateSampler();
+  std::vector<ompl::base::State*> ompl_states(NUM_STATES);
+  data.space_info->allocStates(ompl_states);
+  for (ompl::base::State* ompl_state : ompl_states)
+    sampler->sampleUniform(ompl_state);
+
+  std::size_t idx = 0;
+  for (auto _ : state)
+  {
+    bool valid = data.validator->isValid(ompl_states[idx++ % NUM_STATES]);
+    benchmark::DoNotOptimize(valid);
+  }
+  data.space_info->freeStates(ompl_states);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CONTACT_MANAGER_LOOKUP_MUTEX_MAP)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_CONTACT_MANAGER_LOOKUP_POOL)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_STATE_COLLISION_VALIDATOR_IS_VALID)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+/**
+ * @file online_trajopt_ifopt_planner_benchmark.cpp
+ * @brief Benchmark the cycle time of the online TrajOpt IFOPT planner replaying a moving target
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <benchmark/benchmark.h>
+#include <cmath>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/trajopt_ifopt/online_trajopt_ifopt_planner.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+/** @brief The number of cycles replayed in each iteration */
+static const int NUM_CYCLES = 200;
+
+/** @brief The radius of the circle the target moves along */
+static const double TARGET_RADIUS = 0.1;
+
+/**
+ * @brief Replay a target moving along a circle, the argument is the number of steps in the horizon
+ * @details The deadline is not limiting so every iteration takes the same SQP steps and replays the same trajectories,
+ * which makes the reported cycle times comparable between runs.
+ */
+static void BM_ONLINE_TRAJOPT_IFOPT_MOVING_TARGET(benchmark::State& state)
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+  env->init(urdf_path, srdf_path, locator);
+
+  tesseract_common::ManipulatorInfo manip_info("manipulator", "base_link", "tool0");
+  auto manip = env->getJointGroup(manip_info.manipulator);
+  Eigen::VectorXd start_state(7);
+  start_state << -0.4, 0.2762, 0.0, -1.3348, 0.0, 1.4959, 0.0;
+  const Eigen::Isometry3d center = manip->calcFwdKin(start_state).at(manip_info.tcp_frame);
+
+  OnlineTrajOptIfoptStatistics statistics;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    OnlineTrajOptIfoptPlanner planner(env, manip_info, static_cast<int>(state.range(0)));
+    planner.cycle_deadline = 1.0;
+    planner.statistics_window = NUM_CYCLES;
+    if (!planner.init(start_state, center * Eigen::Translation3d(0, TARGET_RADIUS, 0)))
+    {
+      state.SkipWithError("The initial problem failed to converge");
+      break;
+    }
+    state.ResumeTiming();
+
+    bool failed{ false };
+    for (int i = 0; i < NUM_CYCLES; ++i)
+    {
+      const double angle = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(NUM_CYCLES);
+      const Eigen::Translation3d offset(0, TARGET_RADIUS * std::cos(angle), TARGET_RADIUS * std::sin(angle));
+      planner.setTargetPose(center * offset);
+      OnlineTrajOptIfoptCycleResult result = planner.cycle();
+      if (result.status == trajopt_sqp::SQPStatus::QP_SOLVER_ERROR)
+      {
+        failed = true;
+        break;
+      }
+    }
+
+    if (failed)
+    {
+      state.SkipWithError("A cycle failed to solve");
+      break;
+    }
+
+    statistics = planner.getStatistics();
+  }
+
+  state.counters["p50_us"] = statistics.p50 * 1e6;
+  state.counters["p99_us"] = statistics.p99 * 1e6;
+  state.counters["max_us"] = statistics.max * 1e6;
+}
+
+BENCHMARK(BM_ONLINE_TRAJOPT_IFOPT_MOVING_TARGET)->Arg(8)->Arg(12)->Arg(20)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -118,6 +118,7 @@ DescartesDefaultPlanProfile<double> genDescartesPlanProfile()
   DescartesDefaultPlanProfile<double> descartes_profile;
 
   descartes_profile.enable_edge_collision = true;
+  descartes_profile.lazy_edge_collision = true;
 
   return descartes_profile;
 }
@@ -189,6 +190,7 @@ TEST(TesseractMotionPlannersDescartesSerializeUnit, SerializeDescartesDefaultPla
   EXPECT_TRUE(
       toXMLFile(imported_plan_profile, tesseract_common::getTempPath() + "descartes_default_plan_example_input2.xml"));
   EXPECT_TRUE(plan_profile.enable_edge_collision == imported_plan_profile.enable_edge_collision);
+  EXPECT_TRUE(plan_profile.lazy_edge_collision == imported_plan_profile.lazy_edge_collision);
 }
 
 int main(int argc, char** argv)
@@ -32,6 +32,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_environment/environment.h>
 #include <tesseract_motion_planners/simple/simple_motion_planner.h>
 #include <tesseract_motion_planners/simple/profile/simple_planner_fixed_size_plan_profile.h>
+#include <tesseract_motion_planners/core/interpolation.h>
+#include <tesseract_motion_planners/core/planner_request_context.h>
 #include <tesseract_command_language/joint_waypoint.h>
 #include <tesseract_command_language/cartesian_waypoint.h>
 #include <tesseract_command_language/move_instruction.h>
@@ -240,6 +242,63 @@ TEST_F(TesseractPlanningSimplePlannerFixedSizeInterpolationUnit, CartCart_JointI
   EXPECT_TRUE(wp2.getTransform().isApprox(final_pose, 1e-3));
 }
 
+TEST_F(TesseractPlanningSimplePlannerFixedSizeInterpolationUnit, PlannerRequestContext)  // NOLINT
+{
+  PlannerRequest request;
+  request.env = env_;
+  request.env_state = env_->getState();
+  PlannerRequestContext context(request);
+  EXPECT_EQ(&context.getRequest(), &request);
+
+  // The kinematics are resolved once per request
+  auto joint_group = context.getJointGroup(manip_info_.manipulator);
+  ASSERT_TRUE(joint_group != nullptr);
+  EXPECT_EQ(joint_group, context.getJointGroup(manip_info_.manipulator));
+  EXPECT_EQ(joint_group->getJointNames(), joint_names_);
+
+  auto kin_group = context.getKinematicGroup(manip_info_.manipulator);
+  ASSERT_TRUE(kin_group != nullptr);
+  EXPECT_EQ(kin_group, context.getKinematicGroup(manip_info_.manipulator));
+
+  EXPECT_TRUE(context.getTCPOffset(manip_info_).isApprox(env_->findTCPOffset(manip_info_)));
+  tesseract_common::ManipulatorInfo offset_manip_info = manip_info_;
+  offset_manip_info.tcp_offset = Eigen::Isometry3d::Identity() * Eigen::Translation3d(0, 0, 0.1);
+  EXPECT_TRUE(context.getTCPOffset(offset_manip_info).isApprox(env_->findTCPOffset(offset_manip_info)));
+
+  // The instruction information shares the kinematics of the context
+  JointWaypointPoly wp1{ JointWaypoint(joint_names_, Eigen::VectorXd::Zero(7)) };
+  MoveInstruction instr1(wp1, MoveInstructionType::FREESPACE, "TEST_PROFILE", manip_info_);
+  KinematicGroupInstructionInfo info1(instr1, context, tesseract_common::ManipulatorInfo());
+  KinematicGroupInstructionInfo info2(instr1, context, tesseract_common::ManipulatorInfo());
+  EXPECT_EQ(info1.manip, kin_group);
+  EXPECT_EQ(info2.manip, kin_group);
+
+  // Generating with the context matches generating with the request
+  MoveInstruction instr1_seed{ instr1 };
+  instr1_seed.assignJointWaypoint(JointWaypoint(joint_names_, request.env_state.getJointValues(joint_names_)));
+  CartesianWaypointPoly wp2{ CartesianWaypoint(Eigen::Isometry3d::Identity()) };
+  MoveInstruction instr2(wp2, MoveInstructionType::LINEAR, "TEST_PROFILE", manip_info_);
+  InstructionPoly instr3;
+
+  SimplePlannerFixedSizePlanProfile profile(10, 10);
+  std::vector<MoveInstructionPoly> expected =
+      profile.generate(instr1, instr1_seed, instr2, instr3, request, tesseract_common::ManipulatorInfo());
+  std::vector<MoveInstructionPoly> move_instructions =
+      profile.generate(instr1, instr1_seed, instr2, instr3, context, tesseract_common::ManipulatorInfo());
+  ASSERT_EQ(move_instructions.size(), expected.size());
+  for (std::size_t i = 0; i < move_instructions.size(); ++i)
+  {
+    const auto& wp = move_instructions[i].getWaypoint();
+    const auto& expected_wp = expected[i].getWaypoint();
+    if (wp.isCartesianWaypoint())
+      EXPECT_TRUE(wp.as<CartesianWaypointPoly>().getTransform().isApprox(
+          expected_wp.as<CartesianWaypointPoly>().getTransform(), 1e-5));
+    else
+      EXPECT_TRUE(wp.as<JointWaypointPoly>().getPosition().isApprox(
+          expected_wp.as<JointWaypointPoly>().getPosition(), 1e-5));
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
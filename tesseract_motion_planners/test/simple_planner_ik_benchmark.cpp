@@ -0,0 +1,123 @@
+/**
+ * @file simple_planner_ik_benchmark.cpp
+ * @brief Benchmark the inverse kinematics used by the simple planner to seed cartesian rasters
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/core/interpolation.h>
+#include <tesseract_command_language/cartesian_waypoint.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+/** @brief The number of segments in the raster */
+static const int NUM_SEGMENTS = 20;
+
+/** @brief The number of poses in each segment */
+static const long NUM_STEPS = 100;
+
+/** @brief The environment, manipulator and raster shared by the benchmarks */
+struct RasterFixture
+{
+  RasterFixture()
+  {
+    auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+    env = std::make_shared<tesseract_environment::Environment>();
+    tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+    tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+    env->init(urdf_path, srdf_path, locator);
+
+    manip_info = tesseract_common::ManipulatorInfo("manipulator", "base_link", "tool0");
+    request.env = env;
+    request.env_state = env->getState();
+    seed = request.env_state.getJointValues(env->getJointGroup(manip_info.manipulator)->getJointNames());
+
+    // Alternating passes over a plane in front of the robot
+    const Eigen::Quaterniond orientation(0, 0, -1.0, 0);
+    for (int i = 0; i < NUM_SEGMENTS; ++i)
+    {
+      const double x = 0.8 + 0.01 * static_cast<double>(i);
+      const double y = (i % 2 == 0) ? 0.3 : -0.3;
+      Eigen::Isometry3d start = Eigen::Isometry3d::Identity() * Eigen::Translation3d(x, -y, 0.8) * orientation;
+      Eigen::Isometry3d end = Eigen::Isometry3d::Identity() * Eigen::Translation3d(x, y, 0.8) * orientation;
+      CartesianWaypointPoly start_wp{ CartesianWaypoint(start) };
+      CartesianWaypointPoly end_wp{ CartesianWaypoint(end) };
+      instructions.emplace_back(start_wp, MoveInstructionType::LINEAR, "TEST_PROFILE", manip_info);
+      instructions.emplace_back(end_wp, MoveInstructionType::LINEAR, "TEST_PROFILE", manip_info);
+      segments.push_back(interpolate(start, end, NUM_STEPS - 1));
+      seeds.push_back(seed);
+    }
+  }
+
+  tesseract_environment::Environment::Ptr env;
+  tesseract_common::ManipulatorInfo manip_info;
+  PlannerRequest request;
+  Eigen::VectorXd seed;
+  std::vector<MoveInstruction> instructions;
+  std::vector<tesseract_common::VectorIsometry3d> segments;
+  std::vector<Eigen::VectorXd> seeds;
+};
+
+/** @brief Solve the endpoints of every segment as the simple planner profiles do when seeding a cartesian move */
+static void BM_GET_CLOSEST_JOINT_SOLUTION_ENDPOINTS(benchmark::State& state)
+{
+  RasterFixture fixture;
+  std::vector<KinematicGroupInstructionInfo> infos;
+  infos.reserve(fixture.instructions.size());
+  for (const auto& instruction : fixture.instructions)
+    infos.emplace_back(instruction, fixture.request, tesseract_common::ManipulatorInfo());
+
+  for (auto _ : state)
+  {
+    for (std::size_t i = 0; i < infos.size(); i += 2)
+      benchmark::DoNotOptimize(getClosestJointSolution(infos[i], infos[i + 1], fixture.seed));
+  }
+
+  state.counters["segments_per_second"] =
+      benchmark::Counter(static_cast<double>(NUM_SEGMENTS), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/** @brief Solve every pose of every segment, the argument is the number of threads */
+static void BM_GET_CLOSEST_JOINT_SOLUTIONS(benchmark::State& state)
+{
+  RasterFixture fixture;
+  const KinematicGroupInstructionInfo info(
+      fixture.instructions.front(), fixture.request, tesseract_common::ManipulatorInfo());
+  const auto num_threads = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(getClosestJointSolutions(info, fixture.segments, fixture.seeds, num_threads));
+
+  state.counters["segments_per_second"] =
+      benchmark::Counter(static_cast<double>(NUM_SEGMENTS), benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["poses_per_second"] = benchmark::Counter(static_cast<double>(NUM_SEGMENTS * NUM_STEPS),
+                                                          benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_GET_CLOSEST_JOINT_SOLUTION_ENDPOINTS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_GET_CLOSEST_JOINT_SOLUTIONS)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
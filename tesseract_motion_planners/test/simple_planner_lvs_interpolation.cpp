@@ -30,6 +30,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_common/types.h>
 #include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/core/interpolation.h>
 #include <tesseract_motion_planners/simple/simple_motion_planner.h>
 #include <tesseract_motion_planners/simple/profile/simple_planner_lvs_plan_profile.h>
 #include <tesseract_command_language/joint_waypoint.h>
@@ -571,6 +572,46 @@ TEST_F(TesseractPlanningSimplePlannerLVSInterpolationUnit, InterpolateStateWaypo
   EXPECT_EQ(crl.size(), rot_steps);
 }
 
+TEST_F(TesseractPlanningSimplePlannerLVSInterpolationUnit, GetClosestJointSolutions)  // NOLINT
+{
+  PlannerRequest request;
+  request.env = env_;
+  request.env_state = env_->getState();
+
+  auto joint_group = env_->getJointGroup(manip_info_.manipulator);
+  Eigen::VectorXd start_state = Eigen::VectorXd::Constant(7, 0.1);
+  Eigen::VectorXd end_state = Eigen::VectorXd::Constant(7, 0.5);
+  Eigen::Isometry3d start_pose = joint_group->calcFwdKin(start_state).at(manip_info_.tcp_frame);
+  Eigen::Isometry3d end_pose = joint_group->calcFwdKin(end_state).at(manip_info_.tcp_frame);
+
+  CartesianWaypointPoly wp{ CartesianWaypoint(start_pose) };
+  MoveInstruction instr(wp, MoveInstructionType::LINEAR, "TEST_PROFILE", manip_info_);
+  KinematicGroupInstructionInfo info(instr, request, tesseract_common::ManipulatorInfo());
+
+  // Every solution reaches its pose
+  tesseract_common::VectorIsometry3d poses = interpolate(start_pose, end_pose, 10);
+  Eigen::MatrixXd states = getClosestJointSolutions(info, poses, start_state);
+  ASSERT_EQ(states.cols(), static_cast<Eigen::Index>(poses.size()));
+  for (std::size_t i = 0; i < poses.size(); ++i)
+  {
+    Eigen::Isometry3d pose = joint_group->calcFwdKin(states.col(static_cast<Eigen::Index>(i))).at(info.tcp_frame);
+    EXPECT_TRUE(poses[i].isApprox(pose, 1e-3));
+  }
+
+  // The parallel results are identical to the serial results
+  std::vector<tesseract_common::VectorIsometry3d> segments{ poses, interpolate(end_pose, start_pose, 10), poses };
+  std::vector<Eigen::VectorXd> seeds{ start_state, end_state, start_state };
+  std::vector<Eigen::MatrixXd> serial = getClosestJointSolutions(info, segments, seeds, 1);
+  std::vector<Eigen::MatrixXd> parallel = getClosestJointSolutions(info, segments, seeds, 3);
+  ASSERT_EQ(serial.size(), segments.size());
+  ASSERT_EQ(parallel.size(), segments.size());
+  EXPECT_TRUE(serial[0].isApprox(states));
+  for (std::size_t i = 0; i < segments.size(); ++i)
+    EXPECT_TRUE(serial[i] == parallel[i]);
+
+  EXPECT_ANY_THROW(getClosestJointSolutions(info, segments, { start_state }, 2));  // NOLINT
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,379 @@
+/**
+ * @file trajopt_ifopt_planner_tests.cpp
+ * @brief This contains unit test for the tesseract trajopt ifopt planners
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/joint_waypoint.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_motion_planners/trajopt_ifopt/online_trajopt_ifopt_planner.h>
+#include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_motion_planner.h>
+#include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_qp_solver_pool.h>
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_default_solver_profile.h>
+#include <tesseract_motion_planners/interface_utils.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_environment;
+using namespace tesseract_planning;
+
+static const std::string TRAJOPT_IFOPT_DEFAULT_NAMESPACE = "TrajOptIfoptMotionPlannerTask";
+
+class TesseractPlanningTrajoptIfoptUnit : public ::testing::Test
+{
+protected:
+  Environment::Ptr env_;
+  tesseract_common::ManipulatorInfo manip_info_{ "manipulator", "base_link", "tool0" };
+  Eigen::VectorXd start_state_;
+  Eigen::Isometry3d target_pose_;
+
+  void SetUp() override
+  {
+    auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+    Environment::Ptr env = std::make_shared<Environment>();
+    tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+    tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+    EXPECT_TRUE(env->init(urdf_path, srdf_path, locator));
+    env_ = env;
+
+    start_state_.resize(7);
+    start_state_ << -0.4, 0.2762, 0.0, -1.3348, 0.0, 1.4959, 0.0;
+    auto manip = env_->getJointGroup(manip_info_.manipulator);
+    target_pose_ = manip->calcFwdKin(start_state_).at(manip_info_.tcp_frame) * Eigen::Translation3d(0, 0.1, 0);
+  }
+};
+
+/** @brief Counts the QP solvers created by the default solver profile */
+class CountingSolverProfile : public TrajOptIfoptDefaultSolverProfile
+{
+public:
+  mutable int created{ 0 };
+
+  std::shared_ptr<trajopt_sqp::QPSolver> createSolver() const override
+  {
+    ++created;
+    return TrajOptIfoptDefaultSolverProfile::createSolver();
+  }
+};
+
+/** @brief Exposes recording cycles so the statistics can be checked with known cycle times */
+class OnlineTrajOptIfoptPlannerTester : public OnlineTrajOptIfoptPlanner
+{
+public:
+  using OnlineTrajOptIfoptPlanner::OnlineTrajOptIfoptPlanner;
+  using OnlineTrajOptIfoptPlanner::recordCycle;
+};
+
+TEST_F(TesseractPlanningTrajoptIfoptUnit, OnlinePlannerStartStateUnit)  // NOLINT
+{
+  OnlineTrajOptIfoptPlanner planner(env_, manip_info_, 8);
+  EXPECT_ANY_THROW(planner.cycle());                      // NOLINT
+  EXPECT_ANY_THROW(planner.setTargetPose(target_pose_));  // NOLINT
+  ASSERT_TRUE(planner.init(start_state_, target_pose_));
+  EXPECT_TRUE(planner.getTrajectory().row(0).transpose().isApprox(start_state_, 1e-4));
+  EXPECT_ANY_THROW(planner.setStartState(Eigen::VectorXd::Zero(6)));  // NOLINT
+
+  // Without a start state the second step of the previous solution becomes the first step
+  tesseract_common::TrajArray previous = planner.getTrajectory();
+  auto problem = planner.getProblem();
+  planner.cycle();
+  EXPECT_TRUE(planner.getTrajectory().row(0).isApprox(previous.row(1), 1e-4));
+  EXPECT_EQ(planner.getProblem(), problem);
+
+  // A start state away from the previous solution is fixed as the first step
+  Eigen::VectorXd start_state = planner.getTrajectory().row(1).transpose() + Eigen::VectorXd::Constant(7, 0.02);
+  planner.setStartState(start_state);
+  planner.cycle();
+  EXPECT_TRUE(planner.getTrajectory().row(0).transpose().isApprox(start_state, 1e-4));
+
+  // The start state is also used without shifting the horizon
+  start_state = planner.getTrajectory().row(0).transpose() - Eigen::VectorXd::Constant(7, 0.02);
+  planner.setStartState(start_state);
+  planner.cycle(false);
+  EXPECT_TRUE(planner.getTrajectory().row(0).transpose().isApprox(start_state, 1e-4));
+
+  // The start state is only used by the following cycle
+  previous = planner.getTrajectory();
+  planner.cycle();
+  EXPECT_TRUE(planner.getTrajectory().row(0).isApprox(previous.row(1), 1e-4));
+}
+
+TEST_F(TesseractPlanningTrajoptIfoptUnit, OnlinePlannerDeadlineUnit)  // NOLINT
+{
+  OnlineTrajOptIfoptPlanner planner(env_, manip_info_, 8);
+  ASSERT_TRUE(planner.init(start_state_, target_pose_));
+  planner.setTargetPose(target_pose_ * Eigen::Translation3d(0, 0, 0.05));
+
+  // Every cycle misses a deadline of zero but still takes one step
+  planner.cycle_deadline = 0;
+  planner.max_sqp_steps_per_cycle = 5;
+  for (int i = 0; i < 5; ++i)
+  {
+    OnlineTrajOptIfoptCycleResult result = planner.cycle();
+    EXPECT_EQ(result.sqp_steps, 1);
+    EXPECT_TRUE(result.deadline_missed);
+    EXPECT_GT(result.cycle_time, 0);
+  }
+
+  OnlineTrajOptIfoptStatistics statistics = planner.getStatistics();
+  EXPECT_EQ(statistics.cycles, 5);
+  EXPECT_EQ(statistics.deadline_misses, 5);
+
+  // Without a limiting deadline the number of steps is limited by max_sqp_steps_per_cycle
+  planner.cycle_deadline = 10;
+  planner.max_sqp_steps_per_cycle = 2;
+  for (int i = 0; i < 5; ++i)
+  {
+    OnlineTrajOptIfoptCycleResult result = planner.cycle();
+    EXPECT_GE(result.sqp_steps, 1);
+    EXPECT_LE(result.sqp_steps, 2);
+    EXPECT_FALSE(result.deadline_missed);
+  }
+
+  statistics = planner.getStatistics();
+  EXPECT_EQ(statistics.cycles, 10);
+  EXPECT_EQ(statistics.deadline_misses, 5);
+}
+
+TEST_F(TesseractPlanningTrajoptIfoptUnit, OnlinePlannerStatisticsUnit)  // NOLINT
+{
+  OnlineTrajOptIfoptPlannerTester planner(env_, manip_info_, 8);
+  OnlineTrajOptIfoptStatistics statistics = planner.getStatistics();
+  EXPECT_EQ(statistics.cycles, 0);
+  EXPECT_NEAR(statistics.p99, 0, 1e-12);
+
+  // Cycle times of 1 to 100 ms in a scrambled order, with a deadline of 50 ms
+  planner.statistics_window = 100;
+  for (int i = 0; i < 100; ++i)
+  {
+    OnlineTrajOptIfoptCycleResult result;
+    result.cycle_time = static_cast<double>(((i * 37) % 100) + 1) * 1e-3;
+    result.deadline_missed = (result.cycle_time > 0.05);
+    planner.recordCycle(result);
+  }
+
+  statistics = planner.getStatistics();
+  EXPECT_EQ(statistics.cycles, 100);
+  EXPECT_EQ(statistics.deadline_misses, 50);
+  EXPECT_NEAR(statistics.mean, 0.0505, 1e-12);
+  EXPECT_NEAR(statistics.p50, 0.050, 1e-12);
+  EXPECT_NEAR(statistics.p99, 0.099, 1e-12);
+  EXPECT_NEAR(statistics.max, 0.100, 1e-12);
+
+  // Only the most recent cycles are used, while the counts include every cycle since the reset
+  planner.resetStatistics();
+  planner.statistics_window = 10;
+  for (int i = 0; i < 20; ++i)
+  {
+    OnlineTrajOptIfoptCycleResult result;
+    result.cycle_time = static_cast<double>(i + 1) * 1e-3;
+    planner.recordCycle(result);
+  }
+
+  statistics = planner.getStatistics();
+  EXPECT_EQ(statistics.cycles, 20);
+  EXPECT_EQ(statistics.deadline_misses, 0);
+  EXPECT_NEAR(statistics.mean, 0.0155, 1e-12);
+  EXPECT_NEAR(statistics.p50, 0.015, 1e-12);
+  EXPECT_NEAR(statistics.p99, 0.020, 1e-12);
+  EXPECT_NEAR(statistics.max, 0.020, 1e-12);
+}
+
+TEST(TesseractPlanningTrajoptIfoptQPSolverPoolUnit, AcquireReleaseUnit)  // NOLINT
+{
+  CountingSolverProfile profile;
+  TrajOptIfoptQPSolverPool pool;
+  const TrajOptIfoptQPSolverPool::Key key = TrajOptIfoptQPSolverPool::createKey(profile, 10, 20);
+
+  // Solvers in use are never handed out twice
+  std::shared_ptr<trajopt_sqp::QPSolver> solver1 = pool.acquire(key, profile);
+  std::shared_ptr<trajopt_sqp::QPSolver> solver2 = pool.acquire(key, profile);
+  ASSERT_TRUE(solver1 != nullptr);
+  ASSERT_TRUE(solver2 != nullptr);
+  EXPECT_NE(solver1, solver2);
+  EXPECT_EQ(profile.created, 2);
+  EXPECT_EQ(pool.getCreatedCount(), 2);
+  EXPECT_EQ(pool.size(), 0);
+
+  pool.release(key, solver1);
+  pool.release(key, solver2);
+  EXPECT_EQ(pool.size(), 2);
+
+  // A released solver is reused instead of creating a new one
+  std::shared_ptr<trajopt_sqp::QPSolver> solver3 = pool.acquire(key, profile);
+  EXPECT_TRUE(solver3 == solver1 || solver3 == solver2);
+  EXPECT_EQ(profile.created, 2);
+  EXPECT_EQ(pool.getCreatedCount(), 2);
+  EXPECT_EQ(pool.size(), 1);
+
+  pool.release(key, nullptr);
+  EXPECT_EQ(pool.size(), 1);
+  pool.release(key, solver3);
+  EXPECT_EQ(pool.size(), 2);
+
+  pool.clear();
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_EQ(pool.getCreatedCount(), 2);
+}
+
+TEST(TesseractPlanningTrajoptIfoptQPSolverPoolUnit, KeySeparationUnit)  // NOLINT
+{
+  CountingSolverProfile profile;
+  TrajOptIfoptDefaultSolverProfile default_profile;
+  const TrajOptIfoptQPSolverPool::Key key = TrajOptIfoptQPSolverPool::createKey(profile, 10, 20);
+  EXPECT_TRUE(key == TrajOptIfoptQPSolverPool::createKey(profile, 10, 20));
+  EXPECT_FALSE(key == TrajOptIfoptQPSolverPool::createKey(profile, 11, 20));
+  EXPECT_FALSE(key == TrajOptIfoptQPSolverPool::createKey(profile, 10, 21));
+  EXPECT_FALSE(key == TrajOptIfoptQPSolverPool::createKey(default_profile, 10, 20));
+
+  TrajOptIfoptQPSolverPool pool;
+  std::shared_ptr<trajopt_sqp::QPSolver> solver = pool.acquire(key, profile);
+  pool.release(key, solver);
+
+  // An idle solver is only reused by problems of the same size and solver profile type
+  const TrajOptIfoptQPSolverPool::Key vars_key = TrajOptIfoptQPSolverPool::createKey(profile, 11, 20);
+  EXPECT_NE(pool.acquire(vars_key, profile), solver);
+  EXPECT_EQ(profile.created, 2);
+
+  const TrajOptIfoptQPSolverPool::Key cnts_key = TrajOptIfoptQPSolverPool::createKey(profile, 10, 21);
+  EXPECT_NE(pool.acquire(cnts_key, profile), solver);
+  EXPECT_EQ(profile.created, 3);
+
+  const TrajOptIfoptQPSolverPool::Key default_key = TrajOptIfoptQPSolverPool::createKey(default_profile, 10, 20);
+  EXPECT_NE(pool.acquire(default_key, default_profile), solver);
+  EXPECT_EQ(profile.created, 3);
+  EXPECT_EQ(pool.getCreatedCount(), 4);
+  EXPECT_EQ(pool.size(), 1);
+
+  EXPECT_EQ(pool.acquire(key, profile), solver);
+  EXPECT_EQ(pool.getCreatedCount(), 4);
+}
+
+TEST(TesseractPlanningTrajoptIfoptQPSolverPoolUnit, LeaseUnit)  // NOLINT
+{
+  CountingSolverProfile profile;
+  auto pool = std::make_shared<TrajOptIfoptQPSolverPool>();
+  const TrajOptIfoptQPSolverPool::Key key = TrajOptIfoptQPSolverPool::createKey(profile, 10, 20);
+
+  std::shared_ptr<trajopt_sqp::QPSolver> solver;
+  {
+    TrajOptIfoptQPSolverPool::Lease lease(pool, key, profile);
+    solver = lease.get();
+    ASSERT_TRUE(solver != nullptr);
+    EXPECT_EQ(pool->size(), 0);
+  }
+  EXPECT_EQ(pool->size(), 1);
+
+  // The solver is returned when the solve throws
+  try
+  {
+    TrajOptIfoptQPSolverPool::Lease lease(pool, key, profile);
+    EXPECT_EQ(lease.get(), solver);
+    EXPECT_EQ(pool->size(), 0);
+    throw std::runtime_error("The solve failed");
+  }
+  catch (const std::runtime_error&)
+  {
+  }
+  EXPECT_EQ(pool->size(), 1);
+  EXPECT_EQ(pool->getCreatedCount(), 1);
+
+  // Without a pool every lease creates a new solver
+  {
+    TrajOptIfoptQPSolverPool::Lease lease(nullptr, key, profile);
+    EXPECT_TRUE(lease.get() != nullptr);
+    EXPECT_NE(lease.get(), solver);
+  }
+  EXPECT_EQ(profile.created, 2);
+  EXPECT_EQ(pool->size(), 1);
+  EXPECT_EQ(pool->getCreatedCount(), 1);
+}
+
+TEST_F(TesseractPlanningTrajoptIfoptUnit, SolverProfileLookupUnit)  // NOLINT
+{
+  auto joint_group = env_->getJointGroup(manip_info_.manipulator);
+  std::vector<std::string> joint_names = joint_group->getJointNames();
+  auto cur_state = env_->getState();
+
+  JointWaypointPoly wp1{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+  wp1.getPosition() << 0, 0, 0, -1.57, 0, 0, 0;
+  JointWaypointPoly wp2{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+  wp2.getPosition() << 0, 0, 0, -1.0, 0, 0, 0;
+
+  CompositeInstruction program("TEST_PROFILE");
+  program.setManipulatorInfo(manip_info_);
+  program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+  program.appendMoveInstruction(MoveInstruction(wp2, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+  CompositeInstruction interpolated_program =
+      generateInterpolatedProgram(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+
+  // The solver profile is looked up by the profile of the program
+  auto solver_profile = std::make_shared<CountingSolverProfile>();
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<TrajOptIfoptSolverProfile>(TRAJOPT_IFOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", solver_profile);
+
+  PlannerRequest request;
+  request.instructions = interpolated_program;
+  request.env = env_;
+  request.env_state = cur_state;
+  request.profiles = profiles;
+
+  TrajOptIfoptMotionPlanner planner(TRAJOPT_IFOPT_DEFAULT_NAMESPACE);
+  TrajOptIfoptQPSolverPool::Ptr pool = planner.getQPSolverPool();
+  ASSERT_TRUE(pool != nullptr);
+
+  EXPECT_TRUE(planner.solve(request).successful);
+  EXPECT_EQ(solver_profile->created, 1);
+  EXPECT_EQ(pool->getCreatedCount(), 1);
+  EXPECT_EQ(pool->size(), 1);
+
+  // The next solve of the same problem and a clone of the planner reuse the solver
+  EXPECT_TRUE(planner.solve(request).successful);
+  EXPECT_TRUE(planner.clone()->solve(request).successful);
+  EXPECT_EQ(solver_profile->created, 1);
+  EXPECT_EQ(pool->getCreatedCount(), 1);
+  EXPECT_EQ(pool->size(), 1);
+
+  // A program profile without a solver profile uses the default solver profile
+  request.instructions.setProfile("OTHER_PROFILE");
+  EXPECT_TRUE(planner.solve(request).successful);
+  EXPECT_EQ(solver_profile->created, 1);
+  EXPECT_EQ(pool->getCreatedCount(), 2);
+  EXPECT_EQ(pool->size(), 2);
+
+  // Without a pool every solve creates a solver
+  request.instructions.setProfile("TEST_PROFILE");
+  planner.setQPSolverPool(nullptr);
+  EXPECT_TRUE(planner.solve(request).successful);
+  EXPECT_EQ(solver_profile->created, 2);
+  EXPECT_EQ(pool->size(), 2);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
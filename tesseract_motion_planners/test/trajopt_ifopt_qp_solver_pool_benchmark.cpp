@@ -0,0 +1,84 @@
+/**
+ * @file trajopt_ifopt_qp_solver_pool_benchmark.cpp
+ * @brief Benchmark repeated TrajOpt IFOPT solves with and without reusing QP solvers
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <benchmark/benchmark.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_environment/environment.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/joint_waypoint.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_motion_planner.h>
+#include <tesseract_motion_planners/interface_utils.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Solve the same freespace problem with one planner, the argument enables the QP solver pool (1) or not (0)
+ * @details The planner and its pool live across iterations, so with the pool every iteration after the first reuses
+ * the QP solver of the previous one.
+ */
+static void BM_TRAJOPT_IFOPT_QP_SOLVER_POOL(benchmark::State& state)
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/lbr_iiwa_14_r820.srdf");
+  env->init(urdf_path, srdf_path, locator);
+
+  tesseract_common::ManipulatorInfo manip_info("manipulator", "base_link", "tool0");
+  std::vector<std::string> joint_names = env->getJointGroup(manip_info.manipulator)->getJointNames();
+  JointWaypointPoly wp1{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+  wp1.getPosition() << 0, 0, 0, -1.57, 0, 0, 0;
+  JointWaypointPoly wp2{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+  wp2.getPosition() << 0, 0, 0, 1.57, 0, 0, 0;
+
+  CompositeInstruction program(DEFAULT_PROFILE_KEY);
+  program.setManipulatorInfo(manip_info);
+  program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE));
+  program.appendMoveInstruction(MoveInstruction(wp2, MoveInstructionType::FREESPACE));
+
+  PlannerRequest request;
+  request.instructions = generateInterpolatedProgram(program, env->getState(), env, 3.14, 1.0, 3.14, 10);
+  request.env = env;
+  request.env_state = env->getState();
+  request.profiles = std::make_shared<ProfileDictionary>();
+
+  TrajOptIfoptMotionPlanner planner("TrajOptIfoptMotionPlannerTask");
+  if (state.range(0) == 0)
+    planner.setQPSolverPool(nullptr);
+
+  for (auto _ : state)
+  {
+    if (!planner.solve(request).successful)
+    {
+      state.SkipWithError("The planner failed");
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_TRAJOPT_IFOPT_QP_SOLVER_POOL)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -31,11 +31,13 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_common/types.h>
 #include <tesseract_environment/environment.h>
+#include <tesseract_environment/commands.h>
 
 #include <tesseract_command_language/composite_instruction.h>
 #include <tesseract_command_language/joint_waypoint.h>
 #include <tesseract_command_language/cartesian_waypoint.h>
 #include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/utils.h>
 
 #include <tesseract_motion_planners/trajopt/trajopt_motion_planner.h>
 #include <tesseract_motion_planners/trajopt/profile/trajopt_default_plan_profile.h>
@@ -716,6 +718,256 @@ TEST_F(TesseractPlanningTrajoptUnit, TrajoptArrayJointCost)  // NOLINT
       (tesseract_tests::vectorContainsType<sco::Cost::Ptr, trajopt::TrajOptCostFromErrFunc>(problem->getCosts())));
 }
 
+// This test checks that solutions are reused to warm start similar requests
+TEST_F(TesseractPlanningTrajoptUnit, TrajoptSolutionCacheJointJoint)  // NOLINT
+{
+  auto joint_group = env_->getJointGroup(manip.manipulator);
+  std::vector<std::string> joint_names = joint_group->getJointNames();
+  auto cur_state = env_->getState();
+
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<TrajOptPlanProfile>(
+      TRAJOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", std::make_shared<TrajOptDefaultPlanProfile>());
+  profiles->addProfile<TrajOptCompositeProfile>(
+      TRAJOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", std::make_shared<TrajOptDefaultCompositeProfile>());
+
+  auto create_request = [&](double goal) {
+    JointWaypointPoly wp1{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+    wp1.getPosition() << 0, 0, 0, -1.57, 0, 0, 0;
+
+    JointWaypointPoly wp2{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+    wp2.getPosition() << 0, 0, 0, goal, 0, 0, 0;
+
+    CompositeInstruction program("TEST_PROFILE");
+    program.setManipulatorInfo(manip);
+    program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+    program.appendMoveInstruction(MoveInstruction(wp2, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+
+    PlannerRequest request;
+    request.instructions = generateInterpolatedProgram(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+    request.env = env_;
+    request.env_state = cur_state;
+    request.profiles = profiles;
+    return request;
+  };
+
+  auto cache = std::make_shared<TrajOptSolutionCache>(0.1, 0.05);
+  TrajOptMotionPlanner test_planner(TRAJOPT_DEFAULT_NAMESPACE);
+  test_planner.setSolutionCache(cache);
+  EXPECT_EQ(test_planner.getSolutionCache(), cache);
+  EXPECT_EQ(std::dynamic_pointer_cast<TrajOptMotionPlanner>(test_planner.clone())->getSolutionCache(), cache);
+
+  // The first request is seeded with the interpolated program
+  PlannerResponse response = test_planner.solve(create_request(1.52));
+  EXPECT_TRUE(response.successful);
+  EXPECT_EQ(cache->size(), 1);
+  EXPECT_NEAR(response.statistics.at("warm_started"), 0, 1e-8);
+  EXPECT_NEAR(response.statistics.at("cache_hit_rate"), 0, 1e-8);
+  EXPECT_GT(response.statistics.at("solve_time"), 0);
+  EXPECT_GT(response.statistics.at("qp_solves"), 0);
+
+  // A slightly shifted goal is warm started from the prior solution
+  response = test_planner.solve(create_request(1.54));
+  EXPECT_TRUE(response.successful);
+  EXPECT_EQ(cache->size(), 2);
+  EXPECT_NEAR(response.statistics.at("warm_started"), 1, 1e-8);
+  EXPECT_NEAR(response.statistics.at("cache_hit_rate"), 0.5, 1e-8);
+
+  // A different goal is not
+  response = test_planner.solve(create_request(0.5));
+  EXPECT_TRUE(response.successful);
+  EXPECT_NEAR(response.statistics.at("warm_started"), 0, 1e-8);
+  EXPECT_EQ(cache->getLookupCount(), 3);
+  EXPECT_EQ(cache->getHitCount(), 1);
+
+  // Solutions are not shared between environments or revisions of an environment
+  PlannerRequest request = create_request(1.54);
+  const TrajOptSolutionCache::Key key = cache->createKey(request, TRAJOPT_DEFAULT_NAMESPACE);
+  EXPECT_TRUE(key == cache->createKey(create_request(1.54), TRAJOPT_DEFAULT_NAMESPACE));
+
+  Environment::Ptr env = env_->clone();
+  request.env = env;
+  const TrajOptSolutionCache::Key env_key = cache->createKey(request, TRAJOPT_DEFAULT_NAMESPACE);
+  EXPECT_TRUE(key != env_key);
+
+  EXPECT_TRUE(env->applyCommand(std::make_shared<ChangeJointPositionLimitsCommand>(joint_names[0], -1.0, 1.0)));
+  const TrajOptSolutionCache::Key revision_key = cache->createKey(request, TRAJOPT_DEFAULT_NAMESPACE);
+  EXPECT_TRUE(env_key != revision_key);
+
+  tesseract_common::TrajArray trajectory;
+  EXPECT_TRUE(cache->lookup(key, trajectory));
+  EXPECT_FALSE(cache->lookup(env_key, trajectory));
+  EXPECT_FALSE(cache->lookup(revision_key, trajectory));
+
+  cache->clear();
+  EXPECT_EQ(cache->size(), 0);
+  EXPECT_EQ(cache->getLookupCount(), 0);
+}
+
+// This test checks that problems created from a template match the problems created from the profiles
+TEST_F(TesseractPlanningTrajoptUnit, TrajoptProblemTemplateJointJoint)  // NOLINT
+{
+  auto joint_group = env_->getJointGroup(manip.manipulator);
+  std::vector<std::string> joint_names = joint_group->getJointNames();
+  auto cur_state = env_->getState();
+
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<TrajOptPlanProfile>(
+      TRAJOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", std::make_shared<TrajOptDefaultPlanProfile>());
+  profiles->addProfile<TrajOptCompositeProfile>(
+      TRAJOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", std::make_shared<TrajOptDefaultCompositeProfile>());
+
+  auto create_request = [&](double goal) {
+    JointWaypointPoly wp1{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+    wp1.getPosition() << 0, 0, 0, -1.57, 0, 0, 0;
+
+    JointWaypointPoly wp2{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+    wp2.getPosition() << 0, 0, 0, goal, 0, 0, 0;
+
+    CompositeInstruction program("TEST_PROFILE");
+    program.setManipulatorInfo(manip);
+    program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+    program.appendMoveInstruction(MoveInstruction(wp2, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+
+    PlannerRequest request;
+    request.instructions = generateInterpolatedProgram(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+    request.env = env_;
+    request.env_state = cur_state;
+    request.profiles = profiles;
+    return request;
+  };
+
+  auto cache = std::make_shared<TrajOptProblemTemplateCache>();
+  TrajOptMotionPlanner template_planner(TRAJOPT_DEFAULT_NAMESPACE);
+  template_planner.setProblemTemplateCache(cache);
+  EXPECT_EQ(template_planner.getProblemTemplateCache(), cache);
+  TrajOptMotionPlanner test_planner(TRAJOPT_DEFAULT_NAMESPACE);
+
+  // The first request creates the template
+  PlannerResponse response = template_planner.solve(create_request(1.57));
+  EXPECT_TRUE(response.successful);
+  EXPECT_EQ(cache->size(), 1);
+  EXPECT_NEAR(response.statistics.at("template_hit"), 0, 1e-8);
+  EXPECT_GT(response.statistics.at("construct_time"), 0);
+  EXPECT_GT(response.statistics.at("optimize_time"), 0);
+
+  // The second request rebinds the goal of the template
+  PlannerRequest request = create_request(1.2);
+  response = template_planner.solve(request);
+  EXPECT_TRUE(response.successful);
+  EXPECT_EQ(cache->size(), 1);
+  EXPECT_EQ(cache->getHitCount(), 1);
+  EXPECT_NEAR(response.statistics.at("template_hit"), 1, 1e-8);
+
+  PlannerResponse expected_response = test_planner.solve(request);
+  EXPECT_TRUE(expected_response.successful);
+
+  auto pci = std::static_pointer_cast<trajopt::ProblemConstructionInfo>(response.data);
+  auto expected_pci = std::static_pointer_cast<trajopt::ProblemConstructionInfo>(expected_response.data);
+  EXPECT_TRUE(pci->init_info.data.isApprox(expected_pci->init_info.data));
+  ASSERT_EQ(pci->cnt_infos.size(), expected_pci->cnt_infos.size());
+  for (std::size_t i = 0; i < pci->cnt_infos.size(); ++i)
+  {
+    auto joint_info = std::dynamic_pointer_cast<trajopt::JointPosTermInfo>(pci->cnt_infos[i]);
+    auto expected_joint_info = std::dynamic_pointer_cast<trajopt::JointPosTermInfo>(expected_pci->cnt_infos[i]);
+    ASSERT_EQ(joint_info == nullptr, expected_joint_info == nullptr);
+    if (joint_info != nullptr)
+      EXPECT_EQ(joint_info->targets, expected_joint_info->targets);
+  }
+
+  auto results = response.results.flatten(&moveFilter);
+  auto expected_results = expected_response.results.flatten(&moveFilter);
+  ASSERT_EQ(results.size(), expected_results.size());
+  for (std::size_t i = 0; i < results.size(); ++i)
+  {
+    const auto& wp = results[i].get().as<MoveInstructionPoly>().getWaypoint();
+    const auto& expected_wp = expected_results[i].get().as<MoveInstructionPoly>().getWaypoint();
+    EXPECT_TRUE(getJointPosition(wp).isApprox(getJointPosition(expected_wp), 1e-5));
+  }
+}
+
+// This test checks that cartesian waypoints are rebound and that only requests with the same key share a template
+TEST_F(TesseractPlanningTrajoptUnit, TrajoptProblemTemplateJointCart)  // NOLINT
+{
+  auto joint_group = env_->getJointGroup(manip.manipulator);
+  std::vector<std::string> joint_names = joint_group->getJointNames();
+  auto cur_state = env_->getState();
+
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<TrajOptPlanProfile>(
+      TRAJOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", std::make_shared<TrajOptDefaultPlanProfile>());
+  profiles->addProfile<TrajOptCompositeProfile>(
+      TRAJOPT_DEFAULT_NAMESPACE, "TEST_PROFILE", std::make_shared<TrajOptDefaultCompositeProfile>());
+
+  auto create_request = [&](double goal_x, const std::string& composite_profile) {
+    JointWaypointPoly wp1{ JointWaypoint(joint_names, Eigen::VectorXd::Zero(7)) };
+    wp1.getPosition() << 0, 0, 0, -1.57, 0, 0, 0;
+
+    CartesianWaypointPoly wp2{ CartesianWaypoint(Eigen::Isometry3d::Identity() *
+                                                 Eigen::Translation3d(goal_x, .4, 0.2) *
+                                                 Eigen::Quaterniond(0, 0, 1.0, 0)) };
+
+    CompositeInstruction program(composite_profile);
+    program.setManipulatorInfo(manip);
+    program.appendMoveInstruction(MoveInstruction(wp1, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+    program.appendMoveInstruction(MoveInstruction(wp2, MoveInstructionType::FREESPACE, "TEST_PROFILE"));
+
+    PlannerRequest request;
+    request.instructions = generateInterpolatedProgram(program, cur_state, env_, 3.14, 1.0, 3.14, 10);
+    request.env = env_;
+    request.env_state = cur_state;
+    request.profiles = profiles;
+    return request;
+  };
+
+  auto cache = std::make_shared<TrajOptProblemTemplateCache>();
+  TrajOptMotionPlanner template_planner(TRAJOPT_DEFAULT_NAMESPACE);
+  template_planner.setProblemTemplateCache(cache);
+  TrajOptMotionPlanner test_planner(TRAJOPT_DEFAULT_NAMESPACE);
+
+  // The first request creates the template
+  PlannerRequest first_request = create_request(-0.2, "TEST_PROFILE");
+  PlannerResponse response = template_planner.solve(first_request);
+  EXPECT_EQ(cache->size(), 1);
+  EXPECT_NEAR(response.statistics.at("template_hit"), 0, 1e-8);
+
+  // The second request only differs by its goal, so it has the same key and rebinds the cartesian goal
+  PlannerRequest request = create_request(-0.1, "TEST_PROFILE");
+  EXPECT_TRUE(TrajOptProblemTemplateCache::createKey(request, TRAJOPT_DEFAULT_NAMESPACE) ==
+              TrajOptProblemTemplateCache::createKey(first_request, TRAJOPT_DEFAULT_NAMESPACE));
+  response = template_planner.solve(request);
+  EXPECT_EQ(cache->size(), 1);
+  EXPECT_NEAR(response.statistics.at("template_hit"), 1, 1e-8);
+
+  auto pci = std::static_pointer_cast<trajopt::ProblemConstructionInfo>(response.data);
+  std::shared_ptr<trajopt::ProblemConstructionInfo> expected_pci = test_planner.createProblem(request);
+  EXPECT_TRUE(pci->init_info.data.isApprox(expected_pci->init_info.data));
+  ASSERT_EQ(pci->cnt_infos.size(), expected_pci->cnt_infos.size());
+  std::size_t cart_count{ 0 };
+  for (std::size_t i = 0; i < pci->cnt_infos.size(); ++i)
+  {
+    auto cart_info = std::dynamic_pointer_cast<trajopt::CartPoseTermInfo>(pci->cnt_infos[i]);
+    auto expected_cart_info = std::dynamic_pointer_cast<trajopt::CartPoseTermInfo>(expected_pci->cnt_infos[i]);
+    ASSERT_EQ(cart_info == nullptr, expected_cart_info == nullptr);
+    if (cart_info == nullptr)
+      continue;
+
+    EXPECT_EQ(cart_info->timestep, expected_cart_info->timestep);
+    EXPECT_TRUE(cart_info->target_frame_offset.isApprox(expected_cart_info->target_frame_offset));
+    EXPECT_TRUE(cart_info->source_frame_offset.isApprox(expected_cart_info->source_frame_offset));
+    ++cart_count;
+  }
+  EXPECT_EQ(cart_count, 1);
+
+  // A request with another composite profile has a different key, so it creates its own template
+  PlannerRequest other_request = create_request(-0.1, "OTHER_PROFILE");
+  EXPECT_TRUE(TrajOptProblemTemplateCache::createKey(other_request, TRAJOPT_DEFAULT_NAMESPACE) !=
+              TrajOptProblemTemplateCache::createKey(request, TRAJOPT_DEFAULT_NAMESPACE));
+  response = template_planner.solve(other_request);
+  EXPECT_EQ(cache->size(), 2);
+  EXPECT_NEAR(response.statistics.at("template_hit"), 0, 1e-8);
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -26,11 +26,24 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <gtest/gtest.h>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_common/types.h>
 #include <tesseract_environment/environment.h>
+#include <tesseract_environment/commands.h>
+#include <tesseract_geometry/impl/box.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
 #include <tesseract_motion_planners/core/utils.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
+#include <tesseract_motion_planners/core/lvs_substep_iterator.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
 #include <tesseract_motion_planners/planner_utils.h>
 #include <tesseract_support/tesseract_support_resource_locator.h>
 
@@ -91,6 +104,297 @@ TEST_F(TesseractPlanningUtilsUnit, GetProfileStringTest)  // NOLINT
   EXPECT_EQ(output_profile, "profile_1_remapped");
 }
 
+TEST(TesseractPlanningUtilsUnit, LVSSubstepIteratorTest)  // NOLINT
+{
+  Eigen::VectorXd start = Eigen::VectorXd::Zero(3);
+  Eigen::VectorXd end(3);
+  end << 0.25, -0.1, 0.05;
+
+  const double longest_valid_segment_length = 0.05;
+  const double dist = (end - start).norm();
+  auto cnt = static_cast<long>(std::ceil(dist / longest_valid_segment_length)) + 1;
+  tesseract_common::TrajArray expected(cnt, start.size());
+  for (long iVar = 0; iVar < start.size(); ++iVar)
+    expected.col(iVar) = Eigen::VectorXd::LinSpaced(cnt, start(iVar), end(iVar));
+
+  LVSSubstepIterator substeps;
+  substeps.reset(start, end, longest_valid_segment_length);
+  EXPECT_NEAR(substeps.distance(), dist, 1e-12);
+  EXPECT_EQ(substeps.size(), cnt);
+
+  long i = 0;
+  do
+  {
+    EXPECT_EQ(substeps.index(), i);
+    EXPECT_TRUE(substeps.state().isApprox(expected.row(i).transpose(), 1e-12));
+    EXPECT_TRUE(substeps.interpolate(i).isApprox(expected.row(i).transpose(), 1e-12));
+    ++i;
+  } while (substeps.next());
+
+  EXPECT_EQ(i, cnt);
+  EXPECT_TRUE(substeps.state().isApprox(end));
+  EXPECT_FALSE(substeps.next());
+
+  // A segment shorter than the longest valid segment length only contains the start and end
+  substeps.reset(start, start, longest_valid_segment_length);
+  EXPECT_EQ(substeps.size(), 2);
+  EXPECT_TRUE(substeps.next());
+  EXPECT_FALSE(substeps.next());
+}
+
+TEST(TesseractPlanningUtilsUnit, ParallelForTest)  // NOLINT
+{
+  EXPECT_EQ(getParallelForWorkers(0, 4), 1);
+  EXPECT_EQ(getParallelForWorkers(2, 4), 2);
+  EXPECT_EQ(getParallelForWorkers(10, 4), 4);
+  EXPECT_EQ(getParallelForWorkers(10, 0), 1);
+
+  // Every index is called once and the worker indices are in range
+  std::vector<int> calls(100, 0);
+  std::atomic<bool> worker_in_range{ true };
+  EXPECT_TRUE(parallelFor(calls.size(), 4, [&](std::size_t i, std::size_t worker) {
+    ++calls[i];
+    if (worker >= 4)
+      worker_in_range = false;
+    return true;
+  }));
+  EXPECT_TRUE(worker_in_range);
+  for (int c : calls)
+    EXPECT_EQ(c, 1);
+
+  // Nothing is called without indices
+  EXPECT_TRUE(parallelFor(0, 4, [](std::size_t, std::size_t) { return false; }));
+
+  // A single worker runs on the calling thread and stops at the first failure
+  const std::thread::id thread_id = std::this_thread::get_id();
+  std::size_t last_index{ 0 };
+  EXPECT_FALSE(parallelFor(10, 1, [&](std::size_t i, std::size_t worker) {
+    EXPECT_EQ(worker, 0);
+    EXPECT_EQ(std::this_thread::get_id(), thread_id);
+    last_index = i;
+    return (i < 3);
+  }));
+  EXPECT_EQ(last_index, 3);
+
+  // The exception of a worker is rethrown by the calling thread once the other workers are done
+  EXPECT_THROW(parallelFor(1000,  // NOLINT
+                           4,
+                           [](std::size_t i, std::size_t /*worker*/) {
+                             if (i == 10)
+                               throw std::runtime_error("Failed");
+                             return true;
+                           }),
+               std::runtime_error);
+}
+
+TEST_F(TesseractPlanningUtilsUnit, ContactManagerPoolTest)  // NOLINT
+{
+  DiscreteContactManagerPool pool(env_->getDiscreteContactManager());
+  EXPECT_EQ(pool.size(), 0);
+
+  pool.warm(2);
+  EXPECT_EQ(pool.size(), 2);
+
+  // The same thread always gets the same manager, which is never the template
+  tesseract_collision::DiscreteContactManager* manager = &pool.get();
+  EXPECT_EQ(manager, &pool.get());
+  EXPECT_NE(manager, &pool.getTemplate());
+  EXPECT_EQ(pool.size(), 2);
+
+  // Another thread gets its own manager, using the remaining warm manager
+  tesseract_collision::DiscreteContactManager* thread_manager{ nullptr };
+  std::thread t([&pool, &thread_manager]() { thread_manager = &pool.get(); });
+  t.join();
+  EXPECT_NE(thread_manager, nullptr);
+  EXPECT_NE(thread_manager, manager);
+  EXPECT_EQ(pool.size(), 2);
+
+  // The manager of an exited thread is returned and reused by the next thread
+  tesseract_collision::DiscreteContactManager* thread_manager2{ nullptr };
+  std::thread t2([&pool, &thread_manager2]() { thread_manager2 = &pool.get(); });
+  t2.join();
+  EXPECT_EQ(thread_manager2, thread_manager);
+  EXPECT_EQ(pool.size(), 2);
+
+  // Threads running at the same time each get their own manager, cloning a new one
+  std::promise<void> assigned;
+  std::promise<void> done;
+  std::shared_future<void> done_future = done.get_future().share();
+  std::thread t3([&pool, &assigned, done_future]() {
+    pool.get();
+    assigned.set_value();
+    done_future.wait();
+  });
+  assigned.get_future().wait();
+  std::thread t4([&pool]() { pool.get(); });
+  t4.join();
+  done.set_value();
+  t3.join();
+  EXPECT_EQ(pool.size(), 3);
+
+  // A thread exiting after its pool is destroyed does not return its manager
+  auto short_lived_pool = std::make_unique<DiscreteContactManagerPool>(env_->getDiscreteContactManager());
+  std::promise<void> short_lived_assigned;
+  std::promise<void> pool_destroyed;
+  std::thread t5([&short_lived_pool, &short_lived_assigned, &pool_destroyed]() {
+    short_lived_pool->get();
+    short_lived_assigned.set_value();
+    pool_destroyed.get_future().wait();
+  });
+  short_lived_assigned.get_future().wait();
+  short_lived_pool = nullptr;
+  pool_destroyed.set_value();
+  t5.join();
+
+  // A different pool used by this thread gets a different manager
+  DiscreteContactManagerPool other_pool(env_->getDiscreteContactManager());
+  EXPECT_NE(&other_pool.get(), manager);
+  EXPECT_EQ(&pool.get(), manager);
+}
+
+/** @brief Add a box which the arm passes through when the first joint moves from -0.5 to 0.5 */
+static void addBox(Environment& env)
+{
+  tesseract_scene_graph::Link link_1("box_attached");
+
+  auto visual = std::make_shared<tesseract_scene_graph::Visual>();
+  visual->origin = Eigen::Isometry3d::Identity();
+  visual->origin.translation() = Eigen::Vector3d(0.5, 0, 0.55);
+  visual->geometry = std::make_shared<tesseract_geometry::Box>(0.4, 0.001, 0.4);
+  link_1.visual.push_back(visual);
+
+  auto collision = std::make_shared<tesseract_scene_graph::Collision>();
+  collision->origin = visual->origin;
+  collision->geometry = visual->geometry;
+  link_1.collision.push_back(collision);
+
+  tesseract_scene_graph::Joint joint_1("joint_n1");
+  joint_1.parent_link_name = "base_link";
+  joint_1.child_link_name = link_1.getName();
+  joint_1.type = tesseract_scene_graph::JointType::FIXED;
+
+  env.applyCommand(std::make_shared<AddLinkCommand>(link_1, joint_1));
+}
+
+/** @brief Check that the contacts of every step have the same pairs and distances */
+static void expectSameContacts(const std::vector<tesseract_collision::ContactResultMap>& contacts,
+                               const std::vector<tesseract_collision::ContactResultMap>& expected_contacts)
+{
+  ASSERT_EQ(contacts.size(), expected_contacts.size());
+  for (std::size_t i = 0; i < contacts.size(); ++i)
+  {
+    ASSERT_EQ(contacts[i].size(), expected_contacts[i].size()) << "step " << i;
+    auto expected_it = expected_contacts[i].begin();
+    for (const auto& pair : contacts[i])
+    {
+      EXPECT_EQ(pair.first, expected_it->first) << "step " << i;
+      ASSERT_EQ(pair.second.size(), expected_it->second.size()) << "step " << i;
+      for (std::size_t j = 0; j < pair.second.size(); ++j)
+        EXPECT_NEAR(pair.second[j].distance, expected_it->second[j].distance, 1e-8) << "step " << i;
+
+      ++expected_it;
+    }
+  }
+}
+
+/** @brief Get the steps with contacts */
+static std::vector<std::size_t> getStepsInContact(const std::vector<tesseract_collision::ContactResultMap>& contacts)
+{
+  std::vector<std::size_t> steps;
+  for (std::size_t i = 0; i < contacts.size(); ++i)
+  {
+    if (!contacts[i].empty())
+      steps.push_back(i);
+  }
+  return steps;
+}
+
+TEST_F(TesseractPlanningUtilsUnit, ContactCheckProgramParallelTest)  // NOLINT
+{
+  addBox(*env_);
+  auto joint_group = env_->getJointGroup("manipulator");
+  const std::vector<std::string> joint_names = joint_group->getJointNames();
+
+  // Move the first joint through the box, the first and last states are not in collision
+  CompositeInstruction program;
+  for (int i = 0; i <= 20; ++i)
+  {
+    Eigen::VectorXd position(7);
+    position << -0.5 + (0.05 * i), 0.5, 0.0, -1.3348, 0.0, 1.4959, 0.0;
+    StateWaypointPoly wp{ StateWaypoint(joint_names, position) };
+    program.appendMoveInstruction(MoveInstruction(wp, MoveInstructionType::FREESPACE));
+  }
+
+  tesseract_scene_graph::StateSolver::UPtr state_solver = env_->getStateSolver();
+  tesseract_collision::DiscreteContactManager::Ptr discrete_manager = env_->getDiscreteContactManager();
+  discrete_manager->setActiveCollisionObjects(joint_group->getActiveLinkNames());
+  tesseract_collision::ContinuousContactManager::Ptr continuous_manager = env_->getContinuousContactManager();
+  continuous_manager->setActiveCollisionObjects(joint_group->getActiveLinkNames());
+
+  // Zero threads checks the program with contactCheckProgram
+  auto check = [&](std::vector<tesseract_collision::ContactResultMap>& contacts,
+                   const tesseract_collision::CollisionCheckConfig& config,
+                   std::size_t num_threads) {
+    const bool discrete = (config.type == tesseract_collision::CollisionEvaluatorType::DISCRETE ||
+                           config.type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE);
+    if (num_threads == 0 && discrete)
+      return contactCheckProgram(contacts, *discrete_manager, *state_solver, program, config);
+
+    if (num_threads == 0)
+      return contactCheckProgram(contacts, *continuous_manager, *state_solver, program, config);
+
+    if (discrete)
+      return contactCheckProgramParallel(contacts, *discrete_manager, *state_solver, program, config, num_threads);
+
+    return contactCheckProgramParallel(contacts, *continuous_manager, *state_solver, program, config, num_threads);
+  };
+
+  for (auto type : { tesseract_collision::CollisionEvaluatorType::DISCRETE,
+                     tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE,
+                     tesseract_collision::CollisionEvaluatorType::CONTINUOUS,
+                     tesseract_collision::CollisionEvaluatorType::LVS_CONTINUOUS })
+  {
+    SCOPED_TRACE("CollisionEvaluatorType " + std::to_string(static_cast<int>(type)));
+    tesseract_collision::CollisionCheckConfig config;
+    config.type = type;
+    config.longest_valid_segment_length = 0.01;
+    config.contact_request.type = tesseract_collision::ContactTestType::ALL;
+
+    // Every step is checked so the parallel contacts match the serial contacts
+    std::vector<tesseract_collision::ContactResultMap> serial_contacts;
+    ASSERT_TRUE(check(serial_contacts, config, 0));
+    const std::vector<std::size_t> steps_in_contact = getStepsInContact(serial_contacts);
+    ASSERT_FALSE(steps_in_contact.empty());
+    EXPECT_GT(steps_in_contact.front(), 0);
+
+    for (std::size_t num_threads : std::vector<std::size_t>{ 1, 4 })
+    {
+      std::vector<tesseract_collision::ContactResultMap> parallel_contacts;
+      EXPECT_TRUE(check(parallel_contacts, config, num_threads));
+      expectSameContacts(parallel_contacts, serial_contacts);
+    }
+
+    // Only the first colliding step is reported by the serial check and a single thread
+    config.contact_request.type = tesseract_collision::ContactTestType::FIRST;
+    std::vector<tesseract_collision::ContactResultMap> serial_first_contacts;
+    EXPECT_TRUE(check(serial_first_contacts, config, 0));
+    EXPECT_EQ(getStepsInContact(serial_first_contacts), std::vector<std::size_t>{ steps_in_contact.front() });
+
+    std::vector<tesseract_collision::ContactResultMap> single_first_contacts;
+    EXPECT_TRUE(check(single_first_contacts, config, 1));
+    expectSameContacts(single_first_contacts, serial_first_contacts);
+
+    // Each thread stops after the step it is checking once a collision is found
+    std::vector<tesseract_collision::ContactResultMap> parallel_first_contacts;
+    EXPECT_TRUE(check(parallel_first_contacts, config, 4));
+    const std::vector<std::size_t> parallel_steps_in_contact = getStepsInContact(parallel_first_contacts);
+    EXPECT_GE(parallel_steps_in_contact.size(), 1);
+    EXPECT_LE(parallel_steps_in_contact.size(), 4);
+    for (std::size_t step : parallel_steps_in_contact)
+      EXPECT_FALSE(serial_contacts[step].empty()) << "step " << step;
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -33,6 +33,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/core/planner.h>
 #include <tesseract_motion_planners/trajopt/profile/trajopt_profile.h>
+#include <tesseract_motion_planners/trajopt/trajopt_solution_cache.h>
+#include <tesseract_motion_planners/trajopt/trajopt_problem_template.h>
 
 namespace tesseract_planning
 {
@@ -48,6 +50,14 @@ public:
   TrajOptMotionPlanner(TrajOptMotionPlanner&&) = delete;
   TrajOptMotionPlanner& operator=(TrajOptMotionPlanner&&) = delete;
 
+  /**
+   * @brief Solve the request
+   * @details The response statistics contain the solve time in seconds (solve_time) split into the time to construct
+   * the problem (construct_time) and to optimize it (optimize_time), the number of function evaluations (func_evals)
+   * and QP solves (qp_solves) of the optimizer, if the problem was created from a template (template_hit) and if it
+   * was warm started from the solution cache (warm_started). If a solution cache is set they also contain its hit
+   * rate (cache_hit_rate).
+   */
   PlannerResponse solve(const PlannerRequest& request) const override;
 
   bool terminate() override;
@@ -57,6 +67,39 @@ public:
   MotionPlanner::Ptr clone() const override;
 
   virtual std::shared_ptr<trajopt::ProblemConstructionInfo> createProblem(const PlannerRequest& request) const;
+
+  /**
+   * @brief Set the cache of prior solutions used to warm start requests
+   * @details If set, requests are seeded with the nearest cached solution instead of the interpolated seed and
+   * successful solutions are added to the cache. The cache may be shared by multiple planners.
+   * @param cache The solution cache, nullptr to disable warm starting
+   */
+  void setSolutionCache(TrajOptSolutionCache::Ptr cache);
+  TrajOptSolutionCache::Ptr getSolutionCache() const;
+
+  /**
+   * @brief Set the cache of problem templates used to create problems
+   * @details If set, requests which only differ from a prior request by their waypoints and seed rebind the problem
+   * of the prior request instead of creating it from the profiles. Only requests whose plan profiles are all
+   * TrajOptDefaultPlanProfile use templates. The cache may be shared by multiple planners, for example the raster
+   * segments of a RasterMotionTask. No cache is set by default, including by the motion planner task factories.
+   * @param cache The problem template cache, nullptr to always create problems from the profiles
+   */
+  void setProblemTemplateCache(TrajOptProblemTemplateCache::Ptr cache);
+  TrajOptProblemTemplateCache::Ptr getProblemTemplateCache() const;
+
+protected:
+  TrajOptSolutionCache::Ptr solution_cache_;
+  TrajOptProblemTemplateCache::Ptr problem_templates_;
+
+  /**
+   * @brief Create the problem from the problem template cache
+   * @param request The planner request
+   * @param template_hit Set to true if the problem was created from a cached template
+   * @return The problem construction info
+   */
+  std::shared_ptr<trajopt::ProblemConstructionInfo> createProblemFromTemplate(const PlannerRequest& request,
+                                                                              bool& template_hit) const;
 };
 
 }  // namespace tesseract_planning
@@ -0,0 +1,187 @@
+/**
+ * @file trajopt_problem_template.h
+ * @brief Reusable TrajOpt problems for requests which only differ by their waypoints
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_TRAJOPT_PROBLEM_TEMPLATE_H
+#define TESSERACT_MOTION_PLANNERS_TRAJOPT_PROBLEM_TEMPLATE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <trajopt/problem_description.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/core/types.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A TrajOpt problem construction info which can be rebound to the waypoints of another request
+ * @details The problem is created once by the planner, after which only the waypoint terms and the initial trajectory
+ * change between requests with the same number of steps, waypoint types, manipulator information and profiles. The
+ * waypoint terms are the cartesian and joint waypoint terms created by the TrajOptDefaultPlanProfile, all other terms
+ * are shared between the problems created from the template.
+ */
+class TrajOptProblemTemplate
+{
+public:
+  using Ptr = std::shared_ptr<TrajOptProblemTemplate>;
+  using ConstPtr = std::shared_ptr<const TrajOptProblemTemplate>;
+  using UPtr = std::unique_ptr<TrajOptProblemTemplate>;
+  using ConstUPtr = std::unique_ptr<const TrajOptProblemTemplate>;
+
+  /**
+   * @brief Create a template from a problem
+   * @param pci The problem construction info created by the planner, which must not be modified afterwards
+   */
+  explicit TrajOptProblemTemplate(std::shared_ptr<const trajopt::ProblemConstructionInfo> pci);
+
+  /**
+   * @brief Create a problem for the waypoints and seed of a request
+   * @param request A request with the same key as the request the template was created from
+   * @return The problem construction info
+   */
+  std::shared_ptr<trajopt::ProblemConstructionInfo> instantiate(const PlannerRequest& request) const;
+
+  /** @brief The number of waypoint terms which are rebound */
+  std::size_t getBindingCount() const;
+
+protected:
+  /** @brief The location of a waypoint term in the problem */
+  struct Binding
+  {
+    /** @brief The index of the waypoint */
+    int index{ 0 };
+    /** @brief Indicate if the term is a constraint or a cost */
+    bool constraint{ false };
+    /** @brief The index of the term in the constraint or cost infos */
+    std::size_t term_index{ 0 };
+  };
+
+  std::shared_ptr<const trajopt::ProblemConstructionInfo> pci_;
+  std::vector<Binding> bindings_;
+};
+
+/**
+ * @brief A thread safe cache of TrajOpt problem templates
+ * @details Templates are keyed on the environment, the number of steps, the manipulator information, the waypoint types
+ * and the profile names of a request. The profiles are identified by name, so they must not be modified while the
+ * templates created from them are cached. The cache may be shared by multiple planners, for example by the raster
+ * segments of a RasterMotionTask.
+ */
+class TrajOptProblemTemplateCache
+{
+public:
+  using Ptr = std::shared_ptr<TrajOptProblemTemplateCache>;
+  using ConstPtr = std::shared_ptr<const TrajOptProblemTemplateCache>;
+  using UPtr = std::unique_ptr<TrajOptProblemTemplateCache>;
+  using ConstUPtr = std::unique_ptr<const TrajOptProblemTemplateCache>;
+
+  /**
+   * @brief The key of a request
+   * @details The full key is stored and compared, so requests whose hashes collide never share a template
+   */
+  struct Key
+  {
+    /** @brief The environment */
+    const tesseract_environment::Environment* env{ nullptr };
+    /** @brief The revision of the environment */
+    int env_revision{ 0 };
+    /** @brief The manipulator information and profile names */
+    std::vector<std::string> names;
+    /** @brief The number of steps, the TCP offsets and the waypoint types */
+    std::vector<double> values;
+    /** @brief The profile overrides */
+    std::vector<const void*> profile_overrides;
+    /** @brief The hash of the key */
+    std::size_t hash{ 0 };
+
+    bool operator==(const Key& rhs) const;
+    bool operator!=(const Key& rhs) const;
+  };
+
+  /** @brief Hash a key, for use as the hash of an unordered container */
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  /**
+   * @brief Constructor
+   * @param max_size The maximum number of templates, the least recently used is removed first
+   */
+  explicit TrajOptProblemTemplateCache(std::size_t max_size = 32);
+
+  /**
+   * @brief Create the key of a request
+   * @param request The planner request
+   * @param planner_name The name of the planner used to remap the profiles
+   * @return The key of the request
+   */
+  static Key createKey(const PlannerRequest& request, const std::string& planner_name);
+
+  /**
+   * @brief Find the template of a key
+   * @param key The key of the request
+   * @param problem_template The template, which is null if the request can not be created from a template
+   * @return True if the key was found, otherwise false
+   */
+  bool lookup(const Key& key, TrajOptProblemTemplate::ConstPtr& problem_template);
+
+  /**
+   * @brief Store a template
+   * @param key The key of the request the template was created from
+   * @param problem_template The template, null to record that requests with this key can not use a template
+   */
+  void insert(const Key& key, TrajOptProblemTemplate::ConstPtr problem_template);
+
+  /** @brief Remove all templates and reset the statistics */
+  void clear();
+
+  /** @brief The number of stored templates */
+  std::size_t size() const;
+
+  /** @brief The number of lookups */
+  std::size_t getLookupCount() const;
+
+  /** @brief The number of lookups which found a template */
+  std::size_t getHitCount() const;
+
+protected:
+  using Entry = std::pair<Key, TrajOptProblemTemplate::ConstPtr>;
+
+  std::size_t max_size_;
+
+  mutable std::mutex mutex_;
+  /** @brief The templates ordered from most to least recently used */
+  std::list<Entry> entries_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  std::size_t lookup_count_{ 0 };
+  std::size_t hit_count_{ 0 };
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_TRAJOPT_PROBLEM_TEMPLATE_H
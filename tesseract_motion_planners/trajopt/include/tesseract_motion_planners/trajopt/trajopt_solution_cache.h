@@ -0,0 +1,158 @@
+/**
+ * @file trajopt_solution_cache.h
+ * @brief A cache of prior TrajOpt solutions used to warm start similar requests
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_TRAJOPT_SOLUTION_CACHE_H
+#define TESSERACT_MOTION_PLANNERS_TRAJOPT_SOLUTION_CACHE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_motion_planners/core/types.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A thread safe cache of prior TrajOpt solutions
+ * @details Requests which are re-planned with slightly shifted poses converge much faster when seeded with a prior
+ * solution than with the interpolated seed. Solutions are stored in buckets keyed on the environment and its revision,
+ * the manipulator, the number of steps, the profiles and the start and goal waypoints quantized to the cache
+ * resolution. A lookup returns the solution in the bucket whose start and goal are nearest to the request.
+ *
+ * Requests which straddle a quantization boundary land in different buckets, so a larger resolution trades the quality
+ * of the seed for a higher hit rate.
+ */
+class TrajOptSolutionCache
+{
+public:
+  using Ptr = std::shared_ptr<TrajOptSolutionCache>;
+  using ConstPtr = std::shared_ptr<const TrajOptSolutionCache>;
+  using UPtr = std::unique_ptr<TrajOptSolutionCache>;
+  using ConstUPtr = std::unique_ptr<const TrajOptSolutionCache>;
+
+  /** @brief The key of a request */
+  struct Key
+  {
+    /** @brief The environment */
+    const tesseract_environment::Environment* env{ nullptr };
+    /** @brief The revision of the environment */
+    int env_revision{ 0 };
+    /** @brief The manipulator information and profile names */
+    std::vector<std::string> names;
+    /** @brief The number of steps */
+    std::size_t steps{ 0 };
+    /** @brief The profile overrides */
+    std::vector<const void*> profile_overrides;
+    /** @brief The start and goal waypoints quantized to the cache resolution */
+    std::vector<long> cells;
+    /** @brief The hash of the key */
+    std::size_t hash{ 0 };
+    /** @brief The start and goal waypoints used to find the nearest solution in a bucket, not part of the comparison */
+    Eigen::VectorXd features;
+
+    bool operator==(const Key& rhs) const;
+    bool operator!=(const Key& rhs) const;
+  };
+
+  /** @brief Hash a key, for use as the hash of an unordered container */
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const { return key.hash; }
+  };
+
+  /**
+   * @brief Constructor
+   * @param joint_resolution The resolution in radians used to quantize joint waypoints
+   * @param cartesian_resolution The resolution in meters used to quantize cartesian waypoints, also applied to the
+   * components of their orientation quaternion
+   * @param max_entries_per_key The maximum number of solutions stored per key, the oldest is removed first
+   */
+  TrajOptSolutionCache(double joint_resolution = 0.1,
+                       double cartesian_resolution = 0.05,
+                       std::size_t max_entries_per_key = 10);
+
+  /**
+   * @brief Create the key of a request
+   * @param request The planner request
+   * @param planner_name The name of the planner used to remap the profiles
+   * @return The key of the request
+   */
+  Key createKey(const PlannerRequest& request, const std::string& planner_name) const;
+
+  /**
+   * @brief Find the stored solution nearest to the key
+   * @param key The key of the request
+   * @param trajectory The nearest solution if found
+   * @return True if a solution was found, otherwise false
+   */
+  bool lookup(const Key& key, tesseract_common::TrajArray& trajectory) const;
+
+  /**
+   * @brief Store a solution
+   * @param key The key of the request which was solved
+   * @param trajectory The solution
+   */
+  void insert(const Key& key, const tesseract_common::TrajArray& trajectory);
+
+  /** @brief Remove all solutions and reset the statistics */
+  void clear();
+
+  /** @brief The number of stored solutions */
+  std::size_t size() const;
+
+  /** @brief The number of lookups */
+  std::size_t getLookupCount() const;
+
+  /** @brief The number of lookups which found a solution */
+  std::size_t getHitCount() const;
+
+  /** @brief The ratio of lookups which found a solution */
+  double getHitRate() const;
+
+protected:
+  struct Entry
+  {
+    Eigen::VectorXd features;
+    tesseract_common::TrajArray trajectory;
+  };
+
+  double joint_resolution_;
+  double cartesian_resolution_;
+  std::size_t max_entries_per_key_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<Key, std::deque<Entry>, KeyHash> entries_;
+  std::size_t size_{ 0 };
+  mutable std::size_t lookup_count_{ 0 };
+  mutable std::size_t hit_count_{ 0 };
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_TRAJOPT_SOLUTION_CACHE_H
@@ -28,6 +28,7 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <functional>
 #include <trajopt/problem_description.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
@@ -36,6 +37,13 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
+/** @brief Combine the hash of a value with a seed, used to create the keys of the TrajOpt caches */
+template <typename T>
+inline void hashCombine(std::size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);  // NOLINT
+}
+
 trajopt::TermInfo::Ptr createCartesianWaypointTermInfo(int index,
                                                        const std::string& working_frame,
                                                        const Eigen::Isometry3d& c_wp,
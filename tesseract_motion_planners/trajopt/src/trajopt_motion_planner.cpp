@@ -25,6 +25,7 @@
  */
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <typeinfo>
 #include <console_bridge/console.h>
 #include <trajopt/plot_callback.hpp>
 #include <trajopt/problem_description.hpp>
@@ -35,6 +36,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <tesseract_environment/utils.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_common/timer.h>
+
 #include <tesseract_motion_planners/trajopt/trajopt_motion_planner.h>
 #include <tesseract_motion_planners/trajopt/profile/trajopt_default_plan_profile.h>
 #include <tesseract_motion_planners/trajopt/profile/trajopt_default_composite_profile.h>
@@ -62,7 +65,24 @@ bool TrajOptMotionPlanner::terminate()
 
 void TrajOptMotionPlanner::clear() {}
 
-MotionPlanner::Ptr TrajOptMotionPlanner::clone() const { return std::make_shared<TrajOptMotionPlanner>(name_); }
+MotionPlanner::Ptr TrajOptMotionPlanner::clone() const
+{
+  auto planner = std::make_shared<TrajOptMotionPlanner>(name_);
+  planner->setSolutionCache(solution_cache_);
+  planner->setProblemTemplateCache(problem_templates_);
+  return planner;
+}
+
+void TrajOptMotionPlanner::setSolutionCache(TrajOptSolutionCache::Ptr cache) { solution_cache_ = std::move(cache); }
+
+TrajOptSolutionCache::Ptr TrajOptMotionPlanner::getSolutionCache() const { return solution_cache_; }
+
+void TrajOptMotionPlanner::setProblemTemplateCache(TrajOptProblemTemplateCache::Ptr cache)
+{
+  problem_templates_ = std::move(cache);
+}
+
+TrajOptProblemTemplateCache::Ptr TrajOptMotionPlanner::getProblemTemplateCache() const { return problem_templates_; }
 
 PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
 {
@@ -74,7 +94,11 @@ PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
     return response;
   }
 
+  tesseract_common::Timer timer;
+  timer.start();
+
   std::shared_ptr<trajopt::ProblemConstructionInfo> pci;
+  bool template_hit{ false };
   if (request.data)
   {
     pci = std::static_pointer_cast<trajopt::ProblemConstructionInfo>(request.data);
@@ -83,7 +107,10 @@ PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
   {
     try
     {
-      pci = createProblem(request);
+      if (problem_templates_ != nullptr)
+        pci = createProblemFromTemplate(request, template_hit);
+      else
+        pci = createProblem(request);
     }
     catch (std::exception& e)
     {
@@ -98,6 +125,7 @@ PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
 
   // Construct Problem
   trajopt::TrajOptProb::Ptr problem = trajopt::ConstructProblem(*pci);
+  const double construct_time = timer.elapsedSeconds();
 
   // Set Log Level
   if (request.verbose)
@@ -113,11 +141,38 @@ PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
   for (const sco::Optimizer::Callback& callback : pci->callbacks)
     opt.addCallback(callback);
 
-  // Initialize
-  opt.initialize(trajToDblVec(problem->GetInitTraj()));
+  // Initialize from the nearest cached solution if available, keeping the fixed timesteps of the problem
+  tesseract_common::TrajArray init_traj = problem->GetInitTraj();
+  TrajOptSolutionCache::Key cache_key;
+  bool warm_started{ false };
+  if (solution_cache_ != nullptr)
+  {
+    cache_key = solution_cache_->createKey(request, name_);
+    tesseract_common::TrajArray cached_traj;
+    if (solution_cache_->lookup(cache_key, cached_traj) && cached_traj.rows() == init_traj.rows() &&
+        cached_traj.cols() == init_traj.cols())
+    {
+      for (int i : pci->basic_info.fixed_timesteps)
+        cached_traj.row(i) = init_traj.row(i);
+
+      init_traj = cached_traj;
+      warm_started = true;
+    }
+  }
+  opt.initialize(trajToDblVec(init_traj));
 
   // Optimize
   opt.optimize();
+  response.statistics["solve_time"] = timer.elapsedSeconds();
+  response.statistics["construct_time"] = construct_time;
+  response.statistics["optimize_time"] = response.statistics["solve_time"] - construct_time;
+  response.statistics["template_hit"] = template_hit ? 1 : 0;
+  response.statistics["func_evals"] = opt.results().n_func_evals;
+  response.statistics["qp_solves"] = opt.results().n_qp_solves;
+  response.statistics["warm_started"] = warm_started ? 1 : 0;
+  if (solution_cache_ != nullptr)
+    response.statistics["cache_hit_rate"] = solution_cache_->getHitRate();
+
   if (opt.results().status != sco::OptStatus::OPT_CONVERGED)
   {
     response.successful = false;
@@ -138,6 +193,9 @@ PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
     tesseract_common::enforcePositionLimits<double>(traj.row(i), joint_limits);
   }
 
+  if (solution_cache_ != nullptr)
+    solution_cache_->insert(cache_key, traj);
+
   // Flatten the results to make them easier to process
   response.results = request.instructions;
   auto results_instructions = response.results.flatten(&moveFilter);
@@ -154,6 +212,48 @@ PlannerResponse TrajOptMotionPlanner::solve(const PlannerRequest& request) const
   return response;
 }
 
+std::shared_ptr<trajopt::ProblemConstructionInfo>
+TrajOptMotionPlanner::createProblemFromTemplate(const PlannerRequest& request, bool& template_hit) const
+{
+  const TrajOptProblemTemplateCache::Key key = TrajOptProblemTemplateCache::createKey(request, name_);
+  TrajOptProblemTemplate::ConstPtr problem_template;
+  if (problem_templates_->lookup(key, problem_template))
+  {
+    if (problem_template == nullptr)
+      return createProblem(request);
+
+    template_hit = true;
+    return problem_template->instantiate(request);
+  }
+
+  std::shared_ptr<trajopt::ProblemConstructionInfo> pci = createProblem(request);
+
+  // Only the waypoint terms added by the default plan profile are known to be rebound correctly
+  bool templatable{ true };
+  for (const auto& instruction : request.instructions.flatten(&moveFilter))
+  {
+    const auto& move_instruction = instruction.get().as<MoveInstructionPoly>();
+    std::string profile = getProfileString(name_, move_instruction.getProfile(), request.plan_profile_remapping);
+    TrajOptPlanProfile::ConstPtr plan_profile = getProfile<TrajOptPlanProfile>(
+        name_, profile, *request.profiles, std::make_shared<TrajOptDefaultPlanProfile>());
+    plan_profile = applyProfileOverrides(name_, profile, plan_profile, move_instruction.getProfileOverrides());
+    const TrajOptPlanProfile& plan_profile_ref = *plan_profile;
+    if (typeid(plan_profile_ref) != typeid(TrajOptDefaultPlanProfile))
+    {
+      templatable = false;
+      break;
+    }
+  }
+
+  if (templatable)
+    problem_templates_->insert(
+        key, std::make_shared<TrajOptProblemTemplate>(std::make_shared<trajopt::ProblemConstructionInfo>(*pci)));
+  else
+    problem_templates_->insert(key, nullptr);
+
+  return pci;
+}
+
 std::shared_ptr<trajopt::ProblemConstructionInfo>
 TrajOptMotionPlanner::createProblem(const PlannerRequest& request) const
 {
@@ -0,0 +1,311 @@
+/**
+ * @file trajopt_problem_template.cpp
+ * @brief Reusable TrajOpt problems for requests which only differ by their waypoints
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <array>
+#include <trajopt/problem_description.hpp>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/utils.h>
+
+#include <tesseract_motion_planners/trajopt/trajopt_problem_template.h>
+#include <tesseract_motion_planners/trajopt/trajopt_utils.h>
+#include <tesseract_motion_planners/planner_utils.h>
+#include <tesseract_command_language/poly/move_instruction_poly.h>
+#include <tesseract_command_language/utils.h>
+
+namespace tesseract_planning
+{
+namespace
+{
+/** @brief Add a name to a key */
+void addName(TrajOptProblemTemplateCache::Key& key, const std::string& name)
+{
+  key.names.push_back(name);
+  hashCombine(key.hash, name);
+}
+
+/** @brief Add a value to a key */
+void addValue(TrajOptProblemTemplateCache::Key& key, double value)
+{
+  key.values.push_back(value);
+  hashCombine(key.hash, value);
+}
+
+/** @brief Add profile overrides to a key, they are identified by their address */
+void addProfileOverrides(TrajOptProblemTemplateCache::Key& key, const void* profile_overrides)
+{
+  key.profile_overrides.push_back(profile_overrides);
+  hashCombine(key.hash, profile_overrides);
+}
+
+void addManipulatorInfo(TrajOptProblemTemplateCache::Key& key,
+                        const tesseract_environment::Environment& env,
+                        const tesseract_common::ManipulatorInfo& mi)
+{
+  addName(key, mi.manipulator);
+  addName(key, mi.manipulator_ik_solver);
+  addName(key, mi.working_frame);
+  addName(key, mi.tcp_frame);
+
+  const Eigen::Isometry3d tcp_offset = env.findTCPOffset(mi);
+  for (Eigen::Index i = 0; i < tcp_offset.matrix().size(); ++i)
+    addValue(key, tcp_offset.matrix()(i));
+}
+
+/** @brief Get the index of the waypoint of a term created by the TrajOptDefaultPlanProfile, otherwise -1 */
+int getWaypointIndex(const trajopt::TermInfo& term_info)
+{
+  static const std::array<std::string, 3> prefixes{ "cartesian_waypoint_",
+                                                    "dyn_cartesian_waypoint_",
+                                                    "joint_waypoint_" };
+  for (const auto& prefix : prefixes)
+  {
+    if (term_info.name.compare(0, prefix.size(), prefix) != 0)
+      continue;
+
+    int index{ -1 };
+    if (tesseract_common::toNumeric<int>(term_info.name.substr(prefix.size()), index))
+      return index;
+  }
+  return -1;
+}
+
+/** @brief Create a copy of a waypoint term which targets the provided waypoint */
+trajopt::TermInfo::Ptr rebindTermInfo(const trajopt::TermInfo::Ptr& term_info, const WaypointPoly& waypoint)
+{
+  if (auto cart_info = std::dynamic_pointer_cast<trajopt::CartPoseTermInfo>(term_info))
+  {
+    auto rebound = std::make_shared<trajopt::CartPoseTermInfo>(*cart_info);
+    rebound->target_frame_offset = waypoint.as<CartesianWaypointPoly>().getTransform();
+    return rebound;
+  }
+
+  if (auto dyn_cart_info = std::dynamic_pointer_cast<trajopt::DynamicCartPoseTermInfo>(term_info))
+  {
+    auto rebound = std::make_shared<trajopt::DynamicCartPoseTermInfo>(*dyn_cart_info);
+    rebound->target_frame_offset = waypoint.as<CartesianWaypointPoly>().getTransform();
+    return rebound;
+  }
+
+  if (auto joint_info = std::dynamic_pointer_cast<trajopt::JointPosTermInfo>(term_info))
+  {
+    auto rebound = std::make_shared<trajopt::JointPosTermInfo>(*joint_info);
+    const Eigen::VectorXd& position = getJointPosition(waypoint);
+    rebound->targets = std::vector<double>(position.data(), position.data() + position.size());
+    if (waypoint.isJointWaypoint() && waypoint.as<JointWaypointPoly>().isToleranced())
+    {
+      const auto& jwp = waypoint.as<JointWaypointPoly>();
+      const Eigen::VectorXd& lower_tol = jwp.getLowerTolerance();
+      const Eigen::VectorXd& upper_tol = jwp.getUpperTolerance();
+      rebound->lower_tols = std::vector<double>(lower_tol.data(), lower_tol.data() + lower_tol.size());
+      rebound->upper_tols = std::vector<double>(upper_tol.data(), upper_tol.data() + upper_tol.size());
+    }
+    return rebound;
+  }
+
+  throw std::runtime_error("TrajOptProblemTemplate, unsupported waypoint term '" + term_info->name + "'");
+}
+}  // namespace
+
+TrajOptProblemTemplate::TrajOptProblemTemplate(std::shared_ptr<const trajopt::ProblemConstructionInfo> pci)
+  : pci_(std::move(pci))
+{
+  for (std::size_t i = 0; i < pci_->cnt_infos.size(); ++i)
+  {
+    int index = getWaypointIndex(*pci_->cnt_infos[i]);
+    if (index >= 0)
+      bindings_.push_back(Binding{ index, true, i });
+  }
+
+  for (std::size_t i = 0; i < pci_->cost_infos.size(); ++i)
+  {
+    int index = getWaypointIndex(*pci_->cost_infos[i]);
+    if (index >= 0)
+      bindings_.push_back(Binding{ index, false, i });
+  }
+}
+
+std::shared_ptr<trajopt::ProblemConstructionInfo>
+TrajOptProblemTemplate::instantiate(const PlannerRequest& request) const
+{
+  auto move_instructions = request.instructions.flatten(&moveFilter);
+  if (static_cast<long>(move_instructions.size()) != pci_->basic_info.n_steps)
+    throw std::runtime_error("TrajOptProblemTemplate, the request does not match the template");
+
+  auto pci = std::make_shared<trajopt::ProblemConstructionInfo>(*pci_);
+  for (const Binding& binding : bindings_)
+  {
+    std::vector<trajopt::TermInfo::Ptr>& term_infos = (binding.constraint) ? pci->cnt_infos : pci->cost_infos;
+    const auto& move_instruction =
+        move_instructions.at(static_cast<std::size_t>(binding.index)).get().as<MoveInstructionPoly>();
+    term_infos[binding.term_index] = rebindTermInfo(term_infos[binding.term_index], move_instruction.getWaypoint());
+  }
+
+  // Seed the problem the same way as TrajOptMotionPlanner::createProblem
+  const std::vector<std::string> joint_names = pci->kin->getJointNames();
+  for (std::size_t i = 0; i < move_instructions.size(); ++i)
+  {
+    const WaypointPoly& waypoint = move_instructions[i].get().as<MoveInstructionPoly>().getWaypoint();
+    auto row = static_cast<Eigen::Index>(i);
+    if (!waypoint.isCartesianWaypoint())
+      pci->init_info.data.row(row) = getJointPosition(waypoint);
+    else if (waypoint.as<CartesianWaypointPoly>().hasSeed())
+      pci->init_info.data.row(row) = waypoint.as<CartesianWaypointPoly>().getSeed().position;
+    else
+      pci->init_info.data.row(row) = request.env_state.getJointValues(joint_names);
+  }
+
+  return pci;
+}
+
+std::size_t TrajOptProblemTemplate::getBindingCount() const { return bindings_.size(); }
+
+TrajOptProblemTemplateCache::TrajOptProblemTemplateCache(std::size_t max_size) : max_size_(max_size)
+{
+  if (max_size_ == 0)
+    throw std::runtime_error("TrajOptProblemTemplateCache, the maximum size must be greater than zero");
+}
+
+bool TrajOptProblemTemplateCache::Key::operator==(const Key& rhs) const
+{
+  return (hash == rhs.hash && env == rhs.env && env_revision == rhs.env_revision && names == rhs.names &&
+          values == rhs.values && profile_overrides == rhs.profile_overrides);
+}
+
+bool TrajOptProblemTemplateCache::Key::operator!=(const Key& rhs) const { return !operator==(rhs); }
+
+TrajOptProblemTemplateCache::Key TrajOptProblemTemplateCache::createKey(const PlannerRequest& request,
+                                                                        const std::string& planner_name)
+{
+  const tesseract_common::ManipulatorInfo& composite_mi = request.instructions.getManipulatorInfo();
+  auto move_instructions = request.instructions.flatten(&moveFilter);
+
+  Key key;
+  key.env = request.env.get();
+  key.env_revision = request.env->getRevision();
+  hashCombine(key.hash, key.env);
+  hashCombine(key.hash, key.env_revision);
+  addManipulatorInfo(key, *request.env, composite_mi);
+  addValue(key, static_cast<double>(move_instructions.size()));
+  addName(key, getProfileString(planner_name, request.instructions.getProfile(), request.plan_profile_remapping));
+  addName(key, getProfileString(planner_name, request.instructions.getProfile(), request.composite_profile_remapping));
+  addProfileOverrides(key, request.instructions.getProfileOverrides().get());
+
+  for (const auto& instruction : move_instructions)
+  {
+    const auto& move_instruction = instruction.get().as<MoveInstructionPoly>();
+
+    // Record if the manipulator information is set, so the layout of the names and values is unambiguous
+    const bool has_manipulator_info = !move_instruction.getManipulatorInfo().empty();
+    addValue(key, (has_manipulator_info) ? 1 : 0);
+    if (has_manipulator_info)
+      addManipulatorInfo(key, *request.env, composite_mi.getCombined(move_instruction.getManipulatorInfo()));
+
+    addName(key, getProfileString(planner_name, move_instruction.getProfile(), request.plan_profile_remapping));
+    addProfileOverrides(key, move_instruction.getProfileOverrides().get());
+
+    const WaypointPoly& waypoint = move_instruction.getWaypoint();
+    if (waypoint.isCartesianWaypoint())
+    {
+      addValue(key, 0);
+    }
+    else if (waypoint.isJointWaypoint())
+    {
+      const auto& jwp = waypoint.as<JointWaypointPoly>();
+      addValue(key, 1);
+      addValue(key, (jwp.isConstrained()) ? 1 : 0);
+      addValue(key, (jwp.isToleranced()) ? 1 : 0);
+    }
+    else
+    {
+      addValue(key, 2);
+    }
+  }
+
+  return key;
+}
+
+bool TrajOptProblemTemplateCache::lookup(const Key& key, TrajOptProblemTemplate::ConstPtr& problem_template)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++lookup_count_;
+
+  auto it = index_.find(key);
+  if (it == index_.end())
+    return false;
+
+  ++hit_count_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  problem_template = it->second->second;
+  return true;
+}
+
+void TrajOptProblemTemplateCache::insert(const Key& key, TrajOptProblemTemplate::ConstPtr problem_template)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it != index_.end())
+  {
+    it->second->second = std::move(problem_template);
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  if (entries_.size() >= max_size_)
+  {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+
+  entries_.emplace_front(key, std::move(problem_template));
+  index_[key] = entries_.begin();
+}
+
+void TrajOptProblemTemplateCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  lookup_count_ = 0;
+  hit_count_ = 0;
+}
+
+std::size_t TrajOptProblemTemplateCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+std::size_t TrajOptProblemTemplateCache::getLookupCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lookup_count_;
+}
+
+std::size_t TrajOptProblemTemplateCache::getHitCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+}  // namespace tesseract_planning
@@ -0,0 +1,241 @@
+/**
+ * @file trajopt_solution_cache.cpp
+ * @brief A cache of prior TrajOpt solutions used to warm start similar requests
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <limits>
+#include <Eigen/Geometry>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/trajopt/trajopt_solution_cache.h>
+#include <tesseract_motion_planners/trajopt/trajopt_utils.h>
+#include <tesseract_motion_planners/planner_utils.h>
+#include <tesseract_command_language/poly/move_instruction_poly.h>
+#include <tesseract_command_language/utils.h>
+
+namespace tesseract_planning
+{
+namespace
+{
+/** @brief The features of a waypoint and the resolution used to quantize each of them */
+void appendWaypointFeatures(std::vector<double>& features,
+                            std::vector<double>& resolutions,
+                            const MoveInstructionPoly& move_instruction,
+                            double joint_resolution,
+                            double cartesian_resolution)
+{
+  const WaypointPoly& wp = move_instruction.getWaypoint();
+  if (wp.isCartesianWaypoint())
+  {
+    const Eigen::Isometry3d& pose = wp.as<CartesianWaypointPoly>().getTransform();
+    Eigen::Quaterniond q(pose.rotation());
+    if (q.w() < 0)
+      q.coeffs() *= -1;
+
+    for (Eigen::Index i = 0; i < 3; ++i)
+      features.push_back(pose.translation()(i));
+
+    for (Eigen::Index i = 0; i < 4; ++i)
+      features.push_back(q.coeffs()(i));
+
+    resolutions.insert(resolutions.end(), 7, cartesian_resolution);
+  }
+  else
+  {
+    const Eigen::VectorXd& position = getJointPosition(wp);
+    features.insert(features.end(), position.data(), position.data() + position.size());
+    resolutions.insert(resolutions.end(), static_cast<std::size_t>(position.size()), joint_resolution);
+  }
+}
+
+/** @brief Add a name to a key */
+void addName(TrajOptSolutionCache::Key& key, const std::string& name)
+{
+  key.names.push_back(name);
+  hashCombine(key.hash, name);
+}
+
+/** @brief Add profile overrides to a key, they are identified by their address */
+void addProfileOverrides(TrajOptSolutionCache::Key& key, const void* profile_overrides)
+{
+  key.profile_overrides.push_back(profile_overrides);
+  hashCombine(key.hash, profile_overrides);
+}
+}  // namespace
+
+bool TrajOptSolutionCache::Key::operator==(const Key& rhs) const
+{
+  return (hash == rhs.hash && env == rhs.env && env_revision == rhs.env_revision && names == rhs.names &&
+          steps == rhs.steps && profile_overrides == rhs.profile_overrides && cells == rhs.cells);
+}
+
+bool TrajOptSolutionCache::Key::operator!=(const Key& rhs) const { return !operator==(rhs); }
+
+TrajOptSolutionCache::TrajOptSolutionCache(double joint_resolution,
+                                           double cartesian_resolution,
+                                           std::size_t max_entries_per_key)
+  : joint_resolution_(joint_resolution)
+  , cartesian_resolution_(cartesian_resolution)
+  , max_entries_per_key_(max_entries_per_key)
+{
+  if (joint_resolution_ <= 0 || cartesian_resolution_ <= 0)
+    throw std::runtime_error("TrajOptSolutionCache, the resolution must be greater than zero");
+
+  if (max_entries_per_key_ == 0)
+    throw std::runtime_error("TrajOptSolutionCache, the maximum number of entries per key must be greater than zero");
+}
+
+TrajOptSolutionCache::Key TrajOptSolutionCache::createKey(const PlannerRequest& request,
+                                                          const std::string& planner_name) const
+{
+  const tesseract_common::ManipulatorInfo& composite_mi = request.instructions.getManipulatorInfo();
+  auto move_instructions = request.instructions.flatten(&moveFilter);
+  if (move_instructions.empty())
+    throw std::runtime_error("TrajOptSolutionCache, the request does not contain any move instructions");
+
+  Key key;
+  key.env = request.env.get();
+  key.env_revision = request.env->getRevision();
+  key.steps = move_instructions.size();
+  hashCombine(key.hash, key.env);
+  hashCombine(key.hash, key.env_revision);
+  hashCombine(key.hash, key.steps);
+  addName(key, composite_mi.manipulator);
+  addName(key, composite_mi.tcp_frame);
+  addName(key, composite_mi.working_frame);
+  addName(key, getProfileString(planner_name, request.instructions.getProfile(), request.composite_profile_remapping));
+  addProfileOverrides(key, request.instructions.getProfileOverrides().get());
+
+  for (const auto& instruction : move_instructions)
+  {
+    const auto& move_instruction = instruction.get().as<MoveInstructionPoly>();
+    addName(key, getProfileString(planner_name, move_instruction.getProfile(), request.plan_profile_remapping));
+    addProfileOverrides(key, move_instruction.getProfileOverrides().get());
+  }
+
+  std::vector<double> features;
+  std::vector<double> resolutions;
+  appendWaypointFeatures(features,
+                         resolutions,
+                         move_instructions.front().get().as<MoveInstructionPoly>(),
+                         joint_resolution_,
+                         cartesian_resolution_);
+  appendWaypointFeatures(features,
+                         resolutions,
+                         move_instructions.back().get().as<MoveInstructionPoly>(),
+                         joint_resolution_,
+                         cartesian_resolution_);
+
+  key.features = Eigen::Map<Eigen::VectorXd>(features.data(), static_cast<Eigen::Index>(features.size()));
+  key.cells.reserve(features.size());
+  for (std::size_t i = 0; i < features.size(); ++i)
+  {
+    key.cells.push_back(static_cast<long>(std::floor(features[i] / resolutions[i])));
+    hashCombine(key.hash, key.cells.back());
+  }
+
+  return key;
+}
+
+bool TrajOptSolutionCache::lookup(const Key& key, tesseract_common::TrajArray& trajectory) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++lookup_count_;
+
+  auto it = entries_.find(key);
+  if (it == entries_.end())
+    return false;
+
+  const Entry* nearest{ nullptr };
+  double nearest_distance = std::numeric_limits<double>::max();
+  for (const Entry& entry : it->second)
+  {
+    if (entry.features.size() != key.features.size())
+      continue;
+
+    const double distance = (entry.features - key.features).squaredNorm();
+    if (distance < nearest_distance)
+    {
+      nearest_distance = distance;
+      nearest = &entry;
+    }
+  }
+
+  if (nearest == nullptr)
+    return false;
+
+  ++hit_count_;
+  trajectory = nearest->trajectory;
+  return true;
+}
+
+void TrajOptSolutionCache::insert(const Key& key, const tesseract_common::TrajArray& trajectory)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::deque<Entry>& bucket = entries_[key];
+  if (bucket.size() >= max_entries_per_key_)
+  {
+    bucket.pop_front();
+    --size_;
+  }
+
+  bucket.push_back(Entry{ key.features, trajectory });
+  ++size_;
+}
+
+void TrajOptSolutionCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  size_ = 0;
+  lookup_count_ = 0;
+  hit_count_ = 0;
+}
+
+std::size_t TrajOptSolutionCache::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+std::size_t TrajOptSolutionCache::getLookupCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return lookup_count_;
+}
+
+std::size_t TrajOptSolutionCache::getHitCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hit_count_;
+}
+
+double TrajOptSolutionCache::getHitRate() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (lookup_count_ == 0)
+    return 0;
+
+  return static_cast<double>(hit_count_) / static_cast<double>(lookup_count_);
+}
+
+}  // namespace tesseract_planning
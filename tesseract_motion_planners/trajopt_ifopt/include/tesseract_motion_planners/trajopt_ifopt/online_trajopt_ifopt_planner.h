@@ -0,0 +1,212 @@
+/**
+ * @file online_trajopt_ifopt_planner.h
+ * @brief A receding horizon TrajOpt IFOPT planner which replans on every control cycle
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_ONLINE_TRAJOPT_IFOPT_PLANNER_H
+#define TESSERACT_MOTION_PLANNERS_ONLINE_TRAJOPT_IFOPT_PLANNER_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <deque>
+#include <memory>
+#include <vector>
+#include <Eigen/Geometry>
+#include <trajopt_sqp/qp_problem.h>
+#include <trajopt_sqp/qp_solver.h>
+#include <trajopt_sqp/trust_region_sqp_solver.h>
+#include <trajopt_sqp/types.h>
+#include <trajopt_ifopt/trajopt_ifopt.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/manipulator_info.h>
+#include <tesseract_common/types.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_profile.h>
+
+namespace tesseract_planning
+{
+/** @brief The result of a single replanning cycle */
+struct OnlineTrajOptIfoptCycleResult
+{
+  /** @brief The status of the SQP solver at the end of the cycle */
+  trajopt_sqp::SQPStatus status{ trajopt_sqp::SQPStatus::RUNNING };
+
+  /** @brief The number of SQP steps taken */
+  int sqp_steps{ 0 };
+
+  /** @brief The duration of the cycle in seconds */
+  double cycle_time{ 0 };
+
+  /** @brief Indicate if the cycle took longer than the deadline */
+  bool deadline_missed{ false };
+};
+
+/** @brief The cycle time statistics of the most recent replanning cycles, in seconds */
+struct OnlineTrajOptIfoptStatistics
+{
+  /** @brief The total number of cycles */
+  std::size_t cycles{ 0 };
+
+  /** @brief The total number of cycles which took longer than the deadline */
+  std::size_t deadline_misses{ 0 };
+
+  double mean{ 0 };
+  double p50{ 0 };
+  double p99{ 0 };
+  double max{ 0 };
+};
+
+/**
+ * @brief A receding horizon planner which moves the tool to a target pose while the target and the environment change
+ * @details Like OnlinePlanningExample, the problem, the SQP solver and its QP solver are created once by init and kept
+ * alive for every following cycle. Each cycle shifts the previous solution by one step, fixes the first step to the
+ * start state, warm starts the solver from the shifted trajectory and takes SQP steps until the solver stops or another
+ * step would exceed the cycle deadline. Since a SQP step can not be interrupted, at least one step is taken per cycle
+ * and a cycle may still exceed the deadline, which is reported in the cycle result and the statistics.
+ *
+ * The collision cache is cleared at the start of every cycle, so the collision evaluators check against the current
+ * state of the environment and moving obstacles only require updating the environment state. Changes to the
+ * environment structure require calling init again.
+ *
+ * This is not thread safe, each control loop should use its own planner.
+ */
+class OnlineTrajOptIfoptPlanner
+{
+public:
+  using Ptr = std::shared_ptr<OnlineTrajOptIfoptPlanner>;
+  using ConstPtr = std::shared_ptr<const OnlineTrajOptIfoptPlanner>;
+  using UPtr = std::unique_ptr<OnlineTrajOptIfoptPlanner>;
+  using ConstUPtr = std::unique_ptr<const OnlineTrajOptIfoptPlanner>;
+
+  /**
+   * @brief Constructor
+   * @param env The environment
+   * @param manip_info The manipulator, tcp frame and working frame of the target pose
+   * @param steps The number of steps in the horizon
+   * @param solver_profile The solver profile, if null the TrajOptIfoptDefaultSolverProfile is used
+   */
+  OnlineTrajOptIfoptPlanner(tesseract_environment::Environment::ConstPtr env,
+                            tesseract_common::ManipulatorInfo manip_info,
+                            int steps,
+                            TrajOptIfoptSolverProfile::ConstPtr solver_profile = nullptr);
+  virtual ~OnlineTrajOptIfoptPlanner() = default;
+  OnlineTrajOptIfoptPlanner(const OnlineTrajOptIfoptPlanner&) = delete;
+  OnlineTrajOptIfoptPlanner& operator=(const OnlineTrajOptIfoptPlanner&) = delete;
+  OnlineTrajOptIfoptPlanner(OnlineTrajOptIfoptPlanner&&) = delete;
+  OnlineTrajOptIfoptPlanner& operator=(OnlineTrajOptIfoptPlanner&&) = delete;
+
+  /** @brief The collision configuration, the type NONE disables collision checking */
+  trajopt_ifopt::TrajOptCollisionConfig::ConstPtr collision_config;
+
+  /** @brief The coefficients of the joint velocity cost */
+  Eigen::VectorXd velocity_coeff{ Eigen::VectorXd::Ones(1) };
+
+  /** @brief The trust region size used by every cycle, larger adapts quicker but more jerkily */
+  double trust_box_size{ 0.01 };
+
+  /** @brief The deadline of a cycle in seconds */
+  double cycle_deadline{ 0.01 };
+
+  /** @brief The maximum number of SQP steps per cycle */
+  int max_sqp_steps_per_cycle{ 5 };
+
+  /** @brief The number of recent cycles the statistics are computed from */
+  std::size_t statistics_window{ 1000 };
+
+  /** @brief Print the solver output */
+  bool verbose{ false };
+
+  /**
+   * @brief Create the problem and solve it to convergence
+   * @param start_state The joint state of the manipulator at the first step
+   * @param target_pose The target pose of the tcp relative to the working frame at the last step
+   * @param seed The initial trajectory, if empty every step is seeded with the start state
+   * @return True if the initial problem converged
+   */
+  bool init(const Eigen::Ref<const Eigen::VectorXd>& start_state,
+            const Eigen::Isometry3d& target_pose,
+            const tesseract_common::TrajArray& seed = tesseract_common::TrajArray());
+
+  /**
+   * @brief Set the joint state of the manipulator at the first step of the next cycle
+   * @details If not set between two cycles, the second step of the previous solution is used
+   */
+  void setStartState(const Eigen::Ref<const Eigen::VectorXd>& start_state);
+
+  /** @brief Set the target pose of the tcp relative to the working frame */
+  void setTargetPose(const Eigen::Isometry3d& target_pose);
+
+  /**
+   * @brief Replan from the previous solution
+   * @param shift_horizon Shift the previous solution by one step before solving
+   * @return The result of the cycle
+   */
+  OnlineTrajOptIfoptCycleResult cycle(bool shift_horizon = true);
+
+  /** @brief The current trajectory, one step per row */
+  const tesseract_common::TrajArray& getTrajectory() const;
+
+  /** @brief The joint names of the trajectory columns */
+  std::vector<std::string> getJointNames() const;
+
+  /** @brief The problem reused by every cycle, which is null until init is called */
+  std::shared_ptr<const trajopt_sqp::QPProblem> getProblem() const;
+
+  /** @brief The cycle time statistics */
+  OnlineTrajOptIfoptStatistics getStatistics() const;
+
+  /** @brief Reset the cycle time statistics */
+  void resetStatistics();
+
+protected:
+  tesseract_environment::Environment::ConstPtr env_;
+  tesseract_common::ManipulatorInfo manip_info_;
+  int steps_;
+  TrajOptIfoptSolverProfile::ConstPtr solver_profile_;
+
+  tesseract_kinematics::JointGroup::ConstPtr manip_;
+  trajopt_sqp::QPProblem::Ptr nlp_;
+  std::vector<trajopt_ifopt::JointPosition::Ptr> vars_;
+  trajopt_ifopt::CartPosConstraint::Ptr target_constraint_;
+  std::shared_ptr<trajopt_ifopt::CollisionCache> collision_cache_;
+  std::shared_ptr<trajopt_sqp::QPSolver> qp_solver_;
+  std::unique_ptr<trajopt_sqp::TrustRegionSQPSolver> solver_;
+
+  tesseract_common::TrajArray trajectory_;
+  Eigen::VectorXd start_state_;
+  bool start_state_set_{ false };
+
+  std::deque<double> cycle_times_;
+  std::size_t cycles_{ 0 };
+  std::size_t deadline_misses_{ 0 };
+
+  /** @brief Fix the first step to the start state */
+  void fixStartState();
+
+  /** @brief Add a cycle to the statistics */
+  void recordCycle(const OnlineTrajOptIfoptCycleResult& result);
+
+  /** @brief Add the collision constraints of every step after the first */
+  void addCollisionConstraints(const std::vector<trajopt_ifopt::JointPosition::ConstPtr>& vars);
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_ONLINE_TRAJOPT_IFOPT_PLANNER_H
@@ -0,0 +1,82 @@
+/**
+ * @file trajopt_ifopt_default_solver_profile.h
+ * @brief The default solver profile for TrajOpt IFOPT
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_TRAJOPT_IFOPT_DEFAULT_SOLVER_PROFILE_H
+#define TESSERACT_MOTION_PLANNERS_TRAJOPT_IFOPT_DEFAULT_SOLVER_PROFILE_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <trajopt_sqp/types.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_profile.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief The default solver parameters available for setting up TrajOpt IFOPT
+ * @details This uses the OSQP backend. Other QP solver backends are selected by providing a solver profile which
+ * creates and configures them.
+ */
+class TrajOptIfoptDefaultSolverProfile : public TrajOptIfoptSolverProfile
+{
+public:
+  using Ptr = std::shared_ptr<TrajOptIfoptDefaultSolverProfile>;
+  using ConstPtr = std::shared_ptr<const TrajOptIfoptDefaultSolverProfile>;
+
+  TrajOptIfoptDefaultSolverProfile() = default;
+  ~TrajOptIfoptDefaultSolverProfile() override = default;
+  TrajOptIfoptDefaultSolverProfile(const TrajOptIfoptDefaultSolverProfile&) = default;
+  TrajOptIfoptDefaultSolverProfile& operator=(const TrajOptIfoptDefaultSolverProfile&) = default;
+  TrajOptIfoptDefaultSolverProfile(TrajOptIfoptDefaultSolverProfile&&) = default;
+  TrajOptIfoptDefaultSolverProfile& operator=(TrajOptIfoptDefaultSolverProfile&&) = default;
+
+  /** @brief Optimization parameters */
+  trajopt_sqp::SQPParameters opt_info;
+
+  /** @brief Warm start each QP solve from the previous solution */
+  bool warm_start{ true };
+
+  /** @brief Polish the QP solution */
+  bool polish{ true };
+
+  /** @brief Adapt the ADMM step size during the QP solve */
+  bool adaptive_rho{ false };
+
+  /** @brief The maximum number of ADMM iterations of a QP solve */
+  int max_iteration{ 8192 };
+
+  /** @brief The absolute tolerance of a QP solve */
+  double absolute_tolerance{ 1e-4 };
+
+  /** @brief The relative tolerance of a QP solve */
+  double relative_tolerance{ 1e-6 };
+
+  std::shared_ptr<trajopt_sqp::QPSolver> createSolver() const override;
+
+  void apply(trajopt_sqp::QPSolver& qp_solver, bool verbose) const override;
+
+  void apply(trajopt_sqp::TrustRegionSQPSolver& solver) const override;
+
+  tinyxml2::XMLElement* toXML(tinyxml2::XMLDocument& doc) const override;
+};
+}  // namespace tesseract_planning
+#endif  // TESSERACT_MOTION_PLANNERS_TRAJOPT_IFOPT_DEFAULT_SOLVER_PROFILE_H
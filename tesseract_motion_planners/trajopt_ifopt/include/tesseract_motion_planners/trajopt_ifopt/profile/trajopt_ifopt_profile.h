@@ -31,6 +31,8 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <vector>
 #include <memory>
 #include <ifopt/problem.h>
+#include <trajopt_sqp/qp_solver.h>
+#include <trajopt_sqp/trust_region_sqp_solver.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/poly/instruction_poly.h>
@@ -94,6 +96,41 @@ public:
   virtual tinyxml2::XMLElement* toXML(tinyxml2::XMLDocument& doc) const = 0;
 };
 
+class TrajOptIfoptSolverProfile
+{
+public:
+  using Ptr = std::shared_ptr<TrajOptIfoptSolverProfile>;
+  using ConstPtr = std::shared_ptr<const TrajOptIfoptSolverProfile>;
+
+  TrajOptIfoptSolverProfile() = default;
+  virtual ~TrajOptIfoptSolverProfile() = default;
+  TrajOptIfoptSolverProfile(const TrajOptIfoptSolverProfile&) = default;
+  TrajOptIfoptSolverProfile& operator=(const TrajOptIfoptSolverProfile&) = default;
+  TrajOptIfoptSolverProfile(TrajOptIfoptSolverProfile&&) = default;
+  TrajOptIfoptSolverProfile& operator=(TrajOptIfoptSolverProfile&&) = default;
+
+  /**
+   * @brief Create the QP solver backend
+   * @details Solvers are reused by later solves with the same profile type and problem size, so this is only called
+   * when no idle solver is available.
+   */
+  virtual std::shared_ptr<trajopt_sqp::QPSolver> createSolver() const = 0;
+
+  /**
+   * @brief Apply the settings of the QP solver
+   * @details This is called before every solve, including when the solver is reused
+   * @param qp_solver A QP solver created by createSolver()
+   * @param verbose Indicate if the solver should be verbose
+   */
+  virtual void apply(trajopt_sqp::QPSolver& qp_solver, bool verbose) const = 0;
+
+  /** @brief Apply the parameters of the SQP solver */
+  virtual void apply(trajopt_sqp::TrustRegionSQPSolver& solver) const = 0;
+
+  virtual tinyxml2::XMLElement* toXML(tinyxml2::XMLDocument& doc) const = 0;
+};
+
+using TrajOptIfoptSolverProfileMap = std::unordered_map<std::string, TrajOptIfoptSolverProfile::ConstPtr>;
 using TrajOptIfoptCompositeProfileMap = std::unordered_map<std::string, TrajOptIfoptCompositeProfile::ConstPtr>;
 using TrajOptIfoptPlanProfileMap = std::unordered_map<std::string, TrajOptIfoptPlanProfile::ConstPtr>;
 
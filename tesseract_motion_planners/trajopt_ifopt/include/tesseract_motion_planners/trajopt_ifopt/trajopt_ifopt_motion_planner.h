@@ -34,6 +34,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/core/planner.h>
 #include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_profile.h>
+#include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_qp_solver_pool.h>
 
 namespace tesseract_planning
 {
@@ -61,6 +62,17 @@ public:
   MotionPlanner::Ptr clone() const override;
 
   virtual std::shared_ptr<TrajOptIfoptProblem> createProblem(const PlannerRequest& request) const;
+
+  /**
+   * @brief Set the pool of QP solvers reused between solves
+   * @details The planner creates its own pool which is shared with its clones
+   * @param pool The QP solver pool, nullptr to create a new QP solver for every solve
+   */
+  void setQPSolverPool(TrajOptIfoptQPSolverPool::Ptr pool);
+  TrajOptIfoptQPSolverPool::Ptr getQPSolverPool() const;
+
+protected:
+  TrajOptIfoptQPSolverPool::Ptr qp_solver_pool_;
 };
 
 }  // namespace tesseract_planning
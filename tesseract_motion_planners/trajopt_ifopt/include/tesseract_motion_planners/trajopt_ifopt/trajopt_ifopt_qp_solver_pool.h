@@ -0,0 +1,130 @@
+/**
+ * @file trajopt_ifopt_qp_solver_pool.h
+ * @brief A pool of QP solvers reused by TrajOpt IFOPT solves
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_MOTION_PLANNERS_TRAJOPT_IFOPT_QP_SOLVER_POOL_H
+#define TESSERACT_MOTION_PLANNERS_TRAJOPT_IFOPT_QP_SOLVER_POOL_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <typeindex>
+#include <vector>
+#include <trajopt_sqp/qp_solver.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_profile.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief A thread safe pool of QP solvers
+ * @details Creating a QP solver allocates its workspace, which is wasted when the planner solves many problems of the
+ * same size. A solve acquires an idle solver created by the same type of solver profile for the same number of QP
+ * variables and constraints, so problems with the same sparsity pattern reuse the solver, and releases it once done.
+ * A solver is only ever used by the thread which acquired it, so the pool holds at most one solver per key for each
+ * thread solving concurrently.
+ */
+class TrajOptIfoptQPSolverPool
+{
+public:
+  using Ptr = std::shared_ptr<TrajOptIfoptQPSolverPool>;
+  using ConstPtr = std::shared_ptr<const TrajOptIfoptQPSolverPool>;
+  using UPtr = std::unique_ptr<TrajOptIfoptQPSolverPool>;
+  using ConstUPtr = std::unique_ptr<const TrajOptIfoptQPSolverPool>;
+
+  /** @brief The solver profile type, number of QP variables and number of QP constraints */
+  using Key = std::tuple<std::type_index, Eigen::Index, Eigen::Index>;
+
+  /**
+   * @brief Create the key of a problem
+   * @param profile The solver profile which creates the solver
+   * @param num_qp_vars The number of QP variables
+   * @param num_qp_cnts The number of QP constraints
+   * @return The key
+   */
+  static Key createKey(const TrajOptIfoptSolverProfile& profile, Eigen::Index num_qp_vars, Eigen::Index num_qp_cnts);
+
+  /**
+   * @brief Holds an acquired solver and releases it to the pool when destroyed, also if the solve throws
+   * @details Without a pool a new solver is created which is destroyed with the lease
+   */
+  class Lease
+  {
+  public:
+    /**
+     * @brief Acquire a solver
+     * @param pool The pool, may be a nullptr
+     * @param key The key of the problem
+     * @param profile The solver profile
+     */
+    Lease(TrajOptIfoptQPSolverPool::Ptr pool, Key key, const TrajOptIfoptSolverProfile& profile);
+    ~Lease();
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    Lease(Lease&&) = delete;
+    Lease& operator=(Lease&&) = delete;
+
+    /** @brief The acquired solver */
+    const std::shared_ptr<trajopt_sqp::QPSolver>& get() const;
+
+  private:
+    TrajOptIfoptQPSolverPool::Ptr pool_;
+    Key key_;
+    std::shared_ptr<trajopt_sqp::QPSolver> solver_;
+  };
+
+  /**
+   * @brief Acquire an idle solver, creating one using the profile if none is available
+   * @param key The key of the problem
+   * @param profile The solver profile
+   * @return The solver which must be released once the solve is complete, prefer a Lease which does so
+   */
+  std::shared_ptr<trajopt_sqp::QPSolver> acquire(const Key& key, const TrajOptIfoptSolverProfile& profile);
+
+  /**
+   * @brief Return a solver to the pool
+   * @param key The key the solver was acquired with
+   * @param solver The solver
+   */
+  void release(const Key& key, std::shared_ptr<trajopt_sqp::QPSolver> solver);
+
+  /** @brief Remove all idle solvers */
+  void clear();
+
+  /** @brief The number of idle solvers */
+  std::size_t size() const;
+
+  /** @brief The number of solvers created */
+  std::size_t getCreatedCount() const;
+
+protected:
+  mutable std::mutex mutex_;
+  std::map<Key, std::vector<std::shared_ptr<trajopt_sqp::QPSolver>>> solvers_;
+  std::size_t size_{ 0 };
+  std::size_t created_count_{ 0 };
+};
+
+}  // namespace tesseract_planning
+
+#endif  // TESSERACT_MOTION_PLANNERS_TRAJOPT_IFOPT_QP_SOLVER_POOL_H
@@ -0,0 +1,310 @@
+/**
+ * @file online_trajopt_ifopt_planner.cpp
+ * @brief A receding horizon TrajOpt IFOPT planner which replans on every control cycle
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <trajopt_sqp/trajopt_qp_problem.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/trajopt_ifopt/online_trajopt_ifopt_planner.h>
+#include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_utils.h>
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_default_solver_profile.h>
+#include <tesseract_collision/core/common.h>
+
+namespace tesseract_planning
+{
+namespace
+{
+/** @brief Get the value at a percentile of the samples using the nearest rank */
+double getPercentile(std::vector<double>& samples, double percentile)
+{
+  auto rank = static_cast<std::size_t>(std::ceil(percentile * static_cast<double>(samples.size())));
+  auto nth = samples.begin() + static_cast<long>(std::max<std::size_t>(rank, 1) - 1);
+  std::nth_element(samples.begin(), nth, samples.end());
+  return *nth;
+}
+}  // namespace
+
+OnlineTrajOptIfoptPlanner::OnlineTrajOptIfoptPlanner(tesseract_environment::Environment::ConstPtr env,
+                                                     tesseract_common::ManipulatorInfo manip_info,
+                                                     int steps,
+                                                     TrajOptIfoptSolverProfile::ConstPtr solver_profile)
+  : env_(std::move(env)), manip_info_(std::move(manip_info)), steps_(steps), solver_profile_(std::move(solver_profile))
+{
+  if (env_ == nullptr)
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, the environment is a nullptr");
+
+  if (manip_info_.empty())
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, the manipulator information is empty");
+
+  if (steps_ < 2)
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, the horizon must have at least two steps");
+
+  if (solver_profile_ == nullptr)
+    solver_profile_ = std::make_shared<TrajOptIfoptDefaultSolverProfile>();
+
+  manip_ = env_->getJointGroup(manip_info_.manipulator);
+
+  auto config = std::make_shared<trajopt_ifopt::TrajOptCollisionConfig>(0.1, 10);
+  config->type = tesseract_collision::CollisionEvaluatorType::DISCRETE;
+  config->contact_request.type = tesseract_collision::ContactTestType::ALL;
+  config->collision_margin_buffer = 0.10;
+  collision_config = config;
+}
+
+bool OnlineTrajOptIfoptPlanner::init(const Eigen::Ref<const Eigen::VectorXd>& start_state,
+                                     const Eigen::Isometry3d& target_pose,
+                                     const tesseract_common::TrajArray& seed)
+{
+  const Eigen::Index dof = manip_->numJoints();
+  if (start_state.size() != dof)
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, the start state does not match the manipulator");
+
+  if (seed.size() != 0 && (seed.rows() != steps_ || seed.cols() != dof))
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, the seed does not match the horizon");
+
+  start_state_ = start_state;
+  start_state_set_ = false;
+  if (seed.size() != 0)
+    trajectory_ = seed;
+  else
+    trajectory_ = start_state.transpose().replicate(steps_, 1);
+  trajectory_.row(0) = start_state.transpose();
+
+  // Create the problem which is reused by every cycle
+  nlp_ = std::make_shared<trajopt_sqp::TrajOptQPProblem>();
+  vars_.clear();
+  collision_cache_ = nullptr;
+  vars_.reserve(static_cast<std::size_t>(steps_));
+  std::vector<trajopt_ifopt::JointPosition::ConstPtr> vars;
+  vars.reserve(static_cast<std::size_t>(steps_));
+  const Eigen::MatrixX2d joint_limits = manip_->getLimits().joint_limits;
+  const std::vector<std::string> joint_names = manip_->getJointNames();
+  for (Eigen::Index i = 0; i < steps_; ++i)
+  {
+    auto var = std::make_shared<trajopt_ifopt::JointPosition>(
+        trajectory_.row(i).transpose(), joint_names, "Joint_Position_" + std::to_string(i));
+    var->SetBounds(joint_limits);
+    vars_.push_back(var);
+    vars.push_back(var);
+    nlp_->addVariableSet(var);
+  }
+  fixStartState();
+
+  // Kept so the target pose can be updated between cycles
+  trajopt_ifopt::CartPosInfo cart_info(
+      manip_, manip_info_.tcp_frame, manip_info_.working_frame, env_->findTCPOffset(manip_info_), target_pose);
+  target_constraint_ = std::make_shared<trajopt_ifopt::CartPosConstraint>(cart_info, vars.back());
+  nlp_->addConstraintSet(target_constraint_);
+
+  addJointVelocitySquaredCost(*nlp_, vars, velocity_coeff);
+  addCollisionConstraints(vars);
+  nlp_->setup();
+
+  // Create the solver which is reused by every cycle
+  qp_solver_ = solver_profile_->createSolver();
+  solver_profile_->apply(*qp_solver_, verbose);
+  solver_ = std::make_unique<trajopt_sqp::TrustRegionSQPSolver>(qp_solver_);
+  solver_profile_->apply(*solver_);
+  solver_->verbose = verbose;
+  solver_->solve(nlp_);
+
+  const Eigen::VectorXd& x = solver_->getResults().best_var_vals;
+  trajectory_ = Eigen::Map<const tesseract_common::TrajArray>(x.data(), steps_, dof);
+
+  resetStatistics();
+  return (solver_->getStatus() == trajopt_sqp::SQPStatus::NLP_CONVERGED);
+}
+
+void OnlineTrajOptIfoptPlanner::setStartState(const Eigen::Ref<const Eigen::VectorXd>& start_state)
+{
+  if (start_state.size() != manip_->numJoints())
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, the start state does not match the manipulator");
+
+  start_state_ = start_state;
+  start_state_set_ = true;
+}
+
+void OnlineTrajOptIfoptPlanner::setTargetPose(const Eigen::Isometry3d& target_pose)
+{
+  if (target_constraint_ == nullptr)
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, init must be called before setting the target pose");
+
+  target_constraint_->SetTargetPose(target_pose);
+}
+
+OnlineTrajOptIfoptCycleResult OnlineTrajOptIfoptPlanner::cycle(bool shift_horizon)
+{
+  if (solver_ == nullptr)
+    throw std::runtime_error("OnlineTrajOptIfoptPlanner, init must be called before running a cycle");
+
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+
+  // Shift the horizon, the last step is repeated
+  if (shift_horizon)
+  {
+    if (!start_state_set_)
+      start_state_ = trajectory_.row(1).transpose();
+
+    trajectory_.topRows(steps_ - 1) = trajectory_.bottomRows(steps_ - 1).eval();
+  }
+  trajectory_.row(0) = start_state_.transpose();
+  start_state_set_ = false;
+
+  // Warm start the problem and solver from the previous solution
+  fixStartState();
+  nlp_->setVariables(trajectory_.data());
+
+  // The cached contacts are only valid for the environment state of the previous cycle
+  if (collision_cache_ != nullptr)
+    collision_cache_->clear();
+
+  solver_->params.initial_trust_box_size = trust_box_size;
+  solver_->init(nlp_);
+
+  OnlineTrajOptIfoptCycleResult result;
+  double step_time{ 0 };
+  while (result.sqp_steps < max_sqp_steps_per_cycle)
+  {
+    const auto step_start = Clock::now();
+    const double elapsed = std::chrono::duration<double>(step_start - start).count();
+    if (result.sqp_steps > 0 && elapsed + step_time > cycle_deadline)
+      break;
+
+    solver_->stepSQPSolver();
+    ++result.sqp_steps;
+    step_time = std::chrono::duration<double>(Clock::now() - step_start).count();
+
+    // The trust region can shrink to zero while stepping, so it is reset for the next step
+    solver_->setBoxSize(trust_box_size);
+    if (solver_->getStatus() != trajopt_sqp::SQPStatus::RUNNING)
+      break;
+  }
+
+  const Eigen::VectorXd& x = solver_->getResults().best_var_vals;
+  trajectory_ = Eigen::Map<const tesseract_common::TrajArray>(x.data(), steps_, manip_->numJoints());
+
+  result.status = solver_->getStatus();
+  result.cycle_time = std::chrono::duration<double>(Clock::now() - start).count();
+  result.deadline_missed = (result.cycle_time > cycle_deadline);
+  recordCycle(result);
+  return result;
+}
+
+const tesseract_common::TrajArray& OnlineTrajOptIfoptPlanner::getTrajectory() const { return trajectory_; }
+
+std::vector<std::string> OnlineTrajOptIfoptPlanner::getJointNames() const { return manip_->getJointNames(); }
+
+std::shared_ptr<const trajopt_sqp::QPProblem> OnlineTrajOptIfoptPlanner::getProblem() const { return nlp_; }
+
+OnlineTrajOptIfoptStatistics OnlineTrajOptIfoptPlanner::getStatistics() const
+{
+  OnlineTrajOptIfoptStatistics statistics;
+  statistics.cycles = cycles_;
+  statistics.deadline_misses = deadline_misses_;
+  if (cycle_times_.empty())
+    return statistics;
+
+  std::vector<double> samples(cycle_times_.begin(), cycle_times_.end());
+  statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+  statistics.max = *std::max_element(samples.begin(), samples.end());
+  statistics.p50 = getPercentile(samples, 0.5);
+  statistics.p99 = getPercentile(samples, 0.99);
+  return statistics;
+}
+
+void OnlineTrajOptIfoptPlanner::resetStatistics()
+{
+  cycle_times_.clear();
+  cycles_ = 0;
+  deadline_misses_ = 0;
+}
+
+void OnlineTrajOptIfoptPlanner::recordCycle(const OnlineTrajOptIfoptCycleResult& result)
+{
+  ++cycles_;
+  if (result.deadline_missed)
+    ++deadline_misses_;
+
+  cycle_times_.push_back(result.cycle_time);
+  while (cycle_times_.size() > statistics_window)
+    cycle_times_.pop_front();
+}
+
+void OnlineTrajOptIfoptPlanner::fixStartState()
+{
+  Eigen::MatrixX2d bounds(start_state_.size(), 2);
+  bounds.col(0) = start_state_;
+  bounds.col(1) = start_state_;
+  vars_.front()->SetBounds(bounds);
+}
+
+void OnlineTrajOptIfoptPlanner::addCollisionConstraints(const std::vector<trajopt_ifopt::JointPosition::ConstPtr>& vars)
+{
+  if (collision_config == nullptr || collision_config->type == tesseract_collision::CollisionEvaluatorType::NONE)
+    return;
+
+  auto cp = tesseract_collision::getCollisionObjectPairs(manip_->getActiveLinkNames(),
+                                                          manip_->getStaticLinkNames(),
+                                                          env_->getDiscreteContactManager()->getIsContactAllowedFn());
+  const int max_num_cnt = std::min(collision_config->max_num_cnt, static_cast<int>(cp.size()));
+
+  // Kept so the cache can be cleared at the start of every cycle
+  collision_cache_ = std::make_shared<trajopt_ifopt::CollisionCache>(vars.size());
+  if (collision_config->type == tesseract_collision::CollisionEvaluatorType::DISCRETE)
+  {
+    for (std::size_t i = 1; i < vars.size(); ++i)
+    {
+      auto collision_evaluator = std::make_shared<trajopt_ifopt::SingleTimestepCollisionEvaluator>(
+          collision_cache_, manip_, env_, collision_config, true);
+
+      nlp_->addConstraintSet(std::make_shared<trajopt_ifopt::DiscreteCollisionConstraint>(
+          collision_evaluator, vars[i], max_num_cnt, "DiscreteCollision_" + std::to_string(i)));
+    }
+    return;
+  }
+
+  std::array<bool, 2> position_vars_fixed{ true, false };
+  for (std::size_t i = 1; i < vars.size(); ++i)
+  {
+    trajopt_ifopt::ContinuousCollisionEvaluator::Ptr collision_evaluator;
+    if (collision_config->type == tesseract_collision::CollisionEvaluatorType::LVS_DISCRETE)
+      collision_evaluator = std::make_shared<trajopt_ifopt::LVSDiscreteCollisionEvaluator>(
+          collision_cache_, manip_, env_, collision_config, true);
+    else
+      collision_evaluator = std::make_shared<trajopt_ifopt::LVSContinuousCollisionEvaluator>(
+          collision_cache_, manip_, env_, collision_config, true);
+
+    std::array<trajopt_ifopt::JointPosition::ConstPtr, 2> position_vars{ vars[i - 1], vars[i] };
+    nlp_->addConstraintSet(std::make_shared<trajopt_ifopt::ContinuousCollisionConstraint>(
+        collision_evaluator, position_vars, position_vars_fixed, max_num_cnt, "LVSCollision_" + std::to_string(i)));
+
+    position_vars_fixed = { false, false };
+  }
+}
+
+}  // namespace tesseract_planning
@@ -0,0 +1,61 @@
+/**
+ * @file trajopt_ifopt_default_solver_profile.cpp
+ * @brief The default solver profile for TrajOpt IFOPT
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <trajopt_sqp/osqp_eigen_solver.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_default_solver_profile.h>
+
+namespace tesseract_planning
+{
+std::shared_ptr<trajopt_sqp::QPSolver> TrajOptIfoptDefaultSolverProfile::createSolver() const
+{
+  return std::make_shared<trajopt_sqp::OSQPEigenSolver>();
+}
+
+void TrajOptIfoptDefaultSolverProfile::apply(trajopt_sqp::QPSolver& qp_solver, bool verbose) const
+{
+  auto* osqp_solver = dynamic_cast<trajopt_sqp::OSQPEigenSolver*>(&qp_solver);
+  if (osqp_solver == nullptr)
+    throw std::runtime_error("TrajOptIfoptDefaultSolverProfile, the QP solver is not an OSQPEigenSolver");
+
+  osqp_solver->solver_.settings()->setVerbosity(verbose);
+  osqp_solver->solver_.settings()->setWarmStart(warm_start);
+  osqp_solver->solver_.settings()->setPolish(polish);
+  osqp_solver->solver_.settings()->setAdaptiveRho(adaptive_rho);
+  osqp_solver->solver_.settings()->setMaxIteration(max_iteration);
+  osqp_solver->solver_.settings()->setAbsoluteTolerance(absolute_tolerance);
+  osqp_solver->solver_.settings()->setRelativeTolerance(relative_tolerance);
+}
+
+void TrajOptIfoptDefaultSolverProfile::apply(trajopt_sqp::TrustRegionSQPSolver& solver) const
+{
+  solver.params = opt_info;
+}
+
+tinyxml2::XMLElement* TrajOptIfoptDefaultSolverProfile::toXML(tinyxml2::XMLDocument& /*doc*/) const
+{
+  throw std::runtime_error("TrajOptIfoptDefaultSolverProfile::toXML is not implemented!");
+}
+
+}  // namespace tesseract_planning
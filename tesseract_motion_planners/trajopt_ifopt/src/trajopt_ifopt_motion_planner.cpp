@@ -30,12 +30,12 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <trajopt_sqp/ifopt_qp_problem.h>
 #include <trajopt_sqp/trajopt_qp_problem.h>
 #include <trajopt_sqp/trust_region_sqp_solver.h>
-#include <trajopt_sqp/osqp_eigen_solver.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_motion_planner.h>
 #include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_default_plan_profile.h>
 #include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_default_composite_profile.h>
+#include <tesseract_motion_planners/trajopt_ifopt/profile/trajopt_ifopt_default_solver_profile.h>
 #include <tesseract_motion_planners/core/utils.h>
 #include <tesseract_motion_planners/planner_utils.h>
 
@@ -49,7 +49,10 @@ using namespace trajopt_ifopt;
 
 namespace tesseract_planning
 {
-TrajOptIfoptMotionPlanner::TrajOptIfoptMotionPlanner(std::string name) : MotionPlanner(std::move(name)) {}
+TrajOptIfoptMotionPlanner::TrajOptIfoptMotionPlanner(std::string name)
+  : MotionPlanner(std::move(name)), qp_solver_pool_(std::make_shared<TrajOptIfoptQPSolverPool>())
+{
+}
 
 bool TrajOptIfoptMotionPlanner::terminate()
 {
@@ -61,9 +64,18 @@ void TrajOptIfoptMotionPlanner::clear() { callbacks.clear(); }
 
 MotionPlanner::Ptr TrajOptIfoptMotionPlanner::clone() const
 {
-  return std::make_shared<TrajOptIfoptMotionPlanner>(name_);
+  auto planner = std::make_shared<TrajOptIfoptMotionPlanner>(name_);
+  planner->setQPSolverPool(qp_solver_pool_);
+  return planner;
+}
+
+void TrajOptIfoptMotionPlanner::setQPSolverPool(TrajOptIfoptQPSolverPool::Ptr pool)
+{
+  qp_solver_pool_ = std::move(pool);
 }
 
+TrajOptIfoptQPSolverPool::Ptr TrajOptIfoptMotionPlanner::getQPSolverPool() const { return qp_solver_pool_; }
+
 PlannerResponse TrajOptIfoptMotionPlanner::solve(const PlannerRequest& request) const
 {
   PlannerResponse response;
@@ -75,6 +87,25 @@ PlannerResponse TrajOptIfoptMotionPlanner::solve(const PlannerRequest& request)
   }
 
   std::shared_ptr<TrajOptIfoptProblem> problem;
+  TrajOptIfoptSolverProfile::ConstPtr solver_profile;
+  try
+  {
+    std::string profile = getProfileString(name_, request.instructions.getProfile(), request.plan_profile_remapping);
+    solver_profile = getProfile<TrajOptIfoptSolverProfile>(
+        name_, profile, *request.profiles, std::make_shared<TrajOptIfoptDefaultSolverProfile>());
+    solver_profile =
+        applyProfileOverrides(name_, profile, solver_profile, request.instructions.getProfileOverrides());
+    if (!solver_profile)
+      throw std::runtime_error("TrajOptIfoptMotionPlanner: Invalid solver profile");
+  }
+  catch (std::exception& e)
+  {
+    CONSOLE_BRIDGE_logError("TrajOptIfoptPlanner failed to get the solver profile: %s.", e.what());
+    response.successful = false;
+    response.message = ERROR_INVALID_INPUT;
+    return response;
+  }
+
   if (request.data)
   {
     problem = std::static_pointer_cast<TrajOptIfoptProblem>(request.data);
@@ -96,18 +127,13 @@ PlannerResponse TrajOptIfoptMotionPlanner::solve(const PlannerRequest& request)
     response.data = problem;
   }
 
-  // Create optimizer
-  /** @todo Enable solver selection (e.g. IPOPT) */
-  auto qp_solver = std::make_shared<trajopt_sqp::OSQPEigenSolver>();
-  trajopt_sqp::TrustRegionSQPSolver solver(qp_solver);
-  /** @todo Set these as the defaults in trajopt and allow setting */
-  qp_solver->solver_.settings()->setVerbosity(request.verbose);
-  qp_solver->solver_.settings()->setWarmStart(true);
-  qp_solver->solver_.settings()->setPolish(true);
-  qp_solver->solver_.settings()->setAdaptiveRho(false);
-  qp_solver->solver_.settings()->setMaxIteration(8192);
-  qp_solver->solver_.settings()->setAbsoluteTolerance(1e-4);
-  qp_solver->solver_.settings()->setRelativeTolerance(1e-6);
+  // Create optimizer, reusing a QP solver of a prior problem with the same size if available
+  const TrajOptIfoptQPSolverPool::Key qp_solver_key = TrajOptIfoptQPSolverPool::createKey(
+      *solver_profile, problem->nlp->getNumQPVars(), problem->nlp->getNumQPConstraints());
+  TrajOptIfoptQPSolverPool::Lease qp_solver(qp_solver_pool_, qp_solver_key, *solver_profile);
+  solver_profile->apply(*qp_solver.get(), request.verbose);
+  trajopt_sqp::TrustRegionSQPSolver solver(qp_solver.get());
+  solver_profile->apply(solver);
 
   // Add all callbacks
   for (const trajopt_sqp::SQPCallback::Ptr& callback : callbacks)
@@ -214,18 +240,6 @@ std::shared_ptr<TrajOptIfoptProblem> TrajOptIfoptMotionPlanner::createProblem(co
     throw std::runtime_error(error_msg);
   }
 
-  // Apply Solver parameters
-  std::string profile = request.instructions.getProfile();
-  ProfileDictionary::ConstPtr profile_overrides = request.instructions.getProfileOverrides();
-  profile = getProfileString(name_, profile, PlannerProfileRemapping());
-  //  TrajOptSolverProfile::ConstPtr solver_profile =
-  //      getProfile<TrajOptSolverProfile>(profile, solver_profiles, std::make_shared<TrajOptDefaultSolverProfile>());
-  //  solver_profile = applyProfileOverrides(name, solver_profile, profile_overrides);
-  //  if (!solver_profile)
-  //    throw std::runtime_error("TrajOptSolverConfig: Invalid profile");
-
-  //  solver_profile->apply(*pci);
-
   // Get kinematics information
   tesseract_environment::Environment::ConstPtr env = request.env;
   std::vector<std::string> active_links = problem->manip->getActiveLinkNames();
@@ -343,7 +357,8 @@ std::shared_ptr<TrajOptIfoptProblem> TrajOptIfoptMotionPlanner::createProblem(co
   // ----------------
   // Translate TCL for CompositeInstructions
   // ----------------
-  profile = getProfileString(name_, request.instructions.getProfile(), request.composite_profile_remapping);
+  std::string profile =
+      getProfileString(name_, request.instructions.getProfile(), request.composite_profile_remapping);
   TrajOptIfoptCompositeProfile::ConstPtr cur_composite_profile = getProfile<TrajOptIfoptCompositeProfile>(
       name_, profile, *request.profiles, std::make_shared<TrajOptIfoptDefaultCompositeProfile>());
   cur_composite_profile =
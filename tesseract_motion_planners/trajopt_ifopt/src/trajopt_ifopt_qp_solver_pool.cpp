@@ -0,0 +1,103 @@
+/**
+ * @file trajopt_ifopt_qp_solver_pool.cpp
+ * @brief A pool of QP solvers reused by TrajOpt IFOPT solves
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_motion_planners/trajopt_ifopt/trajopt_ifopt_qp_solver_pool.h>
+
+namespace tesseract_planning
+{
+TrajOptIfoptQPSolverPool::Key TrajOptIfoptQPSolverPool::createKey(const TrajOptIfoptSolverProfile& profile,
+                                                                  Eigen::Index num_qp_vars,
+                                                                  Eigen::Index num_qp_cnts)
+{
+  return Key{ std::type_index(typeid(profile)), num_qp_vars, num_qp_cnts };
+}
+
+TrajOptIfoptQPSolverPool::Lease::Lease(TrajOptIfoptQPSolverPool::Ptr pool,
+                                       Key key,
+                                       const TrajOptIfoptSolverProfile& profile)
+  : pool_(std::move(pool)), key_(std::move(key))
+{
+  solver_ = (pool_ == nullptr) ? profile.createSolver() : pool_->acquire(key_, profile);
+  if (solver_ == nullptr)
+    throw std::runtime_error("TrajOptIfoptQPSolverPool, the solver profile created a nullptr solver");
+}
+
+TrajOptIfoptQPSolverPool::Lease::~Lease()
+{
+  if (pool_ != nullptr)
+    pool_->release(key_, std::move(solver_));
+}
+
+const std::shared_ptr<trajopt_sqp::QPSolver>& TrajOptIfoptQPSolverPool::Lease::get() const { return solver_; }
+
+std::shared_ptr<trajopt_sqp::QPSolver> TrajOptIfoptQPSolverPool::acquire(const Key& key,
+                                                                         const TrajOptIfoptSolverProfile& profile)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = solvers_.find(key);
+    if (it != solvers_.end() && !it->second.empty())
+    {
+      std::shared_ptr<trajopt_sqp::QPSolver> solver = std::move(it->second.back());
+      it->second.pop_back();
+      --size_;
+      return solver;
+    }
+    ++created_count_;
+  }
+
+  std::shared_ptr<trajopt_sqp::QPSolver> solver = profile.createSolver();
+  if (solver == nullptr)
+    throw std::runtime_error("TrajOptIfoptQPSolverPool, the solver profile created a nullptr solver");
+
+  return solver;
+}
+
+void TrajOptIfoptQPSolverPool::release(const Key& key, std::shared_ptr<trajopt_sqp::QPSolver> solver)
+{
+  if (solver == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  solvers_[key].push_back(std::move(solver));
+  ++size_;
+}
+
+void TrajOptIfoptQPSolverPool::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  solvers_.clear();
+  size_ = 0;
+}
+
+std::size_t TrajOptIfoptQPSolverPool::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+std::size_t TrajOptIfoptQPSolverPool::getCreatedCount() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return created_count_;
+}
+
+}  // namespace tesseract_planning
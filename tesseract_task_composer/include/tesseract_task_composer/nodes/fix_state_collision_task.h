@@ -35,6 +35,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_task_composer/task_composer_node_info.h>
 
 #include <tesseract_task_composer/profiles/fix_state_collision_profile.h>
+#include <tesseract_motion_planners/core/contact_manager_pool.h>
 
 namespace tesseract_planning
 {
@@ -95,6 +96,9 @@ public:
 
   std::vector<tesseract_collision::ContactResultMap> contact_results;
 
+  /** @brief The number of random sampling attempts made for each waypoint, zero if it was not sampled */
+  std::vector<int> sampling_attempts;
+
   bool operator==(const FixStateCollisionTaskInfo& rhs) const;
   bool operator!=(const FixStateCollisionTaskInfo& rhs) const;
 
@@ -104,6 +108,57 @@ private:
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
 };
 
+/**
+ * @brief The kinematics and configured contact manager used to check the states of a manipulator
+ * @details Getting the joint group and cloning and configuring a contact manager cost far more than a single contact
+ * test, so FixStateCollisionTask creates a context once per manipulator and reuses it for every waypoint and sample.
+ * Each thread checking states is given its own clone of the configured contact manager.
+ */
+class FixStateCollisionContext
+{
+public:
+  using Ptr = std::shared_ptr<FixStateCollisionContext>;
+  using ConstPtr = std::shared_ptr<const FixStateCollisionContext>;
+  using UPtr = std::unique_ptr<FixStateCollisionContext>;
+  using ConstUPtr = std::unique_ptr<const FixStateCollisionContext>;
+
+  /**
+   * @brief Construct a context
+   * @param env The environment
+   * @param manipulator The name of the manipulator's joint group
+   * @param profile The profile providing the contact manager config
+   */
+  FixStateCollisionContext(const tesseract_environment::Environment& env,
+                           const std::string& manipulator,
+                           const FixStateCollisionProfile& profile);
+
+  /** @brief The manipulator's joint group */
+  const tesseract_kinematics::JointGroup& getJointGroup() const;
+
+  /** @brief The manipulator's joint limits */
+  const Eigen::MatrixX2d& getLimits() const;
+
+  /** @brief The configured contact manager of the calling thread */
+  tesseract_collision::DiscreteContactManager& getContactManager() const;
+
+private:
+  tesseract_kinematics::JointGroup::ConstPtr joint_group_;
+  Eigen::MatrixX2d limits_;
+  DiscreteContactManagerPool::UPtr contact_managers_;
+};
+
+/**
+ * @brief Checks if a joint state is in collision
+ * @param start_pos Vector that represents a joint state
+ * @param context The kinematics and contact manager of the manipulator
+ * @param profile Profile containing needed params
+ * @return True if in collision
+ */
+bool stateInCollision(const Eigen::Ref<const Eigen::VectorXd>& start_pos,
+                      const FixStateCollisionContext& context,
+                      const FixStateCollisionProfile& profile,
+                      tesseract_collision::ContactResultMap& contacts);
+
 /**
  * @brief Checks if a joint state is in collision
  * @param start_pos Vector that represents a joint state
@@ -116,6 +171,18 @@ bool stateInCollision(const Eigen::Ref<const Eigen::VectorXd>& start_pos,
                       const FixStateCollisionProfile& profile,
                       tesseract_collision::ContactResultMap& contacts);
 
+/**
+ * @brief Checks if a waypoint is in collision
+ * @param waypoint Must be a waypoint for which getJointPosition will return a position
+ * @param context The kinematics and contact manager of the manipulator
+ * @param profile Profile containing needed params
+ * @return True if in collision
+ */
+bool waypointInCollision(const WaypointPoly& waypoint,
+                         const FixStateCollisionContext& context,
+                         const FixStateCollisionProfile& profile,
+                         tesseract_collision::ContactResultMap& contacts);
+
 /**
  * @brief Checks if a waypoint is in collision
  * @param waypoint Must be a waypoint for which getJointPosition will return a position
@@ -140,6 +207,22 @@ bool moveWaypointFromCollisionTrajopt(WaypointPoly& waypoint,
                                       const TaskComposerInput& input,
                                       const FixStateCollisionProfile& profile);
 
+/**
+ * @brief Takes a waypoint and uses random sampling to find a position that is out of collision
+ * @details The samples are generated in batches and checked in order until one is out of collision
+ * @param waypoint Must be a waypoint for which getJointPosition will return a position
+ * @param context The kinematics and contact manager of the manipulator
+ * @param profile Profile containing needed params
+ * @param waypoint_index The index of the waypoint, combined with the seed of the profile
+ * @param attempts The number of samples checked
+ * @return True if successful
+ */
+bool moveWaypointFromCollisionRandomSampler(WaypointPoly& waypoint,
+                                            const FixStateCollisionContext& context,
+                                            const FixStateCollisionProfile& profile,
+                                            std::size_t waypoint_index,
+                                            int& attempts);
+
 /**
  * @brief Takes a waypoint and uses random sampling to find a position that is out of collision
  * @param waypoint Must be a waypoint for which getJointPosition will return a position
@@ -152,13 +235,36 @@ bool moveWaypointFromCollisionRandomSampler(WaypointPoly& waypoint,
                                             const TaskComposerInput& input,
                                             const FixStateCollisionProfile& profile);
 
+/**
+ * @brief Applies the correction methods of the profile in order until one moves the waypoint out of collision
+ * @param waypoint Must be a waypoint for which getJointPosition will return a position
+ * @param context The kinematics and contact manager of the manipulator
+ * @param profile Profile containing needed params
+ * @param waypoint_index The index of the waypoint, combined with the seed of the profile
+ * @param contacts The contacts of the waypoint if it could not be corrected
+ * @param sampling_attempts The number of random sampling attempts
+ * @return True if successful
+ */
+bool applyCorrectionWorkflow(WaypointPoly& waypoint,
+                             const tesseract_common::ManipulatorInfo& manip_info,
+                             const TaskComposerInput& input,
+                             const FixStateCollisionContext& context,
+                             const FixStateCollisionProfile& profile,
+                             std::size_t waypoint_index,
+                             tesseract_collision::ContactResultMap& contacts,
+                             int& sampling_attempts);
+
 bool applyCorrectionWorkflow(WaypointPoly& waypoint,
                              const tesseract_common::ManipulatorInfo& manip_info,
                              const TaskComposerInput& input,
-                             const FixStateCollisionProfile& profile);
+                             const FixStateCollisionProfile& profile,
+                             tesseract_collision::ContactResultMap& contacts);
 }  // namespace tesseract_planning
 
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::FixStateCollisionTask, "FixStateCollisionTask")
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::FixStateCollisionTaskInfo, "FixStateCollisionTaskInfo")
+// Version 1 added sampling_attempts
+BOOST_CLASS_VERSION(tesseract_planning::FixStateCollisionTaskInfo, 1)
 #endif  // TESSERACT_TASK_COMPOSER_FIX_STATE_COLLISION_TASK_H
@@ -51,7 +51,8 @@ public:
                                                std::string input_key,
                                                std::string output_key,
                                                bool is_conditional = true,
-                                               bool add_points = true);
+                                               bool add_points = true,
+                                               bool move_input = false);
   explicit IterativeSplineParameterizationTask(std::string name,
                                                const YAML::Node& config,
                                                const TaskComposerPluginFactory& plugin_factory);
@@ -71,6 +72,12 @@ protected:
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
 
   bool add_points_{ true };
+  /**
+   * @brief If true and the input key is also the output key, the program is moved out of the data storage instead of
+   * being copied. This avoids copying large programs but other tasks must not read the key while this task runs. On
+   * failure the program is restored unchanged.
+   */
+  bool move_input_{ false };
   IterativeSplineParameterization solver_;
 
   TaskComposerNodeInfo::UPtr runImpl(TaskComposerInput& input,
@@ -80,5 +87,8 @@ protected:
 }  // namespace tesseract_planning
 
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::IterativeSplineParameterizationTask, "IterativeSplineParameterizationTask")
+// Version 1 added move_input
+BOOST_CLASS_VERSION(tesseract_planning::IterativeSplineParameterizationTask, 1)
 #endif  // TESSERACT_TASK_COMPOSER_ITERATIVE_SPLINE_PARAMETERIZATION_TASK_H
@@ -30,6 +30,9 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/version.hpp>
+#include <type_traits>
+#include <utility>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_common/timer.h>
 
@@ -40,6 +43,21 @@ namespace tesseract_planning
 {
 class TaskComposerPluginFactory;
 
+namespace detail
+{
+/** @brief Check if a motion planner can solve with multiple threads */
+template <typename T, typename = void>
+struct HasSetNumThreads : std::false_type
+{
+};
+
+template <typename T>
+struct HasSetNumThreads<T, std::void_t<decltype(std::declval<T&>().setNumThreads(std::size_t{ 1 }))>>
+  : std::true_type
+{
+};
+}  // namespace detail
+
 template <typename MotionPlannerType>
 class MotionPlannerTask : public TaskComposerTask
 {
@@ -49,10 +67,12 @@ public:
                              std::string input_key,
                              std::string output_key,
                              bool format_result_as_input,
-                             bool is_conditional)
+                             bool is_conditional,
+                             bool move_input = false)
     : TaskComposerTask(std::move(name), is_conditional)
     , planner_(std::make_shared<MotionPlannerType>(name_))
     , format_result_as_input_(format_result_as_input)
+    , move_input_(move_input)
   {
     input_keys_.push_back(std::move(input_key));
     output_keys_.push_back(std::move(output_key));
@@ -79,6 +99,17 @@ public:
     {
       if (YAML::Node n = config["format_result_as_input"])
         format_result_as_input_ = n.as<bool>();
+
+      if (YAML::Node n = config["move_input"])
+        move_input_ = n.as<bool>();
+
+      if (YAML::Node n = config["num_threads"])
+      {
+        if constexpr (detail::HasSetNumThreads<MotionPlannerType>::value)
+          planner_->setNumThreads(n.as<std::size_t>());
+        else
+          throw std::runtime_error("'num_threads' is not supported by the planner");
+      }
     }
     catch (const std::exception& e)
     {
@@ -92,22 +123,38 @@ public:
   {
     bool equal = true;
     equal &= (format_result_as_input_ == rhs.format_result_as_input_);
+    equal &= (move_input_ == rhs.move_input_);
     equal &= TaskComposerTask::operator==(rhs);
     return equal;
   }
 
   bool operator!=(const MotionPlannerTask& rhs) const { return !operator==(rhs); }
 
+  /**
+   * @brief Get the planner used by the task
+   * @details This allows configuring planner specific options, for example sharing the TrajOpt problem template cache
+   * between the raster tasks created by the task factory of a RasterMotionTask.
+   */
+  std::shared_ptr<MotionPlannerType> getPlanner() const { return planner_; }
+
 protected:
   std::shared_ptr<MotionPlannerType> planner_;
   bool format_result_as_input_{ true };
 
+  /**
+   * @brief Move the instructions out of the data storage instead of copying them when the input and output keys match
+   * @details Other tasks must not read the key while the planner runs. On failure the instructions are restored.
+   */
+  bool move_input_{ false };
+
   friend struct tesseract_common::Serialization;
   friend class boost::serialization::access;
   template <class Archive>
-  void serialize(Archive& ar, const unsigned int /*version*/)  // NOLINT
+  void serialize(Archive& ar, const unsigned int version)  // NOLINT
   {
     ar& BOOST_SERIALIZATION_NVP(format_result_as_input_);
+    if (version > 0)
+      ar& BOOST_SERIALIZATION_NVP(move_input_);
     ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerTask);
   }
 
@@ -130,8 +177,11 @@ protected:
     // --------------------
     // Check that inputs are valid
     // --------------------
-    auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-    if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+    const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+    const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+    auto input_data_ptr = input.data_storage.getDataPtr(input_slot);
+    if (input_data_ptr == nullptr || input_data_ptr->isNull() ||
+        input_data_ptr->getType() != std::type_index(typeid(CompositeInstruction)))
     {
       info->message = "Input instructions to MotionPlannerTask: " + name_ + " must be a composite instruction";
       info->elapsed_time = timer.elapsedSeconds();
@@ -139,10 +189,16 @@ protected:
       return info;
     }
 
-    // Make a non-const copy of the input instructions to update the start/end
+    // The manipulator info of the input instructions is updated, so they are copied unless configured to take
+    // ownership of them when they are replaced by the results
+    input_data_ptr.reset();
+    const bool extract_input = move_input_ && (input_keys_[0] == output_keys_[0]);
+    tesseract_common::AnyPoly input_data_poly =
+        extract_input ? input.data_storage.extractData(input_slot) : input.data_storage.getData(input_slot);
     auto& instructions = input_data_poly.template as<CompositeInstruction>();
-    assert(!(input.problem.manip_info.empty() && instructions.getManipulatorInfo().empty()));
-    instructions.setManipulatorInfo(instructions.getManipulatorInfo().getCombined(input.problem.manip_info));
+    const tesseract_common::ManipulatorInfo input_manip_info = instructions.getManipulatorInfo();
+    assert(!(input.problem.manip_info.empty() && input_manip_info.empty()));
+    instructions.setManipulatorInfo(input_manip_info.getCombined(input.problem.manip_info));
 
     // --------------------
     // Fill out request
@@ -150,7 +206,7 @@ protected:
     PlannerRequest request;
     request.env_state = input.problem.env->getState();
     request.env = input.problem.env;
-    request.instructions = instructions;
+    request.instructions = std::move(instructions);
     request.profiles = input.profiles;
     request.plan_profile_remapping = input.problem.move_profile_remapping;
     request.composite_profile_remapping = input.problem.composite_profile_remapping;
@@ -162,14 +218,33 @@ protected:
     request.verbose = false;
     if (console_bridge::getLogLevel() == console_bridge::LogLevel::CONSOLE_BRIDGE_LOG_DEBUG)
       request.verbose = true;
-    PlannerResponse response = planner_->solve(request);
+
+    // Restores extracted instructions so the data storage is unchanged when planning fails
+    auto restore_input = [&]() {
+      if (!extract_input)
+        return;
+
+      request.instructions.setManipulatorInfo(input_manip_info);
+      input.data_storage.setData(input_slot, std::move(request.instructions));
+    };
+
+    PlannerResponse response;
+    try
+    {
+      response = planner_->solve(request);
+    }
+    catch (...)
+    {
+      restore_input();
+      throw;
+    }
 
     // --------------------
     // Verify Success
     // --------------------
     if (response)
     {
-      input.data_storage.setData(output_keys_[0], response.results);
+      input.data_storage.setData(output_slot, std::move(response.results));
 
       info->return_value = 1;
       info->message = response.message;
@@ -181,7 +256,8 @@ protected:
     CONSOLE_BRIDGE_logInform("%s motion planning failed (%s) for process input: %s",
                              planner_->getName().c_str(),
                              response.message.c_str(),
-                             instructions.getDescription().c_str());
+                             request.instructions.getDescription().c_str());
+    restore_input();
     info->message = response.message;
     info->elapsed_time = timer.elapsedSeconds();
     return info;
@@ -190,4 +266,16 @@ protected:
 
 }  // namespace tesseract_planning
 
+// Version 1 added move_input
+namespace boost::serialization
+{
+template <typename MotionPlannerType>
+struct version<tesseract_planning::MotionPlannerTask<MotionPlannerType>>
+{
+  using type = mpl::int_<1>;
+  using tag = mpl::integral_c_tag;
+  BOOST_STATIC_CONSTANT(int, value = version::type::value);
+};
+}  // namespace boost::serialization
+
 #endif  // TESSERACT_TASK_COMPOSER_MOTION_PLANNER_TASK_HPP
@@ -31,9 +31,13 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <console_bridge/console.h>
 #include <boost/serialization/string.hpp>
 #include <functional>
+#include <map>
+#include <mutex>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_task_composer/task_composer_task.h>
+#include <tesseract_task_composer/task_composer_graph.h>
+#include <tesseract_task_composer/task_composer_node_info.h>
 #include <tesseract_common/any_poly.h>
 
 namespace tesseract_planning
@@ -54,6 +58,16 @@ class TaskComposerPluginFactory;
  *   Composite - Raster segment
  *   Composite - to end
  * }
+ *
+ * The graph of tasks used to plan the program only depends on the number of rasters, so it is built once for each
+ * raster count and reused by subsequent runs which only assign the program segments to the graph's data keys.
+ *
+ * Raster segments usually share the same number of steps and profiles, so a raster task factory creating TrajOpt
+ * planner tasks can give each planner the same TrajOptProblemTemplateCache so the segments rebind a single problem.
+ *
+ * If TaskComposerInput::segment_callback is set, each planned segment (from start, rasters, transitions and to end) is
+ * published in program order as soon as it and all preceding segments have finished. The start instruction of every
+ * segment after from start is removed, so the published segments match the segments of the output program.
  */
 
 class RasterMotionTask : public TaskComposerTask
@@ -89,11 +103,52 @@ public:
   bool operator==(const RasterMotionTask& rhs) const;
   bool operator!=(const RasterMotionTask& rhs) const;
 
+  /** @brief The maximum number of raster graphs cached, each for a different number of rasters */
+  static const std::size_t MAX_CACHED_GRAPHS{ 16 };
+
 protected:
+  /** @brief A graph for planning a program with a given number of rasters along with its data keys */
+  struct RasterGraph
+  {
+    using ConstPtr = std::shared_ptr<const RasterGraph>;
+
+    /** @brief The graph of tasks */
+    TaskComposerGraph::UPtr graph;
+
+    /** @brief The input and output key of each raster task */
+    std::vector<std::pair<std::string, std::string>> raster_keys;
+
+    /** @brief The input key of the update state task and the output key of each transition task */
+    std::vector<std::pair<std::string, std::string>> transition_keys;
+
+    /** @brief The input key of the update state task and the output key of the from start task */
+    std::pair<std::string, std::string> from_start_keys;
+
+    /** @brief The input key of the update state task and the output key of the to end task */
+    std::pair<std::string, std::string> to_end_keys;
+  };
+
   TaskFactory freespace_task_factory_;
   TaskFactory raster_task_factory_;
   TaskFactory transition_task_factory_;
 
+  /** @brief Protects the raster graph cache */
+  mutable std::mutex graphs_mutex_;
+
+  /** @brief The raster graphs which have been built, keyed by the number of rasters */
+  mutable std::map<std::size_t, RasterGraph::ConstPtr> graphs_;
+
+  /**
+   * @brief Get the graph for the provided number of rasters, building it if it does not exist
+   * @param raster_count The number of rasters in the program
+   * @param cache_hit Set to true if the graph was previously built, otherwise false
+   * @return The raster graph
+   */
+  RasterGraph::ConstPtr getRasterGraph(std::size_t raster_count, bool& cache_hit) const;
+
+  /** @brief Build the graph for the provided number of rasters */
+  RasterGraph::ConstPtr createRasterGraph(std::size_t raster_count) const;
+
   friend struct tesseract_common::Serialization;
   friend class boost::serialization::access;
 
@@ -105,9 +160,38 @@ protected:
   TaskComposerNodeInfo::UPtr runImpl(TaskComposerInput& input,
                                      OptionalTaskComposerExecutor executor) const override final;
 };
+
+class RasterMotionTaskInfo : public TaskComposerNodeInfo
+{
+public:
+  using Ptr = std::shared_ptr<RasterMotionTaskInfo>;
+  using ConstPtr = std::shared_ptr<const RasterMotionTaskInfo>;
+  using UPtr = std::unique_ptr<RasterMotionTaskInfo>;
+  using ConstUPtr = std::unique_ptr<const RasterMotionTaskInfo>;
+
+  RasterMotionTaskInfo() = default;
+  RasterMotionTaskInfo(const RasterMotionTask& task);
+
+  /** @brief Time spent getting the graph and assigning its input data in seconds */
+  double graph_build_time{ 0 };
+
+  /** @brief Indicates if the graph was reused from a previous run */
+  bool graph_cache_hit{ false };
+
+  TaskComposerNodeInfo::UPtr clone() const override;
+
+  bool operator==(const RasterMotionTaskInfo& rhs) const;
+  bool operator!=(const RasterMotionTaskInfo& rhs) const;
+
+private:
+  friend class boost::serialization::access;
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int version);  // NOLINT
+};
 }  // namespace tesseract_planning
 
 #include <boost/serialization/export.hpp>
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::RasterMotionTask, "RasterMotionTask")
+BOOST_CLASS_EXPORT_KEY2(tesseract_planning::RasterMotionTaskInfo, "RasterMotionTaskInfo")
 
 #endif  // TESSERACT_TASK_COMPOSER_RASTER_MOTION_TASK_H
@@ -46,7 +46,8 @@ public:
   explicit RuckigTrajectorySmoothingTask(std::string name,
                                          std::string input_key,
                                          std::string output_key,
-                                         bool is_conditional = true);
+                                         bool is_conditional = true,
+                                         bool move_input = false);
   explicit RuckigTrajectorySmoothingTask(std::string name,
                                          const YAML::Node& config,
                                          const TaskComposerPluginFactory& plugin_factory);
@@ -65,6 +66,9 @@ protected:
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
 
+  /** @brief Move the program out of the data storage rather than copy it when the input and output keys match */
+  bool move_input_{ false };
+
   TaskComposerNodeInfo::UPtr runImpl(TaskComposerInput& input,
                                      OptionalTaskComposerExecutor executor = std::nullopt) const override final;
 };
@@ -72,6 +76,9 @@ protected:
 }  // namespace tesseract_planning
 
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::RuckigTrajectorySmoothingTask, "RuckigTrajectorySmoothingTask")
+// Version 1 added move_input
+BOOST_CLASS_VERSION(tesseract_planning::RuckigTrajectorySmoothingTask, 1)
 
 #endif  // TESSERACT_TASK_COMPOSER_RUCKIG_TRAJECTORY_SMOOTHING_TASK_H
@@ -50,7 +50,8 @@ public:
   explicit TimeOptimalParameterizationTask(std::string name,
                                            std::string input_key,
                                            std::string output_key,
-                                           bool is_conditional = true);
+                                           bool is_conditional = true,
+                                           bool move_input = false);
   explicit TimeOptimalParameterizationTask(std::string name,
                                            const YAML::Node& config,
                                            const TaskComposerPluginFactory& /*plugin_factory*/);
@@ -69,6 +70,9 @@ protected:
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
 
+  /** @brief Take the program from the data storage without copying when the input and output keys match */
+  bool move_input_{ false };
+
   TaskComposerNodeInfo::UPtr runImpl(TaskComposerInput& input,
                                      OptionalTaskComposerExecutor executor = std::nullopt) const override final;
 };
@@ -100,6 +104,9 @@ private:
 }  // namespace tesseract_planning
 
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::TimeOptimalParameterizationTask, "TimeOptimalParameterizationTask")
+// Version 1 added move_input
+BOOST_CLASS_VERSION(tesseract_planning::TimeOptimalParameterizationTask, 1)
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::TimeOptimalParameterizationTaskInfo, "TimeOptimalParameterizationTaskInfo")
 #endif  // TESSERACT_TASK_COMPOSER_TIME_OPTIMAL_TRAJECTORY_GENERATION_TASK_H
@@ -60,6 +60,12 @@ struct ContactCheckProfile
   virtual ~ContactCheckProfile() = default;
 
   tesseract_collision::CollisionCheckConfig config;
+
+  /**
+   * @brief The number of threads used to check the program
+   * @details If greater than one, the trajectory is split across threads each using a clone of the contact manager
+   */
+  std::size_t num_threads{ 1 };
 };
 }  // namespace tesseract_planning
 
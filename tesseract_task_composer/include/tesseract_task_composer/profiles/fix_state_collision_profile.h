@@ -81,6 +81,18 @@ struct FixStateCollisionProfile
 
   /** @brief Number of sampling attempts if TrajOpt correction fails*/
   int sampling_attempts{ 100 };
+
+  /** @brief The number of random samples generated at once by the random sampler */
+  int sampling_batch_size{ 10 };
+
+  /** @brief The seed of the random sampler, combined with the index of the waypoint so the samples are reproducible */
+  unsigned int seed{ 0 };
+
+  /**
+   * @brief The number of threads used to check and correct waypoints
+   * @details Only used by the modes checking more than one waypoint, the calling thread is one of the threads
+   */
+  std::size_t num_threads{ 1 };
 };
 }  // namespace tesseract_planning
 #endif  // TESSERACT_TASK_COMPOSER_FIX_STATE_COLLISION_PROFILE_H
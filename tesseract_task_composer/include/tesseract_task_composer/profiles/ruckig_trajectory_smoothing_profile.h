@@ -54,6 +54,12 @@ struct RuckigTrajectorySmoothingCompositeProfile
   /** @brief The max allow extension factor */
   double max_duration_extension_factor{ 10.0 };
 
+  /** @brief Stretch only the waypoints around a failing waypoint instead of the whole trajectory */
+  bool local_stretch{ false };
+
+  /** @brief The number of waypoints on each side of a failing waypoint stretched when local_stretch is enabled */
+  long local_stretch_window{ 3 };
+
   /** @brief max_velocity_scaling_factor The max velocity scaling factor passed to the solver */
   double max_velocity_scaling_factor{ 1.0 };
 
@@ -31,13 +31,23 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <memory>
 #include <unordered_map>
 #include <shared_mutex>
+#include <atomic>
+#include <array>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_common/any_poly.h>
 
 namespace tesseract_planning
 {
-/** @brief A thread save data storage */
+/**
+ * @brief A thread save data storage
+ * @details Each key is assigned an integer slot the first time it is used. Each slot holds a reference counted
+ * immutable value which is replaced (copy-on-write) when data is set, so readers can share the data without copying
+ * it. Slot lookups do not take the storage lock, so tasks which resolve their keys to slots up front can access data
+ * without contending with other tasks. Slots remain valid for the life of the storage but are reassigned when the
+ * storage is assigned to, so slots must be resolved again after an assignment.
+ */
 class TaskComposerDataStorage
 {
 public:
@@ -46,6 +56,12 @@ public:
   using UPtr = std::unique_ptr<TaskComposerDataStorage>;
   using ConstUPtr = std::unique_ptr<const TaskComposerDataStorage>;
 
+  /** @brief The shared immutable data stored in a slot */
+  using DataPtr = std::shared_ptr<const tesseract_common::AnyPoly>;
+
+  /** @brief The number of slots allocated at a time */
+  static constexpr std::size_t SLOT_CHUNK_SIZE{ 64 };
+
   TaskComposerDataStorage() = default;
   ~TaskComposerDataStorage() = default;
   TaskComposerDataStorage(const TaskComposerDataStorage&);
@@ -75,6 +91,30 @@ public:
    */
   tesseract_common::AnyPoly getData(const std::string& key) const;
 
+  /**
+   * @brief Get a shared pointer to the data for the provided key without copying it
+   * @param key The key to retreive the data
+   * @return The data associated with the key, nullptr if it does not exist
+   */
+  DataPtr getDataPtr(const std::string& key) const;
+
+  /**
+   * @brief Set data for the provided key, sharing it rather than copying it
+   * @param key The key to set data for
+   * @param data The data to assign to the provided key, which must not be modified while shared
+   */
+  void setDataPtr(const std::string& key, DataPtr data);
+
+  /**
+   * @brief Take ownership of the data for the provided key, removing it from the storage
+   * @details The data is moved out of the storage if it holds the only reference, otherwise a copy is returned. A task
+   * which is the sole consumer of a key can extract the data, modify it and move it back using setData, so the data is
+   * never copied.
+   * @param key The key to extract the data for
+   * @return The data associated with the key, null if it does not exist
+   */
+  tesseract_common::AnyPoly extractData(const std::string& key);
+
   /**
    * @brief Remove data for the provide key
    * @param key The key to remove data for
@@ -87,6 +127,71 @@ public:
    */
   std::unordered_map<std::string, tesseract_common::AnyPoly> getData() const;
 
+  /**
+   * @brief Get the slot assigned to the key, assigning a new slot if the key has not been used
+   * @param key The key to get the slot for
+   * @return The slot associated with the key
+   */
+  std::size_t getSlot(const std::string& key);
+
+  /**
+   * @brief Get the slots assigned to the keys, assigning new slots for keys that have not been used
+   * @param keys The keys to get the slots for
+   * @return The slots associated with the keys in the same order
+   */
+  std::vector<std::size_t> getSlots(const std::vector<std::string>& keys);
+
+  /**
+   * @brief Check if data exists for the provided slot
+   * @param slot The slot to check
+   * @return True if data exists, otherwise false
+   */
+  bool hasData(std::size_t slot) const;
+
+  /**
+   * @brief Set data for the provided slot
+   * @param slot The slot returned by getSlot
+   * @param data The data to assign to the slot
+   */
+  void setData(std::size_t slot, tesseract_common::AnyPoly data);
+
+  /**
+   * @brief Get a copy of the data for the provided slot
+   * @details This does not take the storage lock
+   * @param slot The slot returned by getSlot
+   * @return The data associated with the slot, null if it does not exist
+   */
+  tesseract_common::AnyPoly getData(std::size_t slot) const;
+
+  /**
+   * @brief Get a shared pointer to the data for the provided slot without copying it
+   * @details This does not take the storage lock
+   * @param slot The slot returned by getSlot
+   * @return The data associated with the slot, nullptr if it does not exist
+   */
+  DataPtr getDataPtr(std::size_t slot) const;
+
+  /**
+   * @brief Set data for the provided slot, sharing it rather than copying it
+   * @param slot The slot returned by getSlot
+   * @param data The data to assign to the slot, which must not be modified while shared
+   */
+  void setDataPtr(std::size_t slot, DataPtr data);
+
+  /**
+   * @brief Take ownership of the data for the provided slot, removing it from the storage
+   * @details The data is moved out of the storage if it holds the only reference, otherwise a copy is returned.
+   * @param slot The slot returned by getSlot
+   * @return The data associated with the slot, null if it does not exist
+   */
+  tesseract_common::AnyPoly extractData(std::size_t slot);
+
+  /**
+   * @brief Remove data for the provide slot
+   * @param slot The slot to remove data for
+   */
+  void removeData(std::size_t slot);
+
   bool operator==(const TaskComposerDataStorage& rhs) const;
   bool operator!=(const TaskComposerDataStorage& rhs) const;
 
@@ -94,11 +199,63 @@ protected:
   friend struct tesseract_common::Serialization;
   friend class boost::serialization::access;
 
+  template <class Archive>
+  void save(Archive& ar, const unsigned int version) const;  // NOLINT
+
+  template <class Archive>
+  void load(Archive& ar, const unsigned int version);  // NOLINT
+
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
 
+  struct SlotChunk
+  {
+    std::array<DataPtr, SLOT_CHUNK_SIZE> data;
+  };
+
+  /**
+   * @brief The table of slot chunks
+   * @details When full it is replaced by a larger copy. Readers may still hold the previous table, so replaced tables
+   * are kept until the storage is destroyed. They only hold pointers so the memory used is small.
+   */
+  struct SlotDirectory
+  {
+    explicit SlotDirectory(std::size_t capacity) : chunks(capacity) {}
+    std::vector<std::atomic<SlotChunk*>> chunks;
+  };
+
+  /** @brief Protects the key to slot mapping and the allocation of slot chunks */
   mutable std::shared_mutex mutex_;
-  std::unordered_map<std::string, tesseract_common::AnyPoly> data_;
+
+  /** @brief The slot assigned to each key */
+  std::unordered_map<std::string, std::size_t> slots_;
+
+  /** @brief The key assigned to each slot */
+  std::vector<std::string> keys_;
+
+  /** @brief The current slot chunk table, nullptr until the first slot is assigned */
+  std::atomic<SlotDirectory*> directory_{ nullptr };
+
+  /** @brief Owns the current and replaced slot chunk tables */
+  std::vector<std::unique_ptr<SlotDirectory>> directory_storage_;
+
+  /** @brief Owns the allocated slot chunks, once allocated a chunk is not released until the storage is destroyed */
+  std::vector<std::unique_ptr<SlotChunk>> chunk_storage_;
+
+  /** @brief Get the slot for a key, the caller must hold a unique lock */
+  std::size_t getSlotHelper(const std::string& key);
+
+  /** @brief Get the data location for a slot, nullptr if the chunk has not been allocated */
+  DataPtr* getSlotData(std::size_t slot) const;
+
+  /** @brief Allocate the chunk holding a slot, growing the chunk table if needed, the caller must hold a unique lock */
+  void allocateSlotChunk(std::size_t slot);
+
+  /** @brief Copy the slots and data from other, the caller must hold a unique lock and a lock on other */
+  void copyHelper(const TaskComposerDataStorage& other);
+
+  /** @brief Clear all data, the caller must hold a unique lock */
+  void clearHelper();
 };
 
 }  // namespace tesseract_planning
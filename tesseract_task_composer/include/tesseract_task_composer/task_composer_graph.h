@@ -80,6 +80,13 @@ public:
   /** @brief Get the nodes associated with the pipeline */
   std::map<boost::uuids::uuid, TaskComposerNode::ConstPtr> getNodes() const;
 
+  /**
+   * @brief Get the revision of the structure of the graph
+   * @details The revision changes whenever a node or edge is added to the graph or one of its subgraphs. Revisions are
+   * unique within the process, so a deserialized copy sharing the uuid of a graph has a different revision.
+   */
+  std::size_t getRevision() const;
+
   void renameInputKeys(const std::map<std::string, std::string>& input_keys) override;
 
   void renameOutputKeys(const std::map<std::string, std::string>& output_keys) override;
@@ -99,6 +106,9 @@ protected:
   void dumpHelper(std::ostream& os, const TaskComposerGraph& parent) const;
 
   std::map<boost::uuids::uuid, TaskComposerNode::Ptr> nodes_;
+
+  /** @brief The revision of the nodes and edges of this graph, excluding its subgraphs */
+  std::size_t revision_;
 };
 
 }  // namespace tesseract_planning
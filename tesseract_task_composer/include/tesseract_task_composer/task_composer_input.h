@@ -29,6 +29,7 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <atomic>
+#include <functional>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/profile_dictionary.h>
@@ -51,6 +52,13 @@ struct TaskComposerInput
   using UPtr = std::unique_ptr<TaskComposerInput>;
   using ConstUPtr = std::unique_ptr<const TaskComposerInput>;
 
+  /**
+   * @brief Callback used to publish a segment of the results
+   * @param index The index of the segment in the results
+   * @param segment The segment data
+   */
+  using SegmentCallback = std::function<void(std::size_t index, const tesseract_common::AnyPoly& segment)>;
+
   TaskComposerInput(TaskComposerProblem problem, ProfileDictionary::ConstPtr profiles = nullptr);
   TaskComposerInput& operator=(const TaskComposerInput&) = delete;
   TaskComposerInput& operator=(TaskComposerInput&&) = delete;
@@ -71,6 +79,14 @@ struct TaskComposerInput
   /** @brief The location where task info is stored during execution */
   TaskComposerNodeInfoContainer task_infos;
 
+  /**
+   * @brief Optional callback used by tasks which support streaming results (e.g. RasterMotionTask)
+   * @details Each segment is published in order as soon as it and all segments preceding it have finished, so
+   * execution of the first segments may start while the remaining ones are still being planned. It is called from
+   * the executor threads, so it should return quickly. This is not serialized.
+   */
+  SegmentCallback segment_callback;
+
   /**
    * @brief Check if process has been aborted
    * @details This accesses the internal process interface class
@@ -29,6 +29,10 @@
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <memory>
+#include <mutex>
+#include <map>
+#include <atomic>
+#include <boost/uuid/uuid.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_task_composer/task_composer_executor.h>
@@ -53,7 +57,9 @@ public:
   using ConstUPtr = std::unique_ptr<const TaskflowTaskComposerExecutor>;
 
   TaskflowTaskComposerExecutor(std::string name = "TaskflowExecutor",
-                               size_t num_threads = std::thread::hardware_concurrency());
+                               size_t num_threads = std::thread::hardware_concurrency(),
+                               bool cache_graphs = false,
+                               std::size_t cache_size = 64);
   TaskflowTaskComposerExecutor(std::string name, const YAML::Node& config);
   TaskflowTaskComposerExecutor(size_t num_threads);
   ~TaskflowTaskComposerExecutor() override;
@@ -70,6 +76,30 @@ public:
 
   long getTaskCount() const override final;
 
+  /** @brief Check if compiled taskflow graphs are cached between runs */
+  bool isGraphCacheEnabled() const;
+
+  /**
+   * @brief Enable or disable caching of compiled taskflow graphs
+   * @details When enabled, the taskflow generated for a graph is stored keyed by the graph uuid and reused by
+   * subsequent runs of the same graph, only the task input is rebound per run. A graph modified since it was compiled
+   * is detected by its revision and compiled again. Disabling the cache clears it.
+   * @param enable True to enable the cache, otherwise false
+   */
+  void setGraphCacheEnabled(bool enable);
+
+  /**
+   * @brief The maximum number of graphs stored in the cache
+   * @details Once exceeded the least recently used graph is removed from the cache
+   */
+  std::size_t getGraphCacheSize() const;
+
+  /** @brief Set the maximum number of graphs stored in the cache */
+  void setGraphCacheSize(std::size_t cache_size);
+
+  /** @brief Remove all compiled graphs from the cache */
+  void clearGraphCache();
+
   bool operator==(const TaskflowTaskComposerExecutor& rhs) const;
   bool operator!=(const TaskflowTaskComposerExecutor& rhs) const;
 
@@ -86,13 +116,52 @@ protected:
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);  // NOLINT
 
+  /**
+   * @brief A taskflow generated from a graph
+   * @details The task input and executor are bound through this object so the taskflow can be reused across runs
+   */
+  struct CompiledTaskflow
+  {
+    /** @brief The taskflows, the first being the top level graph followed by all subgraphs */
+    std::vector<std::unique_ptr<tf::Taskflow>> taskflows;
+
+    /** @brief The task input bound for the current run */
+    TaskComposerInput* task_input{ nullptr };
+
+    /** @brief The executor bound for the current run */
+    TaskComposerExecutor* task_executor{ nullptr };
+
+    /** @brief The revision of the graph when it was compiled, used to detect a modified graph */
+    std::size_t revision{ 0 };
+
+    /** @brief Indicates the taskflow is currently being executed */
+    std::atomic<bool> in_use{ false };
+  };
+
+  struct CachedGraph
+  {
+    /** @brief Compiled taskflows for a graph, more than one exists if the graph is run concurrently */
+    std::vector<std::shared_ptr<CompiledTaskflow>> compiled;
+
+    /** @brief Used to identify the least recently used graph */
+    std::size_t last_used{ 0 };
+  };
+
   std::size_t num_threads_;
+  bool cache_graphs_{ false };
+  std::size_t cache_size_{ 64 };
   std::unique_ptr<tf::Executor> executor_;
 
-  static std::shared_ptr<std::vector<std::unique_ptr<tf::Taskflow>>>
-  convertToTaskflow(const TaskComposerGraph& task_graph,
-                    TaskComposerInput& task_input,
-                    TaskComposerExecutor& task_executor);
+  mutable std::mutex cache_mutex_;
+  std::map<boost::uuids::uuid, CachedGraph> cache_;
+  std::size_t cache_counter_{ 0 };
+
+  /** @brief Get an idle compiled taskflow for the graph from the cache, compiling it if one does not exist */
+  std::shared_ptr<CompiledTaskflow> acquireCompiledTaskflow(const TaskComposerGraph& task_graph);
+
+  static std::shared_ptr<CompiledTaskflow> compileTaskflow(const TaskComposerGraph& task_graph);
+
+  static void convertToTaskflow(const TaskComposerGraph& task_graph, CompiledTaskflow& compiled);
 
   static std::shared_ptr<std::vector<std::unique_ptr<tf::Taskflow>>>
   convertToTaskflow(const TaskComposerTask& task, TaskComposerInput& task_input, TaskComposerExecutor& task_executor);
@@ -101,6 +170,9 @@ protected:
 
 #include <boost/serialization/export.hpp>
 #include <boost/serialization/tracking.hpp>
+#include <boost/serialization/version.hpp>
 BOOST_CLASS_EXPORT_KEY2(tesseract_planning::TaskflowTaskComposerExecutor, "TaskflowExecutor")
+// Version 1 added the graph cache settings
+BOOST_CLASS_VERSION(tesseract_planning::TaskflowTaskComposerExecutor, 1)
 
 #endif  // TESSERACT_TASK_COMPOSER_TASKFLOW_TASK_COMPOSER_EXECUTOR_H
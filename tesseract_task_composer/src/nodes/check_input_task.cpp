@@ -73,17 +73,20 @@ TaskComposerNodeInfo::UPtr CheckInputTask::runImpl(TaskComposerInput& input,
   }
 
   // Get Composite Profile
-  for (const auto& key : input_keys_)
+  const std::vector<std::size_t> input_slots = input.data_storage.getSlots(input_keys_);
+  for (std::size_t i = 0; i < input_keys_.size(); ++i)
   {
-    auto input_data_poly = input.data_storage.getData(key);
-    if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+    const std::string& key = input_keys_[i];
+    auto input_data_poly = input.data_storage.getDataPtr(input_slots[i]);
+    if (input_data_poly == nullptr || input_data_poly->isNull() ||
+        input_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
     {
       info->message = "Input key '" + key + "' is missing";
       CONSOLE_BRIDGE_logError("%s", info->message.c_str());
       return info;
     }
 
-    const auto& ci = input_data_poly.as<CompositeInstruction>();
+    const auto& ci = input_data_poly->as<CompositeInstruction>();
     std::string profile = ci.getProfile();
     profile = getProfileString(name_, profile, input.problem.composite_profile_remapping);
     auto cur_composite_profile =
@@ -83,8 +83,10 @@ TaskComposerNodeInfo::UPtr ContinuousContactCheckTask::runImpl(TaskComposerInput
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  auto input_data_poly = input.data_storage.getDataPtr(input_slot);
+  if (input_data_poly == nullptr || input_data_poly->isNull() ||
+      input_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input seed to ContinuousContactCheckTask must be a composite instruction";
     CONSOLE_BRIDGE_logError("%s", info->message.c_str());
@@ -94,7 +96,7 @@ TaskComposerNodeInfo::UPtr ContinuousContactCheckTask::runImpl(TaskComposerInput
   }
 
   // Get Composite Profile
-  const auto& ci = input_data_poly.as<CompositeInstruction>();
+  const auto& ci = input_data_poly->as<CompositeInstruction>();
   std::string profile = ci.getProfile();
   profile = getProfileString(name_, profile, input.problem.composite_profile_remapping);
   auto cur_composite_profile =
@@ -111,7 +113,14 @@ TaskComposerNodeInfo::UPtr ContinuousContactCheckTask::runImpl(TaskComposerInput
   manager->applyContactManagerConfig(cur_composite_profile->config.contact_manager_config);
 
   std::vector<tesseract_collision::ContactResultMap> contacts;
-  if (contactCheckProgram(contacts, *manager, *state_solver, ci, cur_composite_profile->config))
+  bool in_contact{ false };
+  if (cur_composite_profile->num_threads > 1)
+    in_contact = contactCheckProgramParallel(
+        contacts, *manager, *state_solver, ci, cur_composite_profile->config, cur_composite_profile->num_threads);
+  else
+    in_contact = contactCheckProgram(contacts, *manager, *state_solver, ci, cur_composite_profile->config);
+
+  if (in_contact)
   {
     info->message = "Results are not contact free for process input: " + ci.getDescription();
     CONSOLE_BRIDGE_logInform("%s", info->message.c_str());
@@ -87,7 +87,9 @@ TaskComposerNodeInfo::UPtr FixStateBoundsTask::runImpl(TaskComposerInput& input,
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slot);
   if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input instruction to FixStateBounds must be a composite instruction";
@@ -111,7 +113,7 @@ TaskComposerNodeInfo::UPtr FixStateBoundsTask::runImpl(TaskComposerInput& input,
 
   if (cur_composite_profile->mode == FixStateBoundsProfile::Settings::DISABLED)
   {
-    input.data_storage.setData(output_keys_[0], input_data_poly);
+    input.data_storage.setData(output_slot, input_data_poly);
     info->message = "Successful, DISABLED";
     info->return_value = 1;
     info->elapsed_time = timer.elapsedSeconds();
@@ -171,7 +173,7 @@ TaskComposerNodeInfo::UPtr FixStateBoundsTask::runImpl(TaskComposerInput& input,
       auto flattened = ci.flatten(moveFilter);
       if (flattened.empty())
       {
-        input.data_storage.setData(output_keys_[0], input_data_poly);
+        input.data_storage.setData(output_slot, input_data_poly);
         info->message = "FixStateBoundsTask found no MoveInstructions to process";
         info->return_value = 1;
         info->elapsed_time = timer.elapsedSeconds();
@@ -206,14 +208,14 @@ TaskComposerNodeInfo::UPtr FixStateBoundsTask::runImpl(TaskComposerInput& input,
     }
     break;
     case FixStateBoundsProfile::Settings::DISABLED:
-      input.data_storage.setData(output_keys_[0], input_data_poly);
+      input.data_storage.setData(output_slot, input_data_poly);
       info->message = "Successful, DISABLED";
       info->return_value = 1;
       info->elapsed_time = timer.elapsedSeconds();
       return info;
   }
 
-  input.data_storage.setData(output_keys_[0], input_data_poly);
+  input.data_storage.setData(output_slot, input_data_poly);
   info->message = "Successful";
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
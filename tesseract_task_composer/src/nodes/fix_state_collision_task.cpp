@@ -30,6 +30,9 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <boost/serialization/string.hpp>
 #include <boost/serialization/vector.hpp>
 #include <boost/serialization/map.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <trajopt/problem_description.hpp>
@@ -39,28 +42,41 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_task_composer/nodes/fix_state_collision_task.h>
 #include <tesseract_command_language/utils.h>
 #include <tesseract_motion_planners/planner_utils.h>
+#include <tesseract_motion_planners/core/parallel_for.h>
 #include <tesseract_collision/core/serialization.h>
 
 namespace tesseract_planning
 {
+FixStateCollisionContext::FixStateCollisionContext(const tesseract_environment::Environment& env,
+                                                   const std::string& manipulator,
+                                                   const FixStateCollisionProfile& profile)
+  : joint_group_(env.getJointGroup(manipulator)), limits_(joint_group_->getLimits().joint_limits)
+{
+  tesseract_collision::DiscreteContactManager::Ptr manager = env.getDiscreteContactManager();
+  manager->setActiveCollisionObjects(joint_group_->getActiveLinkNames());
+  manager->applyContactManagerConfig(profile.collision_check_config.contact_manager_config);
+  contact_managers_ = std::make_unique<DiscreteContactManagerPool>(std::move(manager));
+}
+
+const tesseract_kinematics::JointGroup& FixStateCollisionContext::getJointGroup() const { return *joint_group_; }
+
+const Eigen::MatrixX2d& FixStateCollisionContext::getLimits() const { return limits_; }
+
+tesseract_collision::DiscreteContactManager& FixStateCollisionContext::getContactManager() const
+{
+  return contact_managers_->get();
+}
+
 bool stateInCollision(const Eigen::Ref<const Eigen::VectorXd>& start_pos,
-                      const tesseract_common::ManipulatorInfo& manip_info,
-                      const TaskComposerInput& input,
+                      const FixStateCollisionContext& context,
                       const FixStateCollisionProfile& profile,
                       tesseract_collision::ContactResultMap& contacts)
 {
   using namespace tesseract_collision;
   using namespace tesseract_environment;
 
-  tesseract_common::ManipulatorInfo mi = manip_info.getCombined(input.problem.manip_info);
-  auto joint_group = input.problem.env->getJointGroup(mi.manipulator);
-
-  DiscreteContactManager::Ptr manager = input.problem.env->getDiscreteContactManager();
-  manager->setActiveCollisionObjects(joint_group->getActiveLinkNames());
-  manager->applyContactManagerConfig(profile.collision_check_config.contact_manager_config);
-
-  tesseract_common::TransformMap state = joint_group->calcFwdKin(start_pos);
-  contacts = checkTrajectoryState(*manager, state, profile.collision_check_config);
+  tesseract_common::TransformMap state = context.getJointGroup().calcFwdKin(start_pos);
+  contacts = checkTrajectoryState(context.getContactManager(), state, profile.collision_check_config);
   if (contacts.empty())
   {
     CONSOLE_BRIDGE_logDebug("No collisions found");
@@ -81,9 +97,19 @@ bool stateInCollision(const Eigen::Ref<const Eigen::VectorXd>& start_pos,
   return true;
 }
 
+bool stateInCollision(const Eigen::Ref<const Eigen::VectorXd>& start_pos,
+                      const tesseract_common::ManipulatorInfo& manip_info,
+                      const TaskComposerInput& input,
+                      const FixStateCollisionProfile& profile,
+                      tesseract_collision::ContactResultMap& contacts)
+{
+  tesseract_common::ManipulatorInfo mi = manip_info.getCombined(input.problem.manip_info);
+  FixStateCollisionContext context(*input.problem.env, mi.manipulator, profile);
+  return stateInCollision(start_pos, context, profile, contacts);
+}
+
 bool waypointInCollision(const WaypointPoly& waypoint,
-                         const tesseract_common::ManipulatorInfo& manip_info,
-                         const TaskComposerInput& input,
+                         const FixStateCollisionContext& context,
                          const FixStateCollisionProfile& profile,
                          tesseract_collision::ContactResultMap& contacts)
 {
@@ -105,7 +131,24 @@ bool waypointInCollision(const WaypointPoly& waypoint,
     return false;
   }
 
-  return stateInCollision(start_pos, manip_info, input, profile, contacts);
+  return stateInCollision(start_pos, context, profile, contacts);
+}
+
+bool waypointInCollision(const WaypointPoly& waypoint,
+                         const tesseract_common::ManipulatorInfo& manip_info,
+                         const TaskComposerInput& input,
+                         const FixStateCollisionProfile& profile,
+                         tesseract_collision::ContactResultMap& contacts)
+{
+  if (waypoint.isCartesianWaypoint())
+  {
+    CONSOLE_BRIDGE_logDebug("WaypointInCollision, skipping cartesian waypoint!");
+    return false;
+  }
+
+  tesseract_common::ManipulatorInfo mi = manip_info.getCombined(input.problem.manip_info);
+  FixStateCollisionContext context(*input.problem.env, mi.manipulator, profile);
+  return waypointInCollision(waypoint, context, profile, contacts);
 }
 
 bool moveWaypointFromCollisionTrajopt(WaypointPoly& waypoint,
@@ -232,10 +275,12 @@ bool moveWaypointFromCollisionTrajopt(WaypointPoly& waypoint,
 }
 
 bool moveWaypointFromCollisionRandomSampler(WaypointPoly& waypoint,
-                                            const tesseract_common::ManipulatorInfo& manip_info,
-                                            const TaskComposerInput& input,
-                                            const FixStateCollisionProfile& profile)
+                                            const FixStateCollisionContext& context,
+                                            const FixStateCollisionProfile& profile,
+                                            std::size_t waypoint_index,
+                                            int& attempts)
 {
+  attempts = 0;
   if (waypoint.isCartesianWaypoint())
   {
     CONSOLE_BRIDGE_logDebug("MoveWaypointFromCollisionRandomSampler, skipping cartesian waypoint!");
@@ -254,37 +299,65 @@ bool moveWaypointFromCollisionRandomSampler(WaypointPoly& waypoint,
     return false;
   }
 
-  tesseract_common::ManipulatorInfo mi = manip_info.getCombined(input.problem.manip_info);
-  tesseract_kinematics::JointGroup::UPtr kin = input.problem.env->getJointGroup(mi.manipulator);
-  Eigen::MatrixXd limits = kin->getLimits().joint_limits;
+  const Eigen::MatrixX2d& limits = context.getLimits();
   Eigen::VectorXd range = limits.col(1).array() - limits.col(0).array();
-
   assert(start_pos.size() == range.size());
-  for (int i = 0; i < profile.sampling_attempts; i++)
-  {
-    Eigen::VectorXd start_sampled_pos =
-        start_pos + Eigen::VectorXd::Random(start_pos.size()).cwiseProduct(range) * profile.jiggle_factor;
 
-    // Make sure it doesn't violate joint limits
-    Eigen::VectorXd sampled_pos = start_sampled_pos;
-    sampled_pos = sampled_pos.cwiseMax(limits.col(0));
-    sampled_pos = sampled_pos.cwiseMin(limits.col(1));
+  // Each waypoint has its own generator so the samples do not depend on the thread or the order of the waypoints
+  std::seed_seq seed{ profile.seed, static_cast<unsigned int>(waypoint_index) };
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  const int batch_size = std::max(profile.sampling_batch_size, 1);
+  Eigen::MatrixXd samples(start_pos.size(), batch_size);
+  tesseract_collision::ContactResultMap contacts;
+  while (attempts < profile.sampling_attempts)
+  {
+    // Generate a batch of samples
+    const int count = std::min(batch_size, profile.sampling_attempts - attempts);
+    auto batch = samples.leftCols(count);
+    batch = Eigen::MatrixXd::NullaryExpr(start_pos.size(), count, [&]() { return distribution(generator); });
+    batch = (batch.array().colwise() * (range * profile.jiggle_factor).array()).colwise() + start_pos.array();
 
-    tesseract_collision::ContactResultMap contacts;
-    if (!stateInCollision(sampled_pos, manip_info, input, profile, contacts))
+    for (Eigen::Index i = 0; i < count; ++i)
     {
-      return setJointPosition(waypoint, sampled_pos);
+      // Make sure it doesn't violate joint limits
+      batch.col(i) = batch.col(i).cwiseMax(limits.col(0)).cwiseMin(limits.col(1));
+
+      ++attempts;
+      if (!stateInCollision(batch.col(i), context, profile, contacts))
+        return setJointPosition(waypoint, batch.col(i));
     }
   }
 
   return false;
 }
 
+bool moveWaypointFromCollisionRandomSampler(WaypointPoly& waypoint,
+                                            const tesseract_common::ManipulatorInfo& manip_info,
+                                            const TaskComposerInput& input,
+                                            const FixStateCollisionProfile& profile)
+{
+  if (waypoint.isCartesianWaypoint())
+  {
+    CONSOLE_BRIDGE_logDebug("MoveWaypointFromCollisionRandomSampler, skipping cartesian waypoint!");
+    return true;
+  }
+
+  tesseract_common::ManipulatorInfo mi = manip_info.getCombined(input.problem.manip_info);
+  FixStateCollisionContext context(*input.problem.env, mi.manipulator, profile);
+  int attempts{ 0 };
+  return moveWaypointFromCollisionRandomSampler(waypoint, context, profile, 0, attempts);
+}
+
 bool applyCorrectionWorkflow(WaypointPoly& waypoint,
                              const tesseract_common::ManipulatorInfo& manip_info,
                              const TaskComposerInput& input,
+                             const FixStateCollisionContext& context,
                              const FixStateCollisionProfile& profile,
-                             tesseract_collision::ContactResultMap& contacts)
+                             std::size_t waypoint_index,
+                             tesseract_collision::ContactResultMap& contacts,
+                             int& sampling_attempts)
 {
   for (const auto& method : profile.correction_workflow)
   {
@@ -297,16 +370,93 @@ bool applyCorrectionWorkflow(WaypointPoly& waypoint,
           return true;
         break;
       case FixStateCollisionProfile::CorrectionMethod::RANDOM_SAMPLER:
-        if (moveWaypointFromCollisionRandomSampler(waypoint, manip_info, input, profile))
+        if (moveWaypointFromCollisionRandomSampler(waypoint, context, profile, waypoint_index, sampling_attempts))
           return true;
         break;
     }
   }
   // If all methods have tried without returning, then correction failed
-  waypointInCollision(waypoint, manip_info, input, profile, contacts);  // NOLINT Not sure why clang-tidy errors here
+  waypointInCollision(waypoint, context, profile, contacts);  // NOLINT Not sure why clang-tidy errors here
   return false;
 }
 
+bool applyCorrectionWorkflow(WaypointPoly& waypoint,
+                             const tesseract_common::ManipulatorInfo& manip_info,
+                             const TaskComposerInput& input,
+                             const FixStateCollisionProfile& profile,
+                             tesseract_collision::ContactResultMap& contacts)
+{
+  tesseract_common::ManipulatorInfo mi = manip_info.getCombined(input.problem.manip_info);
+  FixStateCollisionContext context(*input.problem.env, mi.manipulator, profile);
+  int sampling_attempts{ 0 };
+  return applyCorrectionWorkflow(waypoint, manip_info, input, context, profile, 0, contacts, sampling_attempts);
+}
+
+namespace
+{
+/**
+ * @brief Check the move instructions in [begin, end) and correct the ones in collision
+ * @details A collision context is created once per manipulator and shared by every waypoint and thread
+ * @return True if every waypoint is out of collision, otherwise false
+ */
+bool fixWaypointsInCollision(std::vector<std::reference_wrapper<InstructionPoly>>& flattened,
+                             std::size_t begin,
+                             std::size_t end,
+                             const CompositeInstruction& ci,
+                             const TaskComposerInput& input,
+                             const FixStateCollisionProfile& profile,
+                             FixStateCollisionTaskInfo& info)
+{
+  // Create the contexts before checking so they can be shared by the threads
+  std::vector<tesseract_common::ManipulatorInfo> manip_infos(flattened.size());
+  std::vector<const FixStateCollisionContext*> contexts(flattened.size(), nullptr);
+  std::map<std::string, FixStateCollisionContext::UPtr> context_map;
+  for (std::size_t i = begin; i < end; i++)
+  {
+    const auto& plan = flattened[i].get().as<MoveInstructionPoly>();
+    manip_infos[i] = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
+    const std::string manipulator = manip_infos[i].getCombined(input.problem.manip_info).manipulator;
+    auto it = context_map.find(manipulator);
+    if (it == context_map.end())
+      it = context_map
+               .emplace(manipulator,
+                        std::make_unique<FixStateCollisionContext>(*input.problem.env, manipulator, profile))
+               .first;
+
+    contexts[i] = it->second.get();
+  }
+
+  std::vector<int> in_collision_vec(flattened.size(), 0);
+  parallelFor(end - begin, profile.num_threads, [&](std::size_t idx, std::size_t /*worker*/) {
+    const std::size_t i = begin + idx;
+    const auto& plan = flattened[i].get().as<MoveInstructionPoly>();
+    in_collision_vec[i] = static_cast<int>(
+        waypointInCollision(plan.getWaypoint(), *contexts[i], profile, info.contact_results[i]));
+    return true;
+  });
+
+  if (std::none_of(in_collision_vec.begin(), in_collision_vec.end(), [](int v) { return v != 0; }))
+    return true;
+
+  CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
+  return parallelFor(end - begin, profile.num_threads, [&](std::size_t idx, std::size_t /*worker*/) {
+    const std::size_t i = begin + idx;
+    if (in_collision_vec[i] == 0)
+      return true;
+
+    auto& plan = flattened[i].get().as<MoveInstructionPoly>();
+    return applyCorrectionWorkflow(plan.getWaypoint(),
+                                   manip_infos[i],
+                                   input,
+                                   *contexts[i],
+                                   profile,
+                                   i,
+                                   info.contact_results[i],
+                                   info.sampling_attempts[i]);
+  });
+}
+}  // namespace
+
 FixStateCollisionTask::FixStateCollisionTask() : TaskComposerTask("FixStateCollisionTask", true) {}
 FixStateCollisionTask::FixStateCollisionTask(std::string name,
                                              std::string input_key,
@@ -355,7 +505,9 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slot);
   if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input to FixStateCollision must be a composite instruction";
@@ -381,12 +533,21 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
       if (first_mi != nullptr)
       {
         info->contact_results.resize(1);
+        info->sampling_attempts.resize(1, 0);
         tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(first_mi->getManipulatorInfo());
-        if (waypointInCollision(first_mi->getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[0]))
+        FixStateCollisionContext context(
+            *input.problem.env, mi.getCombined(input.problem.manip_info).manipulator, *cur_composite_profile);
+        if (waypointInCollision(first_mi->getWaypoint(), context, *cur_composite_profile, info->contact_results[0]))
         {
           CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
-          if (!applyCorrectionWorkflow(
-                  first_mi->getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[0]))
+          if (!applyCorrectionWorkflow(first_mi->getWaypoint(),
+                                       mi,
+                                       input,
+                                       context,
+                                       *cur_composite_profile,
+                                       0,
+                                       info->contact_results[0],
+                                       info->sampling_attempts[0]))
           {
             info->message = "Failed to correct state in collision";
             info->elapsed_time = timer.elapsedSeconds();
@@ -402,12 +563,21 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
       if (last_mi != nullptr)
       {
         info->contact_results.resize(1);
+        info->sampling_attempts.resize(1, 0);
         tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(last_mi->getManipulatorInfo());
-        if (waypointInCollision(last_mi->getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[0]))
+        FixStateCollisionContext context(
+            *input.problem.env, mi.getCombined(input.problem.manip_info).manipulator, *cur_composite_profile);
+        if (waypointInCollision(last_mi->getWaypoint(), context, *cur_composite_profile, info->contact_results[0]))
         {
           CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
-          if (!applyCorrectionWorkflow(
-                  last_mi->getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[0]))
+          if (!applyCorrectionWorkflow(last_mi->getWaypoint(),
+                                       mi,
+                                       input,
+                                       context,
+                                       *cur_composite_profile,
+                                       static_cast<std::size_t>(ci.getMoveInstructionCount() - 1),
+                                       info->contact_results[0],
+                                       info->sampling_attempts[0]))
           {
             info->message = "Failed to correct state in collision";
             info->elapsed_time = timer.elapsedSeconds();
@@ -421,6 +591,7 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
     {
       auto flattened = ci.flatten(moveFilter);
       info->contact_results.resize(flattened.size());
+      info->sampling_attempts.resize(flattened.size(), 0);
       if (flattened.empty())
       {
         info->message = "FixStateCollisionTask found no MoveInstructions to process";
@@ -437,33 +608,11 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
         return info;
       }
 
-      bool in_collision = false;
-      std::vector<bool> in_collision_vec(flattened.size());
-      for (std::size_t i = 1; i < flattened.size() - 1; i++)
+      if (!fixWaypointsInCollision(flattened, 1, flattened.size() - 1, ci, input, *cur_composite_profile, *info))
       {
-        auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-        tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-        in_collision_vec[i] =
-            waypointInCollision(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]);
-        in_collision |= in_collision_vec[i];
-      }
-      if (!in_collision)
-        break;
-
-      CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
-      for (std::size_t i = 1; i < flattened.size() - 1; i++)
-      {
-        if (in_collision_vec[i])
-        {
-          auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-          tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-          if (!applyCorrectionWorkflow(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]))
-          {
-            info->message = "Failed to correct state in collision";
-            info->elapsed_time = timer.elapsedSeconds();
-            return info;
-          }
-        }
+        info->message = "Failed to correct state in collision";
+        info->elapsed_time = timer.elapsedSeconds();
+        return info;
       }
     }
     break;
@@ -471,6 +620,7 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
     {
       auto flattened = ci.flatten(moveFilter);
       info->contact_results.resize(flattened.size());
+      info->sampling_attempts.resize(flattened.size(), 0);
       if (flattened.empty())
       {
         info->message = "FixStateCollisionTask found no MoveInstructions to process";
@@ -479,33 +629,11 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
         return info;
       }
 
-      bool in_collision = false;
-      std::vector<bool> in_collision_vec(flattened.size());
-      for (std::size_t i = 0; i < flattened.size(); i++)
-      {
-        auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-        tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-        in_collision_vec[i] =
-            waypointInCollision(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]);
-        in_collision |= in_collision_vec[i];
-      }
-      if (!in_collision)
-        break;
-
-      CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
-      for (std::size_t i = 0; i < flattened.size(); i++)
+      if (!fixWaypointsInCollision(flattened, 0, flattened.size(), ci, input, *cur_composite_profile, *info))
       {
-        if (in_collision_vec[i])
-        {
-          auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-          tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-          if (!applyCorrectionWorkflow(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]))
-          {
-            info->message = "Failed to correct state in collision";
-            info->elapsed_time = timer.elapsedSeconds();
-            return info;
-          }
-        }
+        info->message = "Failed to correct state in collision";
+        info->elapsed_time = timer.elapsedSeconds();
+        return info;
       }
     }
     break;
@@ -513,6 +641,7 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
     {
       auto flattened = ci.flatten(moveFilter);
       info->contact_results.resize(flattened.size());
+      info->sampling_attempts.resize(flattened.size(), 0);
       if (flattened.empty())
       {
         info->message = "FixStateCollisionTask found no MoveInstructions to process";
@@ -521,33 +650,11 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
         return info;
       }
 
-      bool in_collision = false;
-      std::vector<bool> in_collision_vec(flattened.size());
-      for (std::size_t i = 1; i < flattened.size(); i++)
-      {
-        auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-        tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-        in_collision_vec[i] =
-            waypointInCollision(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]);
-        in_collision |= in_collision_vec[i];
-      }
-      if (!in_collision)
-        break;
-
-      CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
-      for (std::size_t i = 1; i < flattened.size(); i++)
+      if (!fixWaypointsInCollision(flattened, 1, flattened.size(), ci, input, *cur_composite_profile, *info))
       {
-        if (in_collision_vec[i])
-        {
-          auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-          tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-          if (!applyCorrectionWorkflow(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]))
-          {
-            info->message = "Failed to correct state in collision";
-            info->elapsed_time = timer.elapsedSeconds();
-            return info;
-          }
-        }
+        info->message = "Failed to correct state in collision";
+        info->elapsed_time = timer.elapsedSeconds();
+        return info;
       }
     }
     break;
@@ -555,6 +662,7 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
     {
       auto flattened = ci.flatten(moveFilter);
       info->contact_results.resize(flattened.size());
+      info->sampling_attempts.resize(flattened.size(), 0);
       if (flattened.size() <= 1)
       {
         info->message = "FixStateCollisionTask found no MoveInstructions to process";
@@ -563,33 +671,11 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
         return info;
       }
 
-      bool in_collision = false;
-      std::vector<bool> in_collision_vec(flattened.size());
-      for (std::size_t i = 0; i < flattened.size() - 1; i++)
-      {
-        auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-        tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-        in_collision_vec[i] =
-            waypointInCollision(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]);
-        in_collision |= in_collision_vec[i];
-      }
-      if (!in_collision)
-        break;
-
-      CONSOLE_BRIDGE_logInform("FixStateCollisionTask is modifying the input instructions");
-      for (std::size_t i = 0; i < flattened.size() - 1; i++)
+      if (!fixWaypointsInCollision(flattened, 0, flattened.size() - 1, ci, input, *cur_composite_profile, *info))
       {
-        if (in_collision_vec[i])
-        {
-          auto& plan = flattened[i].get().as<MoveInstructionPoly>();
-          tesseract_common::ManipulatorInfo mi = ci.getManipulatorInfo().getCombined(plan.getManipulatorInfo());
-          if (!applyCorrectionWorkflow(plan.getWaypoint(), mi, input, *cur_composite_profile, info->contact_results[i]))
-          {
-            info->message = "Failed to correct state in collision";
-            info->elapsed_time = timer.elapsedSeconds();
-            return info;
-          }
-        }
+        info->message = "Failed to correct state in collision";
+        info->elapsed_time = timer.elapsedSeconds();
+        return info;
       }
     }
     break;
@@ -600,7 +686,7 @@ TaskComposerNodeInfo::UPtr FixStateCollisionTask::runImpl(TaskComposerInput& inp
       return info;
   }
 
-  input.data_storage.setData(output_keys_[0], input_data_poly);
+  input.data_storage.setData(output_slot, input_data_poly);
   info->message = "Successful";
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
@@ -634,15 +720,18 @@ bool FixStateCollisionTaskInfo::operator==(const FixStateCollisionTaskInfo& rhs)
   bool equal = true;
   equal &= TaskComposerNodeInfo::operator==(rhs);
   //  equal &= contact_results == rhs.contact_results;
+  equal &= sampling_attempts == rhs.sampling_attempts;
   return equal;
 }
 bool FixStateCollisionTaskInfo::operator!=(const FixStateCollisionTaskInfo& rhs) const { return !operator==(rhs); }
 
 template <class Archive>
-void FixStateCollisionTaskInfo::serialize(Archive& ar, const unsigned int /*version*/)
+void FixStateCollisionTaskInfo::serialize(Archive& ar, const unsigned int version)
 {
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerNodeInfo);
   ar& BOOST_SERIALIZATION_NVP(contact_results);
+  if (version > 0)
+    ar& BOOST_SERIALIZATION_NVP(sampling_attempts);
 }
 }  // namespace tesseract_planning
 
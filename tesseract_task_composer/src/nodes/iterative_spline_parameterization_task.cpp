@@ -26,6 +26,7 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <optional>
 #include <console_bridge/console.h>
 #include <boost/serialization/string.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -37,7 +38,10 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_task_composer/profiles/interative_spline_parameterization_profile.h>
 #include <tesseract_command_language/composite_instruction.h>
 #include <tesseract_command_language/poly/move_instruction_poly.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
 #include <tesseract_time_parameterization/core/instructions_trajectory.h>
+#include <tesseract_time_parameterization/core/joint_trajectory_block_trajectory.h>
 
 namespace tesseract_planning
 {
@@ -49,8 +53,12 @@ IterativeSplineParameterizationTask::IterativeSplineParameterizationTask(std::st
                                                                          std::string input_key,
                                                                          std::string output_key,
                                                                          bool is_conditional,
-                                                                         bool add_points)
-  : TaskComposerTask(std::move(name), is_conditional), add_points_(add_points), solver_(add_points)
+                                                                         bool add_points,
+                                                                         bool move_input)
+  : TaskComposerTask(std::move(name), is_conditional)
+  , add_points_(add_points)
+  , move_input_(move_input)
+  , solver_(add_points)
 {
   input_keys_.push_back(std::move(input_key));
   output_keys_.push_back(std::move(output_key));
@@ -80,6 +88,9 @@ IterativeSplineParameterizationTask::IterativeSplineParameterizationTask(
   {
     if (YAML::Node n = config["add_points"])
       add_points_ = n.as<bool>();
+
+    if (YAML::Node n = config["move_input"])
+      move_input_ = n.as<bool>();
   }
   catch (const std::exception& e)
   {
@@ -107,8 +118,11 @@ TaskComposerNodeInfo::UPtr IterativeSplineParameterizationTask::runImpl(TaskComp
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getDataPtr(input_slot);
+  if (input_data_poly == nullptr || input_data_poly->isNull() ||
+      input_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input results to iterative spline parameterization must be a composite instruction";
     info->elapsed_time = timer.elapsedSeconds();
@@ -116,7 +130,7 @@ TaskComposerNodeInfo::UPtr IterativeSplineParameterizationTask::runImpl(TaskComp
     return info;
   }
 
-  auto& ci = input_data_poly.as<CompositeInstruction>();
+  const auto& ci = input_data_poly->as<CompositeInstruction>();
   const tesseract_common::ManipulatorInfo& manip_info = ci.getManipulatorInfo();
   auto joint_group = input.problem.env->getJointGroup(manip_info.manipulator);
   auto limits = joint_group->getLimits();
@@ -129,7 +143,7 @@ TaskComposerNodeInfo::UPtr IterativeSplineParameterizationTask::runImpl(TaskComp
   cur_composite_profile = applyProfileOverrides(name_, profile, cur_composite_profile, ci.getProfileOverrides());
 
   // Create data structures for checking for plan profile overrides
-  auto flattened = ci.flatten(moveFilter);
+  auto flattened = ci.flatten(moveOrJointTrajectoryBlockFilter);
   if (flattened.empty())
   {
     info->message = "Iterative spline time parameterization found no MoveInstructions to process";
@@ -139,16 +153,52 @@ TaskComposerNodeInfo::UPtr IterativeSplineParameterizationTask::runImpl(TaskComp
     return info;
   }
 
-  Eigen::VectorXd velocity_scaling_factors = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(flattened.size())) *
+  // Joint trajectory blocks are parameterized in place, which requires the program to only contain blocks
+  Eigen::Index num_points{ 0 };
+  std::size_t num_blocks{ 0 };
+  for (const auto& instruction : flattened)
+  {
+    if (instruction.get().isJointTrajectoryBlock())
+    {
+      num_points += instruction.get().as<JointTrajectoryBlock>().size();
+      ++num_blocks;
+    }
+    else
+    {
+      ++num_points;
+    }
+  }
+
+  if (num_blocks > 0 && num_blocks != flattened.size())
+  {
+    info->message = "Iterative spline time parameterization does not support mixing MoveInstructions and "
+                    "JointTrajectoryBlocks";
+    info->elapsed_time = timer.elapsedSeconds();
+    CONSOLE_BRIDGE_logError("%s", info->message.c_str());
+    return info;
+  }
+
+  Eigen::VectorXd velocity_scaling_factors = Eigen::VectorXd::Ones(num_points) *
                                              cur_composite_profile->max_velocity_scaling_factor;
-  Eigen::VectorXd acceleration_scaling_factors = Eigen::VectorXd::Ones(static_cast<Eigen::Index>(flattened.size())) *
+  Eigen::VectorXd acceleration_scaling_factors = Eigen::VectorXd::Ones(num_points) *
                                                  cur_composite_profile->max_acceleration_scaling_factor;
 
-  // Loop over all MoveInstructions
-  for (Eigen::Index idx = 0; idx < static_cast<Eigen::Index>(flattened.size()); idx++)
+  // Loop over all MoveInstructions, every point of a joint trajectory block shares its profile
+  Eigen::Index idx{ 0 };
+  for (const auto& instruction : flattened)
   {
-    const auto& mi = flattened[static_cast<std::size_t>(idx)].get().as<MoveInstructionPoly>();
-    std::string move_profile = mi.getProfile();
+    std::string move_profile;
+    Eigen::Index count{ 1 };
+    if (instruction.get().isJointTrajectoryBlock())
+    {
+      const auto& block = instruction.get().as<JointTrajectoryBlock>();
+      move_profile = block.getProfile();
+      count = block.size();
+    }
+    else
+    {
+      move_profile = instruction.get().as<MoveInstructionPoly>().getProfile();
+    }
 
     // Check for remapping of the plan profile
     move_profile = getProfileString(name_, profile, input.problem.move_profile_remapping);
@@ -159,28 +209,71 @@ TaskComposerNodeInfo::UPtr IterativeSplineParameterizationTask::runImpl(TaskComp
     // If there is a move profile associated with it, override the parameters
     if (cur_move_profile)
     {
-      velocity_scaling_factors[idx] = cur_move_profile->max_velocity_scaling_factor;
-      acceleration_scaling_factors[idx] = cur_move_profile->max_acceleration_scaling_factor;
+      velocity_scaling_factors.segment(idx, count).setConstant(cur_move_profile->max_velocity_scaling_factor);
+      acceleration_scaling_factors.segment(idx, count).setConstant(cur_move_profile->max_acceleration_scaling_factor);
     }
+    idx += count;
   }
 
-  // Solve using parameters
-  TrajectoryContainer::Ptr trajectory = std::make_shared<InstructionsTrajectory>(ci);
-  if (!solver_.compute(*trajectory,
-                       limits.velocity_limits,
-                       limits.acceleration_limits,
-                       velocity_scaling_factors,
-                       acceleration_scaling_factors))
+  // When configured to, take ownership of the program if it is replaced by the results, otherwise copy it. Joint
+  // trajectory blocks are parameterized in place so they are always copied.
+  flattened.clear();
+  input_data_poly.reset();
+  const bool extract_input = move_input_ && (num_blocks == 0) && (input_keys_[0] == output_keys_[0]);
+  tesseract_common::AnyPoly results_poly =
+      extract_input ? input.data_storage.extractData(input_slot) : input.data_storage.getData(input_slot);
+  auto& results = results_poly.as<CompositeInstruction>();
+
+  // Move instructions are gathered into contiguous storage so the solver does not access each point through the
+  // instruction and waypoint type erasure, the results are scattered back once it succeeds
+  std::optional<InstructionsTrajectory> instructions_trajectory;
+  ContiguousTrajectory::Ptr contiguous_trajectory;
+  bool solved{ false };
+  try
+  {
+    TrajectoryContainer::Ptr trajectory;
+    if (num_blocks > 0)
+    {
+      trajectory = std::make_shared<JointTrajectoryBlockTrajectory>(results);
+    }
+    else
+    {
+      instructions_trajectory.emplace(results);
+      contiguous_trajectory = std::make_shared<ContiguousTrajectory>(*instructions_trajectory);
+      trajectory = contiguous_trajectory;
+    }
+
+    // Solve using parameters
+    solved = solver_.compute(*trajectory,
+                             limits.velocity_limits,
+                             limits.acceleration_limits,
+                             velocity_scaling_factors,
+                             acceleration_scaling_factors);
+  }
+  catch (...)
+  {
+    // The program is only modified once the solver succeeds, so an extracted program is restored unchanged
+    if (extract_input)
+      input.data_storage.setData(input_slot, std::move(results_poly));
+    throw;
+  }
+
+  if (!solved)
   {
     info->message =
-        "Failed to perform iterative spline time parameterization for process input: " + ci.getDescription();
+        "Failed to perform iterative spline time parameterization for process input: " + results.getDescription();
     info->elapsed_time = timer.elapsedSeconds();
     CONSOLE_BRIDGE_logInform("%s", info->message.c_str());
+    if (extract_input)
+      input.data_storage.setData(input_slot, std::move(results_poly));
     return info;
   }
 
+  if (contiguous_trajectory)
+    contiguous_trajectory->scatter(*instructions_trajectory);
+
   info->message = "Successful";
-  input.data_storage.setData(output_keys_[0], input_data_poly);
+  input.data_storage.setData(output_slot, std::move(results_poly));
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
   CONSOLE_BRIDGE_logDebug("Iterative spline time parameterization succeeded");
@@ -191,6 +284,7 @@ bool IterativeSplineParameterizationTask::operator==(const IterativeSplineParame
 {
   bool equal = true;
   equal &= (add_points_ == rhs.add_points_);
+  equal &= (move_input_ == rhs.move_input_);
   equal &= TaskComposerTask::operator==(rhs);
   return equal;
 }
@@ -200,9 +294,11 @@ bool IterativeSplineParameterizationTask::operator!=(const IterativeSplineParame
 }
 
 template <class Archive>
-void IterativeSplineParameterizationTask::serialize(Archive& ar, const unsigned int /*version*/)
+void IterativeSplineParameterizationTask::serialize(Archive& ar, const unsigned int version)
 {
   ar& BOOST_SERIALIZATION_NVP(add_points_);
+  if (version > 0)
+    ar& BOOST_SERIALIZATION_NVP(move_input_);
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerTask);
 }
 
@@ -87,8 +87,11 @@ TaskComposerNodeInfo::UPtr MinLengthTask::runImpl(TaskComposerInput& input,
   //  saveInputs(*info, input);
 
   // Check that inputs are valid
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getDataPtr(input_slot);
+  if (input_data_poly == nullptr || input_data_poly->isNull() ||
+      input_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input seed to MinLengthTask must be a composite instruction";
     info->elapsed_time = timer.elapsedSeconds();
@@ -97,7 +100,7 @@ TaskComposerNodeInfo::UPtr MinLengthTask::runImpl(TaskComposerInput& input,
   }
 
   // Get Composite Profile
-  const auto& ci = input_data_poly.as<CompositeInstruction>();
+  const auto& ci = input_data_poly->as<CompositeInstruction>();
   long cnt = ci.getMoveInstructionCount();
   std::string profile = ci.getProfile();
   profile = getProfileString(name_, profile, input.problem.composite_profile_remapping);
@@ -144,11 +147,12 @@ TaskComposerNodeInfo::UPtr MinLengthTask::runImpl(TaskComposerInput& input,
       return info;
     }
 
-    input.data_storage.setData(output_keys_[0], response.results);
+    input.data_storage.setData(output_slot, std::move(response.results));
   }
   else
   {
-    input.data_storage.setData(output_keys_[0], ci);
+    // The program is unchanged so share it rather than copying it
+    input.data_storage.setDataPtr(output_slot, input_data_poly);
   }
 
   info->message = "Successful";
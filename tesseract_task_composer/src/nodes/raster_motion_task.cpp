@@ -37,6 +37,7 @@
 #include <tesseract_command_language/composite_instruction.h>
 
 #include <tesseract_common/timer.h>
+#include <tesseract_common/utils.h>
 
 namespace
 {
@@ -83,6 +84,112 @@ createTask(const std::string& name,
 
   return tf_results;
 }
+
+/**
+ * @brief Publishes a segment of the raster program using the input segment callback
+ * @details It is ordered after the node planning the segment and the task publishing the previous segment so the
+ * segments are published in program order. A segment is only published if it was planned successfully and all of the
+ * previous segments were published, so a failure stops publishing the remaining segments.
+ */
+class PublishSegmentTask : public tesseract_planning::TaskComposerTask
+{
+public:
+  PublishSegmentTask(std::string name,
+                     std::string input_key,
+                     std::size_t index,
+                     bool erase_first,
+                     boost::uuids::uuid segment_uuid,
+                     boost::uuids::uuid prev_publish_uuid)
+    : TaskComposerTask(std::move(name), false)
+    , index_(index)
+    , erase_first_(erase_first)
+    , segment_uuid_(segment_uuid)
+    , prev_publish_uuid_(prev_publish_uuid)
+  {
+    input_keys_.push_back(std::move(input_key));
+  }
+
+protected:
+  std::size_t index_;
+  bool erase_first_;
+
+  /** @brief The node planning the segment */
+  boost::uuids::uuid segment_uuid_;
+
+  /** @brief The task publishing the previous segment, nil for the first segment */
+  boost::uuids::uuid prev_publish_uuid_;
+
+  /** @brief Check if a task ran and succeeded, graphs do not store info so they only fail by aborting the input */
+  static bool isSuccessful(const tesseract_planning::TaskComposerInput& input, const boost::uuids::uuid& uuid)
+  {
+    try
+    {
+      return (input.task_infos.getInfo(uuid).return_value != 0);
+    }
+    catch (const std::out_of_range&)
+    {
+      return true;
+    }
+  }
+
+  tesseract_planning::TaskComposerNodeInfo::UPtr
+  runImpl(tesseract_planning::TaskComposerInput& input,
+          tesseract_planning::OptionalTaskComposerExecutor /*executor*/) const override final
+  {
+    auto info = std::make_unique<tesseract_planning::TaskComposerNodeInfo>(*this);
+    info->return_value = 0;
+
+    if (input.isAborted())
+    {
+      info->message = "Aborted";
+      return info;
+    }
+
+    if (!prev_publish_uuid_.is_nil() && !isSuccessful(input, prev_publish_uuid_))
+    {
+      info->message = "Previous segment was not published";
+      return info;
+    }
+
+    if (!isSuccessful(input, segment_uuid_))
+    {
+      info->message = "Segment failed";
+      return info;
+    }
+
+    if (!input.segment_callback)
+    {
+      info->message = "Successful, no segment callback";
+      info->return_value = 1;
+      return info;
+    }
+
+    auto segment_poly = input.data_storage.getDataPtr(input.data_storage.getSlot(input_keys_[0]));
+    if (segment_poly == nullptr || segment_poly->isNull() ||
+        segment_poly->getType() != std::type_index(typeid(tesseract_planning::CompositeInstruction)))
+    {
+      info->message = "Segment is not a composite instruction";
+      CONSOLE_BRIDGE_logError("%s", info->message.c_str());
+      return info;
+    }
+
+    if (erase_first_)
+    {
+      // Remove the start instruction which is the last instruction of the previous segment
+      auto segment = segment_poly->as<tesseract_planning::CompositeInstruction>();
+      segment.erase(segment.begin());
+      input.segment_callback(index_, tesseract_common::AnyPoly(std::move(segment)));
+    }
+    else
+    {
+      input.segment_callback(index_, *segment_poly);
+    }
+
+    info->message = "Successful";
+    info->return_value = 1;
+    return info;
+  }
+};
 }  // namespace
 
 namespace tesseract_planning
@@ -269,10 +376,145 @@ void RasterMotionTask::serialize(Archive& ar, const unsigned int /*version*/)  /
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerTask);
 }
 
+RasterMotionTask::RasterGraph::ConstPtr RasterMotionTask::getRasterGraph(std::size_t raster_count,
+                                                                          bool& cache_hit) const
+{
+  {
+    std::scoped_lock lock(graphs_mutex_);
+    auto it = graphs_.find(raster_count);
+    if (it != graphs_.end())
+    {
+      cache_hit = true;
+      return it->second;
+    }
+  }
+
+  // Build outside the lock so runs with a different number of rasters are not blocked
+  cache_hit = false;
+  RasterGraph::ConstPtr raster_graph = createRasterGraph(raster_count);
+
+  std::scoped_lock lock(graphs_mutex_);
+  if (graphs_.size() >= MAX_CACHED_GRAPHS)
+    graphs_.clear();
+
+  // If another run built the same graph concurrently keep the first so the graph uuid remains stable
+  auto result = graphs_.emplace(raster_count, raster_graph);
+  return result.first->second;
+}
+
+RasterMotionTask::RasterGraph::ConstPtr RasterMotionTask::createRasterGraph(std::size_t raster_count) const
+{
+  auto raster_graph = std::make_shared<RasterGraph>();
+  raster_graph->graph = std::make_unique<TaskComposerGraph>(name_ + " Subgraph");
+  TaskComposerGraph& task_graph = *raster_graph->graph;
+
+  auto start_task = std::make_unique<StartTask>();
+  auto start_uuid = task_graph.addNode(std::move(start_task));
+
+  std::vector<boost::uuids::uuid> raster_uuids;
+  raster_uuids.reserve(raster_count);
+  raster_graph->raster_keys.reserve(raster_count);
+
+  // Generate all of the raster tasks. They don't depend on anything
+  for (std::size_t raster_idx = 0; raster_idx < raster_count; ++raster_idx)
+  {
+    const std::string task_name = "Raster #" + std::to_string(raster_idx + 1);
+    auto raster_results = raster_task_factory_(task_name, raster_idx + 1);
+    auto raster_uuid = task_graph.addNode(std::move(raster_results.node));
+    raster_uuids.push_back(raster_uuid);
+    raster_graph->raster_keys.emplace_back(raster_results.input_key, raster_results.output_key);
+
+    task_graph.addEdges(start_uuid, { raster_uuid });
+  }
+
+  // Loop over all transitions
+  std::vector<boost::uuids::uuid> transition_uuids;
+  transition_uuids.reserve(raster_count);
+  raster_graph->transition_keys.reserve(raster_count);
+  for (std::size_t transition_idx = 0; transition_idx + 1 < raster_count; ++transition_idx)
+  {
+    const std::string task_name = "Transition #" + std::to_string(transition_idx + 1);
+    auto transition_results = transition_task_factory_(task_name, transition_idx + 1);
+    auto transition_uuid = task_graph.addNode(std::move(transition_results.node));
+    transition_uuids.push_back(transition_uuid);
+
+    const auto& prev_output = raster_graph->raster_keys[transition_idx].second;
+    const auto& next_output = raster_graph->raster_keys[transition_idx + 1].second;
+    auto transition_mux_task = std::make_unique<UpdateStartAndEndStateTask>(
+        "UpdateStartAndEndStateTask", prev_output, next_output, transition_results.input_key, false);
+    std::string transition_mux_key = transition_mux_task->getUUIDString();
+    auto transition_mux_uuid = task_graph.addNode(std::move(transition_mux_task));
+    raster_graph->transition_keys.emplace_back(transition_mux_key, transition_results.output_key);
+
+    task_graph.addEdges(transition_mux_uuid, { transition_uuid });
+    task_graph.addEdges(raster_uuids[transition_idx], { transition_mux_uuid });
+    task_graph.addEdges(raster_uuids[transition_idx + 1], { transition_mux_uuid });
+  }
+
+  // Plan from_start - preceded by the first raster
+  auto from_start_results = freespace_task_factory_("From Start", 1);
+  auto from_start_pipeline_uuid = task_graph.addNode(std::move(from_start_results.node));
+
+  const auto& first_raster_output_key = raster_graph->raster_keys.front().second;
+  auto update_end_state_task = std::make_unique<UpdateEndStateTask>(
+      "UpdateEndStateTask", first_raster_output_key, from_start_results.input_key, false);
+  std::string update_end_state_key = update_end_state_task->getUUIDString();
+  auto update_end_state_uuid = task_graph.addNode(std::move(update_end_state_task));
+  raster_graph->from_start_keys = std::make_pair(update_end_state_key, from_start_results.output_key);
+
+  task_graph.addEdges(update_end_state_uuid, { from_start_pipeline_uuid });
+  task_graph.addEdges(raster_uuids.front(), { update_end_state_uuid });
+
+  // Plan to_end - preceded by the last raster
+  auto to_end_results = freespace_task_factory_("To End", 2);
+  auto to_end_pipeline_uuid = task_graph.addNode(std::move(to_end_results.node));
+
+  const auto& last_raster_output_key = raster_graph->raster_keys.back().second;
+  auto update_start_state_task = std::make_unique<UpdateStartStateTask>(
+      "UpdateStartStateTask", last_raster_output_key, to_end_results.input_key, false);
+  std::string update_start_state_key = update_start_state_task->getUUIDString();
+  auto update_start_state_uuid = task_graph.addNode(std::move(update_start_state_task));
+  raster_graph->to_end_keys = std::make_pair(update_start_state_key, to_end_results.output_key);
+
+  task_graph.addEdges(update_start_state_uuid, { to_end_pipeline_uuid });
+  task_graph.addEdges(raster_uuids.back(), { update_start_state_uuid });
+
+  // Publish the segments in program order as they finish, each waits on its planning task and the previous publisher
+  std::vector<std::pair<boost::uuids::uuid, std::string>> segments;
+  segments.reserve((2 * raster_count) + 1);
+  segments.emplace_back(from_start_pipeline_uuid, raster_graph->from_start_keys.second);
+  for (std::size_t i = 0; i < raster_count; ++i)
+  {
+    segments.emplace_back(raster_uuids[i], raster_graph->raster_keys[i].second);
+    if (i < transition_uuids.size())
+      segments.emplace_back(transition_uuids[i], raster_graph->transition_keys[i].second);
+  }
+  segments.emplace_back(to_end_pipeline_uuid, raster_graph->to_end_keys.second);
+
+  boost::uuids::uuid prev_publish_uuid{};
+  for (std::size_t i = 0; i < segments.size(); ++i)
+  {
+    auto publish_task = std::make_unique<PublishSegmentTask>("PublishSegmentTask #" + std::to_string(i + 1),
+                                                             segments[i].second,
+                                                             i,
+                                                             (i != 0),
+                                                             segments[i].first,
+                                                             prev_publish_uuid);
+    auto publish_uuid = task_graph.addNode(std::move(publish_task));
+    task_graph.addEdges(segments[i].first, { publish_uuid });
+    if (i > 0)
+      task_graph.addEdges(prev_publish_uuid, { publish_uuid });
+
+    prev_publish_uuid = publish_uuid;
+  }
+
+  return raster_graph;
+}
+
 TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
                                                      OptionalTaskComposerExecutor executor) const
 {
-  auto info = std::make_unique<TaskComposerNodeInfo>(*this);
+  auto info = std::make_unique<RasterMotionTaskInfo>(*this);
   info->return_value = 0;
   info->env = input.problem.env;
 
@@ -288,7 +530,9 @@ TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slot);
   try
   {
     checkTaskInput(input_data_poly);
@@ -302,18 +546,28 @@ TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
   }
 
   auto& program = input_data_poly.template as<CompositeInstruction>();
-  TaskComposerGraph task_graph;
 
   tesseract_common::ManipulatorInfo program_manip_info =
       program.getManipulatorInfo().getCombined(input.problem.manip_info);
 
-  auto start_task = std::make_unique<StartTask>();
-  auto start_uuid = task_graph.addNode(std::move(start_task));
-
-  std::vector<std::pair<boost::uuids::uuid, std::pair<std::string, std::string>>> raster_tasks;
-  raster_tasks.reserve(program.size());
-
-  // Generate all of the raster tasks. They don't depend on anything
+  std::size_t raster_count = 0;
+  for (std::size_t idx = 1; idx < program.size() - 1; idx += 2)
+    raster_count++;
+
+  tesseract_common::Timer graph_timer;
+  graph_timer.start();
+  RasterGraph::ConstPtr raster_graph = getRasterGraph(raster_count, info->graph_cache_hit);
+
+  // Remove results left by a previous run, so a segment which fails is never published or stitched using stale data.
+  // This is done before assigning the inputs in case a segment uses the same input and output key.
+  input.data_storage.removeData(raster_graph->from_start_keys.second);
+  for (const auto& keys : raster_graph->raster_keys)
+    input.data_storage.removeData(keys.second);
+  for (const auto& keys : raster_graph->transition_keys)
+    input.data_storage.removeData(keys.second);
+  input.data_storage.removeData(raster_graph->to_end_keys.second);
+
+  // Assign the rasters to the graph
   std::size_t raster_idx = 0;
   for (std::size_t idx = 1; idx < program.size() - 1; idx += 2)
   {
@@ -331,20 +585,12 @@ TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
     assert(li != nullptr);
     raster_input.insertMoveInstruction(raster_input.begin(), *li);
 
-    const std::string task_name = "Raster #" + std::to_string(raster_idx + 1) + ": " + raster_input.getDescription();
-    auto raster_results = raster_task_factory_(task_name, raster_idx + 1);
-    auto raster_uuid = task_graph.addNode(std::move(raster_results.node));
-    raster_tasks.emplace_back(raster_uuid, std::make_pair(raster_results.input_key, raster_results.output_key));
-    input.data_storage.setData(raster_results.input_key, raster_input);
-
-    task_graph.addEdges(start_uuid, { raster_uuid });
+    input.data_storage.setData(raster_graph->raster_keys[raster_idx].first, std::move(raster_input));
 
     raster_idx++;
   }
 
-  // Loop over all transitions
-  std::vector<std::pair<std::string, std::string>> transition_keys;
-  transition_keys.reserve(program.size());
+  // Assign the transitions to the graph
   std::size_t transition_idx = 0;
   for (std::size_t idx = 2; idx < program.size() - 2; idx += 2)
   {
@@ -362,51 +608,18 @@ TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
     assert(li != nullptr);
     transition_input.insertMoveInstruction(transition_input.begin(), *li);
 
-    const std::string task_name =
-        "Transition #" + std::to_string(transition_idx + 1) + ": " + transition_input.getDescription();
-    auto transition_results = transition_task_factory_(task_name, transition_idx + 1);
-    auto transition_uuid = task_graph.addNode(std::move(transition_results.node));
-    transition_keys.emplace_back(std::make_pair(transition_results.input_key, transition_results.output_key));
-
-    const auto& prev = raster_tasks[transition_idx];
-    const auto& next = raster_tasks[transition_idx + 1];
-    const auto& prev_output = prev.second.second;
-    const auto& next_output = next.second.second;
-    auto transition_mux_task = std::make_unique<UpdateStartAndEndStateTask>(
-        "UpdateStartAndEndStateTask", prev_output, next_output, transition_results.input_key, false);
-    std::string transition_mux_key = transition_mux_task->getUUIDString();
-    auto transition_mux_uuid = task_graph.addNode(std::move(transition_mux_task));
-
-    input.data_storage.setData(transition_mux_key, transition_input);
-
-    task_graph.addEdges(transition_mux_uuid, { transition_uuid });
-    task_graph.addEdges(prev.first, { transition_mux_uuid });
-    task_graph.addEdges(next.first, { transition_mux_uuid });
+    input.data_storage.setData(raster_graph->transition_keys[transition_idx].first, std::move(transition_input));
 
     transition_idx++;
   }
 
-  // Plan from_start - preceded by the first raster
+  // Assign from_start to the graph
   auto from_start_input = program[0].template as<CompositeInstruction>();
   from_start_input.setManipulatorInfo(from_start_input.getManipulatorInfo().getCombined(program_manip_info));
+  input.data_storage.setData(raster_graph->from_start_keys.first, std::move(from_start_input));
 
-  auto from_start_results = freespace_task_factory_("From Start: " + from_start_input.getDescription(), 1);
-  auto from_start_pipeline_uuid = task_graph.addNode(std::move(from_start_results.node));
-
-  const auto& first_raster_output_key = raster_tasks[0].second.second;
-  auto update_end_state_task = std::make_unique<UpdateEndStateTask>(
-      "UpdateEndStateTask", first_raster_output_key, from_start_results.input_key, false);
-  std::string update_end_state_key = update_end_state_task->getUUIDString();
-  auto update_end_state_uuid = task_graph.addNode(std::move(update_end_state_task));
-
-  input.data_storage.setData(update_end_state_key, from_start_input);
-
-  task_graph.addEdges(update_end_state_uuid, { from_start_pipeline_uuid });
-  task_graph.addEdges(raster_tasks[0].first, { update_end_state_uuid });
-
-  // Plan to_end - preceded by the last raster
+  // Assign to_end to the graph
   auto to_end_input = program.back().template as<CompositeInstruction>();
-
   to_end_input.setManipulatorInfo(to_end_input.getManipulatorInfo().getCombined(program_manip_info));
 
   // Get Start Plan Instruction
@@ -416,22 +629,10 @@ TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
   const auto* li = tci.getLastMoveInstruction();
   assert(li != nullptr);
   to_end_input.insertMoveInstruction(to_end_input.begin(), *li);
+  input.data_storage.setData(raster_graph->to_end_keys.first, std::move(to_end_input));
+  info->graph_build_time = graph_timer.elapsedSeconds();
 
-  auto to_end_results = freespace_task_factory_("To End: " + to_end_input.getDescription(), 2);
-  auto to_end_pipeline_uuid = task_graph.addNode(std::move(to_end_results.node));
-
-  const auto& last_raster_output_key = raster_tasks.back().second.second;
-  auto update_start_state_task = std::make_unique<UpdateStartStateTask>(
-      "UpdateStartStateTask", last_raster_output_key, to_end_results.input_key, false);
-  std::string update_start_state_key = update_start_state_task->getUUIDString();
-  auto update_start_state_uuid = task_graph.addNode(std::move(update_start_state_task));
-
-  input.data_storage.setData(update_start_state_key, to_end_input);
-
-  task_graph.addEdges(update_start_state_uuid, { to_end_pipeline_uuid });
-  task_graph.addEdges(raster_tasks.back().first, { update_start_state_uuid });
-
-  TaskComposerFuture::UPtr future = executor.value().get().run(task_graph, input);
+  TaskComposerFuture::UPtr future = executor.value().get().run(*raster_graph->graph, input);
   future->wait();
 
   if (input.isAborted())
@@ -442,28 +643,44 @@ TaskComposerNodeInfo::UPtr RasterMotionTask::runImpl(TaskComposerInput& input,
     return info;
   }
 
-  program.clear();
-  program.emplace_back(input.data_storage.getData(from_start_results.output_key).as<CompositeInstruction>());
-  for (std::size_t i = 0; i < raster_tasks.size(); ++i)
+  // A segment task may fail without aborting the input, in which case it has no results
+  std::vector<std::string> output_keys;
+  output_keys.reserve((2 * raster_count) + 1);
+  output_keys.push_back(raster_graph->from_start_keys.second);
+  for (std::size_t i = 0; i < raster_graph->raster_keys.size(); ++i)
   {
-    const auto& raster_output_key = raster_tasks[i].second.second;
-    CompositeInstruction segment = input.data_storage.getData(raster_output_key).as<CompositeInstruction>();
-    segment.erase(segment.begin());
-    program.emplace_back(segment);
+    output_keys.push_back(raster_graph->raster_keys[i].second);
+    if (i < raster_graph->transition_keys.size())
+      output_keys.push_back(raster_graph->transition_keys[i].second);
+  }
+  output_keys.push_back(raster_graph->to_end_keys.second);
 
-    if (i < raster_tasks.size() - 1)
+  std::vector<TaskComposerDataStorage::DataPtr> segments;
+  segments.reserve(output_keys.size());
+  for (const auto& output_key : output_keys)
+  {
+    TaskComposerDataStorage::DataPtr segment = input.data_storage.getDataPtr(output_key);
+    if (segment == nullptr || segment->isNull() || segment->getType() != std::type_index(typeid(CompositeInstruction)))
     {
-      const auto& transition_output_key = transition_keys[i].second;
-      CompositeInstruction transition = input.data_storage.getData(transition_output_key).as<CompositeInstruction>();
-      transition.erase(transition.begin());
-      program.emplace_back(transition);
+      info->message = "Raster subgraph failed, missing results for key '" + output_key + "'";
+      info->elapsed_time = timer.elapsedSeconds();
+      CONSOLE_BRIDGE_logError("%s", info->message.c_str());
+      return info;
     }
+    segments.push_back(std::move(segment));
   }
-  CompositeInstruction to_end = input.data_storage.getData(to_end_results.output_key).as<CompositeInstruction>();
-  to_end.erase(to_end.begin());
-  program.emplace_back(to_end);
 
-  input.data_storage.setData(output_keys_[0], program);
+  // The start instruction of every segment after from start is the last instruction of the previous segment
+  program.clear();
+  program.emplace_back(segments.front()->as<CompositeInstruction>());
+  for (std::size_t i = 1; i < segments.size(); ++i)
+  {
+    CompositeInstruction segment = segments[i]->as<CompositeInstruction>();
+    segment.erase(segment.begin());
+    program.emplace_back(std::move(segment));
+  }
+
+  input.data_storage.setData(output_slot, std::move(input_data_poly));
 
   info->message = "Successful";
   info->return_value = 1;
@@ -501,8 +718,32 @@ void RasterMotionTask::checkTaskInput(const tesseract_common::AnyPoly& input)
     throw std::runtime_error("RasterMotionTask, to_end should be a composite");
 }
 
+RasterMotionTaskInfo::RasterMotionTaskInfo(const RasterMotionTask& task) : TaskComposerNodeInfo(task) {}
+
+TaskComposerNodeInfo::UPtr RasterMotionTaskInfo::clone() const { return std::make_unique<RasterMotionTaskInfo>(*this); }
+
+bool RasterMotionTaskInfo::operator==(const RasterMotionTaskInfo& rhs) const
+{
+  bool equal = true;
+  equal &= TaskComposerNodeInfo::operator==(rhs);
+  equal &= tesseract_common::almostEqualRelativeAndAbs(graph_build_time, rhs.graph_build_time);
+  equal &= (graph_cache_hit == rhs.graph_cache_hit);
+  return equal;
+}
+bool RasterMotionTaskInfo::operator!=(const RasterMotionTaskInfo& rhs) const { return !operator==(rhs); }
+
+template <class Archive>
+void RasterMotionTaskInfo::serialize(Archive& ar, const unsigned int /*version*/)
+{
+  ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerNodeInfo);
+  ar& BOOST_SERIALIZATION_NVP(graph_build_time);
+  ar& BOOST_SERIALIZATION_NVP(graph_cache_hit);
+}
+
 }  // namespace tesseract_planning
 
 #include <tesseract_common/serialization.h>
 TESSERACT_SERIALIZE_ARCHIVES_INSTANTIATE(tesseract_planning::RasterMotionTask)
 BOOST_CLASS_EXPORT_IMPLEMENT(tesseract_planning::RasterMotionTask)
+TESSERACT_SERIALIZE_ARCHIVES_INSTANTIATE(tesseract_planning::RasterMotionTaskInfo)
+BOOST_CLASS_EXPORT_IMPLEMENT(tesseract_planning::RasterMotionTaskInfo)
@@ -241,7 +241,9 @@ TaskComposerNodeInfo::UPtr RasterOnlyMotionTask::runImpl(TaskComposerInput& inpu
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slot);
   try
   {
     checkTaskInput(input_data_poly);
@@ -376,7 +378,7 @@ TaskComposerNodeInfo::UPtr RasterOnlyMotionTask::runImpl(TaskComposerInput& inpu
     }
   }
 
-  input.data_storage.setData(output_keys_[0], program);
+  input.data_storage.setData(output_slot, program);
 
   info->message = "Successful";
   info->return_value = 1;
@@ -27,6 +27,8 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <optional>
 #include <console_bridge/console.h>
 #include <boost/serialization/string.hpp>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
@@ -38,8 +40,11 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_command_language/composite_instruction.h>
 #include <tesseract_command_language/poly/move_instruction_poly.h>
 #include <tesseract_command_language/utils.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
 #include <tesseract_time_parameterization/totg/time_optimal_trajectory_generation.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
 #include <tesseract_time_parameterization/core/instructions_trajectory.h>
+#include <tesseract_time_parameterization/core/joint_trajectory_block_trajectory.h>
 #include <tesseract_time_parameterization/core/utils.h>
 
 namespace tesseract_planning
@@ -51,8 +56,9 @@ TimeOptimalParameterizationTask::TimeOptimalParameterizationTask()
 TimeOptimalParameterizationTask::TimeOptimalParameterizationTask(std::string name,
                                                                  std::string input_key,
                                                                  std::string output_key,
-                                                                 bool is_conditional)
-  : TaskComposerTask(std::move(name), is_conditional)
+                                                                 bool is_conditional,
+                                                                 bool move_input)
+  : TaskComposerTask(std::move(name), is_conditional), move_input_(move_input)
 {
   input_keys_.push_back(std::move(input_key));
   output_keys_.push_back(std::move(output_key));
@@ -76,6 +82,17 @@ TimeOptimalParameterizationTask::TimeOptimalParameterizationTask(std::string nam
   if (output_keys_.size() > 1)
     throw std::runtime_error("TimeOptimalParameterizationTask, config 'outputs' entry currently only supports one "
                              "output key");
+
+  try
+  {
+    if (YAML::Node n = config["move_input"])
+      move_input_ = n.as<bool>();
+  }
+  catch (const std::exception& e)
+  {
+    throw std::runtime_error("TimeOptimalParameterizationTask: Failed to parse yaml config data! Details: " +
+                             std::string(e.what()));
+  }
 }
 
 TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposerInput& input,
@@ -97,8 +114,11 @@ TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposer
   // --------------------
   // Check that inputs are valid
   // --------------------
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getDataPtr(input_slot);
+  if (input_data_poly == nullptr || input_data_poly->isNull() ||
+      input_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input results to TOTG must be a composite instruction";
     info->elapsed_time = timer.elapsedSeconds();
@@ -106,7 +126,7 @@ TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposer
     return info;
   }
 
-  auto& ci = input_data_poly.as<CompositeInstruction>();
+  const auto& ci = input_data_poly->as<CompositeInstruction>();
   const tesseract_common::ManipulatorInfo& manip_info = ci.getManipulatorInfo();
   auto joint_group = input.problem.env->getJointGroup(manip_info.manipulator);
   auto limits = joint_group->getLimits();
@@ -119,7 +139,7 @@ TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposer
   cur_composite_profile = applyProfileOverrides(name_, profile, cur_composite_profile, ci.getProfileOverrides());
 
   // Create data structures for checking for plan profile overrides
-  auto flattened = ci.flatten(moveFilter);
+  auto flattened = ci.flatten(moveOrJointTrajectoryBlockFilter);
   if (flattened.empty())
   {
     info->message = "TOTG found no MoveInstructions to process";
@@ -129,6 +149,19 @@ TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposer
     return info;
   }
 
+  // Joint trajectory blocks are parameterized in place, which requires the program to only contain blocks
+  auto num_blocks = static_cast<std::size_t>(std::count_if(flattened.begin(), flattened.end(), [](const auto& i) {
+    return i.get().isJointTrajectoryBlock();
+  }));
+
+  if (num_blocks > 0 && num_blocks != flattened.size())
+  {
+    info->message = "TOTG does not support mixing MoveInstructions and JointTrajectoryBlocks";
+    info->elapsed_time = timer.elapsedSeconds();
+    CONSOLE_BRIDGE_logError("%s", info->message.c_str());
+    return info;
+  }
+
   // Solve using parameters
   TimeOptimalTrajectoryGeneration solver(cur_composite_profile->path_tolerance,
                                          cur_composite_profile->resample_dt,
@@ -138,22 +171,63 @@ TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposer
   info->max_velocity_scaling_factor = cur_composite_profile->max_velocity_scaling_factor;
   info->max_acceleration_scaling_factor = cur_composite_profile->max_acceleration_scaling_factor;
 
-  // Copy the Composite before passing in because it will get flattened and resampled
-  CompositeInstruction copy_ci(ci);
-  InstructionsTrajectory traj_wrapper(copy_ci);
-  if (!solver.computeTimeStamps(traj_wrapper,
-                                limits.velocity_limits,
-                                limits.acceleration_limits,
-                                cur_composite_profile->max_velocity_scaling_factor,
-                                cur_composite_profile->max_acceleration_scaling_factor))
+  // When configured to, take ownership of the program if it is replaced by the results, otherwise copy it. Joint
+  // trajectory blocks are parameterized in place so they are always copied.
+  flattened.clear();
+  input_data_poly.reset();
+  const bool extract_input = move_input_ && (num_blocks == 0) && (input_keys_[0] == output_keys_[0]);
+  tesseract_common::AnyPoly results_poly =
+      extract_input ? input.data_storage.extractData(input_slot) : input.data_storage.getData(input_slot);
+  auto& results = results_poly.as<CompositeInstruction>();
+
+  // Move instructions are gathered into contiguous storage so the solver does not access each point through the
+  // instruction and waypoint type erasure, the results are scattered back once it succeeds
+  std::optional<InstructionsTrajectory> instructions_trajectory;
+  ContiguousTrajectory::Ptr contiguous_trajectory;
+  bool solved{ false };
+  try
+  {
+    TrajectoryContainer::Ptr traj_wrapper;
+    if (num_blocks > 0)
+    {
+      traj_wrapper = std::make_shared<JointTrajectoryBlockTrajectory>(results);
+    }
+    else
+    {
+      instructions_trajectory.emplace(results);
+      contiguous_trajectory = std::make_shared<ContiguousTrajectory>(*instructions_trajectory);
+      traj_wrapper = contiguous_trajectory;
+    }
+
+    // Solve using parameters
+    solved = solver.computeTimeStamps(*traj_wrapper,
+                                      limits.velocity_limits,
+                                      limits.acceleration_limits,
+                                      cur_composite_profile->max_velocity_scaling_factor,
+                                      cur_composite_profile->max_acceleration_scaling_factor);
+  }
+  catch (...)
   {
-    info->message = "Failed to perform TOTG for process input: " + ci.getDescription();
+    // The program is only modified once the solver succeeds, so an extracted program is restored unchanged
+    if (extract_input)
+      input.data_storage.setData(input_slot, std::move(results_poly));
+    throw;
+  }
+
+  if (!solved)
+  {
+    info->message = "Failed to perform TOTG for process input: " + results.getDescription();
     info->elapsed_time = timer.elapsedSeconds();
     CONSOLE_BRIDGE_logInform("%s", info->message.c_str());
+    if (extract_input)
+      input.data_storage.setData(input_slot, std::move(results_poly));
     return info;
   }
 
-  input.data_storage.setData(output_keys_[0], copy_ci);
+  if (contiguous_trajectory)
+    contiguous_trajectory->scatter(*instructions_trajectory);
+
+  input.data_storage.setData(output_slot, std::move(results_poly));
   info->message = "Successful";
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
@@ -164,6 +238,7 @@ TaskComposerNodeInfo::UPtr TimeOptimalParameterizationTask::runImpl(TaskComposer
 bool TimeOptimalParameterizationTask::operator==(const TimeOptimalParameterizationTask& rhs) const
 {
   bool equal = true;
+  equal &= (move_input_ == rhs.move_input_);
   equal &= TaskComposerTask::operator==(rhs);
   return equal;
 }
@@ -173,8 +248,10 @@ bool TimeOptimalParameterizationTask::operator!=(const TimeOptimalParameterizati
 }
 
 template <class Archive>
-void TimeOptimalParameterizationTask::serialize(Archive& ar, const unsigned int /*version*/)
+void TimeOptimalParameterizationTask::serialize(Archive& ar, const unsigned int version)
 {
+  if (version > 0)
+    ar& BOOST_SERIALIZATION_NVP(move_input_);
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerTask);
 }
 
@@ -74,8 +74,10 @@ TaskComposerNodeInfo::UPtr UpdateEndStateTask::runImpl(TaskComposerInput& input,
   tesseract_common::Timer timer;
   timer.start();
 
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  auto input_next_data_poly = input.data_storage.getData(input_keys_[1]);
+  const std::vector<std::size_t> input_slots = input.data_storage.getSlots(input_keys_);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slots[0]);
+  auto input_next_data_poly = input.data_storage.getDataPtr(input_slots[1]);
 
   // --------------------
   // Check that inputs are valid
@@ -88,7 +90,8 @@ TaskComposerNodeInfo::UPtr UpdateEndStateTask::runImpl(TaskComposerInput& input,
     return info;
   }
 
-  if (input_next_data_poly.isNull() || input_next_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  if (input_next_data_poly == nullptr || input_next_data_poly->isNull() ||
+      input_next_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "UpdateEndStateTask: Input data for key '" + input_keys_[1] + "' must be a composite instruction";
     info->elapsed_time = timer.elapsedSeconds();
@@ -102,7 +105,7 @@ TaskComposerNodeInfo::UPtr UpdateEndStateTask::runImpl(TaskComposerInput& input,
   /** @todo Should the waypoint profile be updated to the path profile if it exists? **/
 
   // Update end instruction
-  const auto* next_start_move = input_next_data_poly.as<CompositeInstruction>().getFirstMoveInstruction();
+  const auto* next_start_move = input_next_data_poly->as<CompositeInstruction>().getFirstMoveInstruction();
   if (next_start_move->getWaypoint().isCartesianWaypoint())
     last_move_instruction->assignCartesianWaypoint(next_start_move->getWaypoint().as<CartesianWaypointPoly>());
   else if (next_start_move->getWaypoint().isJointWaypoint())
@@ -113,7 +116,7 @@ TaskComposerNodeInfo::UPtr UpdateEndStateTask::runImpl(TaskComposerInput& input,
     throw std::runtime_error("Invalid waypoint type");
 
   // Store results
-  input.data_storage.setData(output_keys_[0], input_data_poly);
+  input.data_storage.setData(output_slot, input_data_poly);
   info->message = "Successful";
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
@@ -78,9 +78,11 @@ TaskComposerNodeInfo::UPtr UpdateStartAndEndStateTask::runImpl(TaskComposerInput
   tesseract_common::Timer timer;
   timer.start();
 
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  auto input_prev_data_poly = input.data_storage.getData(input_keys_[1]);
-  auto input_next_data_poly = input.data_storage.getData(input_keys_[2]);
+  const std::vector<std::size_t> input_slots = input.data_storage.getSlots(input_keys_);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slots[0]);
+  auto input_prev_data_poly = input.data_storage.getDataPtr(input_slots[1]);
+  auto input_next_data_poly = input.data_storage.getDataPtr(input_slots[2]);
 
   // --------------------
   // Check that inputs are valid
@@ -94,7 +96,8 @@ TaskComposerNodeInfo::UPtr UpdateStartAndEndStateTask::runImpl(TaskComposerInput
     return info;
   }
 
-  if (input_prev_data_poly.isNull() || input_prev_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  if (input_prev_data_poly == nullptr || input_prev_data_poly->isNull() ||
+      input_prev_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message =
         "UpdateStartAndEndStateTask: Input data for key '" + input_keys_[1] + "' must be a composite instruction";
@@ -103,7 +106,8 @@ TaskComposerNodeInfo::UPtr UpdateStartAndEndStateTask::runImpl(TaskComposerInput
     return info;
   }
 
-  if (input_next_data_poly.isNull() || input_next_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  if (input_next_data_poly == nullptr || input_next_data_poly->isNull() ||
+      input_next_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message =
         "UpdateStartAndEndStateTask: Input data for key '" + input_keys_[2] + "' must be a composite instruction";
@@ -114,8 +118,8 @@ TaskComposerNodeInfo::UPtr UpdateStartAndEndStateTask::runImpl(TaskComposerInput
 
   // Make a non-const copy of the input instructions to update the start/end
   auto& instructions = input_data_poly.as<CompositeInstruction>();
-  const auto* prev_last_move = input_prev_data_poly.as<CompositeInstruction>().getLastMoveInstruction();
-  const auto* next_start_move = input_next_data_poly.as<CompositeInstruction>().getFirstMoveInstruction();
+  const auto* prev_last_move = input_prev_data_poly->as<CompositeInstruction>().getLastMoveInstruction();
+  const auto* next_start_move = input_next_data_poly->as<CompositeInstruction>().getFirstMoveInstruction();
 
   // Update start instruction
   instructions.at(0) = (*prev_last_move);
@@ -132,7 +136,7 @@ TaskComposerNodeInfo::UPtr UpdateStartAndEndStateTask::runImpl(TaskComposerInput
     throw std::runtime_error("Invalid waypoint type");
 
   // Store results
-  input.data_storage.setData(output_keys_[0], input_data_poly);
+  input.data_storage.setData(output_slot, input_data_poly);
   info->message = "Successful";
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
@@ -74,8 +74,10 @@ TaskComposerNodeInfo::UPtr UpdateStartStateTask::runImpl(TaskComposerInput& inpu
   tesseract_common::Timer timer;
   timer.start();
 
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  auto input_prev_data_poly = input.data_storage.getData(input_keys_[1]);
+  const std::vector<std::size_t> input_slots = input.data_storage.getSlots(input_keys_);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getData(input_slots[0]);
+  auto input_prev_data_poly = input.data_storage.getDataPtr(input_slots[1]);
 
   // --------------------
   // Check that inputs are valid
@@ -88,7 +90,8 @@ TaskComposerNodeInfo::UPtr UpdateStartStateTask::runImpl(TaskComposerInput& inpu
     return info;
   }
 
-  if (input_prev_data_poly.isNull() || input_prev_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  if (input_prev_data_poly == nullptr || input_prev_data_poly->isNull() ||
+      input_prev_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "UpdateStartStateTask: Input data for key '" + input_keys_[1] + "' must be a composite instruction";
     info->elapsed_time = timer.elapsedSeconds();
@@ -98,13 +101,13 @@ TaskComposerNodeInfo::UPtr UpdateStartStateTask::runImpl(TaskComposerInput& inpu
 
   // Make a non-const copy of the input instructions to update the start/end
   auto& instructions = input_data_poly.as<CompositeInstruction>();
-  const auto* prev_last_move = input_prev_data_poly.as<CompositeInstruction>().getLastMoveInstruction();
+  const auto* prev_last_move = input_prev_data_poly->as<CompositeInstruction>().getLastMoveInstruction();
 
   // Update start instruction
   instructions.at(0) = (*prev_last_move);
 
   // Store results
-  input.data_storage.setData(output_keys_[0], input_data_poly);
+  input.data_storage.setData(output_slot, input_data_poly);
   info->message = "Successful";
   info->return_value = 1;
   info->elapsed_time = timer.elapsedSeconds();
@@ -38,8 +38,92 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_motion_planners/core/interpolation.h>
 #include <tesseract_motion_planners/planner_utils.h>
 
+#include <tesseract_command_language/joint_trajectory_block.h>
+
 namespace tesseract_planning
 {
+namespace
+{
+/**
+ * @brief Upsample a joint trajectory block so the distance between consecutive points is less than the longest valid
+ * segment length
+ * @details Like move instructions, each interpolated point is a copy of the point it ends at with the position
+ * replaced, so the block is resized once and filled column by column.
+ * @param block The block to upsample
+ * @param start_instruction The move instruction preceding the block, null if the block starts the trajectory
+ * @param longest_valid_segment_length The longest valid segment length
+ * @return The upsampled block
+ */
+JointTrajectoryBlock upsampleBlock(const JointTrajectoryBlock& block,
+                                   const InstructionPoly& start_instruction,
+                                   double longest_valid_segment_length)
+{
+  const Eigen::MatrixXd& position = block.getPosition();
+  auto getPrevious = [&](Eigen::Index i) -> Eigen::Ref<const Eigen::VectorXd> {
+    if (i > 0)
+      return position.col(i - 1);
+
+    const auto& mi = start_instruction.as<MoveInstructionPoly>();
+    assert(mi.getWaypoint().isStateWaypoint());
+    return mi.getWaypoint().as<StateWaypointPoly>().getPosition();
+  };
+
+  // The number of points each point of the block is replaced with
+  std::vector<long> counts(static_cast<std::size_t>(block.size()), 1);
+  Eigen::Index new_size{ 0 };
+  for (Eigen::Index i = 0; i < block.size(); ++i)
+  {
+    if (i > 0 || !start_instruction.isNull())
+    {
+      double dist = (position.col(i) - getPrevious(i)).norm();
+      if (dist > longest_valid_segment_length)
+        counts[static_cast<std::size_t>(i)] = static_cast<long>(std::ceil(dist / longest_valid_segment_length)) + 1;
+    }
+    new_size += counts[static_cast<std::size_t>(i)];
+  }
+
+  if (new_size == block.size())
+    return block;
+
+  JointTrajectoryBlock upsampled(block);
+  upsampled.resize(new_size);
+
+  auto copyColumn = [](Eigen::MatrixXd& to, const Eigen::MatrixXd& from, Eigen::Index to_col, Eigen::Index from_col) {
+    if (from.size() != 0)
+      to.col(to_col) = from.col(from_col);
+  };
+
+  Eigen::Index col{ 0 };
+  for (Eigen::Index i = 0; i < block.size(); ++i)
+  {
+    const long cnt = counts[static_cast<std::size_t>(i)];
+    Eigen::MatrixXd states;
+    if (cnt > 1)
+      states = interpolate(getPrevious(i), position.col(i), cnt);
+
+    // Since the start is the previous point it is excluded
+    for (long j = 1; j <= cnt; ++j, ++col)
+    {
+      if (cnt > 1)
+        upsampled.getPosition().col(col) = states.col(j);
+      else
+        upsampled.getPosition().col(col) = position.col(i);
+
+      copyColumn(upsampled.getVelocity(), block.getVelocity(), col, i);
+      copyColumn(upsampled.getAcceleration(), block.getAcceleration(), col, i);
+      copyColumn(upsampled.getEffort(), block.getEffort(), col, i);
+      upsampled.getTime()(col) = block.getTime()(i);
+      upsampled.getPointUUIDs()[static_cast<std::size_t>(col)] = block.getPointUUIDs()[static_cast<std::size_t>(i)];
+      upsampled.getPointParentUUIDs()[static_cast<std::size_t>(col)] =
+          block.getPointParentUUIDs()[static_cast<std::size_t>(i)];
+      upsampled.setMoveType(col, block.getMoveType(i));
+    }
+  }
+
+  return upsampled;
+}
+}  // namespace
+
 UpsampleTrajectoryTask::UpsampleTrajectoryTask() : TaskComposerTask("UpsampleTrajectoryTask", false) {}
 UpsampleTrajectoryTask::UpsampleTrajectoryTask(std::string name,
                                                std::string input_key,
@@ -87,8 +171,11 @@ TaskComposerNodeInfo::UPtr UpsampleTrajectoryTask::runImpl(TaskComposerInput& in
   timer.start();
 
   // Check that inputs are valid
-  auto input_data_poly = input.data_storage.getData(input_keys_[0]);
-  if (input_data_poly.isNull() || input_data_poly.getType() != std::type_index(typeid(CompositeInstruction)))
+  const std::size_t input_slot = input.data_storage.getSlot(input_keys_[0]);
+  const std::size_t output_slot = input.data_storage.getSlot(output_keys_[0]);
+  auto input_data_poly = input.data_storage.getDataPtr(input_slot);
+  if (input_data_poly == nullptr || input_data_poly->isNull() ||
+      input_data_poly->getType() != std::type_index(typeid(CompositeInstruction)))
   {
     info->message = "Input seed to UpsampleTrajectoryTask must be a composite instruction";
     info->elapsed_time = timer.elapsedSeconds();
@@ -97,7 +184,7 @@ TaskComposerNodeInfo::UPtr UpsampleTrajectoryTask::runImpl(TaskComposerInput& in
   }
 
   // Get Composite Profile
-  const auto& ci = input_data_poly.as<CompositeInstruction>();
+  const auto& ci = input_data_poly->as<CompositeInstruction>();
   std::string profile = ci.getProfile();
   profile = getProfileString(name_, profile, input.problem.composite_profile_remapping);
   auto cur_composite_profile = getProfile<UpsampleTrajectoryProfile>(
@@ -110,7 +197,7 @@ TaskComposerNodeInfo::UPtr UpsampleTrajectoryTask::runImpl(TaskComposerInput& in
   new_results.clear();
 
   upsample(new_results, ci, start_instruction, cur_composite_profile->longest_valid_segment_length);
-  input.data_storage.setData(output_keys_[0], new_results);
+  input.data_storage.setData(output_slot, std::move(new_results));
 
   info->message = "Successful";
   info->return_value = 1;
@@ -176,6 +263,19 @@ void UpsampleTrajectoryTask::upsample(CompositeInstruction& composite,
 
       start_instruction = i;
     }
+    else if (i.isJointTrajectoryBlock())
+    {
+      const auto& block = i.as<JointTrajectoryBlock>();
+      if (block.empty())
+      {
+        composite.push_back(i);
+        continue;
+      }
+
+      assert(start_instruction.isNull() || start_instruction.isMoveInstruction());
+      composite.push_back(upsampleBlock(block, start_instruction, longest_valid_segment_length));
+      start_instruction = block.getMoveInstruction(block.size() - 1);
+    }
     else
     {
       assert(!i.isMoveInstruction());
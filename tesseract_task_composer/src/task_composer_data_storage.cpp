@@ -31,92 +31,351 @@ TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <boost/serialization/library_version_type.hpp>
 #endif
 #include <boost/serialization/unordered_map.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <mutex>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_task_composer/task_composer_data_storage.h>
 namespace tesseract_planning
 {
-TaskComposerDataStorage::TaskComposerDataStorage(const TaskComposerDataStorage& other) { *this = other; }
+TaskComposerDataStorage::TaskComposerDataStorage(const TaskComposerDataStorage& other)
+{
+  std::shared_lock lock(other.mutex_);
+  copyHelper(other);
+}
 TaskComposerDataStorage& TaskComposerDataStorage::operator=(const TaskComposerDataStorage& other)
 {
-  std::shared_lock lhs_lock(mutex_, std::defer_lock);
+  if (this == &other)
+    return *this;
+
+  std::unique_lock lhs_lock(mutex_, std::defer_lock);
   std::shared_lock rhs_lock(other.mutex_, std::defer_lock);
   std::scoped_lock lock{ lhs_lock, rhs_lock };
 
-  data_ = other.data_;
+  clearHelper();
+  copyHelper(other);
   return *this;
 }
 TaskComposerDataStorage::TaskComposerDataStorage(TaskComposerDataStorage&& other) noexcept
 {
-  std::shared_lock lhs_lock(mutex_, std::defer_lock);
-  std::shared_lock rhs_lock(other.mutex_, std::defer_lock);
-  std::scoped_lock lock{ lhs_lock, rhs_lock };
+  std::unique_lock lock(other.mutex_);
+
+  slots_ = std::move(other.slots_);
+  keys_ = std::move(other.keys_);
+  directory_storage_ = std::move(other.directory_storage_);
+  chunk_storage_ = std::move(other.chunk_storage_);
+  directory_ = other.directory_.exchange(nullptr);
 
-  data_ = std::move(other.data_);
+  other.slots_.clear();
+  other.keys_.clear();
+  other.directory_storage_.clear();
+  other.chunk_storage_.clear();
 }
 TaskComposerDataStorage& TaskComposerDataStorage::operator=(TaskComposerDataStorage&& other) noexcept
 {
-  std::shared_lock lhs_lock(mutex_, std::defer_lock);
-  std::shared_lock rhs_lock(other.mutex_, std::defer_lock);
+  if (this == &other)
+    return *this;
+
+  std::unique_lock lhs_lock(mutex_, std::defer_lock);
+  std::unique_lock rhs_lock(other.mutex_, std::defer_lock);
   std::scoped_lock lock{ lhs_lock, rhs_lock };
 
-  data_ = std::move(other.data_);
+  // Swap so chunks currently referenced by readers of either storage are not released
+  std::swap(slots_, other.slots_);
+  std::swap(keys_, other.keys_);
+  std::swap(directory_storage_, other.directory_storage_);
+  std::swap(chunk_storage_, other.chunk_storage_);
+  directory_ = other.directory_.exchange(directory_.load());
+
+  other.clearHelper();
   return *this;
 }
 
 bool TaskComposerDataStorage::hasKey(const std::string& key)
 {
   std::shared_lock lock(mutex_);
-  return (data_.find(key) != data_.end());
+  auto it = slots_.find(key);
+  if (it == slots_.end())
+    return false;
+
+  return hasData(it->second);
 }
 
 void TaskComposerDataStorage::setData(const std::string& key, tesseract_common::AnyPoly data)
 {
-  std::unique_lock lock(mutex_);
-  data_[key] = std::move(data);
+  setData(getSlot(key), std::move(data));
 }
 
 tesseract_common::AnyPoly TaskComposerDataStorage::getData(const std::string& key) const
+{
+  DataPtr data = getDataPtr(key);
+  if (data == nullptr)
+    return {};
+
+  return *data;
+}
+
+TaskComposerDataStorage::DataPtr TaskComposerDataStorage::getDataPtr(const std::string& key) const
 {
   std::shared_lock lock(mutex_);
-  auto it = data_.find(key);
-  if (it == data_.end())
+  auto it = slots_.find(key);
+  if (it == slots_.end())
+    return nullptr;
+
+  return getDataPtr(it->second);
+}
+
+void TaskComposerDataStorage::setDataPtr(const std::string& key, DataPtr data)
+{
+  setDataPtr(getSlot(key), std::move(data));
+}
+
+tesseract_common::AnyPoly TaskComposerDataStorage::extractData(const std::string& key)
+{
+  std::shared_lock lock(mutex_);
+  auto it = slots_.find(key);
+  if (it == slots_.end())
     return {};
 
-  return it->second;
+  return extractData(it->second);
 }
 
 void TaskComposerDataStorage::removeData(const std::string& key)
 {
-  std::unique_lock lock(mutex_);
-  data_.erase(key);
+  std::shared_lock lock(mutex_);
+  auto it = slots_.find(key);
+  if (it != slots_.end())
+    removeData(it->second);
 }
 
 std::unordered_map<std::string, tesseract_common::AnyPoly> TaskComposerDataStorage::getData() const
 {
   std::shared_lock lock(mutex_);
-  return data_;
+  std::unordered_map<std::string, tesseract_common::AnyPoly> data;
+  for (std::size_t slot = 0; slot < keys_.size(); ++slot)
+  {
+    DataPtr slot_data = getDataPtr(slot);
+    if (slot_data != nullptr)
+      data[keys_[slot]] = *slot_data;
+  }
+  return data;
 }
 
-bool TaskComposerDataStorage::operator==(const TaskComposerDataStorage& rhs) const
+std::size_t TaskComposerDataStorage::getSlot(const std::string& key)
 {
-  std::shared_lock lhs_lock(mutex_, std::defer_lock);
-  std::shared_lock rhs_lock(rhs.mutex_, std::defer_lock);
-  std::scoped_lock lock{ lhs_lock, rhs_lock };
+  {
+    std::shared_lock lock(mutex_);
+    auto it = slots_.find(key);
+    if (it != slots_.end())
+      return it->second;
+  }
+
+  std::unique_lock lock(mutex_);
+  return getSlotHelper(key);
+}
+
+std::vector<std::size_t> TaskComposerDataStorage::getSlots(const std::vector<std::string>& keys)
+{
+  std::vector<std::size_t> slots;
+  slots.reserve(keys.size());
+
+  {
+    // Usually every key already has a slot so try without the unique lock first
+    std::shared_lock lock(mutex_);
+    for (const auto& key : keys)
+    {
+      auto it = slots_.find(key);
+      if (it == slots_.end())
+        break;
+
+      slots.push_back(it->second);
+    }
+  }
+
+  if (slots.size() == keys.size())
+    return slots;
+
+  std::unique_lock lock(mutex_);
+  for (std::size_t i = slots.size(); i < keys.size(); ++i)
+    slots.push_back(getSlotHelper(keys[i]));
+
+  return slots;
+}
 
-  bool equal = true;
-  equal &= data_ == rhs.data_;
-  return equal;
+bool TaskComposerDataStorage::hasData(std::size_t slot) const { return (getDataPtr(slot) != nullptr); }
+
+void TaskComposerDataStorage::setData(std::size_t slot, tesseract_common::AnyPoly data)
+{
+  DataPtr* slot_data = getSlotData(slot);
+  if (slot_data == nullptr)
+    throw std::runtime_error("TaskComposerDataStorage, slot " + std::to_string(slot) + " has not been assigned");
+
+  std::atomic_store(slot_data, DataPtr(std::make_shared<tesseract_common::AnyPoly>(std::move(data))));
+}
+
+tesseract_common::AnyPoly TaskComposerDataStorage::getData(std::size_t slot) const
+{
+  DataPtr data = getDataPtr(slot);
+  if (data == nullptr)
+    return {};
+
+  return *data;
+}
+
+TaskComposerDataStorage::DataPtr TaskComposerDataStorage::getDataPtr(std::size_t slot) const
+{
+  DataPtr* slot_data = getSlotData(slot);
+  if (slot_data == nullptr)
+    return nullptr;
+
+  return std::atomic_load(slot_data);
+}
+
+void TaskComposerDataStorage::setDataPtr(std::size_t slot, DataPtr data)
+{
+  DataPtr* slot_data = getSlotData(slot);
+  if (slot_data == nullptr)
+    throw std::runtime_error("TaskComposerDataStorage, slot " + std::to_string(slot) + " has not been assigned");
+
+  std::atomic_store(slot_data, std::move(data));
+}
+
+tesseract_common::AnyPoly TaskComposerDataStorage::extractData(std::size_t slot)
+{
+  DataPtr* slot_data = getSlotData(slot);
+  if (slot_data == nullptr)
+    return {};
+
+  DataPtr data = std::atomic_exchange(slot_data, DataPtr());
+  if (data == nullptr)
+    return {};
+
+  // No other references exist and none can be acquired once removed from the slot, so it is safe to move
+  if (data.use_count() == 1)
+    return std::move(const_cast<tesseract_common::AnyPoly&>(*data));  // NOLINT
+
+  return *data;
+}
+
+void TaskComposerDataStorage::removeData(std::size_t slot)
+{
+  DataPtr* slot_data = getSlotData(slot);
+  if (slot_data != nullptr)
+    std::atomic_store(slot_data, DataPtr());
+}
+
+bool TaskComposerDataStorage::operator==(const TaskComposerDataStorage& rhs) const
+{
+  return (getData() == rhs.getData());
 }
 
 bool TaskComposerDataStorage::operator!=(const TaskComposerDataStorage& rhs) const { return !operator==(rhs); }
 
+std::size_t TaskComposerDataStorage::getSlotHelper(const std::string& key)
+{
+  auto it = slots_.find(key);
+  if (it != slots_.end())
+    return it->second;
+
+  const std::size_t slot = keys_.size();
+  if (getSlotData(slot) == nullptr)
+    allocateSlotChunk(slot);
+
+  keys_.push_back(key);
+  slots_[key] = slot;
+  return slot;
+}
+
+TaskComposerDataStorage::DataPtr* TaskComposerDataStorage::getSlotData(std::size_t slot) const
+{
+  SlotDirectory* directory = directory_.load(std::memory_order_acquire);
+  if (directory == nullptr)
+    return nullptr;
+
+  const std::size_t chunk_idx = slot / SLOT_CHUNK_SIZE;
+  if (chunk_idx >= directory->chunks.size())
+    return nullptr;
+
+  SlotChunk* chunk = directory->chunks[chunk_idx].load(std::memory_order_acquire);
+  if (chunk == nullptr)
+    return nullptr;
+
+  return &chunk->data[slot % SLOT_CHUNK_SIZE];
+}
+
+void TaskComposerDataStorage::allocateSlotChunk(std::size_t slot)
+{
+  const std::size_t chunk_idx = slot / SLOT_CHUNK_SIZE;
+  SlotDirectory* directory = directory_.load(std::memory_order_acquire);
+  if (directory == nullptr || chunk_idx >= directory->chunks.size())
+  {
+    // Replace the table with a larger copy, readers of the previous table still find the existing chunks
+    std::size_t capacity = (directory == nullptr) ? 4 : directory->chunks.size();
+    while (capacity <= chunk_idx)
+      capacity *= 2;
+
+    auto new_directory = std::make_unique<SlotDirectory>(capacity);
+    if (directory != nullptr)
+    {
+      for (std::size_t i = 0; i < directory->chunks.size(); ++i)
+        new_directory->chunks[i].store(directory->chunks[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    directory = new_directory.get();
+    directory_storage_.push_back(std::move(new_directory));
+    directory_.store(directory, std::memory_order_release);
+  }
+
+  chunk_storage_.push_back(std::make_unique<SlotChunk>());
+  directory->chunks[chunk_idx].store(chunk_storage_.back().get(), std::memory_order_release);
+}
+
+void TaskComposerDataStorage::copyHelper(const TaskComposerDataStorage& other)
+{
+  for (std::size_t slot = 0; slot < other.keys_.size(); ++slot)
+  {
+    DataPtr slot_data = other.getDataPtr(slot);
+    if (slot_data == nullptr)
+      continue;
+
+    // The data is immutable so it is shared rather than copied
+    std::atomic_store(getSlotData(getSlotHelper(other.keys_[slot])), slot_data);
+  }
+}
+
+void TaskComposerDataStorage::clearHelper()
+{
+  for (std::size_t slot = 0; slot < keys_.size(); ++slot)
+    std::atomic_store(getSlotData(slot), DataPtr());
+
+  slots_.clear();
+  keys_.clear();
+}
+
 template <class Archive>
-void TaskComposerDataStorage::serialize(Archive& ar, const unsigned int /*version*/)
+void TaskComposerDataStorage::save(Archive& ar, const unsigned int /*version*/) const
 {
+  std::unordered_map<std::string, tesseract_common::AnyPoly> data = getData();
+  ar& boost::serialization::make_nvp("data", data);
+}
+
+template <class Archive>
+void TaskComposerDataStorage::load(Archive& ar, const unsigned int /*version*/)
+{
+  std::unordered_map<std::string, tesseract_common::AnyPoly> data;
+  ar& boost::serialization::make_nvp("data", data);
+
   std::unique_lock lock(mutex_);
-  ar& boost::serialization::make_nvp("data", data_);
+  clearHelper();
+  for (auto& pair : data)
+    std::atomic_store(getSlotData(getSlotHelper(pair.first)),
+                      DataPtr(std::make_shared<tesseract_common::AnyPoly>(std::move(pair.second))));
+}
+
+template <class Archive>
+void TaskComposerDataStorage::serialize(Archive& ar, const unsigned int version)
+{
+  boost::serialization::split_member(ar, *this, version);
 }
 
 }  // namespace tesseract_planning
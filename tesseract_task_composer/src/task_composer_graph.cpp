@@ -26,6 +26,8 @@
 
 #include <tesseract_common/macros.h>
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
 #include <console_bridge/console.h>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/shared_ptr.hpp>
@@ -38,7 +40,18 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
-TaskComposerGraph::TaskComposerGraph(std::string name) : TaskComposerNode(std::move(name), TaskComposerNodeType::GRAPH)
+namespace
+{
+/** @brief Get a revision which is greater than all previous revisions of every graph */
+std::size_t nextRevision()
+{
+  static std::atomic<std::size_t> revision{ 0 };
+  return ++revision;
+}
+}  // namespace
+
+TaskComposerGraph::TaskComposerGraph(std::string name)
+  : TaskComposerNode(std::move(name), TaskComposerNodeType::GRAPH), revision_(nextRevision())
 {
 }
 TaskComposerGraph::TaskComposerGraph(std::string name,
@@ -152,6 +165,7 @@ boost::uuids::uuid TaskComposerGraph::addNode(TaskComposerNode::UPtr task_node)
   boost::uuids::uuid uuid = task_node->getUUID();
   task_node->parent_uuid_ = uuid_;
   nodes_[uuid] = std::move(task_node);
+  revision_ = nextRevision();
   return uuid;
 }
 
@@ -162,6 +176,8 @@ void TaskComposerGraph::addEdges(boost::uuids::uuid source, std::vector<boost::u
   node->outbound_edges_.insert(node->outbound_edges_.end(), destinations.begin(), destinations.end());
   for (const auto& d : destinations)
     nodes_.at(d)->inbound_edges_.push_back(source);
+
+  revision_ = nextRevision();
 }
 
 std::map<boost::uuids::uuid, TaskComposerNode::ConstPtr> TaskComposerGraph::getNodes() const
@@ -169,6 +185,19 @@ std::map<boost::uuids::uuid, TaskComposerNode::ConstPtr> TaskComposerGraph::getN
   return std::map<boost::uuids::uuid, TaskComposerNode::ConstPtr>{ nodes_.begin(), nodes_.end() };
 }
 
+std::size_t TaskComposerGraph::getRevision() const
+{
+  // A change to a subgraph gives it the greatest revision, so the maximum changes whenever any graph is modified
+  std::size_t revision = revision_;
+  for (const auto& pair : nodes_)
+  {
+    if (pair.second->getType() == TaskComposerNodeType::GRAPH)
+      revision = std::max(revision, static_cast<const TaskComposerGraph&>(*pair.second).getRevision());
+  }
+
+  return revision;
+}
+
 void TaskComposerGraph::renameInputKeys(const std::map<std::string, std::string>& input_keys)
 {
   for (const auto& key : input_keys)
@@ -249,6 +278,10 @@ void TaskComposerGraph::serialize(Archive& ar, const unsigned int /*version*/)
 {
   ar& boost::serialization::make_nvp("nodes", nodes_);
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerNode);
+
+  // The revision is not serialized, a loaded graph is given a new one
+  if (Archive::is_loading::value)
+    revision_ = nextRevision();
 }
 
 }  // namespace tesseract_planning
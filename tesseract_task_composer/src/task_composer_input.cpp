@@ -74,6 +74,7 @@ TaskComposerInput::TaskComposerInput(const TaskComposerInput& rhs)
   , profiles(rhs.profiles)
   , data_storage(rhs.data_storage)
   , task_infos(rhs.task_infos)
+  , segment_callback(rhs.segment_callback)
   , aborted_(rhs.aborted_.load())
 {
 }
@@ -83,6 +84,7 @@ TaskComposerInput::TaskComposerInput(TaskComposerInput&& rhs) noexcept
   , profiles(std::move(rhs.profiles))
   , data_storage(std::move(rhs.data_storage))
   , task_infos(std::move(rhs.task_infos))
+  , segment_callback(std::move(rhs.segment_callback))
   , aborted_(rhs.aborted_.load())
 {
 }
@@ -27,6 +27,7 @@
 #include <tesseract_task_composer/taskflow/taskflow_task_composer_executor.h>
 #include <tesseract_task_composer/taskflow/taskflow_task_composer_future.h>
 #include <taskflow/taskflow.hpp>
+#include <algorithm>
 
 namespace tesseract_planning
 {
@@ -36,9 +37,14 @@ TaskflowTaskComposerExecutor::TaskflowTaskComposerExecutor(size_t num_threads)
   , executor_(std::make_unique<tf::Executor>(num_threads_))
 {
 }
-TaskflowTaskComposerExecutor::TaskflowTaskComposerExecutor(std::string name, size_t num_threads)
+TaskflowTaskComposerExecutor::TaskflowTaskComposerExecutor(std::string name,
+                                                           size_t num_threads,
+                                                           bool cache_graphs,
+                                                           std::size_t cache_size)
   : TaskComposerExecutor(std::move(name))
   , num_threads_(num_threads)
+  , cache_graphs_(cache_graphs)
+  , cache_size_(cache_size)
   , executor_(std::make_unique<tf::Executor>(num_threads_))
 {
 }
@@ -57,6 +63,18 @@ TaskflowTaskComposerExecutor::TaskflowTaskComposerExecutor(std::string name, con
         throw std::runtime_error("TaskflowTaskComposerExecutor: entry 'threads' must be greater than zero");
     }
 
+    if (YAML::Node n = config["cache_graphs"])
+      cache_graphs_ = n.as<bool>();
+
+    if (YAML::Node n = config["cache_size"])
+    {
+      auto t = n.as<int>();
+      if (t > 0)
+        cache_size_ = static_cast<std::size_t>(t);
+      else
+        throw std::runtime_error("TaskflowTaskComposerExecutor: entry 'cache_size' must be greater than zero");
+    }
+
     executor_ = std::make_unique<tf::Executor>(num_threads_);
   }
   catch (const std::exception& e)
@@ -71,15 +89,28 @@ TaskflowTaskComposerExecutor::~TaskflowTaskComposerExecutor() = default;
 TaskComposerFuture::UPtr TaskflowTaskComposerExecutor::run(const TaskComposerGraph& task_graph,
                                                            TaskComposerInput& task_input)
 {
-  auto taskflow = convertToTaskflow(task_graph, task_input, *this);
-  std::shared_future<void> f = executor_->run(*(taskflow->front()));
+  std::shared_ptr<CompiledTaskflow> compiled;
+  if (isGraphCacheEnabled())
+    compiled = acquireCompiledTaskflow(task_graph);
+  else
+    compiled = compileTaskflow(task_graph);
+
+  compiled->task_input = &task_input;
+  compiled->task_executor = this;
+
+  // The compiled taskflow is released back to the cache once all tasks have finished
+  CompiledTaskflow* compiled_ptr = compiled.get();
+  std::shared_future<void> f =
+      executor_->run(*(compiled->taskflows.front()), [compiled_ptr]() { compiled_ptr->in_use = false; });
 
   //  std::ofstream out_data;
   //  out_data.open(tesseract_common::getTempPath() + "task_composer_example.dot");
   //  taskflow.top->dump(out_data);  // dump the graph including dynamic tasks
   //  out_data.close();
 
-  return std::make_unique<TaskflowTaskComposerFuture>(f, std::move(taskflow));
+  // The future keeps the compiled taskflow alive even if it gets evicted from the cache
+  std::shared_ptr<const std::vector<std::unique_ptr<tf::Taskflow>>> container(compiled, &compiled->taskflows);
+  return std::make_unique<TaskflowTaskComposerFuture>(f, std::move(container));
 }
 
 TaskComposerFuture::UPtr TaskflowTaskComposerExecutor::run(const TaskComposerTask& task, TaskComposerInput& task_input)
@@ -99,10 +130,47 @@ long TaskflowTaskComposerExecutor::getWorkerCount() const { return static_cast<l
 
 long TaskflowTaskComposerExecutor::getTaskCount() const { return static_cast<long>(executor_->num_topologies()); }
 
+bool TaskflowTaskComposerExecutor::isGraphCacheEnabled() const
+{
+  std::scoped_lock lock(cache_mutex_);
+  return cache_graphs_;
+}
+
+void TaskflowTaskComposerExecutor::setGraphCacheEnabled(bool enable)
+{
+  std::scoped_lock lock(cache_mutex_);
+  cache_graphs_ = enable;
+  if (!cache_graphs_)
+    cache_.clear();
+}
+
+std::size_t TaskflowTaskComposerExecutor::getGraphCacheSize() const
+{
+  std::scoped_lock lock(cache_mutex_);
+  return cache_size_;
+}
+
+void TaskflowTaskComposerExecutor::setGraphCacheSize(std::size_t cache_size)
+{
+  if (cache_size == 0)
+    throw std::runtime_error("TaskflowTaskComposerExecutor: cache size must be greater than zero");
+
+  std::scoped_lock lock(cache_mutex_);
+  cache_size_ = cache_size;
+}
+
+void TaskflowTaskComposerExecutor::clearGraphCache()
+{
+  std::scoped_lock lock(cache_mutex_);
+  cache_.clear();
+}
+
 bool TaskflowTaskComposerExecutor::operator==(const TaskflowTaskComposerExecutor& rhs) const
 {
   bool equal = true;
   equal &= (num_threads_ == rhs.num_threads_);
+  equal &= (cache_graphs_ == rhs.cache_graphs_);
+  equal &= (cache_size_ == rhs.cache_size_);
   equal &= (executor_ == rhs.executor_);
   equal &= TaskComposerExecutor::operator==(rhs);
   return equal;
@@ -117,13 +185,20 @@ template <class Archive>
 void TaskflowTaskComposerExecutor::save(Archive& ar, const unsigned int /*version*/) const
 {
   ar& BOOST_SERIALIZATION_NVP(num_threads_);
+  ar& BOOST_SERIALIZATION_NVP(cache_graphs_);
+  ar& BOOST_SERIALIZATION_NVP(cache_size_);
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerExecutor);
 }
 
 template <class Archive>
-void TaskflowTaskComposerExecutor::load(Archive& ar, const unsigned int /*version*/)
+void TaskflowTaskComposerExecutor::load(Archive& ar, const unsigned int version)
 {
   ar& BOOST_SERIALIZATION_NVP(num_threads_);
+  if (version > 0)
+  {
+    ar& BOOST_SERIALIZATION_NVP(cache_graphs_);
+    ar& BOOST_SERIALIZATION_NVP(cache_size_);
+  }
   ar& BOOST_SERIALIZATION_BASE_OBJECT_NVP(TaskComposerExecutor);
 
   executor_ = std::make_unique<tf::Executor>(num_threads_);
@@ -135,13 +210,69 @@ void TaskflowTaskComposerExecutor::serialize(Archive& ar, const unsigned int ver
   boost::serialization::split_member(ar, *this, version);
 }
 
-std::shared_ptr<std::vector<std::unique_ptr<tf::Taskflow>>>
-TaskflowTaskComposerExecutor::convertToTaskflow(const TaskComposerGraph& task_graph,
-                                                TaskComposerInput& task_input,
-                                                TaskComposerExecutor& task_executor)
+std::shared_ptr<TaskflowTaskComposerExecutor::CompiledTaskflow>
+TaskflowTaskComposerExecutor::acquireCompiledTaskflow(const TaskComposerGraph& task_graph)
 {
-  auto tf_container = std::make_shared<std::vector<std::unique_ptr<tf::Taskflow>>>();
-  tf_container->emplace_back(std::make_unique<tf::Taskflow>(task_graph.getName()));
+  {
+    std::scoped_lock lock(cache_mutex_);
+    auto it = cache_.find(task_graph.getUUID());
+    if (it != cache_.end())
+    {
+      it->second.last_used = ++cache_counter_;
+      for (auto& compiled : it->second.compiled)
+      {
+        bool expected = false;
+        if (compiled->in_use.compare_exchange_strong(expected, true))
+        {
+          if (compiled->revision == task_graph.getRevision())
+            return compiled;
+
+          // The graph was modified since it was compiled so discard all compiled taskflows
+          compiled->in_use = false;
+          cache_.erase(it);
+          break;
+        }
+      }
+    }
+  }
+
+  // Compile outside the lock because it can be expensive for large graphs
+  std::shared_ptr<CompiledTaskflow> compiled = compileTaskflow(task_graph);
+
+  std::scoped_lock lock(cache_mutex_);
+  CachedGraph& cached_graph = cache_[task_graph.getUUID()];
+  cached_graph.compiled.push_back(compiled);
+  cached_graph.last_used = ++cache_counter_;
+
+  // Evict the least recently used graph, running taskflows are kept alive by their future
+  if (cache_.size() > cache_size_)
+  {
+    auto lru_it = std::min_element(cache_.begin(), cache_.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.second.last_used < rhs.second.last_used;
+    });
+    cache_.erase(lru_it);
+  }
+
+  return compiled;
+}
+
+std::shared_ptr<TaskflowTaskComposerExecutor::CompiledTaskflow>
+TaskflowTaskComposerExecutor::compileTaskflow(const TaskComposerGraph& task_graph)
+{
+  auto compiled = std::make_shared<CompiledTaskflow>();
+  compiled->revision = task_graph.getRevision();
+  compiled->in_use = true;
+  convertToTaskflow(task_graph, *compiled);
+  return compiled;
+}
+
+void TaskflowTaskComposerExecutor::convertToTaskflow(const TaskComposerGraph& task_graph, CompiledTaskflow& compiled)
+{
+  compiled.taskflows.emplace_back(std::make_unique<tf::Taskflow>(task_graph.getName()));
+  tf::Taskflow& taskflow = *compiled.taskflows.back();
+
+  // The task input and executor are looked up at execution time so the taskflow can be reused
+  CompiledTaskflow* c = &compiled;
 
   // Generate process tasks for each node
   std::map<boost::uuids::uuid, tf::Task> tasks;
@@ -154,22 +285,18 @@ TaskflowTaskComposerExecutor::convertToTaskflow(const TaskComposerGraph& task_gr
       auto task = std::static_pointer_cast<const TaskComposerTask>(pair.second);
       if (edges.size() > 1 && task->isConditional())
         tasks[pair.first] =
-            tf_container->front()
-                ->emplace([task, &task_input, &task_executor] { return task->run(task_input, task_executor); })
+            taskflow.emplace([task, c] { return task->run(*c->task_input, *c->task_executor); })
                 .name(pair.second->getName());
       else
-        tasks[pair.first] = tf_container->front()
-                                ->emplace([task, &task_input, &task_executor] { task->run(task_input, task_executor); })
-                                .name(pair.second->getName());
+        tasks[pair.first] =
+            taskflow.emplace([task, c] { task->run(*c->task_input, *c->task_executor); }).name(pair.second->getName());
     }
     else if (pair.second->getType() == TaskComposerNodeType::GRAPH)
     {
       const auto& graph = static_cast<const TaskComposerGraph&>(*pair.second);
-      auto sub_tf_container = convertToTaskflow(graph, task_input, task_executor);
-      tasks[pair.first] = tf_container->front()->composed_of(*sub_tf_container->front());
-      tf_container->insert(tf_container->end(),
-                           std::make_move_iterator(sub_tf_container->begin()),
-                           std::make_move_iterator(sub_tf_container->end()));
+      std::size_t sub_idx = compiled.taskflows.size();
+      convertToTaskflow(graph, compiled);
+      tasks[pair.first] = taskflow.composed_of(*compiled.taskflows[sub_idx]);
     }
     else
       throw std::runtime_error("convertToTaskflow, unsupported node type!");
@@ -182,8 +309,6 @@ TaskflowTaskComposerExecutor::convertToTaskflow(const TaskComposerGraph& task_gr
     for (const auto& e : edges)
       tasks[pair.first].precede(tasks[e]);
   }
-
-  return tf_container;
 }
 
 std::shared_ptr<std::vector<std::unique_ptr<tf::Taskflow>>>
@@ -178,6 +178,49 @@ TEST_F(FixStateCollisionTaskUnit, MoveWaypointFromCollisionRandomSamplerTest)  /
   EXPECT_FALSE(waypointInCollision(wp, manip_, *task_input, profile, contacts));
 }
 
+TEST_F(FixStateCollisionTaskUnit, MoveWaypointFromCollisionRandomSamplerContextTest)  // NOLINT
+{
+  FixStateCollisionProfile profile;
+  profile.collision_check_config.contact_manager_config = tesseract_collision::ContactManagerConfig(0.1);
+  profile.jiggle_factor = 1.0;
+  profile.sampling_batch_size = 7;
+
+  // The context is reused for every check and sample
+  FixStateCollisionContext context(*env_, manip_.manipulator, profile);
+  EXPECT_EQ(context.getJointGroup().numJoints(), 2);
+  EXPECT_EQ(context.getLimits().rows(), 2);
+
+  Eigen::VectorXd state = Eigen::VectorXd::Zero(2);
+  state[1] = 1.09;
+  WaypointPoly wp{ JointWaypointPoly{ JointWaypoint({ "boxbot_x_joint", "boxbot_y_joint" }, state) } };
+  tesseract_collision::ContactResultMap contacts;
+  EXPECT_TRUE(stateInCollision(state, context, profile, contacts));
+  EXPECT_FALSE(contacts.empty());
+
+  // Attempts are 0, so it should still be in collision
+  int attempts{ -1 };
+  profile.sampling_attempts = 0;
+  EXPECT_TRUE(waypointInCollision(wp, context, profile, contacts));
+  EXPECT_FALSE(moveWaypointFromCollisionRandomSampler(wp, context, profile, 0, attempts));
+  EXPECT_EQ(attempts, 0);
+  EXPECT_TRUE(waypointInCollision(wp, context, profile, contacts));
+
+  // It is very unlikely that this will still fail
+  profile.sampling_attempts = 1000;
+  EXPECT_TRUE(moveWaypointFromCollisionRandomSampler(wp, context, profile, 0, attempts));
+  EXPECT_GT(attempts, 0);
+  EXPECT_LE(attempts, 1000);
+  EXPECT_FALSE(waypointInCollision(wp, context, profile, contacts));
+  EXPECT_TRUE(contacts.empty());
+
+  // The same seed and waypoint index produce the same samples
+  WaypointPoly wp2{ JointWaypointPoly{ JointWaypoint({ "boxbot_x_joint", "boxbot_y_joint" }, state) } };
+  int attempts2{ -1 };
+  EXPECT_TRUE(moveWaypointFromCollisionRandomSampler(wp2, context, profile, 0, attempts2));
+  EXPECT_EQ(attempts2, attempts);
+  EXPECT_TRUE(getJointPosition(wp2).isApprox(getJointPosition(wp)));
+}
+
 TEST_F(FixStateCollisionTaskUnit, MoveWaypointFromCollisionTrajoptTest)  // NOLINT
 {
   CompositeInstruction program = freespaceExampleProgramABB();
@@ -0,0 +1,104 @@
+/**
+ * @file raster_motion_task_benchmark.cpp
+ * @brief Benchmark the time until the first segment of a raster program is available
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <atomic>
+#include <chrono>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+#include <tesseract_task_composer/task_composer_plugin_factory.h>
+
+#include "raster_example_program.h"
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Measure the time until the first segment of the raster example program can be executed
+ * @details Without streaming the first segment is available once the whole program has been planned, with streaming
+ * it is available as soon as the from start and first raster segments have been planned.
+ */
+static void BM_RASTER_TIME_TO_FIRST_MOTION(benchmark::State& state,
+                                           const std::string& pipeline_name,
+                                           bool stream_segments)
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+  env->init(urdf_path, srdf_path, locator);
+
+  const tesseract_common::fs::path config_path(std::string(TESSERACT_TASK_COMPOSER_DIR) +
+                                               "/config/task_composer_plugins.yaml");
+  TaskComposerPluginFactory factory(config_path);
+  TaskComposerNode::UPtr task = factory.createTaskComposerNode(pipeline_name);
+  auto executor = factory.createTaskComposerExecutor("TaskflowExecutor");
+
+  TaskComposerDataStorage task_data;
+  task_data.setData(task->getInputKeys().front(), rasterExampleProgram());
+  TaskComposerProblem task_problem(env, task_data);
+  auto profiles = std::make_shared<ProfileDictionary>();
+
+  for (auto _ : state)
+  {
+    TaskComposerInput input(task_problem, profiles);
+
+    using Clock = std::chrono::steady_clock;
+    std::atomic<bool> first_segment{ false };
+    Clock::time_point first_segment_time;
+    if (stream_segments)
+    {
+      input.segment_callback = [&first_segment, &first_segment_time](std::size_t /*index*/,
+                                                                      const tesseract_common::AnyPoly& /*segment*/) {
+        if (!first_segment.exchange(true))
+          first_segment_time = Clock::now();
+      };
+    }
+
+    const Clock::time_point start_time = Clock::now();
+    TaskComposerFuture::UPtr future = executor->run(*task, input);
+    future->wait();
+    const Clock::time_point end_time = first_segment ? first_segment_time : Clock::now();
+
+    if (!input.isSuccessful())
+    {
+      state.SkipWithError("Failed to plan the raster example program");
+      break;
+    }
+
+    state.SetIterationTime(std::chrono::duration<double>(end_time - start_time).count());
+  }
+}
+
+BENCHMARK_CAPTURE(BM_RASTER_TIME_TO_FIRST_MOTION, RasterFtPipeline/Wait, "RasterFtPipeline", false)
+    ->UseManualTime()
+    ->Iterations(5)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_RASTER_TIME_TO_FIRST_MOTION, RasterFtPipeline/Stream, "RasterFtPipeline", true)
+    ->UseManualTime()
+    ->Iterations(5)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
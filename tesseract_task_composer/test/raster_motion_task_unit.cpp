@@ -0,0 +1,156 @@
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+#include <mutex>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_task_composer/nodes/raster_motion_task.h>
+#include <tesseract_task_composer/task_composer_input.h>
+#include <tesseract_task_composer/task_composer_future.h>
+#include <tesseract_task_composer/taskflow/taskflow_task_composer_executor.h>
+
+#include "raster_example_program.h"
+
+using namespace tesseract_planning;
+
+/** @brief Stands in for a planner by copying its input to its output, unless it is configured to fail */
+class CopySegmentTask : public TaskComposerTask
+{
+public:
+  CopySegmentTask(std::string name, std::string input_key, std::string output_key, bool fail)
+    : TaskComposerTask(std::move(name), false), fail_(fail)
+  {
+    input_keys_.push_back(std::move(input_key));
+    output_keys_.push_back(std::move(output_key));
+  }
+
+protected:
+  bool fail_;
+
+  TaskComposerNodeInfo::UPtr runImpl(TaskComposerInput& input,
+                                     OptionalTaskComposerExecutor /*executor*/ = std::nullopt) const override
+  {
+    auto info = std::make_unique<TaskComposerNodeInfo>(*this);
+    info->return_value = 0;
+
+    auto data = input.data_storage.getDataPtr(input_keys_[0]);
+    if (fail_ || data == nullptr)
+    {
+      info->message = "Failed";
+      return info;
+    }
+
+    input.data_storage.setDataPtr(output_keys_[0], data);
+    info->message = "Successful";
+    info->return_value = 1;
+    return info;
+  }
+};
+
+/** @brief Create a task factory for CopySegmentTask, the task with the name failing_name fails */
+RasterMotionTask::TaskFactory createTaskFactory(const std::string& failing_name)
+{
+  return [failing_name](const std::string& name, std::size_t /*index*/) {
+    RasterMotionTask::TaskFactoryResults results;
+    results.input_key = name + " input";
+    results.output_key = name + " output";
+    results.node =
+        std::make_unique<CopySegmentTask>(name, results.input_key, results.output_key, (name == failing_name));
+    return results;
+  };
+}
+
+/** @brief Records the published segments */
+struct PublishedSegments
+{
+  std::mutex mutex;
+  std::vector<std::size_t> indices;
+  std::vector<CompositeInstruction> segments;
+
+  TaskComposerInput::SegmentCallback callback()
+  {
+    return [this](std::size_t index, const tesseract_common::AnyPoly& segment) {
+      std::scoped_lock lock(mutex);
+      indices.push_back(index);
+      segments.push_back(segment.as<CompositeInstruction>());
+    };
+  }
+};
+
+TEST(RasterMotionTaskUnit, PublishSegmentsInOrderTest)  // NOLINT
+{
+  RasterMotionTask task("RasterMotionTask",
+                        "program",
+                        "results",
+                        true,
+                        createTaskFactory(""),
+                        createTaskFactory(""),
+                        createTaskFactory(""));
+  TaskflowTaskComposerExecutor executor("TaskflowExecutor", 4);
+
+  TaskComposerDataStorage task_data;
+  task_data.setData("program", rasterExampleProgram());
+  TaskComposerProblem task_problem(task_data, "PublishSegmentsInOrderTest");
+
+  // Run more than once so later runs use the cached raster graph
+  for (int run = 0; run < 3; ++run)
+  {
+    TaskComposerInput input(task_problem);
+    PublishedSegments published;
+    input.segment_callback = published.callback();
+    executor.run(task, input)->wait();
+    ASSERT_TRUE(input.isSuccessful());
+
+    const auto& results = input.data_storage.getData("results").as<CompositeInstruction>();
+    ASSERT_EQ(published.indices.size(), results.size());
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      EXPECT_EQ(published.indices[i], i);
+      EXPECT_TRUE(published.segments[i] == results[i].as<CompositeInstruction>());
+    }
+  }
+}
+
+TEST(RasterMotionTaskUnit, PublishSegmentsFailureTest)  // NOLINT
+{
+  // The second raster is segment 3, after from start, the first raster and the first transition
+  RasterMotionTask task("RasterMotionTask",
+                        "program",
+                        "results",
+                        true,
+                        createTaskFactory(""),
+                        createTaskFactory("Raster #2"),
+                        createTaskFactory(""));
+  TaskflowTaskComposerExecutor executor("TaskflowExecutor", 4);
+
+  // Results of a previous run are left in the data storage, they must not be published
+  CompositeInstruction stale;
+  stale.setDescription("stale");
+  TaskComposerDataStorage task_data;
+  task_data.setData("program", rasterExampleProgram());
+  task_data.setData("Raster #2 output", stale);
+  task_data.setData("Transition #2 output", stale);
+  task_data.setData("To End output", stale);
+  TaskComposerProblem task_problem(task_data, "PublishSegmentsFailureTest");
+
+  TaskComposerInput input(task_problem);
+  PublishedSegments published;
+  input.segment_callback = published.callback();
+  executor.run(task, input)->wait();
+
+  // The first transition plans towards the second raster so it fails too, nothing after it is published
+  ASSERT_EQ(published.indices.size(), 2);
+  EXPECT_EQ(published.indices[0], 0);
+  EXPECT_EQ(published.indices[1], 1);
+  for (const auto& segment : published.segments)
+    EXPECT_NE(segment.getDescription(), "stale");
+
+  EXPECT_FALSE(input.data_storage.hasKey("results"));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+/**
+ * @file simple_planner_raster_benchmark.cpp
+ * @brief Benchmark the throughput of the simple planner on the raster example program
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_motion_planners/simple/simple_motion_planner.h>
+#include <tesseract_motion_planners/simple/profile/simple_planner_fixed_size_plan_profile.h>
+#include <tesseract_motion_planners/simple/profile/simple_planner_lvs_no_ik_plan_profile.h>
+#include <tesseract_motion_planners/simple/profile/simple_planner_lvs_plan_profile.h>
+#include <tesseract_command_language/utils.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+#include "raster_example_program.h"
+
+using namespace tesseract_planning;
+
+static const std::string SIMPLE_DEFAULT_NAMESPACE = "SimpleMotionPlannerTask";
+
+/**
+ * @brief Measure the number of instructions per second the simple planner seeds
+ * @details The raster example program is repeated by the benchmark argument to emulate programs with thousands of
+ * waypoints. Every instruction is interpolated with the profile type of the benchmark.
+ */
+template <typename ProfileType>
+static void BM_SIMPLE_PLANNER_RASTER(benchmark::State& state)
+{
+  auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+  auto env = std::make_shared<tesseract_environment::Environment>();
+  tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+  tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+  env->init(urdf_path, srdf_path, locator);
+
+  CompositeInstruction raster_program = rasterExampleProgram();
+  CompositeInstruction program = raster_program;
+  for (int64_t i = 1; i < state.range(0); ++i)
+  {
+    for (const auto& instruction : raster_program)
+      program.push_back(instruction);
+  }
+  const auto num_instructions = static_cast<double>(program.getMoveInstructionCount());
+
+  auto profile = std::make_shared<ProfileType>();
+  auto profiles = std::make_shared<ProfileDictionary>();
+  profiles->addProfile<SimplePlannerPlanProfile>(SIMPLE_DEFAULT_NAMESPACE, DEFAULT_PROFILE_KEY, profile);
+  profiles->addProfile<SimplePlannerPlanProfile>(SIMPLE_DEFAULT_NAMESPACE, "PROCESS", profile);
+
+  PlannerRequest request;
+  request.env = env;
+  request.env_state = env->getState();
+  request.profiles = profiles;
+  request.instructions = program;
+
+  SimpleMotionPlanner planner(SIMPLE_DEFAULT_NAMESPACE);
+  for (auto _ : state)
+  {
+    PlannerResponse response = planner.solve(request);
+    if (!response.successful)
+    {
+      state.SkipWithError("Failed to seed the raster example program");
+      break;
+    }
+    benchmark::DoNotOptimize(response);
+  }
+
+  state.counters["instructions_per_second"] =
+      benchmark::Counter(num_instructions, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_SIMPLE_PLANNER_RASTER, SimplePlannerLVSNoIKPlanProfile)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SIMPLE_PLANNER_RASTER, SimplePlannerLVSPlanProfile)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_TEMPLATE(BM_SIMPLE_PLANNER_RASTER, SimplePlannerFixedSizePlanProfile)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,122 @@
+/**
+ * @file task_composer_data_storage_benchmark.cpp
+ * @brief Benchmark contention when accessing the task composer data storage from many threads
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <tesseract_task_composer/task_composer_data_storage.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+
+using namespace tesseract_planning;
+
+/** @brief The number of segments stored, similar to a raster program with many parallel segments */
+static const std::size_t NUM_SEGMENTS = 256;
+
+/** @brief The number of move instructions in each segment */
+static const long NUM_WAYPOINTS = 100;
+
+CompositeInstruction getSegment()
+{
+  CompositeInstruction segment;
+  std::vector<std::string> joint_names = { "joint_1", "joint_2", "joint_3", "joint_4", "joint_5", "joint_6" };
+  for (long i = 0; i < NUM_WAYPOINTS; ++i)
+  {
+    StateWaypointPoly wp{ StateWaypoint(joint_names, Eigen::VectorXd::Constant(6, static_cast<double>(i))) };
+    segment.appendMoveInstruction(MoveInstruction(wp, MoveInstructionType::LINEAR, "RASTER"));
+  }
+  return segment;
+}
+
+std::string getKey(std::size_t index) { return "output_data" + std::to_string(index); }
+
+TaskComposerDataStorage& getDataStorage()
+{
+  static TaskComposerDataStorage data_storage = []() {
+    TaskComposerDataStorage ds;
+    CompositeInstruction segment = getSegment();
+    for (std::size_t i = 0; i < NUM_SEGMENTS; ++i)
+      ds.setData(getKey(i), segment);
+    return ds;
+  }();
+  return data_storage;
+}
+
+/** @brief Each thread reads a copy of a segment by key, which is the behavior prior to shared data */
+static void BM_GET_DATA_COPY_BY_KEY(benchmark::State& state)
+{
+  TaskComposerDataStorage& ds = getDataStorage();
+  std::size_t idx = static_cast<std::size_t>(state.thread_index());
+  for (auto _ : state)
+  {
+    tesseract_common::AnyPoly data = ds.getData(getKey(idx++ % NUM_SEGMENTS));
+    benchmark::DoNotOptimize(data);
+  }
+}
+
+/** @brief Each thread reads a segment by key without copying the data */
+static void BM_GET_DATA_PTR_BY_KEY(benchmark::State& state)
+{
+  TaskComposerDataStorage& ds = getDataStorage();
+  std::size_t idx = static_cast<std::size_t>(state.thread_index());
+  for (auto _ : state)
+  {
+    TaskComposerDataStorage::DataPtr data = ds.getDataPtr(getKey(idx++ % NUM_SEGMENTS));
+    benchmark::DoNotOptimize(data);
+  }
+}
+
+/** @brief Each thread reads a segment by a slot resolved up front without copying the data or locking */
+static void BM_GET_DATA_PTR_BY_SLOT(benchmark::State& state)
+{
+  TaskComposerDataStorage& ds = getDataStorage();
+  std::vector<std::size_t> slots;
+  slots.reserve(NUM_SEGMENTS);
+  for (std::size_t i = 0; i < NUM_SEGMENTS; ++i)
+    slots.push_back(ds.getSlot(getKey(i)));
+
+  std::size_t idx = static_cast<std::size_t>(state.thread_index());
+  for (auto _ : state)
+  {
+    TaskComposerDataStorage::DataPtr data = ds.getDataPtr(slots[idx++ % NUM_SEGMENTS]);
+    benchmark::DoNotOptimize(data);
+  }
+}
+
+/** @brief Each thread reads a segment and writes it back to its own slot, similar to a pipeline task */
+static void BM_GET_SET_DATA_BY_SLOT(benchmark::State& state)
+{
+  TaskComposerDataStorage& ds = getDataStorage();
+  const std::size_t input_slot = ds.getSlot(getKey(static_cast<std::size_t>(state.thread_index()) % NUM_SEGMENTS));
+  const std::size_t output_slot = ds.getSlot("thread_output_data" + std::to_string(state.thread_index()));
+  for (auto _ : state)
+  {
+    TaskComposerDataStorage::DataPtr data = ds.getDataPtr(input_slot);
+    ds.setData(output_slot, *data);
+  }
+}
+
+BENCHMARK(BM_GET_DATA_COPY_BY_KEY)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_GET_DATA_PTR_BY_KEY)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_GET_DATA_PTR_BY_SLOT)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_GET_SET_DATA_BY_SLOT)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
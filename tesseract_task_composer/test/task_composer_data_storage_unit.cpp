@@ -0,0 +1,141 @@
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_task_composer/task_composer_data_storage.h>
+#include <tesseract_command_language/composite_instruction.h>
+
+using namespace tesseract_planning;
+
+TEST(TesseractTaskComposerDataStorageUnit, SlotLookupTest)  // NOLINT
+{
+  CompositeInstruction program;
+  program.setDescription("program");
+
+  TaskComposerDataStorage data_storage;
+  const std::size_t slot = data_storage.getSlot("program");
+  EXPECT_EQ(data_storage.getSlot("program"), slot);
+  EXPECT_FALSE(data_storage.hasData(slot));
+  EXPECT_FALSE(data_storage.hasKey("program"));
+  EXPECT_TRUE(data_storage.getDataPtr(slot) == nullptr);
+  EXPECT_TRUE(data_storage.getData(slot).isNull());
+
+  // Data set by key is found by slot
+  data_storage.setData("program", program);
+  EXPECT_TRUE(data_storage.hasData(slot));
+  EXPECT_EQ(data_storage.getData(slot).as<CompositeInstruction>().getDescription(), "program");
+  EXPECT_EQ(data_storage.getDataPtr(slot)->as<CompositeInstruction>().getDescription(), "program");
+
+  // Existing keys keep their slot and new keys are assigned a new one
+  const std::vector<std::size_t> slots = data_storage.getSlots({ "program", "results" });
+  ASSERT_EQ(slots.size(), 2);
+  EXPECT_EQ(slots[0], slot);
+  EXPECT_NE(slots[1], slot);
+  EXPECT_EQ(data_storage.getSlot("results"), slots[1]);
+
+  // Data set by slot is found by key
+  CompositeInstruction results;
+  results.setDescription("results");
+  data_storage.setData(slots[1], results);
+  EXPECT_TRUE(data_storage.hasKey("results"));
+  EXPECT_EQ(data_storage.getData("results").as<CompositeInstruction>().getDescription(), "results");
+  EXPECT_EQ(data_storage.getData().size(), 2);
+
+  data_storage.removeData(slots[1]);
+  EXPECT_FALSE(data_storage.hasKey("results"));
+  EXPECT_FALSE(data_storage.hasData(slots[1]));
+  EXPECT_EQ(data_storage.getData().size(), 1);
+
+  // Slots which were never assigned have no data
+  EXPECT_FALSE(data_storage.hasData(slots[1] + 1000000));
+  EXPECT_TRUE(data_storage.getDataPtr(slots[1] + 1000000) == nullptr);
+}
+
+TEST(TesseractTaskComposerDataStorageUnit, SlotGrowthTest)  // NOLINT
+{
+  // More keys than the previous fixed size slot table could hold
+  const std::size_t num_keys = 300 * TaskComposerDataStorage::SLOT_CHUNK_SIZE;
+
+  TaskComposerDataStorage data_storage;
+  const std::size_t first_slot = data_storage.getSlot("key_0");
+  CompositeInstruction program;
+  program.setDescription("key_0");
+  data_storage.setData(first_slot, program);
+
+  std::vector<std::string> keys;
+  keys.reserve(num_keys);
+  for (std::size_t i = 0; i < num_keys; ++i)
+    keys.push_back("key_" + std::to_string(i));
+
+  const std::vector<std::size_t> slots = data_storage.getSlots(keys);
+  ASSERT_EQ(slots.size(), num_keys);
+  EXPECT_EQ(slots[0], first_slot);
+  for (std::size_t i = 1; i < num_keys; ++i)
+  {
+    program.setDescription(keys[i]);
+    data_storage.setData(slots[i], program);
+  }
+
+  // Slots assigned before the table grew are still valid
+  EXPECT_EQ(data_storage.getData(first_slot).as<CompositeInstruction>().getDescription(), "key_0");
+  for (std::size_t i = 0; i < num_keys; ++i)
+    EXPECT_EQ(data_storage.getData(keys[i]).as<CompositeInstruction>().getDescription(), keys[i]);
+
+  // A copy and a moved storage keep all of the data
+  TaskComposerDataStorage copy(data_storage);
+  EXPECT_EQ(copy.getData().size(), num_keys);
+  TaskComposerDataStorage moved(std::move(copy));
+  EXPECT_EQ(moved.getData().size(), num_keys);
+  EXPECT_EQ(moved.getData(keys.back()).as<CompositeInstruction>().getDescription(), keys.back());
+}
+
+TEST(TesseractTaskComposerDataStorageUnit, CopyOnWriteTest)  // NOLINT
+{
+  CompositeInstruction program;
+  program.setDescription("program");
+
+  TaskComposerDataStorage data_storage;
+  data_storage.setData("program", program);
+  TaskComposerDataStorage::DataPtr data = data_storage.getDataPtr("program");
+  ASSERT_TRUE(data != nullptr);
+
+  // Copies share the data rather than copying it
+  TaskComposerDataStorage copy(data_storage);
+  EXPECT_EQ(copy.getDataPtr("program").get(), data.get());
+  EXPECT_TRUE(copy == data_storage);
+
+  // Setting data replaces it, readers and other storages holding the previous data are not affected
+  CompositeInstruction modified;
+  modified.setDescription("modified");
+  copy.setData("program", modified);
+  EXPECT_NE(copy.getDataPtr("program").get(), data.get());
+  EXPECT_EQ(copy.getData("program").as<CompositeInstruction>().getDescription(), "modified");
+  EXPECT_EQ(data_storage.getDataPtr("program").get(), data.get());
+  EXPECT_EQ(data->as<CompositeInstruction>().getDescription(), "program");
+  EXPECT_TRUE(copy != data_storage);
+
+  // Sharing data by pointer
+  data_storage.setDataPtr("shared", data);
+  EXPECT_EQ(data_storage.getDataPtr("shared").get(), data.get());
+
+  // Extracting data still referenced elsewhere returns a copy and leaves the references untouched
+  tesseract_common::AnyPoly extracted = data_storage.extractData("program");
+  EXPECT_FALSE(data_storage.hasKey("program"));
+  EXPECT_EQ(extracted.as<CompositeInstruction>().getDescription(), "program");
+  EXPECT_EQ(data->as<CompositeInstruction>().getDescription(), "program");
+  EXPECT_EQ(data_storage.getData("shared").as<CompositeInstruction>().getDescription(), "program");
+
+  // Extracting the only reference moves the data out
+  tesseract_common::AnyPoly moved = copy.extractData("program");
+  EXPECT_FALSE(copy.hasKey("program"));
+  EXPECT_EQ(moved.as<CompositeInstruction>().getDescription(), "modified");
+  EXPECT_TRUE(copy.extractData("program").isNull());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+/**
+ * @file task_composer_executor_benchmark.cpp
+ * @brief Benchmark the executor overhead of running task composer pipelines
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <yaml-cpp/yaml.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_task_composer/task_composer_plugin_factory.h>
+#include <tesseract_task_composer/taskflow/taskflow_task_composer_executor.h>
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Run a pipeline with empty input data
+ * @details Every pipeline fails on its first task without input data so the time measured is dominated by the
+ * executor converting and scheduling the graph rather than the work performed by the tasks.
+ */
+static void BM_PIPELINE_EXECUTOR_OVERHEAD(benchmark::State& state,
+                                          std::shared_ptr<TaskComposerPluginFactory> factory,
+                                          const std::string& pipeline_name,
+                                          bool cache_graphs)
+{
+  TaskflowTaskComposerExecutor executor("TaskflowExecutor", 1, cache_graphs);
+  TaskComposerNode::UPtr pipeline = factory->createTaskComposerNode(pipeline_name);
+  TaskComposerInput input(TaskComposerProblem{}, std::make_shared<ProfileDictionary>());
+
+  for (auto _ : state)
+  {
+    input.reset();
+    TaskComposerFuture::UPtr future = executor.run(*pipeline, input);
+    future->wait();
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const tesseract_common::fs::path config_path(std::string(TESSERACT_TASK_COMPOSER_DIR) +
+                                               "/config/task_composer_plugins.yaml");
+  auto factory = std::make_shared<TaskComposerPluginFactory>(config_path);
+
+  YAML::Node plugin_config = YAML::LoadFile(config_path.string());
+  const YAML::Node& task_plugins =
+      plugin_config[tesseract_common::TaskComposerPluginInfo::CONFIG_KEY]["tasks"]["plugins"];
+
+  for (auto it = task_plugins.begin(); it != task_plugins.end(); ++it)
+  {
+    // Only graphs are converted to a taskflow with more than a single task
+    if (it->second["class"].as<std::string>() != "GraphTaskFactory")
+      continue;
+
+    const auto pipeline_name = it->first.as<std::string>();
+    benchmark::RegisterBenchmark(
+        std::string("BM_PIPELINE_EXECUTOR_OVERHEAD/" + pipeline_name + "/NoCache").c_str(),
+        &BM_PIPELINE_EXECUTOR_OVERHEAD,
+        factory,
+        pipeline_name,
+        false)
+        ->UseRealTime()
+        ->Unit(benchmark::TimeUnit::kMicrosecond);
+
+    benchmark::RegisterBenchmark(std::string("BM_PIPELINE_EXECUTOR_OVERHEAD/" + pipeline_name + "/Cache").c_str(),
+                                 &BM_PIPELINE_EXECUTOR_OVERHEAD,
+                                 factory,
+                                 pipeline_name,
+                                 true)
+        ->UseRealTime()
+        ->Unit(benchmark::TimeUnit::kMicrosecond);
+  }
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,129 @@
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_task_composer/task_composer_graph.h>
+#include <tesseract_task_composer/task_composer_input.h>
+#include <tesseract_task_composer/nodes/done_task.h>
+#include <tesseract_task_composer/taskflow/taskflow_task_composer_executor.h>
+
+using namespace tesseract_planning;
+
+/** @brief Records the order tasks are run in */
+class RecordOrderTask : public TaskComposerTask
+{
+public:
+  RecordOrderTask(std::string name, std::vector<std::string>& order)
+    : TaskComposerTask(std::move(name), false), order_(order)
+  {
+  }
+
+protected:
+  std::vector<std::string>& order_;
+
+  TaskComposerNodeInfo::UPtr runImpl(TaskComposerInput& /*input*/,
+                                     OptionalTaskComposerExecutor /*executor*/ = std::nullopt) const override
+  {
+    order_.push_back(getName());
+    auto info = std::make_unique<TaskComposerNodeInfo>(*this);
+    info->return_value = 1;
+    return info;
+  }
+};
+
+TEST(TesseractTaskComposerExecutorUnit, TaskflowExecutorGraphCacheTest)  // NOLINT
+{
+  // A single thread so tasks never run concurrently
+  TaskflowTaskComposerExecutor executor("TaskflowExecutor", 1, true);
+  EXPECT_TRUE(executor.isGraphCacheEnabled());
+
+  std::vector<std::string> order;
+  TaskComposerGraph graph;
+  auto first = graph.addNode(std::make_unique<RecordOrderTask>("First", order));
+  auto second = graph.addNode(std::make_unique<RecordOrderTask>("Second", order));
+  auto third = graph.addNode(std::make_unique<RecordOrderTask>("Third", order));
+  graph.addEdges(first, { second });
+
+  TaskComposerInput input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, input)->wait();
+  EXPECT_EQ(order.size(), 3);
+  EXPECT_EQ(input.task_infos.getInfoMap().size(), 3);
+
+  // Rerun the cached graph with a new input
+  order.clear();
+  TaskComposerInput cached_input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, cached_input)->wait();
+  EXPECT_EQ(order.size(), 3);
+  EXPECT_EQ(cached_input.task_infos.getInfoMap().size(), 3);
+
+  // Adding an edge keeps the number of nodes, the cached taskflow must not be used
+  std::size_t revision = graph.getRevision();
+  graph.addEdges(third, { first });
+  EXPECT_NE(graph.getRevision(), revision);
+  order.clear();
+  TaskComposerInput modified_input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, modified_input)->wait();
+  ASSERT_EQ(order.size(), 3);
+  EXPECT_EQ(order[0], "Third");
+  EXPECT_EQ(order[1], "First");
+  EXPECT_EQ(order[2], "Second");
+
+  // Adding a node
+  auto done = graph.addNode(std::make_unique<DoneTask>("Done"));
+  graph.addEdges(second, { done });
+  order.clear();
+  TaskComposerInput added_input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, added_input)->wait();
+  EXPECT_EQ(order.size(), 3);
+  EXPECT_EQ(added_input.task_infos.getInfoMap().size(), 4);
+  EXPECT_TRUE(added_input.isSuccessful());
+
+  executor.setGraphCacheEnabled(false);
+  EXPECT_FALSE(executor.isGraphCacheEnabled());
+}
+
+TEST(TesseractTaskComposerExecutorUnit, TaskflowExecutorGraphCacheSubgraphTest)  // NOLINT
+{
+  TaskflowTaskComposerExecutor executor("TaskflowExecutor", 1, true);
+
+  std::vector<std::string> order;
+  auto subgraph = std::make_unique<TaskComposerGraph>("Subgraph");
+  TaskComposerGraph* subgraph_ptr = subgraph.get();
+  auto first = subgraph->addNode(std::make_unique<RecordOrderTask>("First", order));
+  auto second = subgraph->addNode(std::make_unique<RecordOrderTask>("Second", order));
+
+  TaskComposerGraph graph;
+  graph.addNode(std::move(subgraph));
+
+  TaskComposerInput input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, input)->wait();
+  EXPECT_EQ(order.size(), 2);
+
+  // Modifying a subgraph changes the revision of the graph, the cached taskflow must not be used
+  std::size_t revision = graph.getRevision();
+  subgraph_ptr->addEdges(second, { first });
+  EXPECT_NE(graph.getRevision(), revision);
+
+  order.clear();
+  TaskComposerInput modified_input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, modified_input)->wait();
+  ASSERT_EQ(order.size(), 2);
+  EXPECT_EQ(order[0], "Second");
+  EXPECT_EQ(order[1], "First");
+
+  // The revision only changes when the structure is modified
+  revision = graph.getRevision();
+  order.clear();
+  TaskComposerInput cached_input(TaskComposerProblem("GraphCacheTest"));
+  executor.run(graph, cached_input)->wait();
+  EXPECT_EQ(order.size(), 2);
+  EXPECT_EQ(graph.getRevision(), revision);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
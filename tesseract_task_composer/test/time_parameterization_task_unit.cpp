@@ -0,0 +1,175 @@
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <gtest/gtest.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_common/types.h>
+#include <tesseract_environment/environment.h>
+#include <tesseract_task_composer/profiles/interative_spline_parameterization_profile.h>
+#include <tesseract_task_composer/nodes/iterative_spline_parameterization_task.h>
+#include <tesseract_task_composer/nodes/ruckig_trajectory_smoothing_task.h>
+#include <tesseract_task_composer/nodes/time_optimal_parameterization_task.h>
+#include <tesseract_task_composer/task_composer_input.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_support/tesseract_support_resource_locator.h>
+
+using namespace tesseract_planning;
+using namespace tesseract_environment;
+using tesseract_common::ManipulatorInfo;
+
+static const std::string ISP_TASK_NAME = "IterativeSplineParameterizationTask";
+
+class TimeParameterizationTaskUnit : public ::testing::Test
+{
+protected:
+  Environment::Ptr env_;
+  ProfileDictionary::Ptr profiles_;
+
+  void SetUp() override
+  {
+    auto locator = std::make_shared<tesseract_common::TesseractSupportResourceLocator>();
+    Environment::Ptr env = std::make_shared<Environment>();
+
+    tesseract_common::fs::path urdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.urdf");
+    tesseract_common::fs::path srdf_path(std::string(TESSERACT_SUPPORT_DIR) + "/urdf/abb_irb2400.srdf");
+    EXPECT_TRUE(env->init(urdf_path, srdf_path, locator));
+    env_ = env;
+
+    profiles_ = std::make_shared<ProfileDictionary>();
+  }
+};
+
+CompositeInstruction createStraightProgram()
+{
+  CompositeInstruction program(
+      DEFAULT_PROFILE_KEY, CompositeInstructionOrder::ORDERED, ManipulatorInfo("manipulator", "base_link", "tool0"));
+
+  std::vector<std::string> joint_names = { "joint_1", "joint_2", "joint_3", "joint_4", "joint_5", "joint_6" };
+  for (int i = 0; i < 10; ++i)
+  {
+    StateWaypointPoly swp{ StateWaypoint(joint_names, Eigen::VectorXd::Constant(6, 0.05 * i)) };
+    program.appendMoveInstruction(MoveInstruction(swp, MoveInstructionType::FREESPACE));
+  }
+
+  return program;
+}
+
+double getDuration(const CompositeInstruction& program)
+{
+  return program.getLastMoveInstruction()->getWaypoint().as<StateWaypointPoly>().getTime();
+}
+
+/**
+ * @brief Run a task which replaces its input with a copy of the input and then with the input moved, the results of
+ * both must be the same
+ */
+void checkCopyAndMoveInput(const TaskComposerTask& copy_task,
+                           const TaskComposerTask& move_task,
+                           const CompositeInstruction& program,
+                           const Environment::Ptr& env,
+                           const ProfileDictionary::Ptr& profiles)
+{
+  TaskComposerDataStorage task_data;
+  task_data.setData("program", program);
+  TaskComposerProblem task_problem(env, task_data);
+  auto task_input = std::make_shared<TaskComposerInput>(task_problem, profiles);
+
+  // By default the input is copied so anything holding the input data is not affected
+  TaskComposerDataStorage::DataPtr input_data = task_input->data_storage.getDataPtr("program");
+  EXPECT_EQ(copy_task.run(*task_input), 1);
+  TaskComposerDataStorage::DataPtr copy_results = task_input->data_storage.getDataPtr("program");
+  ASSERT_TRUE(copy_results != nullptr);
+  EXPECT_NE(copy_results.get(), input_data.get());
+  EXPECT_TRUE(input_data->as<CompositeInstruction>() == program);
+  EXPECT_GT(getDuration(copy_results->as<CompositeInstruction>()), 0);
+
+  // When moving, the instructions of the input are reused if the data storage holds the only reference
+  task_input->reset();
+  task_input->data_storage.setData("program", program);
+  const InstructionPoly* instructions =
+      task_input->data_storage.getDataPtr("program")->as<CompositeInstruction>().getInstructions().data();
+  EXPECT_EQ(move_task.run(*task_input), 1);
+  TaskComposerDataStorage::DataPtr move_results = task_input->data_storage.getDataPtr("program");
+  ASSERT_TRUE(move_results != nullptr);
+  EXPECT_EQ(move_results->as<CompositeInstruction>().getInstructions().data(), instructions);
+  EXPECT_TRUE(move_results->as<CompositeInstruction>() == copy_results->as<CompositeInstruction>());
+}
+
+TEST_F(TimeParameterizationTaskUnit, IterativeSplineParameterizationMoveInputTest)  // NOLINT
+{
+  IterativeSplineParameterizationTask copy_task(ISP_TASK_NAME, "program", "program", true, false);
+  IterativeSplineParameterizationTask move_task(ISP_TASK_NAME, "program", "program", true, false, true);
+  checkCopyAndMoveInput(copy_task, move_task, createStraightProgram(), env_, profiles_);
+}
+
+TEST_F(TimeParameterizationTaskUnit, IterativeSplineParameterizationMoveInputFailureTest)  // NOLINT
+{
+  CompositeInstruction program = createStraightProgram();
+
+  // A scaling factor of zero fails the parameterization
+  profiles_->addProfile<IterativeSplineParameterizationProfile>(
+      ISP_TASK_NAME, DEFAULT_PROFILE_KEY, std::make_shared<IterativeSplineParameterizationProfile>(0, 0));
+
+  TaskComposerDataStorage task_data;
+  TaskComposerProblem task_problem(env_, task_data);
+  auto task_input = std::make_shared<TaskComposerInput>(task_problem, profiles_);
+  task_input->data_storage.setData("program", program);
+  const InstructionPoly* instructions =
+      task_input->data_storage.getDataPtr("program")->as<CompositeInstruction>().getInstructions().data();
+
+  // The moved program is restored unchanged
+  IterativeSplineParameterizationTask move_task(ISP_TASK_NAME, "program", "program", true, false, true);
+  EXPECT_EQ(move_task.run(*task_input), 0);
+  TaskComposerDataStorage::DataPtr data = task_input->data_storage.getDataPtr("program");
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(data->as<CompositeInstruction>().getInstructions().data(), instructions);
+  EXPECT_TRUE(data->as<CompositeInstruction>() == program);
+}
+
+TEST_F(TimeParameterizationTaskUnit, TimeOptimalParameterizationMoveInputTest)  // NOLINT
+{
+  TimeOptimalParameterizationTask copy_task("TimeOptimalParameterizationTask", "program", "program", true);
+  TimeOptimalParameterizationTask move_task("TimeOptimalParameterizationTask", "program", "program", true, true);
+  checkCopyAndMoveInput(copy_task, move_task, createStraightProgram(), env_, profiles_);
+}
+
+TEST_F(TimeParameterizationTaskUnit, RuckigTrajectorySmoothingMoveInputTest)  // NOLINT
+{
+  // Ruckig smooths a time parameterized program
+  TaskComposerDataStorage task_data;
+  task_data.setData("program", createStraightProgram());
+  TaskComposerProblem task_problem(env_, task_data);
+  TaskComposerInput task_input(task_problem, profiles_);
+  IterativeSplineParameterizationTask isp_task(ISP_TASK_NAME, "program", "program", true, false);
+  ASSERT_EQ(isp_task.run(task_input), 1);
+  const auto program = task_input.data_storage.getData("program").as<CompositeInstruction>();
+
+  RuckigTrajectorySmoothingTask copy_task("RuckigTrajectorySmoothingTask", "program", "program", true);
+  RuckigTrajectorySmoothingTask move_task("RuckigTrajectorySmoothingTask", "program", "program", true, true);
+  checkCopyAndMoveInput(copy_task, move_task, program, env_, profiles_);
+}
+
+TEST_F(TimeParameterizationTaskUnit, MoveInputRequiresSameKeyTest)  // NOLINT
+{
+  CompositeInstruction program = createStraightProgram();
+
+  TaskComposerDataStorage task_data;
+  TaskComposerProblem task_problem(env_, task_data);
+  TaskComposerInput task_input(task_problem, profiles_);
+  task_input.data_storage.setData("input_program", program);
+
+  // The input is left in place when it is not replaced by the results
+  IterativeSplineParameterizationTask move_task(ISP_TASK_NAME, "input_program", "output_program", true, false, true);
+  EXPECT_EQ(move_task.run(task_input), 1);
+  EXPECT_TRUE(task_input.data_storage.getData("input_program").as<CompositeInstruction>() == program);
+  EXPECT_GT(getDuration(task_input.data_storage.getData("output_program").as<CompositeInstruction>()), 0);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
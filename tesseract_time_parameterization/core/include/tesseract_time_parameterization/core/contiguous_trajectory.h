@@ -0,0 +1,123 @@
+/**
+ * @file contiguous_trajectory.h
+ * @brief Trajectory Container implementation which gathers a trajectory into contiguous storage
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_TIME_PARAMETERIZATION_CONTIGUOUS_TRAJECTORY_H
+#define TESSERACT_TIME_PARAMETERIZATION_CONTIGUOUS_TRAJECTORY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <Eigen/Core>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_time_parameterization/core/trajectory_container.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief Trajectory Container which stores the trajectory in contiguous [dof x size] matrices
+ * @details Accessing a point of an InstructionsTrajectory goes through the type erasure of the instruction and the
+ * waypoint, which the time parameterization algorithms pay for on every access in their inner loops. This container
+ * gathers another trajectory once, the algorithm runs on the matrix columns and the results are scattered back once.
+ *
+ * @code
+ * InstructionsTrajectory trajectory(program);
+ * ContiguousTrajectory contiguous(trajectory);
+ * solver.compute(contiguous, ...);
+ * contiguous.scatter(trajectory);
+ * @endcode
+ */
+class ContiguousTrajectory : public TrajectoryContainer
+{
+public:
+  using Ptr = std::shared_ptr<ContiguousTrajectory>;
+  using ConstPtr = std::shared_ptr<const ContiguousTrajectory>;
+
+  ContiguousTrajectory() = default;
+
+  /**
+   * @brief Construct by gathering the data of another trajectory
+   * @param trajectory The trajectory to copy
+   */
+  explicit ContiguousTrajectory(const TrajectoryContainer& trajectory);
+
+  /**
+   * @brief Construct from matrices
+   * @details The velocity and acceleration are zero initialized if empty
+   * @param position The position of each point as a column of a [dof x size] matrix
+   * @param velocity The velocity of each point as a column of a [dof x size] matrix
+   * @param acceleration The acceleration of each point as a column of a [dof x size] matrix
+   * @param time The time from start of each point
+   */
+  ContiguousTrajectory(Eigen::MatrixXd position,
+                       Eigen::MatrixXd velocity,
+                       Eigen::MatrixXd acceleration,
+                       Eigen::VectorXd time);
+
+  /**
+   * @brief Copy the data of a trajectory, reusing the existing storage when the size has not changed
+   * @details Velocity and acceleration which are not the size of the position are zero initialized
+   * @param trajectory The trajectory to copy
+   */
+  void gather(const TrajectoryContainer& trajectory);
+
+  /**
+   * @brief Write the velocity, acceleration and time of each point back to a trajectory
+   * @param trajectory The trajectory to update which must have the same size
+   */
+  void scatter(TrajectoryContainer& trajectory) const;
+
+  Eigen::Ref<const Eigen::VectorXd> getPosition(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getPosition(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getVelocity(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getVelocity(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getAcceleration(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getAcceleration(Eigen::Index i) final;
+  double getTimeFromStart(Eigen::Index i) const final;
+
+  void setData(Eigen::Index i,
+               const Eigen::Ref<const Eigen::VectorXd>& velocity,
+               const Eigen::Ref<const Eigen::VectorXd>& acceleration,
+               double time) final;
+
+  Eigen::Index size() const final;
+  Eigen::Index dof() const final;
+  bool empty() const final;
+
+  /** @brief The position of each point as a column of a [dof x size] matrix */
+  const Eigen::MatrixXd& getPositions() const;
+
+  /** @brief The velocity of each point as a column of a [dof x size] matrix */
+  const Eigen::MatrixXd& getVelocities() const;
+
+  /** @brief The acceleration of each point as a column of a [dof x size] matrix */
+  const Eigen::MatrixXd& getAccelerations() const;
+
+  /** @brief The time from start of each point */
+  const Eigen::VectorXd& getTimes() const;
+
+private:
+  Eigen::MatrixXd position_;
+  Eigen::MatrixXd velocity_;
+  Eigen::MatrixXd acceleration_;
+  Eigen::VectorXd time_;
+};
+}  // namespace tesseract_planning
+#endif  // TESSERACT_TIME_PARAMETERIZATION_CONTIGUOUS_TRAJECTORY_H
@@ -43,15 +43,18 @@ public:
   InstructionsTrajectory(std::vector<std::reference_wrapper<InstructionPoly>> trajectory);
   InstructionsTrajectory(CompositeInstruction& program);
 
-  const Eigen::VectorXd& getPosition(Eigen::Index i) const final;
-  Eigen::VectorXd& getPosition(Eigen::Index i) final;
-  const Eigen::VectorXd& getVelocity(Eigen::Index i) const final;
-  Eigen::VectorXd& getVelocity(Eigen::Index i) final;
-  const Eigen::VectorXd& getAcceleration(Eigen::Index i) const final;
-  Eigen::VectorXd& getAcceleration(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getPosition(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getPosition(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getVelocity(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getVelocity(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getAcceleration(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getAcceleration(Eigen::Index i) final;
   double getTimeFromStart(Eigen::Index i) const final;
 
-  void setData(Eigen::Index i, const Eigen::VectorXd& velocity, const Eigen::VectorXd& acceleration, double time) final;
+  void setData(Eigen::Index i,
+               const Eigen::Ref<const Eigen::VectorXd>& velocity,
+               const Eigen::Ref<const Eigen::VectorXd>& acceleration,
+               double time) final;
 
   Eigen::Index size() const final;
   Eigen::Index dof() const final;
@@ -0,0 +1,77 @@
+/**
+ * @file joint_trajectory_block_trajectory.h
+ * @brief Trajectory Container implementation for joint trajectory blocks
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef TESSERACT_TIME_PARAMETERIZATION_JOINT_TRAJECTORY_BLOCK_TRAJECTORY_H
+#define TESSERACT_TIME_PARAMETERIZATION_JOINT_TRAJECTORY_BLOCK_TRAJECTORY_H
+
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <vector>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_time_parameterization/core/trajectory_container.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/joint_trajectory_block.h>
+
+namespace tesseract_planning
+{
+/**
+ * @brief Trajectory Container which operates directly on the matrices of joint trajectory blocks
+ * @details The velocity and acceleration of every block are allocated if they were not provided.
+ */
+class JointTrajectoryBlockTrajectory : public TrajectoryContainer
+{
+public:
+  JointTrajectoryBlockTrajectory(JointTrajectoryBlock& block);
+
+  /**
+   * @brief Construct a trajectory from every joint trajectory block in the program, in order
+   * @details Throws if the program contains move instructions or no joint trajectory blocks
+   * @param program The program
+   */
+  JointTrajectoryBlockTrajectory(CompositeInstruction& program);
+
+  Eigen::Ref<const Eigen::VectorXd> getPosition(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getPosition(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getVelocity(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getVelocity(Eigen::Index i) final;
+  Eigen::Ref<const Eigen::VectorXd> getAcceleration(Eigen::Index i) const final;
+  Eigen::Ref<Eigen::VectorXd> getAcceleration(Eigen::Index i) final;
+  double getTimeFromStart(Eigen::Index i) const final;
+
+  void setData(Eigen::Index i,
+               const Eigen::Ref<const Eigen::VectorXd>& velocity,
+               const Eigen::Ref<const Eigen::VectorXd>& acceleration,
+               double time) final;
+
+  Eigen::Index size() const final;
+  Eigen::Index dof() const final;
+  bool empty() const final;
+
+private:
+  /** @brief The block and column of each point */
+  std::vector<std::pair<JointTrajectoryBlock*, Eigen::Index>> points_;
+  Eigen::Index dof_{ 0 };
+
+  void addBlock(JointTrajectoryBlock& block);
+};
+}  // namespace tesseract_planning
+#endif  // TESSERACT_TIME_PARAMETERIZATION_JOINT_TRAJECTORY_BLOCK_TRAJECTORY_H
@@ -41,17 +41,17 @@ class TesseractCommonTrajectory : public TrajectoryContainer
 public:
   TesseractCommonTrajectory(tesseract_common::JointTrajectory& trajectory);
 
-  const Eigen::VectorXd& getPosition(Eigen::Index i) const override final;
-  Eigen::VectorXd& getPosition(Eigen::Index i) override final;
-  const Eigen::VectorXd& getVelocity(Eigen::Index i) const override final;
-  Eigen::VectorXd& getVelocity(Eigen::Index i) override final;
-  const Eigen::VectorXd& getAcceleration(Eigen::Index i) const override final;
-  Eigen::VectorXd& getAcceleration(Eigen::Index i) override final;
+  Eigen::Ref<const Eigen::VectorXd> getPosition(Eigen::Index i) const override final;
+  Eigen::Ref<Eigen::VectorXd> getPosition(Eigen::Index i) override final;
+  Eigen::Ref<const Eigen::VectorXd> getVelocity(Eigen::Index i) const override final;
+  Eigen::Ref<Eigen::VectorXd> getVelocity(Eigen::Index i) override final;
+  Eigen::Ref<const Eigen::VectorXd> getAcceleration(Eigen::Index i) const override final;
+  Eigen::Ref<Eigen::VectorXd> getAcceleration(Eigen::Index i) override final;
   double getTimeFromStart(Eigen::Index i) const final;
 
   void setData(Eigen::Index i,
-               const Eigen::VectorXd& velocity,
-               const Eigen::VectorXd& acceleration,
+               const Eigen::Ref<const Eigen::VectorXd>& velocity,
+               const Eigen::Ref<const Eigen::VectorXd>& acceleration,
                double time) override final;
 
   Eigen::Index size() const override final;
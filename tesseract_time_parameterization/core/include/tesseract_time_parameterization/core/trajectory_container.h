@@ -34,7 +34,11 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
-/** @brief A generic container that the time parameterization classes use */
+/**
+ * @brief A generic container that the time parameterization classes use
+ * @details The accessors return references which may point into contiguous storage shared by all of the points, so
+ * the size of the returned data must not be changed through them.
+ */
 class TrajectoryContainer
 {
 public:
@@ -53,24 +57,24 @@ public:
    * @param i The index to extract position data
    * @return The position data
    */
-  virtual const Eigen::VectorXd& getPosition(Eigen::Index i) const = 0;
-  virtual Eigen::VectorXd& getPosition(Eigen::Index i) = 0;
+  virtual Eigen::Ref<const Eigen::VectorXd> getPosition(Eigen::Index i) const = 0;
+  virtual Eigen::Ref<Eigen::VectorXd> getPosition(Eigen::Index i) = 0;
 
   /**
    * @brief Get the velocity data at a given index
    * @param i The index to extract velocity data
    * @return The velocity data
    */
-  virtual const Eigen::VectorXd& getVelocity(Eigen::Index i) const = 0;
-  virtual Eigen::VectorXd& getVelocity(Eigen::Index i) = 0;
+  virtual Eigen::Ref<const Eigen::VectorXd> getVelocity(Eigen::Index i) const = 0;
+  virtual Eigen::Ref<Eigen::VectorXd> getVelocity(Eigen::Index i) = 0;
 
   /**
    * @brief Get the acceleration data at a given index
    * @param i The index to extract acceleration data
    * @return The acceleration data
    */
-  virtual const Eigen::VectorXd& getAcceleration(Eigen::Index i) const = 0;
-  virtual Eigen::VectorXd& getAcceleration(Eigen::Index i) = 0;
+  virtual Eigen::Ref<const Eigen::VectorXd> getAcceleration(Eigen::Index i) const = 0;
+  virtual Eigen::Ref<Eigen::VectorXd> getAcceleration(Eigen::Index i) = 0;
 
   /**
    * @brief Get the time from start at a given index
@@ -86,8 +90,10 @@ public:
    * @param acceleration The acceleration data to assign to index
    * @param time The time from start to assign to index
    */
-  virtual void
-  setData(Eigen::Index i, const Eigen::VectorXd& velocity, const Eigen::VectorXd& acceleration, double time) = 0;
+  virtual void setData(Eigen::Index i,
+                       const Eigen::Ref<const Eigen::VectorXd>& velocity,
+                       const Eigen::Ref<const Eigen::VectorXd>& acceleration,
+                       double time) = 0;
 
   /** @brief The size of the path */
   virtual Eigen::Index size() const = 0;
@@ -0,0 +1,135 @@
+/**
+ * @file contiguous_trajectory.cpp
+ * @brief Trajectory Container implementation which gathers a trajectory into contiguous storage
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <stdexcept>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
+
+namespace tesseract_planning
+{
+ContiguousTrajectory::ContiguousTrajectory(const TrajectoryContainer& trajectory) { gather(trajectory); }
+
+ContiguousTrajectory::ContiguousTrajectory(Eigen::MatrixXd position,
+                                           Eigen::MatrixXd velocity,
+                                           Eigen::MatrixXd acceleration,
+                                           Eigen::VectorXd time)
+  : position_(std::move(position))
+  , velocity_(std::move(velocity))
+  , acceleration_(std::move(acceleration))
+  , time_(std::move(time))
+{
+  if (velocity_.size() == 0)
+    velocity_ = Eigen::MatrixXd::Zero(position_.rows(), position_.cols());
+
+  if (acceleration_.size() == 0)
+    acceleration_ = Eigen::MatrixXd::Zero(position_.rows(), position_.cols());
+
+  if (velocity_.rows() != position_.rows() || velocity_.cols() != position_.cols() ||
+      acceleration_.rows() != position_.rows() || acceleration_.cols() != position_.cols() ||
+      time_.size() != position_.cols())
+    throw std::runtime_error("ContiguousTrajectory, the position, velocity, acceleration and time sizes do not match!");
+}
+
+void ContiguousTrajectory::gather(const TrajectoryContainer& trajectory)
+{
+  const Eigen::Index n = trajectory.size();
+  const Eigen::Index dof = trajectory.dof();
+
+  // Eigen only reallocates when the size changes
+  position_.resize(dof, n);
+  velocity_.resize(dof, n);
+  acceleration_.resize(dof, n);
+  time_.resize(n);
+
+  for (Eigen::Index i = 0; i < n; ++i)
+  {
+    position_.col(i) = trajectory.getPosition(i);
+
+    const Eigen::Ref<const Eigen::VectorXd> velocity = trajectory.getVelocity(i);
+    if (velocity.size() == dof)
+      velocity_.col(i) = velocity;
+    else
+      velocity_.col(i).setZero();
+
+    const Eigen::Ref<const Eigen::VectorXd> acceleration = trajectory.getAcceleration(i);
+    if (acceleration.size() == dof)
+      acceleration_.col(i) = acceleration;
+    else
+      acceleration_.col(i).setZero();
+
+    time_(i) = trajectory.getTimeFromStart(i);
+  }
+}
+
+void ContiguousTrajectory::scatter(TrajectoryContainer& trajectory) const
+{
+  if (trajectory.size() != size())
+    throw std::runtime_error("ContiguousTrajectory, scatter was given a trajectory of a different size!");
+
+  for (Eigen::Index i = 0; i < size(); ++i)
+    trajectory.setData(i, velocity_.col(i), acceleration_.col(i), time_(i));
+}
+
+Eigen::Ref<const Eigen::VectorXd> ContiguousTrajectory::getPosition(Eigen::Index i) const { return position_.col(i); }
+
+Eigen::Ref<Eigen::VectorXd> ContiguousTrajectory::getPosition(Eigen::Index i) { return position_.col(i); }
+
+Eigen::Ref<const Eigen::VectorXd> ContiguousTrajectory::getVelocity(Eigen::Index i) const { return velocity_.col(i); }
+
+Eigen::Ref<Eigen::VectorXd> ContiguousTrajectory::getVelocity(Eigen::Index i) { return velocity_.col(i); }
+
+Eigen::Ref<const Eigen::VectorXd> ContiguousTrajectory::getAcceleration(Eigen::Index i) const
+{
+  return acceleration_.col(i);
+}
+
+Eigen::Ref<Eigen::VectorXd> ContiguousTrajectory::getAcceleration(Eigen::Index i) { return acceleration_.col(i); }
+
+double ContiguousTrajectory::getTimeFromStart(Eigen::Index i) const { return time_(i); }
+
+void ContiguousTrajectory::setData(Eigen::Index i,
+                                   const Eigen::Ref<const Eigen::VectorXd>& velocity,
+                                   const Eigen::Ref<const Eigen::VectorXd>& acceleration,
+                                   double time)
+{
+  velocity_.col(i) = velocity;
+  acceleration_.col(i) = acceleration;
+  time_(i) = time;
+}
+
+Eigen::Index ContiguousTrajectory::size() const { return position_.cols(); }
+
+Eigen::Index ContiguousTrajectory::dof() const { return position_.rows(); }
+
+bool ContiguousTrajectory::empty() const { return (position_.cols() == 0); }
+
+const Eigen::MatrixXd& ContiguousTrajectory::getPositions() const { return position_; }
+
+const Eigen::MatrixXd& ContiguousTrajectory::getVelocities() const { return velocity_; }
+
+const Eigen::MatrixXd& ContiguousTrajectory::getAccelerations() const { return acceleration_; }
+
+const Eigen::VectorXd& ContiguousTrajectory::getTimes() const { return time_; }
+
+}  // namespace tesseract_planning
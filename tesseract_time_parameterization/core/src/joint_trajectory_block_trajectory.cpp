@@ -0,0 +1,127 @@
+/**
+ * @file joint_trajectory_block_trajectory.cpp
+ * @brief Trajectory Container implementation for joint trajectory blocks
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <tesseract_time_parameterization/core/joint_trajectory_block_trajectory.h>
+
+namespace tesseract_planning
+{
+JointTrajectoryBlockTrajectory::JointTrajectoryBlockTrajectory(JointTrajectoryBlock& block)
+{
+  addBlock(block);
+
+  if (points_.empty())
+    throw std::runtime_error("Tried to construct JointTrajectoryBlockTrajectory with empty trajectory!");
+}
+
+JointTrajectoryBlockTrajectory::JointTrajectoryBlockTrajectory(CompositeInstruction& program)
+{
+  std::vector<std::reference_wrapper<InstructionPoly>> instructions =
+      program.flatten(moveOrJointTrajectoryBlockFilter);
+
+  for (auto& instruction : instructions)
+  {
+    if (!instruction.get().isJointTrajectoryBlock())
+      throw std::runtime_error("Tried to construct JointTrajectoryBlockTrajectory with move instructions!");
+
+    addBlock(instruction.get().as<JointTrajectoryBlock>());
+  }
+
+  if (points_.empty())
+    throw std::runtime_error("Tried to construct JointTrajectoryBlockTrajectory with empty trajectory!");
+}
+
+void JointTrajectoryBlockTrajectory::addBlock(JointTrajectoryBlock& block)
+{
+  if (block.empty())
+    return;
+
+  if (points_.empty())
+    dof_ = block.dof();
+  else if (block.dof() != dof_)
+    throw std::runtime_error("JointTrajectoryBlockTrajectory, every block must have the same number of joints!");
+
+  block.initializeDynamics();
+  points_.reserve(points_.size() + static_cast<std::size_t>(block.size()));
+  for (Eigen::Index i = 0; i < block.size(); ++i)
+    points_.emplace_back(&block, i);
+}
+
+Eigen::Ref<const Eigen::VectorXd> JointTrajectoryBlockTrajectory::getPosition(Eigen::Index i) const
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getPosition().col(point.second);
+}
+
+Eigen::Ref<Eigen::VectorXd> JointTrajectoryBlockTrajectory::getPosition(Eigen::Index i)
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getPosition().col(point.second);
+}
+
+Eigen::Ref<const Eigen::VectorXd> JointTrajectoryBlockTrajectory::getVelocity(Eigen::Index i) const
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getVelocity().col(point.second);
+}
+
+Eigen::Ref<Eigen::VectorXd> JointTrajectoryBlockTrajectory::getVelocity(Eigen::Index i)
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getVelocity().col(point.second);
+}
+
+Eigen::Ref<const Eigen::VectorXd> JointTrajectoryBlockTrajectory::getAcceleration(Eigen::Index i) const
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getAcceleration().col(point.second);
+}
+
+Eigen::Ref<Eigen::VectorXd> JointTrajectoryBlockTrajectory::getAcceleration(Eigen::Index i)
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getAcceleration().col(point.second);
+}
+
+double JointTrajectoryBlockTrajectory::getTimeFromStart(Eigen::Index i) const
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  return point.first->getTime()(point.second);
+}
+
+void JointTrajectoryBlockTrajectory::setData(Eigen::Index i,
+                                             const Eigen::Ref<const Eigen::VectorXd>& velocity,
+                                             const Eigen::Ref<const Eigen::VectorXd>& acceleration,
+                                             double time)
+{
+  const auto& point = points_[static_cast<std::size_t>(i)];
+  point.first->getVelocity().col(point.second) = velocity;
+  point.first->getAcceleration().col(point.second) = acceleration;
+  point.first->getTime()(point.second) = time;
+}
+
+Eigen::Index JointTrajectoryBlockTrajectory::size() const { return static_cast<Eigen::Index>(points_.size()); }
+
+Eigen::Index JointTrajectoryBlockTrajectory::dof() const { return dof_; }
+
+bool JointTrajectoryBlockTrajectory::empty() const { return points_.empty(); }
+
+}  // namespace tesseract_planning
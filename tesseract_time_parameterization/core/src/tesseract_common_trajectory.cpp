@@ -37,33 +37,33 @@ TesseractCommonTrajectory::TesseractCommonTrajectory(tesseract_common::JointTraj
   dof_ = static_cast<Eigen::Index>(trajectory_.front().joint_names.size());
 }
 
-const Eigen::VectorXd& TesseractCommonTrajectory::getPosition(Eigen::Index i) const
+Eigen::Ref<const Eigen::VectorXd> TesseractCommonTrajectory::getPosition(Eigen::Index i) const
 {
   // TODO add assert that i<dof_
   return trajectory_.at(static_cast<std::size_t>(i)).position;
 }
 
-Eigen::VectorXd& TesseractCommonTrajectory::getPosition(Eigen::Index i)
+Eigen::Ref<Eigen::VectorXd> TesseractCommonTrajectory::getPosition(Eigen::Index i)
 {
   return trajectory_.at(static_cast<std::size_t>(i)).position;
 }
 
-const Eigen::VectorXd& TesseractCommonTrajectory::getVelocity(Eigen::Index i) const
+Eigen::Ref<const Eigen::VectorXd> TesseractCommonTrajectory::getVelocity(Eigen::Index i) const
 {
   return trajectory_.at(static_cast<std::size_t>(i)).velocity;
 }
 
-Eigen::VectorXd& TesseractCommonTrajectory::getVelocity(Eigen::Index i)
+Eigen::Ref<Eigen::VectorXd> TesseractCommonTrajectory::getVelocity(Eigen::Index i)
 {
   return trajectory_.at(static_cast<std::size_t>(i)).velocity;
 }
 
-const Eigen::VectorXd& TesseractCommonTrajectory::getAcceleration(Eigen::Index i) const
+Eigen::Ref<const Eigen::VectorXd> TesseractCommonTrajectory::getAcceleration(Eigen::Index i) const
 {
   return trajectory_.at(static_cast<std::size_t>(i)).acceleration;
 }
 
-Eigen::VectorXd& TesseractCommonTrajectory::getAcceleration(Eigen::Index i)
+Eigen::Ref<Eigen::VectorXd> TesseractCommonTrajectory::getAcceleration(Eigen::Index i)
 {
   return trajectory_.at(static_cast<std::size_t>(i)).acceleration;
 }
@@ -74,8 +74,8 @@ double TesseractCommonTrajectory::getTimeFromStart(Eigen::Index i) const
 }
 
 void TesseractCommonTrajectory::setData(Eigen::Index i,
-                                        const Eigen::VectorXd& velocity,
-                                        const Eigen::VectorXd& acceleration,
+                                        const Eigen::Ref<const Eigen::VectorXd>& velocity,
+                                        const Eigen::Ref<const Eigen::VectorXd>& acceleration,
                                         double time)
 {
   tesseract_common::JointState& swp = trajectory_.at(static_cast<std::size_t>(i));
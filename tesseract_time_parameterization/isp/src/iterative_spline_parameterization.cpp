@@ -47,54 +47,43 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 namespace tesseract_planning
 {
-static void fit_cubic_spline(long n, const double dt[], const double x[], double x1[], double x2[]);  // NOLINT
-static void adjust_two_positions(long n,
-                                 const double dt[],  // NOLINT
-                                 double x[],         // NOLINT
-                                 double x1[],        // NOLINT
-                                 double x2[],        // NOLINT
-                                 double x2_i,        // NOLINT
-                                 double x2_f);       // NOLINT
-static void
-init_times(long n, double dt[], const double x[], const double max_velocity[], double min_velocity[]);  // NOLINT
-// static int fit_spline_and_adjust_times(const int n,
-//                                       double dt[],
-//                                       const double x[],
-//                                       double x1[],
-//                                       double x2[],
-//                                       const double max_velocity,
-//                                       const double min_velocity,
-//                                       const double max_acceleration,
-//                                       const double min_acceleration,
-//                                       const double tfactor);
-static double global_adjustment_factor(long n,
-                                       double dt[],                       // NOLINT
-                                       const double x[],                  // NOLINT
-                                       double x1[],                       // NOLINT
-                                       double x2[],                       // NOLINT
-                                       const double max_velocity[],       // NOLINT
-                                       const double min_velocity[],       // NOLINT
-                                       const double max_acceleration[],   // NOLINT
-                                       const double min_acceleration[]);  // NOLINT
-
-// The path of a single joint: positions, velocities, and accelerations
-struct SingleJointTrajectory
+/**
+ * @brief The path of every joint stored as [dof x n] matrices with a column per point
+ * @details The spline fit and time adjustments are applied to all joints in lock-step so each step of the
+ * algorithm is a column operation which Eigen vectorizes across the joints. The buffers are allocated once and
+ * reused by every iteration of the time adjustment loop.
+ */
+struct MultiJointTrajectory
 {
-  std::vector<double> positions_;  // joint's position at time[x]
-  std::vector<double> velocities_;
-  std::vector<double> accelerations_;
-  double initial_acceleration_{ 0 };
-  double final_acceleration_{ 0 };
-  std::vector<double> min_velocity_;
-  std::vector<double> max_velocity_;
-  std::vector<double> min_acceleration_;
-  std::vector<double> max_acceleration_;
+  /** @brief The position of each point */
+  Eigen::MatrixXd positions;
+  /** @brief The velocity of each point, the first and last columns are the specified initial and final velocities */
+  Eigen::MatrixXd velocities;
+  /** @brief The acceleration of each point, also used as workspace by the tridiagonal solver */
+  Eigen::MatrixXd accelerations;
+  /** @brief The specified initial acceleration of each joint */
+  Eigen::VectorXd initial_acceleration;
+  /** @brief The specified final acceleration of each joint */
+  Eigen::VectorXd final_acceleration;
+  /** @brief The max velocity of each joint, the min velocity is the negative */
+  Eigen::VectorXd max_velocity;
+  /** @brief The max acceleration of each joint, the min acceleration is the negative */
+  Eigen::VectorXd max_acceleration;
+  /** @brief The velocity scaling factor of each point */
+  Eigen::VectorXd velocity_scaling_factor;
+  /** @brief The acceleration scaling factor of each point */
+  Eigen::VectorXd acceleration_scaling_factor;
+  /** @brief The tridiagonal solver coefficients, which only depend on the time intervals so are shared by all joints */
+  Eigen::VectorXd c;
+
+  Eigen::Index numPoints() const { return positions.cols(); }
 };
 
-void globalAdjustment(std::vector<SingleJointTrajectory>& t2,
-                      long num_joints,
-                      long num_points,
-                      std::vector<double>& time_diff);
+static void fit_cubic_spline(MultiJointTrajectory& t2, const Eigen::VectorXd& dt);  // NOLINT
+static void adjust_two_positions(MultiJointTrajectory& t2, const Eigen::VectorXd& dt);  // NOLINT
+static void init_times(const MultiJointTrajectory& t2, Eigen::VectorXd& dt);  // NOLINT
+static double global_adjustment_factor(const MultiJointTrajectory& t2);  // NOLINT
+static void globalAdjustment(MultiJointTrajectory& t2, Eigen::VectorXd& dt);
 
 IterativeSplineParameterization::IterativeSplineParameterization(bool add_points) : add_points_(add_points) {}
 
@@ -152,9 +141,10 @@ bool IterativeSplineParameterization::compute(
 
   Eigen::VectorXd velocity_scaling_factor = Eigen::VectorXd::Ones(trajectory.size());
   Eigen::VectorXd acceleration_scaling_factor = Eigen::VectorXd::Ones(trajectory.size());
-  auto num_points = static_cast<std::size_t>(trajectory.size());
+  const Eigen::Index num_joints = trajectory.dof();
+  const Eigen::Index num_trajectory_points = trajectory.size();
 
-  if (max_velocity.size() != trajectory.dof() || max_acceleration.size() != trajectory.dof())
+  if (max_velocity.size() != num_joints || max_acceleration.size() != num_joints)
     return false;
 
   // Set scaling factors
@@ -213,152 +203,79 @@ bool IterativeSplineParameterization::compute(
     }
   }
 
-  // JointTrajectory indexes in [point][joint] order.
-  // We need [joint][point] order to solve efficiently,
-  // so convert form here.
-
-  std::vector<SingleJointTrajectory> t2(static_cast<std::size_t>(trajectory.dof()));
-
-  const Eigen::VectorXd& start_vel = trajectory.getVelocity(0);
-  const Eigen::VectorXd& last_vel = trajectory.getVelocity(static_cast<Eigen::Index>(num_points - 1));
-  const Eigen::VectorXd& start_acc = trajectory.getAcceleration(0);
-  const Eigen::VectorXd& last_acc = trajectory.getAcceleration(static_cast<Eigen::Index>(num_points - 1));
-
-  for (std::size_t j = 0; j < static_cast<std::size_t>(trajectory.dof()); j++)
+  // Error out if bounds don't make sense
+  for (Eigen::Index j = 0; j < num_joints; j++)
   {
-    // Copy positions
-    t2[j].positions_.resize(num_points, 0.0);
-    for (std::size_t i = 0; i < num_points; i++)
-      t2[j].positions_[i] = trajectory.getPosition(static_cast<Eigen::Index>(i))[static_cast<Eigen::Index>(j)];
-
-    // Initialize velocities
-    t2[j].velocities_.resize(num_points, 0.0);
-
-    // Copy initial/final velocities if specified
-    if (start_vel.size() > 0)
-      t2[j].velocities_[0] = start_vel[static_cast<Eigen::Index>(j)];
-    if (last_vel.size() > 0)
-      t2[j].velocities_[num_points - 1] = last_vel[static_cast<Eigen::Index>(j)];
-
-    // Initialize accelerations
-    t2[j].accelerations_.resize(num_points, 0.0);
-    t2[j].initial_acceleration_ = 0.0;
-    t2[j].final_acceleration_ = 0.0;
-
-    // Copy initial/final accelerations if specified
-    if (start_acc.size() > 0)
-      t2[j].initial_acceleration_ = start_acc[static_cast<Eigen::Index>(j)];
-    t2[j].accelerations_[0] = t2[j].initial_acceleration_;
-    if (last_acc.size() > 0)
-      t2[j].final_acceleration_ = last_acc[static_cast<Eigen::Index>(j)];
-    t2[j].accelerations_[num_points - 1] = t2[j].final_acceleration_;
-
-    // Set bounds based on inputs
-    t2[j].max_velocity_.resize(num_points);
-    t2[j].min_velocity_.resize(num_points);
-    t2[j].max_acceleration_.resize(num_points);
-    t2[j].min_acceleration_.resize(num_points);
-    Eigen::Map<Eigen::VectorXd> max_velocity_eigen(t2[j].max_velocity_.data(), static_cast<Eigen::Index>(num_points));
-    Eigen::Map<Eigen::VectorXd> min_velocity_eigen(t2[j].min_velocity_.data(), static_cast<Eigen::Index>(num_points));
-    Eigen::Map<Eigen::VectorXd> max_acceleration_eigen(t2[j].max_acceleration_.data(),
-                                                       static_cast<Eigen::Index>(num_points));
-    Eigen::Map<Eigen::VectorXd> min_acceleration_eigen(t2[j].min_acceleration_.data(),
-                                                       static_cast<Eigen::Index>(num_points));
-
-    max_velocity_eigen =
-        Eigen::VectorXd::Ones(static_cast<Eigen::Index>(num_points)) * max_velocity[static_cast<Eigen::Index>(j)];
-    min_velocity_eigen =
-        Eigen::VectorXd::Ones(static_cast<Eigen::Index>(num_points)) * -max_velocity[static_cast<Eigen::Index>(j)];
-    max_velocity_eigen.array() *= velocity_scaling_factor.array();
-    min_velocity_eigen.array() *= velocity_scaling_factor.array();
-
-    max_acceleration_eigen =
-        Eigen::VectorXd::Ones(static_cast<Eigen::Index>(num_points)) * max_acceleration[static_cast<Eigen::Index>(j)];
-    min_acceleration_eigen =
-        Eigen::VectorXd::Ones(static_cast<Eigen::Index>(num_points)) * -max_acceleration[static_cast<Eigen::Index>(j)];
-    max_acceleration_eigen.array() *= acceleration_scaling_factor.array();
-    min_acceleration_eigen.array() *= acceleration_scaling_factor.array();
-
-    // Error out if bounds don't make sense
-    if ((max_velocity_eigen.array() <= 0.0).any() || (max_acceleration_eigen.array() <= 0.0).any())
+    if ((max_velocity[j] * velocity_scaling_factor.array() <= 0.0).any() ||
+        (max_acceleration[j] * acceleration_scaling_factor.array() <= 0.0).any())
     {
       CONSOLE_BRIDGE_logError("iterative_spline_parameterization: Joint %d max velocity %f and max acceleration %f "
                               "must be greater than zero or a solution won't be found.",
                               j,
-                              t2[j].max_velocity_[0],
-                              t2[j].max_acceleration_[0]);
-      return false;
-    }
-    if ((min_velocity_eigen.array() >= 0.0).any() || (min_acceleration_eigen.array() >= 0.0).any())
-    {
-      CONSOLE_BRIDGE_logError("trajectory_processing.iterative_spline_parameterization: Joint %d min velocity %f and "
-                              "min acceleration %f must be less than zero or a solution won't be found.",
-                              j,
-                              t2[j].min_velocity_[0],
-                              t2[j].min_acceleration_[0]);
+                              max_velocity[j] * velocity_scaling_factor[0],
+                              max_acceleration[j] * acceleration_scaling_factor[0]);
       return false;
     }
   }
 
   bool add_points = add_points_;
-  if (num_points < 2)
+  if (num_trajectory_points < 2)
     add_points = false;
 
-  if (add_points)
+  // TrajectoryContainer indexes in [point][joint] order.
+  // The joints of each point are stored in a column so every joint is solved in lock-step, so convert from here.
+  // Insert 2nd and 2nd-last points if requested
+  // (required to force acceleration to specified values at endpoints)
+  const Eigen::Index num_points = num_trajectory_points + (add_points ? 2 : 0);
+  const Eigen::Index offset = (add_points ? 1 : 0);
+
+  MultiJointTrajectory t2;
+  t2.positions.resize(num_joints, num_points);
+  t2.velocities = Eigen::MatrixXd::Zero(num_joints, num_points);
+  t2.accelerations = Eigen::MatrixXd::Zero(num_joints, num_points);
+  t2.initial_acceleration = Eigen::VectorXd::Zero(num_joints);
+  t2.final_acceleration = Eigen::VectorXd::Zero(num_joints);
+  t2.max_velocity = max_velocity;
+  t2.max_acceleration = max_acceleration;
+  t2.velocity_scaling_factor.resize(num_points);
+  t2.acceleration_scaling_factor.resize(num_points);
+  t2.c.resize(num_points);
+
+  // Copy positions and bounds, the added points share the bounds of the endpoints
+  for (Eigen::Index i = 0; i < num_trajectory_points; i++)
   {
-    // Insert 2nd and 2nd-last points
-    // (required to force acceleration to specified values at endpoints)
-    for (unsigned int j = 0; j < trajectory.dof(); j++)
-    {
-      double value = 0.9 * t2[j].positions_[0] + 0.1 * t2[j].positions_[1];
-      t2[j].positions_.insert(t2[j].positions_.begin() + 1, value);
-
-      value = t2[j].velocities_.front();
-      t2[j].velocities_.insert(t2[j].velocities_.begin() + 1, value);
-
-      value = t2[j].accelerations_.front();
-      t2[j].accelerations_.insert(t2[j].accelerations_.begin() + 1, value);
-
-      value = t2[j].max_velocity_.front();
-      t2[j].max_velocity_.insert(t2[j].max_velocity_.begin() + 1, value);
-
-      value = t2[j].min_velocity_.front();
-      t2[j].min_velocity_.insert(t2[j].min_velocity_.begin() + 1, value);
-
-      value = t2[j].max_acceleration_.front();
-      t2[j].max_acceleration_.insert(t2[j].max_acceleration_.begin() + 1, value);
-
-      value = t2[j].min_acceleration_.front();
-      t2[j].min_acceleration_.insert(t2[j].min_acceleration_.begin() + 1, value);
-    }
-    num_points++;
-
-    for (unsigned int j = 0; j < trajectory.dof(); j++)
-    {
-      double value = 0.1 * t2[j].positions_[num_points - 2] + 0.9 * t2[j].positions_[num_points - 1];
-      t2[j].positions_.insert(t2[j].positions_.end() - 1, value);
-
-      value = t2[j].velocities_.back();
-      t2[j].velocities_.insert(t2[j].velocities_.end() - 1, value);
-
-      value = t2[j].accelerations_.back();
-      t2[j].accelerations_.insert(t2[j].accelerations_.end() - 1, value);
-
-      value = t2[j].max_velocity_.back();
-      t2[j].max_velocity_.insert(t2[j].max_velocity_.end() - 1, value);
-
-      value = t2[j].min_velocity_.back();
-      t2[j].min_velocity_.insert(t2[j].min_velocity_.end() - 1, value);
-
-      value = t2[j].max_acceleration_.back();
-      t2[j].max_acceleration_.insert(t2[j].max_acceleration_.end() - 1, value);
+    const Eigen::Index col = (i == 0) ? 0 : i + offset + ((add_points && i == num_trajectory_points - 1) ? 1 : 0);
+    t2.positions.col(col) = trajectory.getPosition(i);
+    t2.velocity_scaling_factor[col] = velocity_scaling_factor[i];
+    t2.acceleration_scaling_factor[col] = acceleration_scaling_factor[i];
+  }
 
-      value = t2[j].min_acceleration_.back();
-      t2[j].min_acceleration_.insert(t2[j].min_acceleration_.end() - 1, value);
-    }
-    num_points++;
+  if (add_points)
+  {
+    t2.positions.col(1) = 0.9 * t2.positions.col(0) + 0.1 * trajectory.getPosition(1);
+    t2.positions.col(num_points - 2) = 0.1 * t2.positions.col(num_points - 3) + 0.9 * t2.positions.col(num_points - 1);
+    t2.velocity_scaling_factor[1] = t2.velocity_scaling_factor[0];
+    t2.velocity_scaling_factor[num_points - 2] = t2.velocity_scaling_factor[num_points - 1];
+    t2.acceleration_scaling_factor[1] = t2.acceleration_scaling_factor[0];
+    t2.acceleration_scaling_factor[num_points - 2] = t2.acceleration_scaling_factor[num_points - 1];
   }
 
+  // Copy initial/final velocities and accelerations if specified
+  const Eigen::Ref<const Eigen::VectorXd> start_vel = trajectory.getVelocity(0);
+  const Eigen::Ref<const Eigen::VectorXd> last_vel = trajectory.getVelocity(num_trajectory_points - 1);
+  const Eigen::Ref<const Eigen::VectorXd> start_acc = trajectory.getAcceleration(0);
+  const Eigen::Ref<const Eigen::VectorXd> last_acc = trajectory.getAcceleration(num_trajectory_points - 1);
+  if (start_vel.size() > 0)
+    t2.velocities.col(0) = start_vel;
+  if (last_vel.size() > 0)
+    t2.velocities.col(num_points - 1) = last_vel;
+  if (start_acc.size() > 0)
+    t2.initial_acceleration = start_acc;
+  if (last_acc.size() > 0)
+    t2.final_acceleration = last_acc;
+  t2.accelerations.col(0) = t2.initial_acceleration;
+  t2.accelerations.col(num_points - 1) = t2.final_acceleration;
+
   // Error check
   if (num_points < 4)
   {
@@ -366,35 +283,40 @@ bool IterativeSplineParameterization::compute(
                             num_points);
     return false;
   }
-  for (std::size_t j = 0; j < static_cast<std::size_t>(trajectory.dof()); j++)
+  for (Eigen::Index j = 0; j < num_joints; j++)
   {
-    if (t2[j].velocities_[0] > t2[j].max_velocity_[0] || t2[j].velocities_[0] < t2[j].min_velocity_[0])
+    const double initial_max_velocity = t2.max_velocity[j] * t2.velocity_scaling_factor[0];
+    const double final_max_velocity = t2.max_velocity[j] * t2.velocity_scaling_factor[num_points - 1];
+    const double initial_max_acceleration = t2.max_acceleration[j] * t2.acceleration_scaling_factor[0];
+    const double final_max_acceleration = t2.max_acceleration[j] * t2.acceleration_scaling_factor[num_points - 1];
+
+    if (t2.velocities(j, 0) > initial_max_velocity || t2.velocities(j, 0) < -initial_max_velocity)
     {
       CONSOLE_BRIDGE_logError("iterative_spline_parameterization: Initial velocity %f out of bounds.",
-                              t2[j].velocities_[0]);
+                              t2.velocities(j, 0));
       return false;
     }
 
-    if (t2[j].velocities_[num_points - 1] > t2[j].max_velocity_[num_points - 1] ||
-        t2[j].velocities_[num_points - 1] < t2[j].min_velocity_[num_points - 1])
+    if (t2.velocities(j, num_points - 1) > final_max_velocity ||
+        t2.velocities(j, num_points - 1) < -final_max_velocity)
     {
       CONSOLE_BRIDGE_logError("iterative_spline_parameterization: Final velocity %f out of bounds.",
-                              t2[j].velocities_[num_points - 1]);
+                              t2.velocities(j, num_points - 1));
       return false;
     }
 
-    if (t2[j].accelerations_[0] > t2[j].max_acceleration_[0] || t2[j].accelerations_[0] < t2[j].min_acceleration_[0])
+    if (t2.accelerations(j, 0) > initial_max_acceleration || t2.accelerations(j, 0) < -initial_max_acceleration)
     {
       CONSOLE_BRIDGE_logError("iterative_spline_parameterization: Initial acceleration %f out of bounds\n",
-                              t2[j].accelerations_[0]);
+                              t2.accelerations(j, 0));
       return false;
     }
 
-    if (t2[j].accelerations_[num_points - 1] > t2[j].max_acceleration_[num_points - 1] ||
-        t2[j].accelerations_[num_points - 1] < t2[j].min_acceleration_[num_points - 1])
+    if (t2.accelerations(j, num_points - 1) > final_max_acceleration ||
+        t2.accelerations(j, num_points - 1) < -final_max_acceleration)
     {
       CONSOLE_BRIDGE_logError("iterative_spline_parameterization: Final acceleration %f out of bounds\n",
-                              t2[j].accelerations_[num_points - 1]);
+                              t2.accelerations(j, num_points - 1));
       return false;
     }
   }
@@ -402,82 +324,54 @@ bool IterativeSplineParameterization::compute(
   // Initialize times
   // start with valid velocities, then expand intervals
   // epsilon to prevent divide-by-zero
-  std::vector<double> time_diff(static_cast<std::size_t>(num_points - 1), std::numeric_limits<double>::epsilon());
-  for (unsigned int j = 0; j < trajectory.dof(); j++)
-    init_times(static_cast<long>(num_points),
-               time_diff.data(),
-               t2[j].positions_.data(),
-               t2[j].max_velocity_.data(),
-               t2[j].min_velocity_.data());
+  Eigen::VectorXd time_diff = Eigen::VectorXd::Constant(num_points - 1, std::numeric_limits<double>::epsilon());
+  init_times(t2, time_diff);
 
   // Stretch intervals until close to the bounds
+  Eigen::VectorXd time_factor(num_points - 1);
   while (true)
   {
-    int loop = 0;
+    bool loop = false;
 
     // Calculate the interval stretches due to acceleration
-    std::vector<double> time_factor(static_cast<std::size_t>(num_points - 1), 1.00);
-    for (unsigned int j = 0; j < trajectory.dof(); j++)
-    {
-      // Move points to satisfy initial/final acceleration
-      if (add_points)
-      {
-        adjust_two_positions(static_cast<int>(num_points),
-                             time_diff.data(),
-                             t2[j].positions_.data(),
-                             t2[j].velocities_.data(),
-                             t2[j].accelerations_.data(),
-                             t2[j].initial_acceleration_,
-                             t2[j].final_acceleration_);
-      }
+    time_factor.setOnes();
 
-      fit_cubic_spline(static_cast<int>(num_points),
-                       time_diff.data(),
-                       t2[j].positions_.data(),
-                       t2[j].velocities_.data(),
-                       t2[j].accelerations_.data());
-      for (unsigned i = 0; i < num_points; i++)
-      {
-        const double acc = t2[j].accelerations_[i];
-        double atfactor = 1.0;
-        if (acc > t2[j].max_acceleration_[i])
-          atfactor = sqrt(acc / t2[j].max_acceleration_[i]);
-        if (acc < t2[j].min_acceleration_[i])
-          atfactor = sqrt(acc / t2[j].min_acceleration_[i]);
-        if (atfactor > 1.01)  // within 1%
-          loop = 1;
-        atfactor = (atfactor - 1.0) / 16.0 + 1.0;  // 1/16th
-        if (i > 0)
-          time_factor[i - 1] = std::max(time_factor[i - 1], atfactor);
-        if (i < num_points - 1)
-          time_factor[i] = std::max(time_factor[i], atfactor);
-      }
+    // Move points to satisfy initial/final acceleration
+    if (add_points)
+      adjust_two_positions(t2, time_diff);
+
+    fit_cubic_spline(t2, time_diff);
+    for (Eigen::Index i = 0; i < num_points; i++)
+    {
+      const auto acc = t2.accelerations.col(i).array();
+      const auto max_acc = t2.max_acceleration.array() * t2.acceleration_scaling_factor[i];
+      double atfactor = (acc > max_acc)
+                            .select((acc / max_acc).sqrt(), (acc < -max_acc).select((acc / -max_acc).sqrt(), 1.0))
+                            .maxCoeff();
+      if (atfactor > 1.01)  // within 1%
+        loop = true;
+      atfactor = (atfactor - 1.0) / 16.0 + 1.0;  // 1/16th
+      if (i > 0)
+        time_factor[i - 1] = std::max(time_factor[i - 1], atfactor);
+      if (i < num_points - 1)
+        time_factor[i] = std::max(time_factor[i], atfactor);
     }
 
-    if (loop == 0)
+    if (!loop)
       break;  // finished
 
     // Stretch
-    for (unsigned i = 0; i < num_points - 1; i++)
-      time_diff[i] *= time_factor[i];
+    time_diff.array() *= time_factor.array();
   }
 
   // Final adjustment forces the trajectory within bounds
-  globalAdjustment(t2, trajectory.dof(), static_cast<long>(num_points), time_diff);
+  globalAdjustment(t2, time_diff);
 
-  // Convert back to JointTrajectory form
+  // Convert back to TrajectoryContainer form
   double time = 0;
   Eigen::Index idx = 0;
-  for (unsigned int i = 0; i < num_points; i++)
+  for (Eigen::Index i = 0; i < num_points; i++)
   {
-    Eigen::VectorXd uv(trajectory.dof());
-    Eigen::VectorXd ua(trajectory.dof());
-    for (unsigned int j = 0; j < trajectory.dof(); j++)
-    {
-      uv[j] = t2[j].velocities_[i];
-      ua[j] = t2[j].accelerations_[i];
-    }
-
     // Calculate time from start
     if (i > 0)
       time = time + time_diff[i - 1];
@@ -489,7 +383,7 @@ bool IterativeSplineParameterization::compute(
       continue;
     }
 
-    trajectory.setData(idx++, uv, ua, time);
+    trajectory.setData(idx++, t2.velocities.col(i), t2.accelerations.col(i), time);
   }
 
   assert(trajectory.isTimeStrictlyIncreasing());
@@ -521,50 +415,52 @@ bool IterativeSplineParameterization::compute(
   using the tridiagonal algorithm.
   There is a forward propogation pass followed by a backsubstitution pass.
 
-  n is the number of points
+  The matrix only depends on the time intervals, so the coefficients c of the forward pass are shared by all joints
+  and each joint's right hand side d is a row of a column operation.
+
   dt contains the time difference between each point (size=n-1)
-  x  contains the positions                          (size=n)
-  x1 contains the 1st derivative (velocities)        (size=n)
-     x1[0] and x1[n-1] MUST be specified.
-  x2 contains the 2nd derivative (accelerations)     (size=n)
-  x1 and x2 are filled in by the algorithm.
+  positions contains the positions                   (size=dof x n)
+  velocities contains the 1st derivative             (size=dof x n)
+     the first and last columns MUST be specified.
+  accelerations contains the 2nd derivative          (size=dof x n)
+  velocities and accelerations are filled in by the algorithm.
 */
 // NOLINTNEXTLINE
-static void fit_cubic_spline(const long n, const double dt[], const double x[], double x1[], double x2[])
+static void fit_cubic_spline(MultiJointTrajectory& t2, const Eigen::VectorXd& dt)
 {
-  long i{ 0 };
-  const double x1_i = x1[0], x1_f = x1[n - 1];
+  const Eigen::Index n = t2.numPoints();
+  const Eigen::MatrixXd& x = t2.positions;
+  Eigen::MatrixXd& x1 = t2.velocities;
+  Eigen::MatrixXd& x2 = t2.accelerations;
+  Eigen::VectorXd& c = t2.c;
 
   // Tridiagonal alg - forward sweep
-  // x1 and x2 used to store the temporary coefficients c and d
+  // x2 used to store the temporary coefficients d
   // (will get overwritten during backsubstitution)
-  double *c = x1, *d = x2;
+  Eigen::MatrixXd& d = x2;
   c[0] = 0.5;
-  d[0] = 3.0 * ((x[1] - x[0]) / dt[0] - x1_i) / dt[0];
-  for (i = 1; i <= n - 2; i++)
+  d.col(0) = 3.0 * ((x.col(1) - x.col(0)) / dt[0] - x1.col(0)) / dt[0];
+  for (Eigen::Index i = 1; i <= n - 2; i++)
   {
     const double dt2 = dt[i - 1] + dt[i];
     const double a = dt[i - 1] / dt2;
     const double denom = 2.0 - a * c[i - 1];
     c[i] = (1.0 - a) / denom;
-    d[i] = 6.0 * ((x[i + 1] - x[i]) / dt[i] - (x[i] - x[i - 1]) / dt[i - 1]) / dt2;
-    d[i] = (d[i] - a * d[i - 1]) / denom;
+    d.col(i) =
+        (6.0 * ((x.col(i + 1) - x.col(i)) / dt[i] - (x.col(i) - x.col(i - 1)) / dt[i - 1]) / dt2 - a * d.col(i - 1)) /
+        denom;
   }
   const double denom = dt[n - 2] * (2.0 - c[n - 2]);
-  d[n - 1] = 6.0 * (x1_f - (x[n - 1] - x[n - 2]) / dt[n - 2]);
-  d[n - 1] = (d[n - 1] - dt[n - 2] * d[n - 2]) / denom;
+  d.col(n - 1) = (6.0 * (x1.col(n - 1) - (x.col(n - 1) - x.col(n - 2)) / dt[n - 2]) - dt[n - 2] * d.col(n - 2)) / denom;
 
   // Tridiagonal alg - backsubstitution sweep
   // 2nd derivative
-  x2[n - 1] = d[n - 1];
-  for (i = n - 2; i >= 0; i--)
-    x2[i] = d[i] - c[i] * x2[i + 1];
-
-  // 1st derivative
-  x1[0] = x1_i;
-  for (i = 1; i < n - 1; i++)
-    x1[i] = (x[i + 1] - x[i]) / dt[i] - (2 * x2[i] + x2[i + 1]) * dt[i] / 6.0;
-  x1[n - 1] = x1_f;
+  for (Eigen::Index i = n - 2; i >= 0; i--)
+    x2.col(i) = d.col(i) - c[i] * x2.col(i + 1);
+
+  // 1st derivative, the first and last are the specified values
+  for (Eigen::Index i = 1; i < n - 1; i++)
+    x1.col(i) = (x.col(i + 1) - x.col(i)) / dt[i] - (2 * x2.col(i) + x2.col(i + 1)) * dt[i] / 6.0;
 }
 
 /*
@@ -575,35 +471,36 @@ static void fit_cubic_spline(const long n, const double dt[], const double x[],
 
   x2_i and x2_f are the (initial and final) 2nd derivative at 0 and N-1
 */
-
-static void adjust_two_positions(const long n,
-                                 const double dt[],  // NOLINT
-                                 double x[],         // NOLINT
-                                 double x1[],        // NOLINT
-                                 double x2[],        // NOLINT
-                                 const double x2_i,
-                                 const double x2_f)
+static void adjust_two_positions(MultiJointTrajectory& t2, const Eigen::VectorXd& dt)
 {
-  x[1] = x[0];
-  x[n - 2] = x[n - 3];
-  fit_cubic_spline(n, dt, x, x1, x2);
-  double a0 = x2[0];
-  double b0 = x2[n - 1];
-
-  x[1] = x[2];
-  x[n - 2] = x[n - 1];
-  fit_cubic_spline(n, dt, x, x1, x2);
-  double a2 = x2[0];
-  double b2 = x2[n - 1];
-
-  // we can solve this with linear equation (use two-point form)
-  // if (a2 != a0)
-  if (!tesseract_common::almostEqualRelativeAndAbs(a2, a0, 1e-5))
-    x[1] = x[0] + ((x[2] - x[0]) / (a2 - a0)) * (x2_i - a0);
-
-  // if (b2 != b0)
-  if (!tesseract_common::almostEqualRelativeAndAbs(b2, b0, 1e-5))
-    x[n - 2] = x[n - 3] + ((x[n - 1] - x[n - 3]) / (b2 - b0)) * (x2_f - b0);
+  const Eigen::Index n = t2.numPoints();
+  Eigen::MatrixXd& x = t2.positions;
+  const Eigen::MatrixXd& x2 = t2.accelerations;
+
+  x.col(1) = x.col(0);
+  x.col(n - 2) = x.col(n - 3);
+  fit_cubic_spline(t2, dt);
+  const Eigen::VectorXd a0 = x2.col(0);
+  const Eigen::VectorXd b0 = x2.col(n - 1);
+
+  x.col(1) = x.col(2);
+  x.col(n - 2) = x.col(n - 1);
+  fit_cubic_spline(t2, dt);
+
+  for (Eigen::Index j = 0; j < x.rows(); j++)
+  {
+    const double a2 = x2(j, 0);
+    const double b2 = x2(j, n - 1);
+
+    // we can solve this with linear equation (use two-point form)
+    // if (a2 != a0)
+    if (!tesseract_common::almostEqualRelativeAndAbs(a2, a0[j], 1e-5))
+      x(j, 1) = x(j, 0) + ((x(j, 2) - x(j, 0)) / (a2 - a0[j])) * (t2.initial_acceleration[j] - a0[j]);
+
+    // if (b2 != b0)
+    if (!tesseract_common::almostEqualRelativeAndAbs(b2, b0[j], 1e-5))
+      x(j, n - 2) = x(j, n - 3) + ((x(j, n - 1) - x(j, n - 3)) / (b2 - b0[j])) * (t2.final_acceleration[j] - b0[j]);
+  }
 }
 
 /*
@@ -611,16 +508,14 @@ static void adjust_two_positions(const long n,
   Increase a segment's time interval if the current time isn't long enough.
 */
 // NOLINTNEXTLINE
-static void init_times(long n, double dt[], const double x[], const double max_velocity[], double min_velocity[])
+static void init_times(const MultiJointTrajectory& t2, Eigen::VectorXd& dt)
 {
-  for (long i = 0; i < n - 1; i++)
+  const Eigen::MatrixXd& x = t2.positions;
+  for (Eigen::Index i = 0; i < t2.numPoints() - 1; i++)
   {
-    double time{ NAN };
-    double dx = x[i + 1] - x[i];
-    if (dx >= 0.0)
-      time = (dx / max_velocity[i]);
-    else
-      time = (dx / min_velocity[i]);
+    const auto dx = (x.col(i + 1) - x.col(i)).array();
+    const auto max_velocity = t2.max_velocity.array() * t2.velocity_scaling_factor[i];
+    double time = (dx >= 0.0).select(dx / max_velocity, dx / -max_velocity).maxCoeff();
     time += std::numeric_limits<double>::epsilon();  // prevent divide-by-zero
 
     if (dt[i] < time)
@@ -696,77 +591,37 @@ static void init_times(long n, double dt[], const double x[], const double max_v
 // to force within bounds.
 // Assumes that the spline is already fit
 // (fit_cubic_spline must have been called before this).
-static double global_adjustment_factor(long n,
-                                       double /*dt*/[],                  // NOLINT
-                                       const double /*x*/[],             // NOLINT
-                                       double x1[],                      // NOLINT
-                                       double x2[],                      // NOLINT
-                                       const double max_velocity[],      // NOLINT
-                                       const double min_velocity[],      // NOLINT
-                                       const double max_acceleration[],  // NOLINT
-                                       const double min_acceleration[])  // NOLINT
+static double global_adjustment_factor(const MultiJointTrajectory& t2)
 {
   double tfactor2 = 1.00;
 
-  // fit_cubic_spline(n, dt, x, x1, x2);
+  // fit_cubic_spline(t2, dt);
 
-  for (long i = 0; i < n; i++)
+  for (Eigen::Index i = 0; i < t2.numPoints(); i++)
   {
-    double tfactor{ NAN };
-    tfactor = x1[i] / max_velocity[i];
-    if (tfactor2 < tfactor)
-      tfactor2 = tfactor;
-    tfactor = x1[i] / min_velocity[i];
-    if (tfactor2 < tfactor)
-      tfactor2 = tfactor;
-
-    if (x2[i] >= 0)
-    {
-      tfactor = sqrt(fabs(x2[i] / max_acceleration[i]));
-      if (tfactor2 < tfactor)
-        tfactor2 = tfactor;
-    }
-    else
-    {
-      tfactor = sqrt(fabs(x2[i] / min_acceleration[i]));
-      if (tfactor2 < tfactor)
-        tfactor2 = tfactor;
-    }
+    const auto x1 = t2.velocities.col(i).array();
+    const auto x2 = t2.accelerations.col(i).array();
+    const auto max_velocity = t2.max_velocity.array() * t2.velocity_scaling_factor[i];
+    const auto max_acceleration = t2.max_acceleration.array() * t2.acceleration_scaling_factor[i];
+
+    tfactor2 = std::max(tfactor2, (x1 / max_velocity).maxCoeff());
+    tfactor2 = std::max(tfactor2, (x1 / -max_velocity).maxCoeff());
+    tfactor2 = std::max(
+        tfactor2,
+        (x2 >= 0).select((x2 / max_acceleration).abs().sqrt(), (x2 / -max_acceleration).abs().sqrt()).maxCoeff());
   }
 
   return tfactor2;
 }
 
 // Expands the entire trajectory to fit exactly within bounds
-void globalAdjustment(std::vector<SingleJointTrajectory>& t2,
-                      long num_joints,
-                      long num_points,
-                      std::vector<double>& time_diff)
+static void globalAdjustment(MultiJointTrajectory& t2, Eigen::VectorXd& dt)
 {
-  double gtfactor = 1.0;
-  for (std::size_t j = 0; j < static_cast<std::size_t>(num_joints); j++)
-  {
-    double tfactor = global_adjustment_factor(num_points,
-                                              time_diff.data(),
-                                              t2[j].positions_.data(),
-                                              t2[j].velocities_.data(),
-                                              t2[j].accelerations_.data(),
-                                              t2[j].max_velocity_.data(),
-                                              t2[j].min_velocity_.data(),
-                                              t2[j].max_acceleration_.data(),
-                                              t2[j].min_acceleration_.data());
-    if (tfactor > gtfactor)
-      gtfactor = tfactor;
-  }
+  const double gtfactor = global_adjustment_factor(t2);
 
   // printf("# Global adjustment: %0.4f%%\n", 100.0 * (gtfactor - 1.0));
-  for (std::size_t i = 0; i < static_cast<std::size_t>(num_points - 1); i++)
-    time_diff[i] *= gtfactor;
+  dt *= gtfactor;
 
-  for (std::size_t j = 0; j < static_cast<std::size_t>(num_joints); j++)
-  {
-    fit_cubic_spline(
-        num_points, time_diff.data(), t2[j].positions_.data(), t2[j].velocities_.data(), t2[j].accelerations_.data());
-  }
+  fit_cubic_spline(t2, dt);
 }
 }  // namespace tesseract_planning
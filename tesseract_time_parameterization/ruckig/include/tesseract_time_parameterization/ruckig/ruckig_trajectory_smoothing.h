@@ -50,6 +50,16 @@ public:
   /** @brief Set the max duration extension factor */
   void setMaxDurationExtensionFactor(double max_duration_extension_factor);
 
+  /**
+   * @brief Set if only the waypoints around a waypoint Ruckig fails to reach are stretched
+   * @details When false every waypoint is stretched and smoothing restarts from the first waypoint. When true only the
+   * waypoints within the local stretch window are stretched and smoothing resumes from the first stretched waypoint.
+   */
+  void setLocalStretch(bool local_stretch);
+
+  /** @brief Set the number of waypoints on each side of a failing waypoint which are stretched by a local stretch */
+  void setLocalStretchWindow(long local_stretch_window);
+
   /**
    * @brief Compute the time stamps for a flattened vector of move instruction
    * @param trajectory Flattended vector of move instruction
@@ -121,6 +131,8 @@ public:
 protected:
   double duration_extension_fraction_;
   double max_duration_extension_factor_;
+  bool local_stretch_{ false };
+  long local_stretch_window_{ 3 };
 };
 }  // namespace tesseract_planning
 
@@ -41,7 +41,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_time_parameterization/ruckig/ruckig_trajectory_smoothing.h>
 #include <tesseract_common/kinematic_limits.h>
 
-#include <memory>
+#include <algorithm>
 
 #include <ruckig/input_parameter.hpp>
 #include <ruckig/ruckig.hpp>
@@ -66,6 +66,13 @@ void RuckigTrajectorySmoothing::setMaxDurationExtensionFactor(double max_duratio
   max_duration_extension_factor_ = max_duration_extension_factor;
 }
 
+void RuckigTrajectorySmoothing::setLocalStretch(bool local_stretch) { local_stretch_ = local_stretch; }
+
+void RuckigTrajectorySmoothing::setLocalStretchWindow(long local_stretch_window)
+{
+  local_stretch_window_ = local_stretch_window;
+}
+
 bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
                                         const double& max_velocity,
                                         const double& max_acceleration,
@@ -151,9 +158,9 @@ bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
   //  input.max_jerk = {4.0, 3.0, 2.0};
 
   {  // Set start position
-    const Eigen::VectorXd& position = trajectory.getPosition(static_cast<Eigen::Index>(0));
-    const Eigen::VectorXd& velocity = trajectory.getVelocity(static_cast<Eigen::Index>(0));
-    const Eigen::VectorXd& accleration = trajectory.getAcceleration(static_cast<Eigen::Index>(0));
+    const Eigen::Ref<const Eigen::VectorXd> position = trajectory.getPosition(static_cast<Eigen::Index>(0));
+    const Eigen::Ref<const Eigen::VectorXd> velocity = trajectory.getVelocity(static_cast<Eigen::Index>(0));
+    const Eigen::Ref<const Eigen::VectorXd> accleration = trajectory.getAcceleration(static_cast<Eigen::Index>(0));
 
     input.current_position = std::vector<double>(position.data(), position.data() + position.rows());
 
@@ -165,9 +172,10 @@ bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
   }
 
   {  // Set end position
-    const Eigen::VectorXd& position = trajectory.getPosition(static_cast<Eigen::Index>(end_index));
-    const Eigen::VectorXd& velocity = trajectory.getVelocity(static_cast<Eigen::Index>(end_index));
-    const Eigen::VectorXd& accleration = trajectory.getAcceleration(static_cast<Eigen::Index>(end_index));
+    const Eigen::Ref<const Eigen::VectorXd> position = trajectory.getPosition(static_cast<Eigen::Index>(end_index));
+    const Eigen::Ref<const Eigen::VectorXd> velocity = trajectory.getVelocity(static_cast<Eigen::Index>(end_index));
+    const Eigen::Ref<const Eigen::VectorXd> accleration =
+        trajectory.getAcceleration(static_cast<Eigen::Index>(end_index));
 
     input.target_position = std::vector<double>(position.data(), position.data() + position.rows());
 
@@ -193,7 +201,39 @@ bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
 }
 #else
 
-void getNextRuckigInput(ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
+/**
+ * @brief The Ruckig solver with its input and output
+ * @details For a fixed number of DOFs Ruckig stores its vectors in std::array, so the solver does not allocate
+ */
+template <std::size_t DOFs>
+struct RuckigSolver
+{
+  RuckigSolver(std::size_t /*dof*/, double delta_time) : otg(delta_time) {}
+
+  ruckig::Ruckig<DOFs> otg;
+  ruckig::InputParameter<DOFs> input;
+  ruckig::OutputParameter<DOFs> output;
+};
+
+template <>
+struct RuckigSolver<ruckig::DynamicDOFs>
+{
+  RuckigSolver(std::size_t dof, double delta_time) : otg(dof, delta_time), input(dof), output(dof) {}
+
+  ruckig::Ruckig<ruckig::DynamicDOFs> otg;
+  ruckig::InputParameter<ruckig::DynamicDOFs> input;
+  ruckig::OutputParameter<ruckig::DynamicDOFs> output;
+};
+
+/** @brief Copy into a Ruckig vector, which is already sized to the number of DOFs */
+template <typename RuckigVector>
+void copyToRuckig(RuckigVector& ruckig_vector, const Eigen::Ref<const Eigen::VectorXd>& vector)
+{
+  Eigen::Map<Eigen::VectorXd>(ruckig_vector.data(), vector.rows()) = vector;
+}
+
+template <std::size_t DOFs>
+void getNextRuckigInput(ruckig::InputParameter<DOFs>& ruckig_input,
                         TrajectoryContainer& trajectory,
                         Eigen::Index current_index,
                         Eigen::Index next_index,
@@ -201,47 +241,44 @@ void getNextRuckigInput(ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_inpu
                         const Eigen::Ref<const Eigen::VectorXd>& max_acceleration)
 {
   // Set current state
-  const auto& current_position = trajectory.getPosition(current_index);
-  Eigen::VectorXd& current_velocity = trajectory.getVelocity(current_index);
-  Eigen::VectorXd& current_accleration = trajectory.getAcceleration(current_index);
+  const Eigen::Ref<const Eigen::VectorXd> current_position = trajectory.getPosition(current_index);
+  Eigen::Ref<Eigen::VectorXd> current_velocity = trajectory.getVelocity(current_index);
+  Eigen::Ref<Eigen::VectorXd> current_accleration = trajectory.getAcceleration(current_index);
 
   // clamp due to small numerical errors
   current_velocity = current_velocity.array().min(max_velocity.array()).max((-1.0 * max_velocity).array());
   current_accleration =
       current_accleration.array().min(max_acceleration.array()).max((-1.0 * max_acceleration).array());
 
-  const Eigen::VectorXd& next_position = trajectory.getPosition(next_index);
-  Eigen::VectorXd& next_velocity = trajectory.getVelocity(next_index);
-  Eigen::VectorXd& next_accleration = trajectory.getAcceleration(next_index);
+  const Eigen::Ref<const Eigen::VectorXd> next_position = trajectory.getPosition(next_index);
+  Eigen::Ref<Eigen::VectorXd> next_velocity = trajectory.getVelocity(next_index);
+  Eigen::Ref<Eigen::VectorXd> next_accleration = trajectory.getAcceleration(next_index);
 
   // clamp due to small numerical errors
   next_velocity = next_velocity.array().min(max_velocity.array()).max((-1.0 * max_velocity).array());
   next_accleration = next_accleration.array().min(max_acceleration.array()).max((-1.0 * max_acceleration).array());
 
   // Update input
-  ruckig_input.current_position =
-      std::vector<double>(current_position.data(), current_position.data() + current_position.rows());
-  ruckig_input.current_velocity =
-      std::vector<double>(current_velocity.data(), current_velocity.data() + current_velocity.rows());
-  ruckig_input.current_acceleration =
-      std::vector<double>(current_accleration.data(), current_accleration.data() + current_accleration.rows());
-
-  ruckig_input.target_position = std::vector<double>(next_position.data(), next_position.data() + next_position.rows());
-  ruckig_input.target_velocity = std::vector<double>(next_velocity.data(), next_velocity.data() + next_velocity.rows());
-  ruckig_input.target_acceleration =
-      std::vector<double>(next_accleration.data(), next_accleration.data() + next_accleration.rows());
+  copyToRuckig(ruckig_input.current_position, current_position);
+  copyToRuckig(ruckig_input.current_velocity, current_velocity);
+  copyToRuckig(ruckig_input.current_acceleration, current_accleration);
+
+  copyToRuckig(ruckig_input.target_position, next_position);
+  copyToRuckig(ruckig_input.target_velocity, next_velocity);
+  copyToRuckig(ruckig_input.target_acceleration, next_accleration);
 }
 
-void initializeRuckigState(ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_input,
-                           ruckig::OutputParameter<ruckig::DynamicDOFs>& ruckig_output,
+template <std::size_t DOFs>
+void initializeRuckigState(ruckig::InputParameter<DOFs>& ruckig_input,
+                           ruckig::OutputParameter<DOFs>& ruckig_output,
                            TrajectoryContainer& trajectory,
                            const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
                            const Eigen::Ref<const Eigen::VectorXd>& max_acceleration)
 {
   // Set current state
-  const Eigen::VectorXd& current_position = trajectory.getPosition(0);
-  Eigen::VectorXd& current_velocity = trajectory.getVelocity(0);
-  Eigen::VectorXd& current_accleration = trajectory.getAcceleration(0);
+  const Eigen::Ref<const Eigen::VectorXd> current_position = trajectory.getPosition(0);
+  Eigen::Ref<Eigen::VectorXd> current_velocity = trajectory.getVelocity(0);
+  Eigen::Ref<Eigen::VectorXd> current_accleration = trajectory.getAcceleration(0);
 
   // clamp due to small numerical errors
   current_velocity = current_velocity.array().min(max_velocity.array()).max((-1.0 * max_velocity).array());
@@ -249,72 +286,44 @@ void initializeRuckigState(ruckig::InputParameter<ruckig::DynamicDOFs>& ruckig_i
       current_accleration.array().min(max_acceleration.array()).max((-1.0 * max_acceleration).array());
 
   // Intialize Ruckig state
-  ruckig_input.current_position =
-      std::vector<double>(current_position.data(), current_position.data() + current_position.rows());
-  ruckig_input.current_velocity =
-      std::vector<double>(current_velocity.data(), current_velocity.data() + current_velocity.rows());
-  ruckig_input.current_acceleration =
-      std::vector<double>(current_accleration.data(), current_accleration.data() + current_accleration.rows());
+  copyToRuckig(ruckig_input.current_position, current_position);
+  copyToRuckig(ruckig_input.current_velocity, current_velocity);
+  copyToRuckig(ruckig_input.current_acceleration, current_accleration);
 
   ruckig_output.new_position = ruckig_input.current_position;
   ruckig_output.new_velocity = ruckig_input.current_velocity;
   ruckig_output.new_acceleration = ruckig_input.current_acceleration;
 }
 
-bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
-                                        const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
-                                        const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
-                                        const Eigen::Ref<const Eigen::VectorXd>& max_jerk,
-                                        const Eigen::Ref<const Eigen::VectorXd>& /*max_velocity_scaling_factors*/,
-                                        const Eigen::Ref<const Eigen::VectorXd>& /*max_acceleration_scaling_factors*/,
-                                        const Eigen::Ref<const Eigen::VectorXd>& /*max_jerk_scaling_factors*/) const
+/**
+ * @brief Smooth the trajectory, stretching the duration of waypoints Ruckig is unable to reach
+ * @details With a global stretch every waypoint is stretched and smoothing restarts from the first waypoint. With a
+ * local stretch only the waypoints within local_stretch_window of the failing waypoint are stretched and smoothing
+ * resumes from the first stretched waypoint. The solver is reused for every attempt.
+ */
+template <std::size_t DOFs>
+bool smoothTrajectory(TrajectoryContainer& trajectory,
+                      const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
+                      const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
+                      const Eigen::Ref<const Eigen::VectorXd>& max_jerk,
+                      double duration_extension_fraction,
+                      double max_duration_extension_factor,
+                      bool local_stretch,
+                      long local_stretch_window)
 {
-  if (trajectory.size() < 2)
-    return true;
-
-  if (max_velocity.size() != trajectory.dof() || max_acceleration.size() != trajectory.dof())
-    return false;
-
-  // Create input parameters
   const auto dof = static_cast<std::size_t>(trajectory.dof());
-  const auto num_waypoints = static_cast<std::size_t>(trajectory.size());
-  ruckig::InputParameter<ruckig::DynamicDOFs> ruckig_input{ dof };
-  ruckig::OutputParameter<ruckig::DynamicDOFs> ruckig_output{ dof };
-
-  const Eigen::VectorXd max_scaled_velocity =
-      max_velocity;  // (max_velocity.array() * max_velocity_scaling_factors.array()).transpose();
-  ruckig_input.max_velocity =
-      std::vector<double>(max_scaled_velocity.data(), max_scaled_velocity.data() + max_scaled_velocity.rows());
+  const Eigen::Index num_waypoints = trajectory.size();
 
-  const Eigen::VectorXd max_scaled_acceleration =
-      max_acceleration;  // max_acceleration.array() * max_acceleration_scaling_factors.array();
-  ruckig_input.max_acceleration = std::vector<double>(max_scaled_acceleration.data(),
-                                                      max_scaled_acceleration.data() + max_scaled_acceleration.rows());
+  // Get original data
+  Eigen::MatrixXd original_velocities(trajectory.dof(), num_waypoints);
+  Eigen::VectorXd original_duration_from_previous(num_waypoints);
 
-  if (!(max_jerk.array() < 0).all())
-  {
-    const Eigen::VectorXd max_scaled_jerk = max_jerk;  // max_jerk.array() * max_jerk_scaling_factors.array();
-    ruckig_input.max_jerk =
-        std::vector<double>(max_scaled_jerk.data(), max_scaled_jerk.data() + max_scaled_jerk.rows());
-  }
-
-  // Get origina data
-  std::vector<Eigen::VectorXd> original_velocities;
-  std::vector<Eigen::VectorXd> original_accelerations;
-  Eigen::VectorXd original_duration_from_previous;
-
-  original_velocities.reserve(num_waypoints);
-  original_accelerations.reserve(num_waypoints);
-  original_duration_from_previous.resize(trajectory.size());
-
-  original_velocities.push_back(trajectory.getVelocity(0));
-  original_accelerations.push_back(trajectory.getAcceleration(0));
+  original_velocities.col(0) = trajectory.getVelocity(0);
   original_duration_from_previous[0] = trajectory.getTimeFromStart(0);
   double previous_time = original_duration_from_previous[0];
-  for (Eigen::Index i = 1; i < trajectory.size(); ++i)
+  for (Eigen::Index i = 1; i < num_waypoints; ++i)
   {
-    original_velocities.push_back(trajectory.getVelocity(i));
-    original_accelerations.push_back(trajectory.getAcceleration(i));
+    original_velocities.col(i) = trajectory.getVelocity(i);
     const double current_time = trajectory.getTimeFromStart(i);
     original_duration_from_previous(i) = current_time - previous_time;
     previous_time = current_time;
@@ -322,66 +331,146 @@ bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
 
   // Initialize Ruckig
   double timestep = original_duration_from_previous.sum() / static_cast<double>(num_waypoints - 1);
-  auto ruckig_ptr = std::make_unique<ruckig::Ruckig<ruckig::DynamicDOFs> >(dof, timestep);
-  initializeRuckigState(ruckig_input, ruckig_output, trajectory, max_scaled_velocity, max_scaled_acceleration);
+  RuckigSolver<DOFs> solver(dof, timestep);
+  copyToRuckig(solver.input.max_velocity, max_velocity);
+  copyToRuckig(solver.input.max_acceleration, max_acceleration);
+  if (!(max_jerk.array() < 0).all())
+    copyToRuckig(solver.input.max_jerk, max_jerk);
+
+  initializeRuckigState(solver.input, solver.output, trajectory, max_velocity, max_acceleration);
+
+  // The duration extension factor of each waypoint
+  Eigen::VectorXd duration_extension_factors = Eigen::VectorXd::Ones(num_waypoints);
+  Eigen::VectorXd new_duration_from_previous = original_duration_from_previous;
+  Eigen::VectorXd new_velocity(trajectory.dof());
+  Eigen::VectorXd new_acceleration(trajectory.dof());
+  bool stretched = false;
 
   // Smooth trajectory
   ruckig::Result ruckig_result{};
-  double duration_extension_factor = 1;
-  bool smoothing_complete = false;
-  while ((duration_extension_factor < max_duration_extension_factor_) && !smoothing_complete)
+  Eigen::Index waypoint_idx = 0;
+  while (waypoint_idx < num_waypoints - 1)
   {
-    for (Eigen::Index waypoint_idx = 0; waypoint_idx < num_waypoints - 1; ++waypoint_idx)
+    // Get Next Input
+    getNextRuckigInput(solver.input, trajectory, waypoint_idx, waypoint_idx + 1, max_velocity, max_acceleration);
+
+    // Run Ruckig
+    ruckig_result = solver.otg.update(solver.input, solver.output);
+    if (ruckig_result == ruckig::Result::Finished)
     {
-      // Get Next Input
-      getNextRuckigInput(
-          ruckig_input, trajectory, waypoint_idx, waypoint_idx + 1, max_scaled_velocity, max_scaled_acceleration);
+      ++waypoint_idx;
+      continue;
+    }
 
-      // Run Ruckig
-      ruckig_result = ruckig_ptr->update(ruckig_input, ruckig_output);
+    // Extend the duration of the waypoints if Ruckig could not reach the waypoint successfully
+    Eigen::Index first_idx = 1;
+    Eigen::Index last_idx = num_waypoints - 1;
+    if (local_stretch)
+    {
+      first_idx = std::max<Eigen::Index>(1, waypoint_idx + 1 - local_stretch_window);
+      last_idx = std::min<Eigen::Index>(num_waypoints - 1, waypoint_idx + 1 + local_stretch_window);
+    }
 
-      if ((waypoint_idx == num_waypoints - 2) && ruckig_result == ruckig::Result::Finished)
-      {
-        smoothing_complete = true;
-        break;
-      }
+    const Eigen::Index count = last_idx - first_idx + 1;
+    duration_extension_factors.segment(first_idx, count) *= duration_extension_fraction;
+    new_duration_from_previous.segment(first_idx, count) = original_duration_from_previous.segment(first_idx, count);
 
-      // Extend the trajectory duration if Ruckig could not reach the waypoint successfully
-      if (ruckig_result != ruckig::Result::Finished)
+    // re-calculate waypoint velocity and acceleration, the acceleration after the stretched waypoints also changes
+    const Eigen::Index end_idx = std::min<Eigen::Index>(num_waypoints - 1, last_idx + 1);
+    for (Eigen::Index time_stretch_idx = first_idx; time_stretch_idx <= end_idx; ++time_stretch_idx)
+    {
+      if (time_stretch_idx <= last_idx)
       {
-        duration_extension_factor *= duration_extension_fraction_;
-        Eigen::VectorXd new_duration_from_previous = original_duration_from_previous;
-
-        double time_from_start = original_duration_from_previous(0);
-        for (Eigen::Index time_stretch_idx = 1; time_stretch_idx < num_waypoints; ++time_stretch_idx)
-        {
-          double duration_from_previous = duration_extension_factor * original_duration_from_previous(time_stretch_idx);
-          new_duration_from_previous(time_stretch_idx) = duration_from_previous;
-          time_from_start += duration_from_previous;
-
-          // re-calculate waypoint velocity and acceleration
-          timestep = new_duration_from_previous.sum() / static_cast<double>(new_duration_from_previous.rows() - 1);
-          Eigen::VectorXd new_velocity =
-              (1 / duration_extension_factor) * original_velocities[static_cast<std::size_t>(time_stretch_idx)];
-          Eigen::VectorXd new_acceleration = (new_velocity - trajectory.getVelocity(time_stretch_idx - 1)) / timestep;
-          trajectory.setData(time_stretch_idx, new_velocity, new_acceleration, time_from_start);
-        }
-        ruckig_ptr = std::make_unique<ruckig::Ruckig<ruckig::DynamicDOFs> >(dof, timestep);
-        initializeRuckigState(ruckig_input, ruckig_output, trajectory, max_scaled_velocity, max_scaled_acceleration);
-
-        // Begin the while() loop again
-        break;
+        // The timestep only includes the waypoints stretched so far
+        new_duration_from_previous(time_stretch_idx) =
+            duration_extension_factors(time_stretch_idx) * original_duration_from_previous(time_stretch_idx);
+        timestep = new_duration_from_previous.sum() / static_cast<double>(new_duration_from_previous.rows() - 1);
       }
+
+      new_velocity = (1 / duration_extension_factors(time_stretch_idx)) * original_velocities.col(time_stretch_idx);
+      new_acceleration = (new_velocity - trajectory.getVelocity(time_stretch_idx - 1)) / timestep;
+      const double time_from_start = trajectory.getTimeFromStart(time_stretch_idx);
+      trajectory.setData(time_stretch_idx, new_velocity, new_acceleration, time_from_start);
+    }
+    stretched = true;
+
+    if (duration_extension_factors.segment(first_idx, count).maxCoeff() >= max_duration_extension_factor)
+      break;
+
+    // Reuse the solver, resuming from the waypoint before the first stretched waypoint
+    solver.otg.delta_time = timestep;
+    solver.otg.reset();
+    initializeRuckigState(solver.input, solver.output, trajectory, max_velocity, max_acceleration);
+    waypoint_idx = first_idx - 1;
+  }
+
+  // The time from start is only used for the output so it is updated once after smoothing
+  if (stretched)
+  {
+    double time_from_start = new_duration_from_previous(0);
+    for (Eigen::Index i = 1; i < num_waypoints; ++i)
+    {
+      time_from_start += new_duration_from_previous(i);
+      new_velocity = trajectory.getVelocity(i);
+      new_acceleration = trajectory.getAcceleration(i);
+      trajectory.setData(i, new_velocity, new_acceleration, time_from_start);
     }
   }
 
   if (ruckig_result != ruckig::Result::Finished)
   {
-    CONSOLE_BRIDGE_logError("Ruckig trajectory smoothing failed. Ruckig error: %s", ruckig_result);
+    CONSOLE_BRIDGE_logError("Ruckig trajectory smoothing failed. Ruckig error: %d", static_cast<int>(ruckig_result));
     return false;
   }
 
   return true;
 }
+
+bool RuckigTrajectorySmoothing::compute(TrajectoryContainer& trajectory,
+                                        const Eigen::Ref<const Eigen::VectorXd>& max_velocity,
+                                        const Eigen::Ref<const Eigen::VectorXd>& max_acceleration,
+                                        const Eigen::Ref<const Eigen::VectorXd>& max_jerk,
+                                        const Eigen::Ref<const Eigen::VectorXd>& /*max_velocity_scaling_factors*/,
+                                        const Eigen::Ref<const Eigen::VectorXd>& /*max_acceleration_scaling_factors*/,
+                                        const Eigen::Ref<const Eigen::VectorXd>& /*max_jerk_scaling_factors*/) const
+{
+  if (trajectory.size() < 2)
+    return true;
+
+  if (max_velocity.size() != trajectory.dof() || max_acceleration.size() != trajectory.dof())
+    return false;
+
+  // Use fixed size solvers for the common number of joints
+  switch (trajectory.dof())
+  {
+    case 6:
+      return smoothTrajectory<6>(trajectory,
+                                 max_velocity,
+                                 max_acceleration,
+                                 max_jerk,
+                                 duration_extension_fraction_,
+                                 max_duration_extension_factor_,
+                                 local_stretch_,
+                                 local_stretch_window_);
+    case 7:
+      return smoothTrajectory<7>(trajectory,
+                                 max_velocity,
+                                 max_acceleration,
+                                 max_jerk,
+                                 duration_extension_fraction_,
+                                 max_duration_extension_factor_,
+                                 local_stretch_,
+                                 local_stretch_window_);
+    default:
+      return smoothTrajectory<ruckig::DynamicDOFs>(trajectory,
+                                                   max_velocity,
+                                                   max_acceleration,
+                                                   max_jerk,
+                                                   duration_extension_fraction_,
+                                                   max_duration_extension_factor_,
+                                                   local_stretch_,
+                                                   local_stretch_window_);
+  }
+}
 #endif
 }  // namespace tesseract_planning
@@ -0,0 +1,80 @@
+/**
+ * @file iterative_spline_parameterization_benchmark.cpp
+ * @brief Benchmark the iterative spline parameterization kernel as the trajectory length and dof increase
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
+#include <tesseract_time_parameterization/isp/iterative_spline_parameterization.h>
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Create a trajectory where each point moves every joint a small amount
+ * @details The trajectory is stored contiguously so the benchmark measures the solver and not the container.
+ */
+ContiguousTrajectory createTrajectory(long num_points, long dof)
+{
+  Eigen::MatrixXd position(dof, num_points);
+  for (long i = 0; i < num_points; ++i)
+    for (long j = 0; j < dof; ++j)
+      position(j, i) = std::sin((0.001 * static_cast<double>(i)) + static_cast<double>(j));
+
+  return { position, Eigen::MatrixXd(), Eigen::MatrixXd(), Eigen::VectorXd::Zero(num_points) };
+}
+
+/** @brief Time parameterize trajectories with an increasing number of points and degrees of freedom */
+static void BM_ISP_COMPUTE(benchmark::State& state, bool add_points)
+{
+  const ContiguousTrajectory base_trajectory = createTrajectory(state.range(0), state.range(1));
+  const Eigen::VectorXd max_velocity = Eigen::VectorXd::Constant(state.range(1), 2.0);
+  const Eigen::VectorXd max_acceleration = Eigen::VectorXd::Constant(state.range(1), 1.0);
+  IterativeSplineParameterization solver(add_points);
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    ContiguousTrajectory trajectory = base_trajectory;
+    state.ResumeTiming();
+
+    if (!solver.compute(trajectory, max_velocity, max_acceleration))
+    {
+      state.SkipWithError("Failed to time parameterize the trajectory");
+      break;
+    }
+    benchmark::DoNotOptimize(trajectory.getTimes().data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_ISP_COMPUTE, ADD_POINTS, true)
+    ->ArgsProduct({ benchmark::CreateRange(1000, 100000, 10), { 6, 7 } })
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_ISP_COMPUTE, NO_ADD_POINTS, false)
+    ->ArgsProduct({ benchmark::CreateRange(1000, 100000, 10), { 6, 7 } })
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -38,12 +38,20 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <gtest/gtest.h>
 #include <console_bridge/console.h>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
+#include <tesseract_command_language/joint_trajectory_block.h>
 #include <tesseract_command_language/move_instruction.h>
 #include <tesseract_command_language/state_waypoint.h>
+#include <tesseract_command_language/utils.h>
 #include <tesseract_time_parameterization/isp/iterative_spline_parameterization.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
 #include <tesseract_time_parameterization/core/instructions_trajectory.h>
+#include <tesseract_time_parameterization/core/joint_trajectory_block_trajectory.h>
 
 using namespace tesseract_planning;
 
@@ -115,6 +123,62 @@ TEST(TestTimeParameterization, TestIterativeSplineAddPoints)  // NOLINT
   ASSERT_LT(program.back().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>().getTime(), 5.0);
 }
 
+TEST(TestTimeParameterization, TestIterativeSplineContiguousTrajectory)  // NOLINT
+{
+  IterativeSplineParameterization time_parameterization(false);
+  CompositeInstruction program = createStraightTrajectory();
+  CompositeInstruction contiguous_program = createStraightTrajectory();
+  std::vector<double> max_velocity = { 2.088, 2.082, 3.27, 3.6, 3.3, 3.078 };
+  std::vector<double> max_acceleration = { 1, 1, 1, 1, 1, 1 };
+  InstructionsTrajectory trajectory(program);
+  EXPECT_TRUE(time_parameterization.compute(trajectory, max_velocity, max_acceleration));
+
+  InstructionsTrajectory contiguous_program_trajectory(contiguous_program);
+  ContiguousTrajectory contiguous_trajectory(contiguous_program_trajectory);
+  EXPECT_EQ(contiguous_trajectory.size(), contiguous_program_trajectory.size());
+  EXPECT_EQ(contiguous_trajectory.dof(), contiguous_program_trajectory.dof());
+  EXPECT_TRUE(time_parameterization.compute(contiguous_trajectory, max_velocity, max_acceleration));
+  contiguous_trajectory.scatter(contiguous_program_trajectory);
+
+  // The results written back match parameterizing the instructions directly
+  for (Eigen::Index i = 0; i < trajectory.size(); ++i)
+  {
+    EXPECT_NEAR(trajectory.getTimeFromStart(i), contiguous_program_trajectory.getTimeFromStart(i), 1e-8);
+    EXPECT_TRUE(trajectory.getVelocity(i).isApprox(contiguous_program_trajectory.getVelocity(i), 1e-8));
+    EXPECT_TRUE(trajectory.getAcceleration(i).isApprox(contiguous_program_trajectory.getAcceleration(i), 1e-8));
+  }
+}
+
+TEST(TestTimeParameterization, TestIterativeSplineJointTrajectoryBlock)  // NOLINT
+{
+  IterativeSplineParameterization time_parameterization(false);
+  CompositeInstruction program = createStraightTrajectory();
+  CompositeInstruction block_program = toJointTrajectoryBlocks(program);
+  ASSERT_EQ(block_program.size(), 1);
+  ASSERT_TRUE(block_program.front().isJointTrajectoryBlock());
+
+  std::vector<double> max_velocity = { 2.088, 2.082, 3.27, 3.6, 3.3, 3.078 };
+  std::vector<double> max_acceleration = { 1, 1, 1, 1, 1, 1 };
+  TrajectoryContainer::Ptr trajectory = std::make_shared<InstructionsTrajectory>(program);
+  EXPECT_TRUE(time_parameterization.compute(*trajectory, max_velocity, max_acceleration));
+  TrajectoryContainer::Ptr block_trajectory = std::make_shared<JointTrajectoryBlockTrajectory>(block_program);
+  EXPECT_TRUE(time_parameterization.compute(*block_trajectory, max_velocity, max_acceleration));
+
+  // Both representations produce the same trajectory
+  ASSERT_EQ(trajectory->size(), block_trajectory->size());
+  for (Eigen::Index i = 0; i < trajectory->size(); ++i)
+  {
+    EXPECT_NEAR(trajectory->getTimeFromStart(i), block_trajectory->getTimeFromStart(i), 1e-8);
+    EXPECT_TRUE(trajectory->getVelocity(i).isApprox(block_trajectory->getVelocity(i), 1e-8));
+    EXPECT_TRUE(trajectory->getAcceleration(i).isApprox(block_trajectory->getAcceleration(i), 1e-8));
+  }
+
+  const auto& block = block_program.front().as<JointTrajectoryBlock>();
+  EXPECT_NEAR(block.getTime()(block.size() - 1),
+              program.back().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>().getTime(),
+              1e-8);
+}
+
 TEST(TestTimeParameterization, TestIterativeSplineDynamicParams)  // NOLINT
 {
   IterativeSplineParameterization time_parameterization(false);
@@ -152,6 +216,126 @@ TEST(TestTimeParameterization, TestRepeatedPoint)  // NOLINT
   ASSERT_LT(program.back().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>().getTime(), 0.001);
 }
 
+/** @brief Values recorded from the previous implementation of the iterative spline parameterization */
+struct ReferenceParameterization
+{
+  std::vector<double> times;
+
+  /** @brief The velocity and acceleration of the first joint */
+  std::vector<double> velocity;
+  std::vector<double> acceleration;
+};
+
+// clang-format off
+const std::array<ReferenceParameterization, 4> REFERENCES{ {
+  {
+    { 0, 0.800870668966, 1.14717150491, 1.45290900613, 1.74991766668, 2.05525091116,
+      2.40721431396, 3.21607777112 },
+    { 0, 0.706831351283, 0.785135920389, 0.623473453305, 0.365628673332, 0.0633675552282,
+      -0.154509748321, 0 },
+    { 0.999323999205, 0.765833294408, -0.31359893065, -0.743925687302, -0.992352167323, -0.987524728299,
+      -0.250543217492, 0.632584826499 }
+  },
+  {
+    { 0, 0.923604067654, 1.26995949074, 1.57556795154, 1.87261246592, 2.17766617678,
+      2.52943021734, 4.13813698478 },
+    { 0, 0.707035635053, 0.785182852386, 0.623670566542, 0.365564991455, 0.0636694501215,
+      -0.155110301339, 0 },
+    { 0.000807497693857, 0.760960604713, -0.309706129544, -0.747282184347, -0.990542031155, -0.988752306755,
+      -0.255148298413, 0.00217496991961 }
+  },
+  {
+    { 0, 1.08696493793, 2.09101986365, 3.06080756379, 4.28682136895, 5.89625261296,
+      7.0885208299, 8.55021112614 },
+    { 0.1, -0.325002940433, -0.10765562885, 0.128802162769, -0.193883978014, -0.270012435579,
+      0.0550551391212, 0 },
+    { -0.40712198711, -0.374877368347, 0.807816455676, -0.32016788768, -0.206230982257, 0.111628049888,
+      0.433664645297, -0.508995430845 }
+  },
+  {
+    { 0, 1.21854306684, 2.21965285843, 3.18659593845, 4.41445353145, 6.02042839299,
+      7.21013611847, 10.1259066027 },
+    { 0.1, -0.330594747522, -0.106840573673, 0.12920875781, -0.194552204053, -0.26957738066,
+      0.0518216106359, 0 },
+    { -0.0271520555502, -0.360825103923, 0.807837361178, -0.319599043203, -0.207760096339, 0.114327529737,
+      0.425971544417, -0.196752162357 }
+  }
+} };
+// clang-format on
+
+/** @brief Create a trajectory moving each joint along a sine wave with a different phase */
+ContiguousTrajectory createSineTrajectory()
+{
+  Eigen::MatrixXd position(3, 8);
+  for (Eigen::Index i = 0; i < position.cols(); ++i)
+    for (Eigen::Index j = 0; j < position.rows(); ++j)
+      position(j, i) = std::sin((0.3 * static_cast<double>(i)) + static_cast<double>(j));
+
+  return { position, Eigen::MatrixXd(), Eigen::MatrixXd(), Eigen::VectorXd::Zero(position.cols()) };
+}
+
+/** @brief Create a random walk starting with a velocity and ending with an acceleration */
+ContiguousTrajectory createRandomTrajectory(std::mt19937& rng)
+{
+  // The distributions of the standard library are implementation defined, so the samples are scaled directly
+  auto sample = [&rng]() { return (2.0 * static_cast<double>(rng()) / static_cast<double>(std::mt19937::max())) - 1; };
+
+  Eigen::MatrixXd position = Eigen::MatrixXd::Zero(3, 8);
+  for (Eigen::Index i = 1; i < position.cols(); ++i)
+    for (Eigen::Index j = 0; j < position.rows(); ++j)
+      position(j, i) = position(j, i - 1) + (0.5 * sample());
+
+  Eigen::MatrixXd velocity = Eigen::MatrixXd::Zero(3, 8);
+  Eigen::MatrixXd acceleration = Eigen::MatrixXd::Zero(3, 8);
+  velocity.col(0).setConstant(0.1);
+  acceleration.col(7).setConstant(-0.2);
+  return { position, velocity, acceleration, Eigen::VectorXd::Zero(position.cols()) };
+}
+
+/** @brief Check the trajectory against the values recorded from the previous implementation */
+void expectSameAsReference(const ContiguousTrajectory& trajectory, const ReferenceParameterization& reference)
+{
+  ASSERT_EQ(trajectory.size(), static_cast<Eigen::Index>(reference.times.size()));
+  for (Eigen::Index i = 0; i < trajectory.size(); ++i)
+  {
+    const auto idx = static_cast<std::size_t>(i);
+    EXPECT_NEAR(trajectory.getTimeFromStart(i), reference.times[idx], 1e-9);
+    EXPECT_NEAR(trajectory.getVelocity(i)[0], reference.velocity[idx], 1e-9);
+    EXPECT_NEAR(trajectory.getAcceleration(i)[0], reference.acceleration[idx], 1e-9);
+  }
+}
+
+TEST(TestTimeParameterization, TestIterativeSplineSameAsReference)  // NOLINT
+{
+  const Eigen::VectorXd max_velocity = Eigen::VectorXd::Constant(3, 2.0);
+  const Eigen::VectorXd max_acceleration = Eigen::VectorXd::Constant(3, 1.0);
+
+  // Sine waves without scaling, without and with added points
+  for (std::size_t i = 0; i < 2; ++i)
+  {
+    SCOPED_TRACE("sine case " + std::to_string(i));
+    ContiguousTrajectory trajectory = createSineTrajectory();
+    IterativeSplineParameterization time_parameterization(i == 1);
+    EXPECT_TRUE(time_parameterization.compute(trajectory, max_velocity, max_acceleration));
+    expectSameAsReference(trajectory, REFERENCES[i]);
+  }
+
+  // A random walk with varying scaling factors, without and with added points
+  std::mt19937 rng(42);  // NOLINT
+  const ContiguousTrajectory random_trajectory = createRandomTrajectory(rng);
+  const Eigen::VectorXd velocity_scaling_factors = Eigen::VectorXd::LinSpaced(8, 0.5, 1.0);
+  const Eigen::VectorXd acceleration_scaling_factors = Eigen::VectorXd::LinSpaced(8, 1.0, 0.7);
+  for (std::size_t i = 2; i < 4; ++i)
+  {
+    SCOPED_TRACE("random case " + std::to_string(i));
+    ContiguousTrajectory trajectory = random_trajectory;
+    IterativeSplineParameterization time_parameterization(i == 3);
+    EXPECT_TRUE(time_parameterization.compute(
+        trajectory, max_velocity, max_acceleration, velocity_scaling_factors, acceleration_scaling_factors));
+    expectSameAsReference(trajectory, REFERENCES[i]);
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,94 @@
+/**
+ * @file ruckig_trajectory_smoothing_benchmark.cpp
+ * @brief Benchmark ruckig trajectory smoothing stretching the whole trajectory against stretching locally
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
+#include <tesseract_time_parameterization/isp/iterative_spline_parameterization.h>
+#include <tesseract_time_parameterization/ruckig/ruckig_trajectory_smoothing.h>
+
+using namespace tesseract_planning;
+
+/**
+ * @brief Create a time parameterized trajectory with a hard corner in the middle
+ * @details Every joint moves smoothly except the first, which reverses direction at the middle point, so Ruckig has to
+ * stretch the waypoints around the corner.
+ */
+ContiguousTrajectory createTrajectory(long num_points, long dof)
+{
+  Eigen::MatrixXd position(dof, num_points);
+  for (long i = 0; i < num_points; ++i)
+  {
+    for (long j = 1; j < dof; ++j)
+      position(j, i) = std::sin((0.001 * static_cast<double>(i)) + static_cast<double>(j));
+
+    position(0, i) = 0.001 * static_cast<double>(std::min(i, num_points - i));
+  }
+
+  ContiguousTrajectory trajectory(position, Eigen::MatrixXd(), Eigen::MatrixXd(), Eigen::VectorXd::Zero(num_points));
+  IterativeSplineParameterization isp(false);
+  isp.compute(trajectory, Eigen::VectorXd::Constant(dof, 2.0), Eigen::VectorXd::Constant(dof, 1.0));
+  return trajectory;
+}
+
+/** @brief Smooth trajectories with an increasing number of points, the 6 and 7 dof use the fixed size solver */
+static void BM_RUCKIG_COMPUTE(benchmark::State& state, bool local_stretch)
+{
+  const ContiguousTrajectory base_trajectory = createTrajectory(state.range(0), state.range(1));
+  const Eigen::VectorXd max_velocity = Eigen::VectorXd::Constant(state.range(1), 2.0);
+  const Eigen::VectorXd max_acceleration = Eigen::VectorXd::Constant(state.range(1), 1.0);
+  const Eigen::VectorXd max_jerk = Eigen::VectorXd::Constant(state.range(1), 100.0);
+  RuckigTrajectorySmoothing solver;
+  solver.setLocalStretch(local_stretch);
+
+  double duration{ 0 };
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    ContiguousTrajectory trajectory = base_trajectory;
+    state.ResumeTiming();
+
+    if (!solver.compute(trajectory, max_velocity, max_acceleration, max_jerk))
+    {
+      state.SkipWithError("Failed to smooth the trajectory");
+      break;
+    }
+    duration = trajectory.getTimeFromStart(trajectory.size() - 1);
+  }
+
+  // The duration shows how much the trajectory was stretched by each approach
+  state.counters["duration"] = duration;
+  state.counters["base_duration"] = base_trajectory.getTimeFromStart(base_trajectory.size() - 1);
+}
+
+BENCHMARK_CAPTURE(BM_RUCKIG_COMPUTE, GLOBAL_STRETCH, false)
+    ->ArgsProduct({ benchmark::CreateRange(1000, 100000, 10), { 6, 7, 8 } })
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_RUCKIG_COMPUTE, LOCAL_STRETCH, true)
+    ->ArgsProduct({ benchmark::CreateRange(1000, 100000, 10), { 6, 7, 8 } })
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
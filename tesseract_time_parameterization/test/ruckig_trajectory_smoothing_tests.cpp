@@ -9,6 +9,7 @@ TESSERACT_COMMON_IGNORE_WARNINGS_POP
 #include <tesseract_time_parameterization/ruckig/ruckig_trajectory_smoothing.h>
 #include <tesseract_time_parameterization/isp/iterative_spline_parameterization.h>
 #include <tesseract_time_parameterization/core/instructions_trajectory.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
 
 #include <ruckig/input_parameter.hpp>
 #include <ruckig/ruckig.hpp>
@@ -123,6 +124,110 @@ TEST(RuckigTrajectorySmoothingTest, RuckigTrajectorySmoothingSolve)  // NOLINT
   ASSERT_LT(program.back().as<MoveInstructionPoly>().getWaypoint().as<StateWaypointPoly>().getTime(), 8.0);
 }
 
+/**
+ * @brief Create a six joint trajectory with waypoints one second apart and a large step to waypoint 6
+ * @details At 1 rad/s and 1 rad/s^2 the small steps take less than a second while the large step takes at least 2.5s,
+ * so Ruckig only reaches waypoint 6 once the durations are stretched.
+ * @param velocity The velocity of the waypoints between the first and last, which are at rest
+ */
+ContiguousTrajectory createStepTrajectory(double velocity = 0)
+{
+  const Eigen::Index num = 11;
+  Eigen::MatrixXd position = Eigen::MatrixXd::Zero(6, num);
+  for (Eigen::Index i = 1; i < num; ++i)
+    position.col(i) = position.col(i - 1).array() + ((i == 6) ? 1.5 : 0.1);
+
+  Eigen::MatrixXd velocities = Eigen::MatrixXd::Zero(6, num);
+  velocities.middleCols(1, num - 2).setConstant(velocity);
+
+  Eigen::VectorXd time = Eigen::VectorXd::LinSpaced(num, 0, static_cast<double>(num - 1));
+  return { position, velocities, Eigen::MatrixXd::Zero(6, num), time };
+}
+
+/** @brief Get the duration between each pair of waypoints */
+Eigen::VectorXd getDurations(const ContiguousTrajectory& trajectory)
+{
+  const Eigen::Index num = trajectory.size() - 1;
+  return trajectory.getTimes().tail(num) - trajectory.getTimes().head(num);
+}
+
+TEST(RuckigTrajectorySmoothingTest, RuckigTrajectorySmoothingLocalStretchSolve)  // NOLINT
+{
+  const Eigen::VectorXd max_velocity = Eigen::VectorXd::Ones(6);
+  const Eigen::VectorXd max_acceleration = Eigen::VectorXd::Ones(6);
+  const Eigen::VectorXd max_jerk = Eigen::VectorXd::Constant(6, 1000);
+
+  ContiguousTrajectory trajectory = createStepTrajectory();
+  RuckigTrajectorySmoothing traj_smoothing;
+  traj_smoothing.setLocalStretch(true);
+  traj_smoothing.setLocalStretchWindow(1);
+  EXPECT_TRUE(traj_smoothing.compute(trajectory, max_velocity, max_acceleration, max_jerk));
+  EXPECT_TRUE(trajectory.isTimeStrictlyIncreasing());
+
+  // Only the large step and the step either side of it are stretched, all by the same factor
+  const Eigen::VectorXd durations = getDurations(trajectory);
+  ASSERT_EQ(durations.rows(), 10);
+  for (Eigen::Index i : { 0, 1, 2, 3, 7, 8, 9 })
+    EXPECT_NEAR(durations[i], 1.0, 1e-12);
+
+  EXPECT_GT(durations[5], 1.0);
+  EXPECT_NEAR(durations[4], durations[5], 1e-12);
+  EXPECT_NEAR(durations[6], durations[5], 1e-12);
+
+  // Ruckig must reach each waypoint within the mean duration, so it fits the large step within the limits
+  EXPECT_GE(durations.mean(), 2.5);
+  for (Eigen::Index i = 0; i < trajectory.size(); ++i)
+  {
+    EXPECT_TRUE((trajectory.getVelocity(i).array().abs() <= max_velocity.array()).all());
+    EXPECT_TRUE((trajectory.getAcceleration(i).array().abs() <= max_acceleration.array()).all());
+  }
+
+  // A global stretch stretches every step
+  ContiguousTrajectory global_trajectory = createStepTrajectory();
+  traj_smoothing.setLocalStretch(false);
+  EXPECT_TRUE(traj_smoothing.compute(global_trajectory, max_velocity, max_acceleration, max_jerk));
+  const Eigen::VectorXd global_durations = getDurations(global_trajectory);
+  EXPECT_GT(global_durations.minCoeff(), 1.0);
+  EXPECT_GE(global_durations.mean(), 2.5);
+}
+
+TEST(RuckigTrajectorySmoothingTest, RuckigTrajectorySmoothingGlobalStretchSolve)  // NOLINT
+{
+  const Eigen::VectorXd max_velocity = Eigen::VectorXd::Ones(6);
+  const Eigen::VectorXd max_acceleration = Eigen::VectorXd::Ones(6);
+  const Eigen::VectorXd max_jerk = Eigen::VectorXd::Constant(6, 1000);
+  const double velocity = 0.05;
+
+  ContiguousTrajectory trajectory = createStepTrajectory(velocity);
+  RuckigTrajectorySmoothing traj_smoothing;
+  EXPECT_TRUE(traj_smoothing.compute(trajectory, max_velocity, max_acceleration, max_jerk));
+
+  // Every step is stretched by the same factor
+  const Eigen::VectorXd durations = getDurations(trajectory);
+  const double factor = durations[0];
+  EXPECT_GT(factor, 1.0);
+  for (Eigen::Index i = 0; i < durations.rows(); ++i)
+    EXPECT_NEAR(durations[i], factor, 1e-12);
+
+  // The acceleration of each waypoint uses the mean duration of the steps stretched up to that waypoint while the
+  // later steps still have their original duration
+  const auto num_steps = static_cast<double>(durations.rows());
+  Eigen::VectorXd previous_velocity = Eigen::VectorXd::Zero(6);
+  for (Eigen::Index i = 1; i < trajectory.size() - 1; ++i)
+  {
+    const Eigen::VectorXd expected_velocity = Eigen::VectorXd::Constant(6, velocity / factor);
+    const double timestep = ((factor * static_cast<double>(i)) + (num_steps - static_cast<double>(i))) / num_steps;
+    const Eigen::VectorXd expected_acceleration = (expected_velocity - previous_velocity) / timestep;
+    EXPECT_TRUE(trajectory.getVelocity(i).isApprox(expected_velocity, 1e-9));
+    EXPECT_TRUE(trajectory.getAcceleration(i).isApprox(expected_acceleration, 1e-9));
+    previous_velocity = expected_velocity;
+  }
+
+  const Eigen::VectorXd expected_acceleration = -previous_velocity / factor;
+  EXPECT_TRUE(trajectory.getVelocity(trajectory.size() - 1).isZero());
+  EXPECT_TRUE(trajectory.getAcceleration(trajectory.size() - 1).isApprox(expected_acceleration, 1e-9));
+}
+
 TEST(RuckigTrajectorySmoothingTest, RuckigTrajectorySmoothingRepeatedPointSolve)  // NOLINT
 {
   IterativeSplineParameterization time_parameterization(true);
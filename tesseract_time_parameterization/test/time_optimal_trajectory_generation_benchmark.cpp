@@ -0,0 +1,144 @@
+/**
+ * @file time_optimal_trajectory_generation_benchmark.cpp
+ * @brief Benchmark the time and memory used by time optimal trajectory generation as the trajectory length increases
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_time_parameterization/totg/time_optimal_trajectory_generation.h>
+#include <tesseract_time_parameterization/core/instructions_trajectory.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+
+using namespace tesseract_planning;
+
+/** @brief The number of allocations performed through operator new */
+static std::atomic<std::size_t> allocation_count{ 0 };
+
+/** @brief The number of bytes currently allocated through operator new */
+static std::atomic<std::size_t> allocated_bytes{ 0 };
+
+/** @brief The maximum number of bytes allocated through operator new since it was last reset */
+static std::atomic<std::size_t> peak_allocated_bytes{ 0 };
+
+/** @brief The size of each allocation is stored in front of it so the current allocation can be tracked */
+static constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* operator new(std::size_t size)
+{
+  auto* ptr = static_cast<char*>(std::malloc(size + HEADER_SIZE));  // NOLINT
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+
+  *reinterpret_cast<std::size_t*>(ptr) = size;  // NOLINT
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  const std::size_t current = allocated_bytes.fetch_add(size) + size;
+  std::size_t peak = peak_allocated_bytes.load();
+  while (current > peak && !peak_allocated_bytes.compare_exchange_weak(peak, current))
+  {
+  }
+  return ptr + HEADER_SIZE;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (ptr == nullptr)
+    return;
+
+  char* header = static_cast<char*>(ptr) - HEADER_SIZE;
+  allocated_bytes.fetch_sub(*reinterpret_cast<std::size_t*>(header));  // NOLINT
+  std::free(header);                                                  // NOLINT
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { operator delete(ptr); }
+
+/**
+ * @brief Create a slow freespace program with the provided number of waypoints
+ * @details Each waypoint moves every joint, so the integrated trajectory contains a step every millisecond of its
+ * duration and the number of steps grows with the number of waypoints.
+ */
+CompositeInstruction createProgram(long num_waypoints)
+{
+  std::vector<std::string> joint_names = { "joint_1", "joint_2", "joint_3", "joint_4", "joint_5", "joint_6" };
+
+  CompositeInstruction program;
+  for (long i = 0; i < num_waypoints; ++i)
+  {
+    Eigen::VectorXd position(6);
+    for (Eigen::Index j = 0; j < 6; ++j)
+      position(j) = std::sin((0.1 * static_cast<double>(i)) + static_cast<double>(j));
+
+    StateWaypointPoly swp{ StateWaypoint(joint_names, position) };
+    program.appendMoveInstruction(MoveInstruction(swp, MoveInstructionType::FREESPACE));
+  }
+  return program;
+}
+
+/** @brief Time parameterize programs with an increasing number of waypoints */
+static void BM_TOTG_COMPUTE_TIME_STAMPS(benchmark::State& state)
+{
+  const CompositeInstruction base_program = createProgram(state.range(0));
+  const Eigen::VectorXd max_velocity = Eigen::VectorXd::Constant(6, 0.1);
+  const Eigen::VectorXd max_acceleration = Eigen::VectorXd::Constant(6, 0.5);
+  TimeOptimalTrajectoryGeneration solver(0.1, 0.1, 1e-3);
+
+  double peak_bytes{ 0 };
+  std::size_t allocations{ 0 };
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    CompositeInstruction program = base_program;
+    InstructionsTrajectory trajectory(program);
+    peak_allocated_bytes = allocated_bytes.load();
+    const std::size_t start_bytes = allocated_bytes.load();
+    const std::size_t start_count = allocation_count.load();
+    state.ResumeTiming();
+
+    if (!solver.computeTimeStamps(trajectory, max_velocity, max_acceleration))
+    {
+      state.SkipWithError("Failed to time parameterize the program");
+      break;
+    }
+
+    peak_bytes = std::max(peak_bytes, static_cast<double>(peak_allocated_bytes.load() - start_bytes));
+    allocations += allocation_count.load() - start_count;
+  }
+
+  state.counters["allocations"] =
+      benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+
+  state.counters["peak_bytes"] =
+      benchmark::Counter(peak_bytes, benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024);
+}
+
+BENCHMARK(BM_TOTG_COMPUTE_TIME_STAMPS)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -37,6 +37,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <array>
+#include <random>
 #include <tesseract_time_parameterization/totg/time_optimal_trajectory_generation.h>
 #include <tesseract_command_language/poly/state_waypoint_poly.h>
 #include <tesseract_command_language/poly/move_instruction_poly.h>
@@ -374,6 +376,176 @@ TEST(time_optimal_trajectory_generation, testTrajectoryContainerInterface)  // N
   runTrajectoryContainerInterfaceTest(0.0001);
 }
 
+/** @brief Values recorded from the list based implementation of Path and Trajectory */
+struct ReferenceTrajectory
+{
+  double length;
+  double duration;
+
+  /** @brief The path position and velocity at a third and at two thirds of the duration */
+  std::array<double, 4> path_data;
+
+  /** @brief The position and velocity of the first six joints at half of the duration */
+  std::array<double, 6> position;
+  std::array<double, 6> velocity;
+
+  /** @brief The time at the path position of the middle waypoint */
+  double middle_time;
+};
+
+// clang-format off
+const std::array<ReferenceTrajectory, 6> RANDOM_REFERENCES{ {
+  { 1.08569078716,
+    1.18559933339,
+    { 0.340570724753, 1.02365780647, 0.745120062411, 1.02365780647 },
+    { -0.324299596035, 0.638970732104, 0.804892651354, -0.715518186583, 0.287919094748, 0.212226991859 },
+    { -0.25, -0.0230536324715, 0.207152392417, -0.0940740108185, 0.0572025693402, -0.202036626527 },
+    1.18559933339 },
+  { 8.53472703381,
+    4.49037839551,
+    { 2.75117432476, 2.05169153514, 5.79780378921, 2.06638813056 },
+    { 0.146203864995, -0.0998065652753, -1.33772248129, -0.760017498155, 0.549605558387, 0.191810489703 },
+    { -0.0149971503154, 0.0809730375722, 0.213723483059, 0.0436410789334, -0.449369007729, 0.162524590406 },
+    2.22219038478 },
+  { 15.825711888,
+    7.11127240637,
+    { 5.16973220723, 2.67596050566, 10.7165265825, 2.20750733692 },
+    { -0.533926287835, 0.818391964464, -0.696769121767, -0.124859549467, 0.0517358134091, 0.708637069913 },
+    { -0.143155207876, -0.197176670166, 0.344610234713, -0.317156525833, -0.458214077461, -0.476809094857 },
+    3.67145384102 },
+  { 23.7874028235,
+    6.17868066622,
+    { 7.75424409662, 4.56856476405, 16.5781976402, 4.7708776831 },
+    { -1.54349220345, 0.589863736282, 0.965341464791, 0.921789966959, 0.53371812744, -0.811404951642 },
+    { 0.644997753186, -0.299019945899, 0.731633996437, -0.395942774554, -1, -0.680145215794 },
+    3.09447248865 },
+  { 30.7563797151,
+    26.0448621931,
+    { 9.61519521709, 1.52165044508, 20.4468759522, 1.08812635346 },
+    { 0.340078913543, 1.30655348519, -0.777428223695, 1.41303082027, -0.448989892879, 0.812254245665 },
+    { 0.0853607095877, 0.243441184769, -0.250000142361, -0.11249278562, -0.170824557436, -0.0879484133557 },
+    14.2058968582 },
+  { 38.2482147886,
+    17.7225104653,
+    { 12.7509501212, 2.31801349818, 25.5445979616, 1.97660746322 },
+    { -0.118418402515, -1.70494634887, 1.31679305003, -0.510230320004, 0.716191070622, 0.824276654827 },
+    { -0.10438897836, -0.0308431235611, 0.168059228455, -0.500000078304, -0.0507953617998, 0.240005735501 },
+    8.82687527032 }
+} };
+
+const std::array<ReferenceTrajectory, 2> FIXED_REFERENCES{ {
+  { 7.52374206328,
+    5.50125830581,
+    { 2.27366569786, 1.44222051019, 5.03655270201, 1.52643375225 },
+    { 0.500142718452, 1, 0.249928640774, 0, 0.49997145631, 2.85436903635e-05 },
+    { -1, 0, 0.5, 0, 0.2, -0.2 },
+    3.25077187136 },
+  { 7.21645338308,
+    5.82086145478,
+    { 2.33189002589, 1.44222051019, 4.9557325747, 1.52643375225 },
+    { 0.401972226711, 1, 0.299013886644, -3.74965602402e-17, 0.519605554658, -0.0196055546578 },
+    { -1, -2.0508104024e-16, 0.5, -1.0254052012e-16, 0.2, -0.2 },
+    3.34331636277 }
+} };
+// clang-format on
+
+/** @brief Create a random walk with an extra joint increasing by one, like TimeOptimalTrajectoryGeneration adds */
+std::list<Eigen::VectorXd> createRandomWaypoints(std::mt19937& rng, int num)
+{
+  // The distributions of the standard library are implementation defined, so the samples are scaled directly
+  auto sample = [&rng]() { return (2.0 * static_cast<double>(rng()) / static_cast<double>(std::mt19937::max())) - 1; };
+
+  std::list<Eigen::VectorXd> waypoints;
+  Eigen::VectorXd waypoint(7);
+  for (Eigen::Index j = 0; j < 6; ++j)
+    waypoint[j] = sample();
+
+  for (int k = 0; k < num; ++k)
+  {
+    for (Eigen::Index j = 0; j < 6; ++j)
+      waypoint[j] += 0.3 * sample();
+    waypoint[6] = k + 1;
+    waypoints.push_back(waypoint);
+  }
+  return waypoints;
+}
+
+/** @brief Create a path with sharp corners and a reversal, with an extra joint increasing by one */
+std::list<Eigen::VectorXd> createFixedWaypoints()
+{
+  Eigen::MatrixXd waypoints(7, 6);
+  waypoints << 0.0, 1.0, 1.0, 0.0, 0.0, 0.5,  //
+      0.0, 0.0, 1.0, 1.0, 0.0, 0.5,           //
+      0.0, 0.0, 0.0, 0.5, 0.5, -0.5,          //
+      0.0, 0.0, 0.0, 0.0, -0.5, -0.5,         //
+      0.0, 0.2, 0.4, 0.6, 0.8, 1.0,           //
+      0.0, -0.1, 0.1, -0.1, 0.1, 0.0,         //
+      1.0, 2.0, 3.0, 4.0, 5.0, 6.0;
+  std::list<Eigen::VectorXd> waypoint_list;
+  for (Eigen::Index i = 0; i < waypoints.cols(); ++i)
+    waypoint_list.emplace_back(waypoints.col(i));
+  return waypoint_list;
+}
+
+/** @brief Check the path and trajectory against the values recorded from the list based implementation */
+void expectSameAsReference(const Path& path, const Trajectory& trajectory, const ReferenceTrajectory& reference)
+{
+  EXPECT_NEAR(path.getLength(), reference.length, 1e-9);
+  ASSERT_TRUE(trajectory.isValid());
+
+  const double duration = trajectory.getDuration();
+  EXPECT_NEAR(duration, reference.duration, 1e-9);
+  for (std::size_t k = 0; k < 2; ++k)
+  {
+    const PathData data = trajectory.getPathData(static_cast<double>(k + 1) * duration / 3.0);
+    EXPECT_NEAR(data.path_pos, reference.path_data[2 * k], 1e-9);
+    EXPECT_NEAR(data.path_vel, reference.path_data[(2 * k) + 1], 1e-9);
+  }
+
+  const PathData data = trajectory.getPathData(duration / 2.0);
+  const Eigen::VectorXd position = trajectory.getPosition(data);
+  const Eigen::VectorXd velocity = trajectory.getVelocity(data);
+  for (Eigen::Index j = 0; j < 6; ++j)
+  {
+    EXPECT_NEAR(position[j], reference.position[static_cast<std::size_t>(j)], 1e-9);
+    EXPECT_NEAR(velocity[j], reference.velocity[static_cast<std::size_t>(j)], 1e-9);
+  }
+
+  const std::vector<double>& mapping = path.getMapping();
+  EXPECT_NEAR(trajectory.getTime(mapping[mapping.size() / 2]), reference.middle_time, 1e-9);
+}
+
+TEST(time_optimal_trajectory_generation, testSameAsReference)  // NOLINT
+{
+  Eigen::VectorXd max_velocity = Eigen::VectorXd::Constant(7, 1.0);
+  Eigen::VectorXd max_acceleration = Eigen::VectorXd::Constant(7, 2.0);
+  max_velocity[6] = std::numeric_limits<double>::max();
+  max_acceleration[6] = std::numeric_limits<double>::max();
+
+  std::mt19937 rng(42);  // NOLINT
+  for (std::size_t i = 0; i < RANDOM_REFERENCES.size(); ++i)
+  {
+    SCOPED_TRACE("random case " + std::to_string(i));
+    const std::list<Eigen::VectorXd> waypoints = createRandomWaypoints(rng, 2 + (7 * static_cast<int>(i)));
+    max_velocity.head(6).setConstant(0.25 * static_cast<double>((i % 4) + 1));
+    const double path_tolerance = (i % 3 == 0) ? 0.0 : 0.1;
+
+    Path path(waypoints, path_tolerance);
+    Trajectory trajectory(path, max_velocity, max_acceleration, 0.001);
+    expectSameAsReference(path, trajectory, RANDOM_REFERENCES[i]);
+  }
+
+  max_velocity.head(6).setConstant(1.0);
+  const std::array<double, 2> path_tolerances{ 0.0, 0.1 };
+  for (std::size_t i = 0; i < FIXED_REFERENCES.size(); ++i)
+  {
+    SCOPED_TRACE("fixed case " + std::to_string(i));
+    Path path(createFixedWaypoints(), path_tolerances[i]);
+    Trajectory trajectory(path, max_velocity, max_acceleration, 0.001);
+    expectSameAsReference(path, trajectory, FIXED_REFERENCES[i]);
+  }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,160 @@
+/**
+ * @file trajectory_container_benchmark.cpp
+ * @brief Benchmark the time parameterization algorithms using an InstructionsTrajectory and a ContiguousTrajectory
+ *
+ * @version TODO
+ * @bug No known bugs
+ *
+ * @par License
+ * Software License Agreement (Apache License)
+ * @par
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * @par
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <tesseract_common/macros.h>
+TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
+#include <cmath>
+#include <functional>
+TESSERACT_COMMON_IGNORE_WARNINGS_POP
+
+#include <benchmark/benchmark.h>
+#include <tesseract_time_parameterization/core/contiguous_trajectory.h>
+#include <tesseract_time_parameterization/core/instructions_trajectory.h>
+#include <tesseract_time_parameterization/isp/iterative_spline_parameterization.h>
+#include <tesseract_time_parameterization/ruckig/ruckig_trajectory_smoothing.h>
+#include <tesseract_time_parameterization/totg/time_optimal_trajectory_generation.h>
+#include <tesseract_command_language/composite_instruction.h>
+#include <tesseract_command_language/move_instruction.h>
+#include <tesseract_command_language/state_waypoint.h>
+
+using namespace tesseract_planning;
+
+using SolveFn = std::function<bool(TrajectoryContainer&)>;
+
+static const Eigen::VectorXd MAX_VELOCITY = Eigen::VectorXd::Constant(6, 2.0);
+static const Eigen::VectorXd MAX_ACCELERATION = Eigen::VectorXd::Constant(6, 1.0);
+static const Eigen::VectorXd MAX_JERK = Eigen::VectorXd::Constant(6, 1000.0);
+
+/** @brief Create a freespace program where each waypoint moves every joint a small amount */
+CompositeInstruction createProgram(long num_waypoints)
+{
+  std::vector<std::string> joint_names = { "joint_1", "joint_2", "joint_3", "joint_4", "joint_5", "joint_6" };
+
+  CompositeInstruction program;
+  for (long i = 0; i < num_waypoints; ++i)
+  {
+    Eigen::VectorXd position(6);
+    for (Eigen::Index j = 0; j < 6; ++j)
+      position(j) = std::sin((0.001 * static_cast<double>(i)) + static_cast<double>(j));
+
+    StateWaypointPoly swp{ StateWaypoint(joint_names, position) };
+    program.appendMoveInstruction(MoveInstruction(swp, MoveInstructionType::FREESPACE));
+  }
+  return program;
+}
+
+/**
+ * @brief Time parameterize a program through the provided container
+ * @details The copy of the program and the InstructionsTrajectory are excluded from the timing. The gather and
+ * scatter of the ContiguousTrajectory are included since they are part of its cost.
+ */
+void runBenchmark(benchmark::State& state, const CompositeInstruction& base_program, bool contiguous, const SolveFn& fn)
+{
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    CompositeInstruction program = base_program;
+    InstructionsTrajectory trajectory(program);
+    state.ResumeTiming();
+
+    bool success{ false };
+    if (contiguous)
+    {
+      ContiguousTrajectory contiguous_trajectory(trajectory);
+      success = fn(contiguous_trajectory);
+      contiguous_trajectory.scatter(trajectory);
+    }
+    else
+    {
+      success = fn(trajectory);
+    }
+
+    if (!success)
+    {
+      state.SkipWithError("Failed to time parameterize the program");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ISP(benchmark::State& state, bool contiguous)
+{
+  const CompositeInstruction program = createProgram(state.range(0));
+  IterativeSplineParameterization solver(false);
+  runBenchmark(state, program, contiguous, [&solver](TrajectoryContainer& trajectory) {
+    return solver.compute(trajectory, MAX_VELOCITY, MAX_ACCELERATION);
+  });
+}
+
+static void BM_TOTG(benchmark::State& state, bool contiguous)
+{
+  const CompositeInstruction program = createProgram(state.range(0));
+  TimeOptimalTrajectoryGeneration solver(0.1, 0.1, 1e-3);
+  runBenchmark(state, program, contiguous, [&solver](TrajectoryContainer& trajectory) {
+    return solver.computeTimeStamps(trajectory, MAX_VELOCITY, MAX_ACCELERATION);
+  });
+}
+
+static void BM_RUCKIG(benchmark::State& state, bool contiguous)
+{
+  // Ruckig smooths an existing time parameterization
+  CompositeInstruction program = createProgram(state.range(0));
+  InstructionsTrajectory trajectory(program);
+  IterativeSplineParameterization isp(false);
+  if (!isp.compute(trajectory, MAX_VELOCITY, MAX_ACCELERATION))
+  {
+    state.SkipWithError("Failed to time parameterize the program");
+    return;
+  }
+
+  RuckigTrajectorySmoothing solver;
+  runBenchmark(state, program, contiguous, [&solver](TrajectoryContainer& trajectory) {
+    return solver.compute(trajectory, MAX_VELOCITY, MAX_ACCELERATION, MAX_JERK);
+  });
+}
+
+BENCHMARK_CAPTURE(BM_ISP, INSTRUCTIONS_TRAJECTORY, false)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_ISP, CONTIGUOUS_TRAJECTORY, true)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_TOTG, INSTRUCTIONS_TRAJECTORY, false)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_TOTG, CONTIGUOUS_TRAJECTORY, true)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_RUCKIG, INSTRUCTIONS_TRAJECTORY, false)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+BENCHMARK_CAPTURE(BM_RUCKIG, CONTIGUOUS_TRAJECTORY, true)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000)
+    ->Unit(benchmark::TimeUnit::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -43,6 +43,7 @@
 TESSERACT_COMMON_IGNORE_WARNINGS_PUSH
 #include <Eigen/Eigen>
 #include <list>
+#include <vector>
 TESSERACT_COMMON_IGNORE_WARNINGS_POP
 
 #include <tesseract_command_language/composite_instruction.h>
@@ -87,7 +88,7 @@ public:
   virtual Eigen::VectorXd getConfig(double s) const = 0;
   virtual Eigen::VectorXd getTangent(double s) const = 0;
   virtual Eigen::VectorXd getCurvature(double s) const = 0;
-  virtual std::list<double> getSwitchingPoints() const = 0;
+  virtual std::vector<double> getSwitchingPoints() const = 0;
   virtual std::unique_ptr<PathSegment> clone() const = 0;
 
   double position_{ 0 };
@@ -99,6 +100,7 @@ protected:
 class Path
 {
 public:
+  Path(const std::vector<Eigen::VectorXd>& path, double max_deviation = 0.0);
   Path(const std::list<Eigen::VectorXd>& path, double max_deviation = 0.0);
   ~Path() = default;
   Path(const Path& path);
@@ -111,15 +113,19 @@ public:
   Eigen::VectorXd getTangent(double s) const;
   Eigen::VectorXd getCurvature(double s) const;
   double getNextSwitchingPoint(double s, bool& discontinuity) const;
-  std::list<std::pair<double, bool>> getSwitchingPoints() const;
+  const std::vector<std::pair<double, bool>>& getSwitchingPoints() const;
   const std::vector<double>& getMapping() const;
 
 private:
+  /** @brief Get the segment containing s using a binary search, s is converted to the position within the segment */
   PathSegment* getPathSegment(double& s) const;
   double length_{ 0 };
   std::vector<double> mapping_;
-  std::list<std::pair<double, bool>> switching_points_;
-  std::list<std::unique_ptr<PathSegment>> path_segments_;
+  /** @brief The sorted switching points and whether each is a discontinuity */
+  std::vector<std::pair<double, bool>> switching_points_;
+  std::vector<std::unique_ptr<PathSegment>> path_segments_;
+  /** @brief The start position of each path segment, stored contiguously for searching */
+  std::vector<double> path_segment_positions_;
 };
 
 /** @brief Structure to store path data sampled at a point in time. */
@@ -191,6 +197,27 @@ private:
     double time_{ 0 };
   };
 
+  /**
+   * @brief The integrated trajectory steps stored as a structure of arrays
+   * @details Integration produces a step every time_step, so long slow trajectories have hundreds of thousands of
+   * steps. Storing each member contiguously keeps them compact and allows binary searching the times and positions.
+   */
+  struct TrajectorySteps
+  {
+    std::vector<double> path_pos;
+    std::vector<double> path_vel;
+    std::vector<double> time;
+
+    std::size_t size() const { return path_pos.size(); }
+    bool empty() const { return path_pos.empty(); }
+    void reserve(std::size_t n);
+    void emplace_back(double pos, double vel);
+    void pop_back();
+    void resize(std::size_t n);
+    void reverse();
+    void append(const TrajectorySteps& steps);
+  };
+
   bool getNextSwitchingPoint(double path_pos,
                              TrajectoryStep& next_switching_point,
                              double& before_acceleration,
@@ -203,9 +230,8 @@ private:
                                      TrajectoryStep& next_switching_point,
                                      double& before_acceleration,
                                      double& after_acceleration);
-  bool integrateForward(std::list<TrajectoryStep>& trajectory, double acceleration);
-  void
-  integrateBackward(std::list<TrajectoryStep>& start_trajectory, double path_pos, double path_vel, double acceleration);
+  bool integrateForward(TrajectorySteps& trajectory, double acceleration);
+  void integrateBackward(TrajectorySteps& start_trajectory, double path_pos, double path_vel, double acceleration);
   double getMinMaxPathAcceleration(double path_position, double path_velocity, bool max);
   double getMinMaxPhaseSlope(double path_position, double path_velocity, bool max);
   double getAccelerationMaxPathVelocity(double path_pos) const;
@@ -213,21 +239,20 @@ private:
   double getAccelerationMaxPathVelocityDeriv(double path_pos);
   double getVelocityMaxPathVelocityDeriv(double path_pos);
 
-  std::list<TrajectoryStep>::const_iterator getTrajectorySegment(double time) const;
-  std::list<TrajectoryStep>::const_iterator getTrajectorySegmentFromDist(double pos) const;
+  /** @brief Get the index of the first step after the provided time using a binary search */
+  std::size_t getTrajectorySegment(double time) const;
+  /** @brief Get the index of the first step after the provided path position using a binary search */
+  std::size_t getTrajectorySegmentFromDist(double pos) const;
 
   Path path_;
   Eigen::VectorXd max_velocity_;
   Eigen::VectorXd max_acceleration_;
   Eigen::Index joint_num_;
   bool valid_{ true };
-  std::list<TrajectoryStep> trajectory_;
-  std::list<TrajectoryStep> end_trajectory_;  // non-empty only if the trajectory generation failed.
+  TrajectorySteps trajectory_;
+  TrajectorySteps end_trajectory_;  // non-empty only if the trajectory generation failed.
 
   const double time_step_;
-
-  mutable double cached_time_;
-  mutable std::list<TrajectoryStep>::const_iterator cached_trajectory_segment_;
 };
 }  // namespace totg
 }  // namespace tesseract_planning
@@ -121,11 +121,13 @@ bool TimeOptimalTrajectoryGeneration::computeTimeStamps(TrajectoryContainer& tra
 
   // Have to convert into Eigen data structs and remove repeated points
   //  (https://github.com/tobiaskunz/trajectories/issues/3)
-  std::list<Eigen::VectorXd> points;
+  std::vector<Eigen::VectorXd> points;
   std::vector<std::size_t> mapping;
+  points.reserve(num_points);
+  mapping.reserve(num_points);
   for (Eigen::Index p = 0; p < static_cast<Eigen::Index>(num_points); ++p)
   {
-    const Eigen::VectorXd& position = trajectory.getPosition(p);
+    const Eigen::Ref<const Eigen::VectorXd> position = trajectory.getPosition(p);
     bool diverse_point = (p == 0);
 
     if (p > 0)
@@ -159,7 +161,8 @@ bool TimeOptimalTrajectoryGeneration::computeTimeStamps(TrajectoryContainer& tra
   }
 
   // Append a dummy joint as a workaround to https://github.com/ros-industrial-consortium/tesseract_planning/issues/27
-  std::list<Eigen::VectorXd> new_points;
+  std::vector<Eigen::VectorXd> new_points;
+  new_points.reserve(points.size());
   double dummy = 1.0;
   for (auto& point : points)
   {
@@ -208,7 +211,7 @@ public:
 
   Eigen::VectorXd getCurvature(double /* s */) const override { return Eigen::VectorXd::Zero(start_.size()); }
 
-  std::list<double> getSwitchingPoints() const override { return {}; }
+  std::vector<double> getSwitchingPoints() const override { return {}; }
 
   std::unique_ptr<PathSegment> clone() const override { return std::make_unique<LinearPathSegment>(*this); }
 
@@ -293,9 +296,9 @@ public:
     return (-1.0 / radius) * (x * cos(angle) + y * sin(angle));
   }
 
-  std::list<double> getSwitchingPoints() const override
+  std::vector<double> getSwitchingPoints() const override
   {
-    std::list<double> switching_points;
+    std::vector<double> switching_points;
     const Eigen::Index dim = x.size();
     for (Eigen::Index i = 0; i < dim; ++i)
     {
@@ -310,7 +313,7 @@ public:
         switching_points.push_back(switching_point);
       }
     }
-    switching_points.sort();
+    std::sort(switching_points.begin(), switching_points.end());
     return switching_points;
   }
 
@@ -323,28 +326,21 @@ private:
   Eigen::VectorXd y;
 };
 
-Path::Path(const std::list<Eigen::VectorXd>& path, double max_deviation)
+Path::Path(const std::vector<Eigen::VectorXd>& path, double max_deviation)
 {
   if (path.size() < 2)
     return;
-  auto path_iterator1 = path.begin();
-  auto path_iterator2 = path_iterator1;
-  ++path_iterator2;
-  std::list<Eigen::VectorXd>::const_iterator path_iterator3;
-  Eigen::VectorXd start_config = *path_iterator1;
+  Eigen::VectorXd start_config = path.front();
   mapping_.reserve(path.size());
   mapping_.push_back(0);
+  path_segments_.reserve(2 * path.size());
   double l{ 0 };
-  while (path_iterator2 != path.end())
+  for (std::size_t i = 1; i < path.size(); ++i)
   {
-    path_iterator3 = path_iterator2;
-    ++path_iterator3;
-    if (max_deviation > 0.0 && path_iterator3 != path.end())
+    if (max_deviation > 0.0 && i + 1 < path.size())
     {
-      auto blend_segment = std::make_unique<CircularPathSegment>(0.5 * (*path_iterator1 + *path_iterator2),
-                                                                 *path_iterator2,
-                                                                 0.5 * (*path_iterator2 + *path_iterator3),
-                                                                 max_deviation);
+      auto blend_segment = std::make_unique<CircularPathSegment>(
+          0.5 * (path[i - 1] + path[i]), path[i], 0.5 * (path[i] + path[i + 1]), max_deviation);
       Eigen::VectorXd end_config = blend_segment->getConfig(0.0);
       if ((end_config - start_config).norm() > 0.000001)
       {
@@ -359,22 +355,22 @@ Path::Path(const std::list<Eigen::VectorXd>& path, double max_deviation)
     }
     else
     {
-      path_segments_.push_back(std::make_unique<LinearPathSegment>(start_config, *path_iterator2));
+      path_segments_.push_back(std::make_unique<LinearPathSegment>(start_config, path[i]));
       l += path_segments_.back()->getLength();
       mapping_.push_back(l);
-      start_config = *path_iterator2;
+      start_config = path[i];
     }
-    path_iterator1 = path_iterator2;
-    ++path_iterator2;
   }
   assert(mapping_.size() == path.size());
 
   // Create list of switching point candidates, calculate total path length and
   // absolute positions of path segments
+  path_segment_positions_.reserve(path_segments_.size());
   for (std::unique_ptr<PathSegment>& path_segment : path_segments_)
   {
     path_segment->position_ = length_;
-    std::list<double> local_switching_points = path_segment->getSwitchingPoints();
+    path_segment_positions_.push_back(length_);
+    std::vector<double> local_switching_points = path_segment->getSwitchingPoints();
     for (const auto& local_switching_point : local_switching_points)
     {
       switching_points_.emplace_back(length_ + local_switching_point, false);
@@ -387,8 +383,18 @@ Path::Path(const std::list<Eigen::VectorXd>& path, double max_deviation)
   switching_points_.pop_back();
 }
 
-Path::Path(const Path& path) : length_(path.length_), mapping_(path.mapping_), switching_points_(path.switching_points_)
+Path::Path(const std::list<Eigen::VectorXd>& path, double max_deviation)
+  : Path(std::vector<Eigen::VectorXd>(path.begin(), path.end()), max_deviation)
+{
+}
+
+Path::Path(const Path& path)
+  : length_(path.length_)
+  , mapping_(path.mapping_)
+  , switching_points_(path.switching_points_)
+  , path_segment_positions_(path.path_segment_positions_)
 {
+  path_segments_.reserve(path.path_segments_.size());
   for (const std::unique_ptr<PathSegment>& path_segment : path.path_segments_)
     path_segments_.emplace_back(path_segment->clone());
 }
@@ -399,16 +405,11 @@ const std::vector<double>& Path::getMapping() const { return mapping_; }
 
 PathSegment* Path::getPathSegment(double& s) const
 {
-  auto it = path_segments_.begin();
-  auto next = it;
-  ++next;
-  while (next != path_segments_.end() && s >= (*next)->position_)
-  {
-    it = next;
-    ++next;
-  }
-  s -= (*it)->position_;
-  return (*it).get();
+  // The last segment starting at or before s, the first segment is used if s is before the start of the path
+  auto it = std::upper_bound(path_segment_positions_.begin() + 1, path_segment_positions_.end(), s);
+  const auto idx = static_cast<std::size_t>(std::distance(path_segment_positions_.begin(), it)) - 1;
+  s -= path_segment_positions_[idx];
+  return path_segments_[idx].get();
 }
 
 Eigen::VectorXd Path::getConfig(double s) const
@@ -431,11 +432,10 @@ Eigen::VectorXd Path::getCurvature(double s) const
 
 double Path::getNextSwitchingPoint(double s, bool& discontinuity) const
 {
-  auto it = switching_points_.begin();
-  while (it != switching_points_.end() && it->first <= s)
-  {
-    ++it;
-  }
+  auto it = std::upper_bound(switching_points_.begin(),
+                             switching_points_.end(),
+                             s,
+                             [](double value, const std::pair<double, bool>& point) { return value < point.first; });
   if (it == switching_points_.end())
   {
     discontinuity = true;
@@ -445,7 +445,51 @@ double Path::getNextSwitchingPoint(double s, bool& discontinuity) const
   return it->first;
 }
 
-std::list<std::pair<double, bool>> Path::getSwitchingPoints() const { return switching_points_; }
+const std::vector<std::pair<double, bool>>& Path::getSwitchingPoints() const { return switching_points_; }
+
+void Trajectory::TrajectorySteps::reserve(std::size_t n)
+{
+  path_pos.reserve(n);
+  path_vel.reserve(n);
+  time.reserve(n);
+}
+
+void Trajectory::TrajectorySteps::emplace_back(double pos, double vel)
+{
+  assert(!std::isnan(pos));
+  assert(!std::isnan(vel));
+  path_pos.push_back(pos);
+  path_vel.push_back(vel);
+  time.push_back(0);
+}
+
+void Trajectory::TrajectorySteps::pop_back()
+{
+  path_pos.pop_back();
+  path_vel.pop_back();
+  time.pop_back();
+}
+
+void Trajectory::TrajectorySteps::resize(std::size_t n)
+{
+  path_pos.resize(n);
+  path_vel.resize(n);
+  time.resize(n);
+}
+
+void Trajectory::TrajectorySteps::reverse()
+{
+  std::reverse(path_pos.begin(), path_pos.end());
+  std::reverse(path_vel.begin(), path_vel.end());
+  std::reverse(time.begin(), time.end());
+}
+
+void Trajectory::TrajectorySteps::append(const TrajectorySteps& steps)
+{
+  path_pos.insert(path_pos.end(), steps.path_pos.begin(), steps.path_pos.end());
+  path_vel.insert(path_vel.end(), steps.path_vel.begin(), steps.path_vel.end());
+  time.insert(time.end(), steps.time.begin(), steps.time.end());
+}
 
 Trajectory::Trajectory(const Path& path,
                        const Eigen::VectorXd& max_velocity,
@@ -456,7 +500,6 @@ Trajectory::Trajectory(const Path& path,
   , max_acceleration_(max_acceleration)
   , joint_num_(max_velocity.size())
   , time_step_(time_step)
-  , cached_time_(std::numeric_limits<double>::max())
 {
   trajectory_.emplace_back(0.0, 0.0);
   double after_acceleration = getMinMaxPathAcceleration(0.0, 0.0, true);
@@ -464,7 +507,7 @@ Trajectory::Trajectory(const Path& path,
   {
     double before_acceleration{ NAN };
     TrajectoryStep switching_point;
-    if (getNextSwitchingPoint(trajectory_.back().path_pos_, switching_point, before_acceleration, after_acceleration))
+    if (getNextSwitchingPoint(trajectory_.path_pos.back(), switching_point, before_acceleration, after_acceleration))
     {
       break;
     }
@@ -480,16 +523,11 @@ Trajectory::Trajectory(const Path& path,
   if (valid_)
   {
     // Calculate timing
-    auto previous = trajectory_.begin();
-    auto it = previous;
-    it->time_ = 0.0;
-    ++it;
-    while (it != trajectory_.end())
+    trajectory_.time[0] = 0.0;
+    for (std::size_t i = 1; i < trajectory_.size(); ++i)
     {
-      it->time_ =
-          previous->time_ + (it->path_pos_ - previous->path_pos_) / ((it->path_vel_ + previous->path_vel_) / 2.0);
-      previous = it;
-      ++it;
+      trajectory_.time[i] = trajectory_.time[i - 1] + (trajectory_.path_pos[i] - trajectory_.path_pos[i - 1]) /
+                                                          ((trajectory_.path_vel[i] + trajectory_.path_vel[i - 1]) / 2.0);
     }
   }
 }
@@ -651,12 +689,12 @@ bool Trajectory::getNextVelocitySwitchingPoint(double path_pos,
 }
 
 // Returns true if end of path is reached
-bool Trajectory::integrateForward(std::list<TrajectoryStep>& trajectory, double acceleration)
+bool Trajectory::integrateForward(TrajectorySteps& trajectory, double acceleration)
 {
-  double path_pos = trajectory.back().path_pos_;
-  double path_vel = trajectory.back().path_vel_;
+  double path_pos = trajectory.path_pos.back();
+  double path_vel = trajectory.path_vel.back();
 
-  std::list<std::pair<double, bool>> switching_points = path_.getSwitchingPoints();
+  const std::vector<std::pair<double, bool>>& switching_points = path_.getSwitchingPoints();
   auto next_discontinuity = switching_points.begin();
 
   while (true)
@@ -712,12 +750,11 @@ bool Trajectory::integrateForward(std::list<TrajectoryStep>& trajectory, double
     if (path_vel > getAccelerationMaxPathVelocity(path_pos) || path_vel > getVelocityMaxPathVelocity(path_pos))
     {
       // Find more accurate intersection with max-velocity curve using bisection
-      TrajectoryStep overshoot = trajectory.back();
+      double after = trajectory.path_pos.back();
+      double after_path_vel = trajectory.path_vel.back();
       trajectory.pop_back();
-      double before = trajectory.back().path_pos_;
-      double before_path_vel = trajectory.back().path_vel_;
-      double after = overshoot.path_pos_;
-      double after_path_vel = overshoot.path_vel_;
+      double before = trajectory.path_pos.back();
+      double before_path_vel = trajectory.path_vel.back();
       while (after - before > EPS)
       {
         const double midpoint = 0.5 * (before + after);
@@ -751,16 +788,16 @@ bool Trajectory::integrateForward(std::list<TrajectoryStep>& trajectory, double
           return false;
         }
 
-        if (getMinMaxPhaseSlope(trajectory.back().path_pos_, trajectory.back().path_vel_, true) >
-            getAccelerationMaxPathVelocityDeriv(trajectory.back().path_pos_))
+        if (getMinMaxPhaseSlope(trajectory.path_pos.back(), trajectory.path_vel.back(), true) >
+            getAccelerationMaxPathVelocityDeriv(trajectory.path_pos.back()))
         {
           return false;
         }
       }
       else
       {
-        if (getMinMaxPhaseSlope(trajectory.back().path_pos_, trajectory_.back().path_vel_, false) >
-            getVelocityMaxPathVelocityDeriv(trajectory_.back().path_pos_))
+        if (getMinMaxPhaseSlope(trajectory.path_pos.back(), trajectory_.path_vel.back(), false) >
+            getVelocityMaxPathVelocityDeriv(trajectory_.path_pos.back()))
         {
           return false;
         }
@@ -769,34 +806,37 @@ bool Trajectory::integrateForward(std::list<TrajectoryStep>& trajectory, double
   }
 }
 
-void Trajectory::integrateBackward(std::list<TrajectoryStep>& start_trajectory,
+void Trajectory::integrateBackward(TrajectorySteps& start_trajectory,
                                    double path_pos,
                                    double path_vel,
                                    double acceleration)
 {
-  auto start2 = start_trajectory.end();
-  --start2;
-  auto start1 = start2;
-  --start1;
-  std::list<TrajectoryStep> trajectory;
+  std::size_t start2 = start_trajectory.size() - 1;
+  std::size_t start1 = start2 - 1;
+  const std::vector<double>& start_pos = start_trajectory.path_pos;
+  const std::vector<double>& start_vel = start_trajectory.path_vel;
+
+  // The steps are appended in reverse order and reversed once the start trajectory is hit
+  TrajectorySteps trajectory;
   double slope{ 0 };
-  assert(start1->path_pos_ < path_pos || tesseract_common::almostEqualRelativeAndAbs(start1->path_pos_, path_pos, EPS));
+  assert(start_pos[start1] < path_pos || tesseract_common::almostEqualRelativeAndAbs(start_pos[start1], path_pos, EPS));
 
-  while (start1 != start_trajectory.begin() || path_pos >= 0.0)
+  while (start1 != 0 || path_pos >= 0.0)
   {
-    if (start1->path_pos_ < path_pos || tesseract_common::almostEqualRelativeAndAbs(start1->path_pos_, path_pos, EPS))
+    if (start_pos[start1] < path_pos || tesseract_common::almostEqualRelativeAndAbs(start_pos[start1], path_pos, EPS))
     {
-      trajectory.push_front(TrajectoryStep(path_pos, path_vel));
+      trajectory.emplace_back(path_pos, path_vel);
       path_vel -= time_step_ * acceleration;
-      path_pos -= time_step_ * 0.5 * (path_vel + trajectory.front().path_vel_);
+      path_pos -= time_step_ * 0.5 * (path_vel + trajectory.path_vel.back());
       acceleration = getMinMaxPathAcceleration(path_pos, path_vel, false);
-      slope = (trajectory.front().path_vel_ - path_vel) / (trajectory.front().path_pos_ - path_pos);
+      slope = (trajectory.path_vel.back() - path_vel) / (trajectory.path_pos.back() - path_pos);
 
       if (path_vel < 0.0)
       {
         valid_ = false;
         CONSOLE_BRIDGE_logError("Error while integrating backward: Negative path velocity");
-        end_trajectory_ = trajectory;
+        trajectory.reverse();
+        end_trajectory_ = std::move(trajectory);
         return;
       }
     }
@@ -808,7 +848,7 @@ void Trajectory::integrateBackward(std::list<TrajectoryStep>& start_trajectory,
 
     // Check for intersection between current start trajectory and backward
     // trajectory segments
-    const double start_slope = (start2->path_vel_ - start1->path_vel_) / (start2->path_pos_ - start1->path_pos_);
+    const double start_slope = (start_vel[start2] - start_vel[start1]) / (start_pos[start2] - start_pos[start1]);
 
     // It is possible to have both slope and start_slope to be equal
     // This occurs if two consecutive TrajectorySteps have the same acceleration.
@@ -816,13 +856,13 @@ void Trajectory::integrateBackward(std::list<TrajectoryStep>& start_trajectory,
     bool check_eq_slope = tesseract_common::almostEqualRelativeAndAbs(slope, start_slope, EPS);
     double intersection_path_pos{ 0 };
     if (check_eq_slope)
-      intersection_path_pos = start1->path_pos_ + (start2->path_pos_ - start1->path_pos_) / 2.0;
+      intersection_path_pos = start_pos[start1] + (start_pos[start2] - start_pos[start1]) / 2.0;
     else
       intersection_path_pos =
-          (start1->path_vel_ - path_vel + slope * path_pos - start_slope * start1->path_pos_) / (slope - start_slope);
+          (start_vel[start1] - path_vel + slope * path_pos - start_slope * start_pos[start1]) / (slope - start_slope);
 
-    double pos_max = std::max(start1->path_pos_, path_pos);
-    double pos_min = std::min(start2->path_pos_, trajectory.front().path_pos_);
+    double pos_max = std::max(start_pos[start1], path_pos);
+    double pos_min = std::min(start_pos[start2], trajectory.path_pos.back());
     bool check1 = (pos_max < intersection_path_pos) ||
                   tesseract_common::almostEqualRelativeAndAbs(pos_max, intersection_path_pos, EPS);
     bool check2 = (intersection_path_pos < pos_min) ||
@@ -830,18 +870,19 @@ void Trajectory::integrateBackward(std::list<TrajectoryStep>& start_trajectory,
 
     if (check1 && check2)
     {
-      const double intersection_path_vel =
-          start1->path_vel_ + start_slope * (intersection_path_pos - start1->path_pos_);
-      start_trajectory.erase(start2, start_trajectory.end());
+      const double intersection_path_vel = start_vel[start1] + start_slope * (intersection_path_pos - start_pos[start1]);
+      start_trajectory.resize(start2);
       start_trajectory.emplace_back(intersection_path_pos, intersection_path_vel);
-      start_trajectory.splice(start_trajectory.end(), trajectory);
+      trajectory.reverse();
+      start_trajectory.append(trajectory);
       return;
     }
   }
 
   valid_ = false;
   CONSOLE_BRIDGE_logError("Error while integrating backward: Did not hit start trajectory");
-  end_trajectory_ = trajectory;
+  trajectory.reverse();
+  end_trajectory_ = std::move(trajectory);
 }
 
 double Trajectory::getMinMaxPathAcceleration(double path_position, double path_velocity, bool max)
@@ -936,7 +977,7 @@ double Trajectory::getVelocityMaxPathVelocityDeriv(double path_pos)
 
 bool Trajectory::isValid() const { return valid_; }
 
-double Trajectory::getDuration() const { return trajectory_.back().time_; }
+double Trajectory::getDuration() const { return trajectory_.time.back(); }
 
 bool Trajectory::assignData(TrajectoryContainer& trajectory, const std::vector<std::size_t>& mapping) const
 {
@@ -978,92 +1019,75 @@ bool Trajectory::assignData(TrajectoryContainer& trajectory, const std::vector<s
   return true;
 }
 
-std::list<Trajectory::TrajectoryStep>::const_iterator Trajectory::getTrajectorySegment(double time) const
+std::size_t Trajectory::getTrajectorySegment(double time) const
 {
-  if (time >= trajectory_.back().time_)
-  {
-    auto last = trajectory_.end();
-    last--;
-    return last;
-  }
+  if (time >= trajectory_.time.back())
+    return trajectory_.size() - 1;
 
-  if (time < cached_time_)
-  {
-    cached_trajectory_segment_ = trajectory_.begin();
-  }
-  while (time >= cached_trajectory_segment_->time_)
-  {
-    ++cached_trajectory_segment_;
-  }
-  cached_time_ = time;
-  return cached_trajectory_segment_;
+  auto it = std::upper_bound(trajectory_.time.begin(), trajectory_.time.end(), time);
+  return static_cast<std::size_t>(std::distance(trajectory_.time.begin(), it));
 }
 
-std::list<Trajectory::TrajectoryStep>::const_iterator Trajectory::getTrajectorySegmentFromDist(double pos) const
+std::size_t Trajectory::getTrajectorySegmentFromDist(double pos) const
 {
-  if (pos >= trajectory_.back().path_pos_)
-  {
-    auto last = trajectory_.end();
-    last--;
-    return last;
-  }
+  if (pos >= trajectory_.path_pos.back())
+    return trajectory_.size() - 1;
 
   if (pos < 0)
-    return trajectory_.begin();
-
-  for (auto it = trajectory_.begin(); it != trajectory_.end(); ++it)
-  {
-    if (pos < it->path_pos_)
-      return it;
-  }
+    return 0;
 
-  throw std::runtime_error("Failed to find trajectory segment, this should not happen");
+  auto it = std::upper_bound(trajectory_.path_pos.begin(), trajectory_.path_pos.end(), pos);
+  return static_cast<std::size_t>(std::distance(trajectory_.path_pos.begin(), it));
 }
 
 PathData Trajectory::getPathData(double time) const
 {
   PathData data;
 
-  auto it = getTrajectorySegment(time);
-  auto previous = it;
-  previous--;
+  const std::size_t it = getTrajectorySegment(time);
+  const std::size_t previous = it - 1;
+  const double previous_path_pos = trajectory_.path_pos[previous];
+  const double previous_path_vel = trajectory_.path_vel[previous];
+  const double previous_time = trajectory_.time[previous];
 
-  double time_step = it->time_ - previous->time_;
+  double time_step = trajectory_.time[it] - previous_time;
   const double acceleration =
-      2.0 * (it->path_pos_ - previous->path_pos_ - time_step * previous->path_vel_) / (time_step * time_step);
+      2.0 * (trajectory_.path_pos[it] - previous_path_pos - time_step * previous_path_vel) / (time_step * time_step);
 
-  time_step = time - previous->time_;
-  data.path_pos = (previous->path_pos_ + time_step * previous->path_vel_ + 0.5 * time_step * time_step * acceleration);
-  data.path_vel = previous->path_vel_ + time_step * acceleration;
+  time_step = time - previous_time;
+  data.path_pos = (previous_path_pos + time_step * previous_path_vel + 0.5 * time_step * time_step * acceleration);
+  data.path_vel = previous_path_vel + time_step * acceleration;
   data.time = time;
-  data.prev_path_pos = previous->path_pos_;
-  data.prev_path_vel = previous->path_vel_;
-  data.prev_time = previous->time_;
+  data.prev_path_pos = previous_path_pos;
+  data.prev_path_vel = previous_path_vel;
+  data.prev_time = previous_time;
   return data;
 }
 
 double Trajectory::getTime(double pos) const
 {
-  auto it = getTrajectorySegmentFromDist(pos);
-  assert(it != trajectory_.begin());
-  auto previous = it;
-  previous--;
+  const std::size_t it = getTrajectorySegmentFromDist(pos);
+  assert(it != 0);
+  const std::size_t previous = it - 1;
+  const double previous_path_pos = trajectory_.path_pos[previous];
+  const double previous_path_vel = trajectory_.path_vel[previous];
+  const double previous_time = trajectory_.time[previous];
 
-  assert(pos >= previous->path_pos_ && pos <= it->path_pos_);
+  assert(pos >= previous_path_pos && pos <= trajectory_.path_pos[it]);
 
-  double time_step = it->time_ - previous->time_;
+  double time_step = trajectory_.time[it] - previous_time;
   const double acceleration =
-      2.0 * (it->path_pos_ - previous->path_pos_ - time_step * previous->path_vel_) / (time_step * time_step);
+      2.0 * (trajectory_.path_pos[it] - previous_path_pos - time_step * previous_path_vel) / (time_step * time_step);
 
   const double a = 0.5 * acceleration;
-  const double b = previous->path_vel_;
-  const double c = previous->path_pos_ - pos;
+  const double b = previous_path_vel;
+  const double c = previous_path_pos - pos;
 
   const double d = std::pow(b, 2.0) - (4 * a * c);
   const double e = ((d > 0) ? std::sqrt(d) : 0);
   const double dt = (-b + e) / (2.0 * a);
   assert(!(dt < 0));
-  return (previous->time_ + dt);
+  return (previous_time + dt);
 }
 
 Eigen::VectorXd Trajectory::getPosition(const PathData& data) const { return path_.getConfig(data.path_pos); }